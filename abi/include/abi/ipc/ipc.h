@@ -52,6 +52,12 @@ enum {
 	/** Maximum active async calls per phone */
 	IPC_MAX_ASYNC_CALLS = 64,
 
+	/**
+	 * Maximum number of entries submitted by SYS_IPC_SUBMIT or received
+	 * by SYS_IPC_WAIT_MANY in one syscall.
+	 */
+	IPC_BATCH_MAX = 64,
+
 	/**
 	 * Maximum buffer size allowed for IPC_M_DATA_WRITE and
 	 * IPC_M_DATA_READ requests.
@@ -92,6 +98,15 @@ enum {
 	IPC_FF_ROUTE_FROM_ME = 1 << 0,
 };
 
+/* Operations submitted by SYS_IPC_SUBMIT. */
+enum {
+	/** Make an asynchronous call over the phone in the handle */
+	IPC_SUBMIT_CALL,
+
+	/** Answer the call in the handle */
+	IPC_SUBMIT_ANSWER,
+};
+
 /* Data transfer flags. */
 enum {
 	IPC_XF_NONE = 0,
@@ -122,6 +137,20 @@ typedef struct {
 	cap_call_handle_t cap_handle;
 } ipc_data_t;
 
+/** Entry of a batch of calls and answers submitted by SYS_IPC_SUBMIT */
+typedef struct {
+	/** IPC_SUBMIT_CALL or IPC_SUBMIT_ANSWER */
+	sysarg_t op;
+	/** Phone handle of a call or call handle of an answer */
+	cap_handle_t handle;
+	/** User-defined label of the answer to a call */
+	sysarg_t label;
+	/** Method and arguments of a call or return value and arguments of an answer */
+	sysarg_t args[IPC_CALL_LEN];
+	/** Result of the operation as filled in by the kernel */
+	errno_t rc;
+} ipc_submit_t;
+
 /* Functions for manipulating calling data */
 
 static inline void ipc_set_retval(ipc_data_t *data, errno_t retval)
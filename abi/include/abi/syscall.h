@@ -67,6 +67,7 @@ typedef enum {
 	SYS_AS_AREA_CHANGE_FLAGS,
 	SYS_AS_AREA_GET_INFO,
 	SYS_AS_AREA_DESTROY,
+	SYS_AS_AREA_POPULATE,
 
 	SYS_PAGE_FIND_MAPPING,
 
@@ -77,6 +78,8 @@ typedef enum {
 	SYS_IPC_FORWARD_FAST,
 	SYS_IPC_FORWARD_SLOW,
 	SYS_IPC_WAIT,
+	SYS_IPC_WAIT_MANY,
+	SYS_IPC_SUBMIT,
 	SYS_IPC_POKE,
 	SYS_IPC_HANGUP,
 	SYS_IPC_CONNECT_KBOX,
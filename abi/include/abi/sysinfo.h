@@ -48,6 +48,7 @@ enum {
 	/** Maximum name sizes */
 	TASK_NAME_BUFLEN = 64,
 	EXC_NAME_BUFLEN  = 20,
+	LOCK_NAME_BUFLEN = 32,
 };
 
 /** Item value type
@@ -107,6 +108,7 @@ typedef struct {
 	size_t threads;               /**< Number of threads */
 	uint64_t ucycles;             /**< Number of CPU cycles in user space */
 	uint64_t kcycles;             /**< Number of CPU cycles in kernel */
+	uint64_t page_faults;         /**< Number of page faults resolved */
 	stats_ipc_t ipc_info;         /**< IPC statistics */
 } stats_task_t;
 
@@ -143,6 +145,22 @@ typedef struct {
 	uint64_t count;              /**< Number of handled exceptions */
 } stats_exc_t;
 
+/** Contention statistics of a class of kernel locks
+ *
+ * Spinlocks are grouped by their name, mutexes by the function which
+ * initialized them.
+ *
+ */
+typedef struct {
+	unsigned int id;               /**< Lock class ID */
+	char name[LOCK_NAME_BUFLEN];   /**< Lock or initializer name */
+	bool mutex;                    /**< Class of mutexes or spinlocks */
+	uint64_t acquisitions;         /**< Number of acquisitions */
+	uint64_t contentions;          /**< Number of contended acquisitions */
+	uint64_t wait_cycles;          /**< Cycles spent waiting for the locks */
+	uint64_t max_wait_cycles;      /**< Longest wait in cycles */
+} stats_lock_t;
+
 /** Load fixed-point value */
 typedef uint32_t load_t;
 
@@ -66,6 +66,11 @@ _NO_TRACE static inline void cpu_sleep(void)
 	 */
 }
 
+/** Spin loop hint. */
+_NO_TRACE static inline void cpu_spin_hint(void)
+{
+}
+
 _NO_TRACE static inline void pio_write_8(ioport8_t *port, uint8_t val)
 {
 }
@@ -69,6 +69,19 @@ _NO_TRACE static inline void cpu_sleep(void)
 	);
 }
 
+/** Spin loop hint.
+ *
+ * PAUSE avoids the penalty for a memory order violation when leaving the
+ * loop and lets the sibling hyperthread run.
+ *
+ */
+_NO_TRACE static inline void cpu_spin_hint(void)
+{
+	asm volatile (
+	    "pause\n"
+	);
+}
+
 _NO_TRACE static inline void __attribute__((noreturn)) cpu_halt(void)
 {
 	while (true) {
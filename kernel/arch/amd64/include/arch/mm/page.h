@@ -90,6 +90,9 @@
 #define PTL2_INDEX_ARCH(vaddr)  (((vaddr) >> 21) & 0x1ffU)
 #define PTL3_INDEX_ARCH(vaddr)  (((vaddr) >> 12) & 0x1ffU)
 
+/* PTL2 entries can map a 2 MiB large page directly. */
+#define LARGE_PAGE_WIDTH_ARCH  21
+
 /* Get PTE address accessors for each level. */
 #define GET_PTL1_ADDRESS_ARCH(ptl0, i) \
 	((pte_t *) ((((uint64_t) ((pte_t *) (ptl0))[(i)].addr_12_31) << 12) | \
@@ -137,6 +140,12 @@
 #define SET_FRAME_FLAGS_ARCH(ptl3, i, x) \
 	set_pt_flags((pte_t *) (ptl3), (size_t) (i), (x))
 
+/* Large page accessors for PTL2 entries. */
+#define GET_PTL3_LARGE_ARCH(ptl2, i) \
+	(((pte_t *) (ptl2))[(i)].page_size != 0)
+#define SET_PTL3_LARGE_ARCH(ptl2, i, x) \
+	(((pte_t *) (ptl2))[(i)].page_size = ((x) != 0))
+
 /* Set PTE present bit accessors for each level. */
 #define SET_PTL1_PRESENT_ARCH(ptl0, i) \
 	set_pt_present((pte_t *) (ptl0), (size_t) (i))
@@ -197,7 +206,7 @@ typedef struct {
 	unsigned int page_cache_disable : 1;
 	unsigned int accessed : 1;
 	unsigned int dirty : 1;
-	unsigned int unused : 1;
+	unsigned int page_size : 1;   /**< Large page (PTL2 entries only). */
 	unsigned int global : 1;
 	unsigned int soft_valid : 1;  /**< Valid content even if present bit is cleared. */
 	unsigned int avl : 2;
@@ -63,6 +63,19 @@ _NO_TRACE static inline void cpu_sleep(void)
 	);
 }
 
+/** Spin loop hint.
+ *
+ * PAUSE avoids the penalty for a memory order violation when leaving the
+ * loop and lets the sibling hyperthread run.
+ *
+ */
+_NO_TRACE static inline void cpu_spin_hint(void)
+{
+	asm volatile (
+	    "pause\n"
+	);
+}
+
 #define GEN_READ_REG(reg) _NO_TRACE static inline sysarg_t read_ ##reg (void) \
 	{ \
 		sysarg_t res; \
@@ -81,6 +81,10 @@ typedef struct {
 	tss_t *tss;
 
 	size_t iomapver_copy;  /** Copy of TASK's I/O Permission bitmap generation count. */
+
+	uint32_t apic_tick;     /** Local APIC timer count of one clock tick. */
+	uint32_t apic_passed;   /** Timer count elapsed when the one-shot was armed. */
+	uint32_t apic_oneshot;  /** Initial count of the armed one-shot. */
 } cpu_arch_t;
 
 #endif
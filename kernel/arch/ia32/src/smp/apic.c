@@ -39,6 +39,7 @@
 #include <arch/boot/boot.h>
 #include <assert.h>
 #include <mm/page.h>
+#include <time/clock.h>
 #include <time/delay.h>
 #include <interrupt.h>
 #include <arch/interrupt.h>
@@ -163,6 +164,107 @@ static void apic_spurious(unsigned int n __attribute__((unused)),
 {
 }
 
+/** Wakeup IPI handler.
+ *
+ * The IPI only needs to bring the CPU out of cpu_sleep(), the scheduler
+ * takes care of the rest.
+ *
+ * @param n      Interrupt vector.
+ * @param istate Interrupted state.
+ *
+ */
+static void wakeup_ipi(unsigned int n __attribute__((unused)),
+    istate_t *istate __attribute__((unused)))
+{
+	l_apic_eoi(0);
+}
+
+/** Reprogram the local timer of the current CPU as a one-shot.
+ *
+ * @param usec Microseconds since the last clock tick after which the
+ *             timer should fire.
+ *
+ */
+static void l_apic_timer_oneshot(uint64_t usec)
+{
+	uint32_t tick = CPU->arch.apic_tick;
+	uint32_t passed = tick - l_apic[CCRT];
+	uint64_t count = usec * tick / (1000000 / HZ);
+
+	if (count > passed)
+		count -= passed;
+	else
+		count = 1;
+
+	if (count > UINT32_MAX)
+		count = UINT32_MAX;
+
+	lvt_tm_t tm;
+
+	tm.value = l_apic[LVT_Tm];
+	tm.mode = TIMER_ONESHOT;
+	l_apic[LVT_Tm] = tm.value;
+	l_apic[ICRT] = (uint32_t) count;
+
+	CPU->arch.apic_passed = passed;
+	CPU->arch.apic_oneshot = (uint32_t) count;
+}
+
+/** Return the local timer of the current CPU to periodic mode.
+ *
+ * @return Microseconds elapsed since the last clock tick before
+ *         l_apic_timer_oneshot() was called.
+ *
+ */
+static uint64_t l_apic_timer_periodic(void)
+{
+	uint32_t tick = CPU->arch.apic_tick;
+	uint64_t count = (uint64_t) CPU->arch.apic_passed +
+	    CPU->arch.apic_oneshot - l_apic[CCRT];
+
+	lvt_tm_t tm;
+
+	tm.value = l_apic[LVT_Tm];
+	tm.mode = TIMER_PERIODIC;
+	l_apic[LVT_Tm] = tm.value;
+	l_apic[ICRT] = tick;
+
+	return count * (1000000 / HZ) / tick;
+}
+
+/** Return the time elapsed since the last clock tick of the current CPU.
+ *
+ * @return Microseconds elapsed since the last clock tick, counting from
+ *         the tick before l_apic_timer_oneshot() if the one-shot is armed.
+ *
+ */
+static uint64_t l_apic_timer_elapsed(void)
+{
+	uint32_t tick = CPU->arch.apic_tick;
+	uint64_t count;
+
+	if (atomic_load(&CPU->tickless)) {
+		count = (uint64_t) CPU->arch.apic_passed +
+		    CPU->arch.apic_oneshot - l_apic[CCRT];
+	} else
+		count = tick - l_apic[CCRT];
+
+	return count * (1000000 / HZ) / tick;
+}
+
+/** Wake up a CPU sleeping with its local timer in one-shot mode. */
+static void l_apic_timer_kick(cpu_t *cpu)
+{
+	l_apic_send_custom_ipi((uint8_t) cpu->arch.id, VECTOR_WAKEUP_IPI);
+}
+
+static clock_oneshot_ops_t l_apic_oneshot_ops = {
+	.oneshot = l_apic_timer_oneshot,
+	.periodic = l_apic_timer_periodic,
+	.kick = l_apic_timer_kick,
+	.elapsed = l_apic_timer_elapsed
+};
+
 static irq_ownership_t l_apic_timer_claim(irq_t *irq)
 {
 	return IRQ_ACCEPT;
@@ -198,6 +300,8 @@ void apic_init(void)
 {
 	exc_register(VECTOR_APIC_SPUR, "apic_spurious", false,
 	    (iroutine_t) apic_spurious);
+	exc_register(VECTOR_WAKEUP_IPI, "wakeup_ipi", true,
+	    (iroutine_t) wakeup_ipi);
 
 	pic_ops = &apic_pic_ops;
 
@@ -215,6 +319,8 @@ void apic_init(void)
 	l_apic_timer_irq.handler = l_apic_timer_irq_handler;
 	irq_register(&l_apic_timer_irq);
 
+	clock_oneshot_ops = &l_apic_oneshot_ops;
+
 	uint8_t i;
 	for (i = 0; i < IRQ_COUNT; i++) {
 		int pin;
@@ -510,6 +616,7 @@ void l_apic_init(void)
 	delay(1000000 / HZ);
 	uint32_t t2 = l_apic[CCRT];
 
+	CPU->arch.apic_tick = t1 - t2;
 	l_apic[ICRT] = t1 - t2;
 
 	/* Program Logical Destination Register. */
@@ -479,6 +479,12 @@ _NO_TRACE static inline void pk_disable(void)
 	);
 }
 
+/** Spin loop hint. */
+_NO_TRACE static inline void cpu_spin_hint(void)
+{
+	asm volatile ("hint @pause");
+}
+
 extern void cpu_halt(void) __attribute__((noreturn));
 extern void cpu_sleep(void);
 extern void asm_delay_loop(uint32_t t);
@@ -44,6 +44,11 @@ _NO_TRACE static inline void cpu_sleep(void)
 	asm volatile ("wait");
 }
 
+/** Spin loop hint, a no-op on this architecture. */
+_NO_TRACE static inline void cpu_spin_hint(void)
+{
+}
+
 /** Return base address of current stack
  *
  * Return the base address of the current stack.
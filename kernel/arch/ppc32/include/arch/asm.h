@@ -186,6 +186,11 @@ _NO_TRACE static inline void cpu_sleep(void)
 {
 }
 
+/** Spin loop hint, a no-op on this architecture. */
+_NO_TRACE static inline void cpu_spin_hint(void)
+{
+}
+
 _NO_TRACE static inline void pio_write_8(ioport8_t *port, uint8_t v)
 {
 	*port = v;
@@ -52,6 +52,12 @@
 #include <bitops.h>
 
 static void pt_mapping_insert(as_t *, uintptr_t, uintptr_t, unsigned int);
+#ifdef LARGE_PAGE_WIDTH_ARCH
+static bool pt_mapping_insert_large(as_t *, uintptr_t, uintptr_t,
+    unsigned int);
+static bool pt_mapping_remove_large(as_t *, uintptr_t);
+static void pt_mapping_split(as_t *, uintptr_t);
+#endif
 static void pt_mapping_remove(as_t *, uintptr_t);
 static bool pt_mapping_find(as_t *, uintptr_t, bool, pte_t *pte);
 static void pt_mapping_update(as_t *, uintptr_t, bool, pte_t *pte);
@@ -59,25 +65,26 @@ static void pt_mapping_make_global(uintptr_t, size_t);
 
 page_mapping_operations_t pt_mapping_operations = {
 	.mapping_insert = pt_mapping_insert,
+#ifdef LARGE_PAGE_WIDTH_ARCH
+	.mapping_insert_large = pt_mapping_insert_large,
+	.mapping_remove_large = pt_mapping_remove_large,
+	.mapping_split = pt_mapping_split,
+#endif
 	.mapping_remove = pt_mapping_remove,
 	.mapping_find = pt_mapping_find,
 	.mapping_update = pt_mapping_update,
 	.mapping_make_global = pt_mapping_make_global
 };
 
-/** Map page to frame using hierarchical page tables.
+/** Get the PTL2 covering a page, allocating the missing upper tables.
  *
- * Map virtual address page to physical address frame
- * using flags.
+ * @param as   Address space to wich page belongs.
+ * @param page Virtual address of the page.
  *
- * @param as    Address space to wich page belongs.
- * @param page  Virtual address of the page to be mapped.
- * @param frame Physical address of memory frame to which the mapping is done.
- * @param flags Flags to be used for mapping.
+ * @return Kernel address of the PTL2.
  *
  */
-void pt_mapping_insert(as_t *as, uintptr_t page, uintptr_t frame,
-    unsigned int flags)
+static pte_t *pt_ptl2_get(as_t *as, uintptr_t page)
 {
 	pte_t *ptl0 = (pte_t *) PA2KA((uintptr_t) as->genarch.page_table);
 
@@ -117,7 +124,234 @@ void pt_mapping_insert(as_t *as, uintptr_t page, uintptr_t frame,
 		SET_PTL2_PRESENT(ptl1, PTL1_INDEX(page));
 	}
 
+	return (pte_t *) PA2KA(GET_PTL2_ADDRESS(ptl1, PTL1_INDEX(page)));
+}
+
+/** Free the PTL2 and PTL1 covering a page if they became empty.
+ *
+ * Tables needed for sharing the kernel non-identity mappings are kept.
+ *
+ * @param ptl0 PTL0 covering the page.
+ * @param ptl1 PTL1 covering the page.
+ * @param ptl2 PTL2 covering the page.
+ * @param page Virtual address of the page whose mapping has been removed.
+ *
+ */
+static void pt_free_upper(pte_t *ptl0, pte_t *ptl1, pte_t *ptl2,
+    uintptr_t page)
+{
+#if (PTL2_ENTRIES != 0)
+	for (unsigned int i = 0; i < PTL2_ENTRIES; i++) {
+		if (PTE_VALID(&ptl2[i])) {
+			/*
+			 * PTL2 is not empty.
+			 * Therefore, there must be a path from PTL0 to PTL2 and
+			 * thus nothing to free in higher levels.
+			 *
+			 */
+			return;
+		}
+	}
+
+	/*
+	 * PTL2 is empty.
+	 * Release the frame and remove PTL2 pointer from the parent
+	 * table.
+	 */
+#if (PTL1_ENTRIES != 0)
+	memsetb(&ptl1[PTL1_INDEX(page)], sizeof(pte_t), 0);
+#else
+	if (km_is_non_identity(page))
+		return;
+
+	memsetb(&ptl0[PTL0_INDEX(page)], sizeof(pte_t), 0);
+#endif
+	frame_free(KA2PA((uintptr_t) ptl2), PTL2_FRAMES);
+#endif /* PTL2_ENTRIES != 0 */
+
+#if (PTL1_ENTRIES != 0)
+	for (unsigned int i = 0; i < PTL1_ENTRIES; i++) {
+		if (PTE_VALID(&ptl1[i]))
+			return;
+	}
+
+	/*
+	 * PTL1 is empty.
+	 * Release the frame and remove PTL1 pointer from the parent
+	 * table.
+	 */
+	if (km_is_non_identity(page))
+		return;
+
+	memsetb(&ptl0[PTL0_INDEX(page)], sizeof(pte_t), 0);
+	frame_free(KA2PA((uintptr_t) ptl1), PTL1_FRAMES);
+#endif /* PTL1_ENTRIES != 0 */
+}
+
+#ifdef LARGE_PAGE_WIDTH_ARCH
+
+/** Split a large page mapping into base page mappings.
+ *
+ * The new PTL3 maps the same frames with the same flags as the large page,
+ * so any TLB entry still caching the large page remains consistent with it.
+ * The PTL2 entry is replaced by a single store so that a concurrent page
+ * table walk sees either the large page or the complete PTL3.
+ *
+ * @param ptl2        PTL2 containing the large page entry.
+ * @param index       Index of the large page entry in ptl2.
+ * @param frame_flags Flags for allocating the new PTL3.
+ *
+ * @return False if the new PTL3 could not be allocated.
+ *
+ */
+static bool pt_split_large(pte_t *ptl2, size_t index,
+    frame_flags_t frame_flags)
+{
+	uintptr_t frame = PTE_GET_FRAME(&ptl2[index]);
+	unsigned int flags = GET_PTL3_FLAGS(ptl2, index);
+
+	uintptr_t pt = frame_alloc(PTL3_FRAMES, FRAME_LOWMEM | frame_flags,
+	    PTL3_SIZE - 1);
+	if (!pt)
+		return false;
+
+	pte_t *newpt = (pte_t *) PA2KA(pt);
+	memsetb(newpt, PTL3_SIZE, 0);
+
+	for (size_t i = 0; i < PTL3_ENTRIES; i++) {
+		SET_FRAME_ADDRESS(newpt, i, frame + P2SZ(i));
+		SET_FRAME_FLAGS(newpt, i, flags);
+	}
+
+	pte_t entry;
+	memsetb(&entry, sizeof(entry), 0);
+	SET_PTL3_ADDRESS(&entry, 0, KA2PA(newpt));
+	SET_PTL3_FLAGS(&entry, 0, PAGE_PRESENT | PAGE_USER | PAGE_EXEC |
+	    PAGE_CACHEABLE | PAGE_WRITE);
+
+	/*
+	 * Make the new PTL3 visible only after it is fully initialized.
+	 */
+	write_barrier();
+	ptl2[index] = entry;
+
+	return true;
+}
+
+/** Map a large page to a block of frames using hierarchical page tables.
+ *
+ * @param as    Address space to wich page belongs.
+ * @param page  Virtual address of the large page to be mapped.
+ * @param frame Physical address of the first frame of the block.
+ * @param flags Flags to be used for mapping.
+ *
+ * @return True on success, false if some part of the large page is already
+ *         mapped.
+ *
+ */
+bool pt_mapping_insert_large(as_t *as, uintptr_t page, uintptr_t frame,
+    unsigned int flags)
+{
+	pte_t *ptl2 = pt_ptl2_get(as, page);
+
+	if (!(GET_PTL3_FLAGS(ptl2, PTL2_INDEX(page)) & PAGE_NOT_PRESENT))
+		return false;
+
+	SET_PTL3_ADDRESS(ptl2, PTL2_INDEX(page), frame);
+	SET_PTL3_FLAGS(ptl2, PTL2_INDEX(page), flags | PAGE_NOT_PRESENT);
+	SET_PTL3_LARGE(ptl2, PTL2_INDEX(page), true);
+	/*
+	 * Make the new mapping visible only after it is fully initialized.
+	 */
+	write_barrier();
+	SET_PTL3_PRESENT(ptl2, PTL2_INDEX(page));
+
+	return true;
+}
+
+/** Remove a large page mapping from hierarchical page tables.
+ *
+ * TLB shootdown should follow in order to make effects of
+ * this call visible.
+ *
+ * @param as   Address space to wich page belongs.
+ * @param page Virtual address of the large page to be demapped.
+ *
+ * @return False if page is not mapped by a large page.
+ *
+ */
+bool pt_mapping_remove_large(as_t *as, uintptr_t page)
+{
+	assert(page_table_locked(as));
+
+	pte_t *ptl0 = (pte_t *) PA2KA((uintptr_t) as->genarch.page_table);
+	if (GET_PTL1_FLAGS(ptl0, PTL0_INDEX(page)) & PAGE_NOT_PRESENT)
+		return false;
+
+	pte_t *ptl1 = (pte_t *) PA2KA(GET_PTL1_ADDRESS(ptl0, PTL0_INDEX(page)));
+	if (GET_PTL2_FLAGS(ptl1, PTL1_INDEX(page)) & PAGE_NOT_PRESENT)
+		return false;
+
 	pte_t *ptl2 = (pte_t *) PA2KA(GET_PTL2_ADDRESS(ptl1, PTL1_INDEX(page)));
+	if ((GET_PTL3_FLAGS(ptl2, PTL2_INDEX(page)) & PAGE_NOT_PRESENT) ||
+	    (!GET_PTL3_LARGE(ptl2, PTL2_INDEX(page))))
+		return false;
+
+	memsetb(&ptl2[PTL2_INDEX(page)], sizeof(pte_t), 0);
+	pt_free_upper(ptl0, ptl1, ptl2, page);
+
+	return true;
+}
+
+/** Split a large page mapping covering a page into base page mappings.
+ *
+ * @param as   Address space to wich page belongs.
+ * @param page Virtual address of a page.
+ *
+ */
+void pt_mapping_split(as_t *as, uintptr_t page)
+{
+	assert(page_table_locked(as));
+
+	pte_t *ptl0 = (pte_t *) PA2KA((uintptr_t) as->genarch.page_table);
+	if (GET_PTL1_FLAGS(ptl0, PTL0_INDEX(page)) & PAGE_NOT_PRESENT)
+		return;
+
+	pte_t *ptl1 = (pte_t *) PA2KA(GET_PTL1_ADDRESS(ptl0, PTL0_INDEX(page)));
+	if (GET_PTL2_FLAGS(ptl1, PTL1_INDEX(page)) & PAGE_NOT_PRESENT)
+		return;
+
+	pte_t *ptl2 = (pte_t *) PA2KA(GET_PTL2_ADDRESS(ptl1, PTL1_INDEX(page)));
+	if ((GET_PTL3_FLAGS(ptl2, PTL2_INDEX(page)) & PAGE_NOT_PRESENT) ||
+	    (!GET_PTL3_LARGE(ptl2, PTL2_INDEX(page))))
+		return;
+
+	(void) pt_split_large(ptl2, PTL2_INDEX(page), 0);
+}
+
+#endif /* LARGE_PAGE_WIDTH_ARCH */
+
+/** Map page to frame using hierarchical page tables.
+ *
+ * Map virtual address page to physical address frame
+ * using flags. A large page mapping covering the page is
+ * split first.
+ *
+ * @param as    Address space to wich page belongs.
+ * @param page  Virtual address of the page to be mapped.
+ * @param frame Physical address of memory frame to which the mapping is done.
+ * @param flags Flags to be used for mapping.
+ *
+ */
+void pt_mapping_insert(as_t *as, uintptr_t page, uintptr_t frame,
+    unsigned int flags)
+{
+	pte_t *ptl2 = pt_ptl2_get(as, page);
+
+#ifdef LARGE_PAGE_WIDTH_ARCH
+	if (GET_PTL3_LARGE(ptl2, PTL2_INDEX(page)))
+		(void) pt_split_large(ptl2, PTL2_INDEX(page), 0);
+#endif
 
 	if (GET_PTL3_FLAGS(ptl2, PTL2_INDEX(page)) & PAGE_NOT_PRESENT) {
 		pte_t *newpt = (pte_t *)
@@ -177,6 +411,18 @@ void pt_mapping_remove(as_t *as, uintptr_t page)
 	if (GET_PTL3_FLAGS(ptl2, PTL2_INDEX(page)) & PAGE_NOT_PRESENT)
 		return;
 
+#ifdef LARGE_PAGE_WIDTH_ARCH
+	/*
+	 * Removing a part of a large page. This usually runs with interrupts
+	 * disabled during TLB shootdown, so the caller should have split the
+	 * large page by page_mapping_split() beforehand.
+	 */
+	if (GET_PTL3_LARGE(ptl2, PTL2_INDEX(page))) {
+		if (!pt_split_large(ptl2, PTL2_INDEX(page), FRAME_ATOMIC))
+			panic("Cannot split large page.");
+	}
+#endif
+
 	pte_t *ptl3 = (pte_t *) PA2KA(GET_PTL3_ADDRESS(ptl2, PTL2_INDEX(page)));
 
 	/*
@@ -232,69 +478,16 @@ void pt_mapping_remove(as_t *as, uintptr_t page)
 		return;
 	}
 
-	/* Check PTL2, empty is still true */
-#if (PTL2_ENTRIES != 0)
-	for (i = 0; i < PTL2_ENTRIES; i++) {
-		if (PTE_VALID(&ptl2[i])) {
-			empty = false;
-			break;
-		}
-	}
-
-	if (empty) {
-		/*
-		 * PTL2 is empty.
-		 * Release the frame and remove PTL2 pointer from the parent
-		 * table.
-		 */
-#if (PTL1_ENTRIES != 0)
-		memsetb(&ptl1[PTL1_INDEX(page)], sizeof(pte_t), 0);
-#else
-		if (km_is_non_identity(page))
-			return;
-
-		memsetb(&ptl0[PTL0_INDEX(page)], sizeof(pte_t), 0);
-#endif
-		frame_free(KA2PA((uintptr_t) ptl2), PTL2_FRAMES);
-	} else {
-		/*
-		 * PTL2 is not empty.
-		 * Therefore, there must be a path from PTL0 to PTL2 and
-		 * thus nothing to free in higher levels.
-		 *
-		 */
-		return;
-	}
-#endif /* PTL2_ENTRIES != 0 */
-
-	/* check PTL1, empty is still true */
-#if (PTL1_ENTRIES != 0)
-	for (i = 0; i < PTL1_ENTRIES; i++) {
-		if (PTE_VALID(&ptl1[i])) {
-			empty = false;
-			break;
-		}
-	}
-
-	if (empty) {
-		/*
-		 * PTL1 is empty.
-		 * Release the frame and remove PTL1 pointer from the parent
-		 * table.
-		 */
-		if (km_is_non_identity(page))
-			return;
-
-		memsetb(&ptl0[PTL0_INDEX(page)], sizeof(pte_t), 0);
-		frame_free(KA2PA((uintptr_t) ptl1), PTL1_FRAMES);
-	}
-#endif /* PTL1_ENTRIES != 0 */
+	pt_free_upper(ptl0, ptl1, ptl2, page);
 }
 
-static pte_t *pt_mapping_find_internal(as_t *as, uintptr_t page, bool nolock)
+static pte_t *pt_mapping_find_internal(as_t *as, uintptr_t page, bool nolock,
+    bool *large)
 {
 	assert(nolock || page_table_locked(as));
 
+	*large = false;
+
 	pte_t *ptl0 = (pte_t *) PA2KA((uintptr_t) as->genarch.page_table);
 	if (GET_PTL1_FLAGS(ptl0, PTL0_INDEX(page)) & PAGE_NOT_PRESENT)
 		return NULL;
@@ -316,6 +509,11 @@ static pte_t *pt_mapping_find_internal(as_t *as, uintptr_t page, bool nolock)
 	if (GET_PTL3_FLAGS(ptl2, PTL2_INDEX(page)) & PAGE_NOT_PRESENT)
 		return NULL;
 
+	if (GET_PTL3_LARGE(ptl2, PTL2_INDEX(page))) {
+		*large = true;
+		return &ptl2[PTL2_INDEX(page)];
+	}
+
 #if (PTL2_ENTRIES != 0)
 	/*
 	 * Always read ptl3 only after we are sure it is present.
@@ -339,10 +537,28 @@ static pte_t *pt_mapping_find_internal(as_t *as, uintptr_t page, bool nolock)
  */
 bool pt_mapping_find(as_t *as, uintptr_t page, bool nolock, pte_t *pte)
 {
-	pte_t *t = pt_mapping_find_internal(as, page, nolock);
-	if (t)
-		*pte = *t;
-	return t != NULL;
+	bool large;
+	pte_t *t = pt_mapping_find_internal(as, page, nolock, &large);
+	if (!t)
+		return false;
+
+	*pte = *t;
+
+#ifdef LARGE_PAGE_WIDTH_ARCH
+	if (large) {
+		/*
+		 * Present the base page of the large page as if it was
+		 * mapped by a PTL3.
+		 */
+		uintptr_t frame = PTE_GET_FRAME(pte) +
+		    (page & (LARGE_PAGE_SIZE - 1));
+
+		SET_PTL3_LARGE(pte, 0, false);
+		SET_FRAME_ADDRESS(pte, 0, frame);
+	}
+#endif
+
+	return true;
 }
 
 /** Update mapping for virtual page in hierarchical page tables.
@@ -354,10 +570,16 @@ bool pt_mapping_find(as_t *as, uintptr_t page, bool nolock, pte_t *pte)
  */
 void pt_mapping_update(as_t *as, uintptr_t page, bool nolock, pte_t *pte)
 {
-	pte_t *t = pt_mapping_find_internal(as, page, nolock);
+	bool large;
+	pte_t *t = pt_mapping_find_internal(as, page, nolock, &large);
 	if (!t)
 		panic("Updating non-existent PTE");
 
+	/*
+	 * Architectures which update PTEs in software do not use large pages.
+	 */
+	assert(!large);
+
 	assert(PTE_VALID(t) == PTE_VALID(pte));
 	assert(PTE_PRESENT(t) == PTE_PRESENT(pte));
 	assert(PTE_GET_FRAME(t) == PTE_GET_FRAME(pte));
@@ -67,6 +67,12 @@ struct waitq;
 
 typedef struct kobject_ops {
 	void (*destroy)(void *);
+	/**
+	 * Optional. Take over the object together with its kobject_t wrapper
+	 * for later reuse instead of destroying them. Returns false if the
+	 * object should be destroyed as usual.
+	 */
+	bool (*recycle)(void *);
 } kobject_ops_t;
 
 extern kobject_ops_t *kobject_ops[];
@@ -110,25 +116,49 @@ typedef struct cap {
 	/* Link to the task's capabilities of the same kobject type. */
 	link_t type_link;
 
-	ht_link_t caps_link;
-
 	/* The underlying kernel object. */
 	kobject_t *kobject;
 } cap_t;
 
+/** Number of slots in one leaf of the capability table. */
+#define CAPS_LEAF_SIZE	256
+
+/**
+ * Number of leaves of the capability table. Together with CAPS_LEAF_SIZE,
+ * it limits each task to 262143 capabilities, as handle zero is never used.
+ */
+#define CAPS_DIR_SIZE	1024
+
+/*
+ * A slot of the capability table. The cap member may only be accessed under
+ * the protection of the cap_info_t lock. The kobject member mirrors the kernel
+ * object of a published capability and is read by kobject_get() without
+ * taking the lock.
+ */
+typedef struct {
+	cap_t *cap;
+	_Atomic(kobject_t *) kobject;
+} cap_slot_t;
+
 typedef struct cap_info {
 	mutex_t lock;
 
 	list_t type_list[KOBJECT_TYPE_MAX];
 
-	hash_table_t caps;
+	/** Capability table indexed by the capability handle. */
+	_Atomic(cap_slot_t *) table[CAPS_DIR_SIZE];
 	ra_arena_t *handles;
+
+	/** Freed capabilities kept together with their reserved handles. */
+	list_t free_caps;
+	size_t free_caps_count;
 } cap_info_t;
 
 extern void caps_init(void);
 extern errno_t caps_task_alloc(struct task *);
 extern void caps_task_free(struct task *);
 extern void caps_task_init(struct task *);
+extern void caps_task_drain(struct task *);
 extern bool caps_apply_to_kobject_type(struct task *, kobject_type_t,
     bool (*)(cap_t *, void *), void *);
 
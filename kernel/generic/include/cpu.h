@@ -37,12 +37,17 @@
 
 #include <mm/tlb.h>
 #include <synch/spinlock.h>
+#include <synch/lockstat.h>
 #include <proc/scheduler.h>
 #include <arch/cpu.h>
 #include <arch/context.h>
 #include <adt/list.h>
+#include <mm/frame.h>
 #include <arch.h>
 
+/** Number of slots in the per-CPU timeout wheel (a power of two). */
+#define TIMEOUT_WHEEL_SIZE  256
+
 #define CPU                  CURRENT->cpu
 
 /** CPU structure.
@@ -59,10 +64,25 @@ typedef struct cpu {
 
 	atomic_t nrdy;
 	runq_t rq[RQ_COUNT];
+
+	/**
+	 * Bitmap of non-empty ready queues. Bit i is set iff rq[i].n != 0
+	 * and is only changed with rq[i].lock held.
+	 */
+	atomic_uint rq_ready;
+
 	volatile size_t needs_relink;
 
 	IRQ_SPINLOCK_DECLARE(timeoutlock);
-	list_t timeout_active_list;
+
+	/** Time of the last clock tick processed by timeouts, in usec. */
+	uint64_t timeout_clock;
+
+	/**
+	 * Active timeouts hashed by the clock tick period of their deadline.
+	 * Each slot is visited once per TIMEOUT_WHEEL_SIZE ticks.
+	 */
+	list_t timeout_wheel[TIMEOUT_WHEEL_SIZE];
 
 	/**
 	 * When system clock loses a tick, it is
@@ -73,6 +93,18 @@ typedef struct cpu {
 	 */
 	size_t missed_clock_ticks;
 
+	/**
+	 * The periodic clock tick is stopped while the CPU is idle
+	 * and a one-shot interrupt is armed for the next timeout.
+	 */
+	atomic_bool tickless;
+
+	/**
+	 * Thread running on this CPU or NULL. Other CPUs may compare it to
+	 * a thread pointer without holding a reference to the thread.
+	 */
+	_Atomic(struct thread *) running;
+
 	/**
 	 * Processor cycle accounting.
 	 */
@@ -96,6 +128,20 @@ typedef struct cpu {
 
 	struct thread *fpu_owner;
 
+	/** Cache of free frames used by frame_alloc() and frame_free(). */
+	frame_cache_t frame_cache;
+
+#ifdef CONFIG_LOCK_STATS
+	/** Contention statistics of the lock classes on this CPU. */
+	lockstat_t lockstats[LOCK_CLASS_MAX];
+#endif
+
+	/**
+	 * Sequence of lock-free capability lookups on this CPU. The value is
+	 * odd while a lookup is in progress.
+	 */
+	atomic_uint cap_lookups;
+
 	/**
 	 * Stack used by scheduler when there is no running thread.
 	 */
@@ -42,6 +42,7 @@
 #include <abi/proc/task.h>
 #include <typedefs.h>
 #include <mm/slab.h>
+#include <mm/frame.h>
 #include <cap/cap.h>
 
 struct answerbox;
@@ -104,8 +105,31 @@ typedef struct answerbox {
 
 	/** Notifications from IRQ handlers. */
 	list_t irq_notifs;
+
+	IRQ_SPINLOCK_DECLARE(free_lock);
+
+	/** Destroyed calls kept for reuse by ipc_call_alloc(). */
+	list_t free_calls;
+	/** Number of calls on, or reserved for, the free_calls list. */
+	size_t free_count;
 } answerbox_t;
 
+/** Maximum number of frames spanned by an IPC data transfer. */
+#define IPC_XFER_FRAMES_MAX  (DATA_XFER_LIMIT / FRAME_SIZE + 1)
+
+/** Maximum number of destroyed calls an answerbox keeps for reuse. */
+#define IPC_FREE_CALLS_MAX  32
+
+/** Userspace buffer pinned for a zero-copy IPC data transfer. */
+typedef struct {
+	/** Number of pinned frames. */
+	size_t count;
+	/** Offset of the data in the first frame. */
+	size_t offset;
+	/** Physical addresses of the pinned frames. */
+	uintptr_t frames[];
+} ipc_xfer_t;
+
 typedef struct call {
 	kobject_t *kobject;
 
@@ -165,6 +189,12 @@ typedef struct call {
 
 	/** Buffer for IPC_M_DATA_WRITE and IPC_M_DATA_READ. */
 	uint8_t *buffer;
+
+	/**
+	 * Pinned requester's buffer for IPC_M_DATA_WRITE and IPC_M_DATA_READ,
+	 * NULL if the data is not transferred directly.
+	 */
+	ipc_xfer_t *xfer;
 } call_t;
 
 extern slab_cache_t *phone_cache;
@@ -189,6 +219,8 @@ extern bool ipc_phone_connect(phone_t *, answerbox_t *);
 extern errno_t ipc_phone_hangup(phone_t *);
 
 extern void ipc_answerbox_init(answerbox_t *, struct task *);
+extern void ipc_answerbox_drain(answerbox_t *);
+extern void ipc_call_stats(uint64_t *, uint64_t *);
 
 extern void ipc_cleanup(void);
 extern void ipc_backsend_err(phone_t *, call_t *, errno_t);
@@ -49,6 +49,9 @@ extern sys_errno_t sys_ipc_answer_fast(cap_call_handle_t, sysarg_t, sysarg_t,
     sysarg_t, sysarg_t, sysarg_t);
 extern sys_errno_t sys_ipc_answer_slow(cap_call_handle_t, uspace_ptr_ipc_data_t);
 extern sys_errno_t sys_ipc_wait_for_call(uspace_ptr_ipc_data_t, uint32_t, unsigned int);
+extern sys_errno_t sys_ipc_wait_many(uspace_ptr_ipc_data_t, size_t, uint32_t,
+    unsigned int, uspace_ptr_size_t);
+extern sys_errno_t sys_ipc_submit(uspace_ptr_ipc_submit_t, size_t);
 extern sys_errno_t sys_ipc_poke(void);
 extern sys_errno_t sys_ipc_forward_fast(cap_call_handle_t, cap_phone_handle_t,
     sysarg_t, sysarg_t, sysarg_t, unsigned int);
@@ -126,6 +126,9 @@ typedef struct as {
 	 */
 	odict_t as_areas;
 
+	/** Number of page faults resolved by a backend. */
+	atomic_size_t page_faults;
+
 	/** Non-generic content. */
 	as_genarch_t genarch;
 
@@ -315,6 +318,8 @@ extern void as_hold(as_t *);
 extern void as_release(as_t *);
 extern void as_switch(as_t *, as_t *);
 extern int as_page_fault(uintptr_t, pf_access_t, istate_t *);
+extern errno_t as_pin_pages(uintptr_t, size_t, pf_access_t, uintptr_t *);
+extern void as_unpin_pages(uintptr_t *, size_t);
 
 extern as_area_t *as_area_create(as_t *, unsigned int, size_t, unsigned int,
     mem_backend_t *, mem_backend_data_t *, uintptr_t *, uintptr_t);
@@ -323,6 +328,7 @@ extern errno_t as_area_resize(as_t *, uintptr_t, size_t, unsigned int);
 extern errno_t as_area_share(as_t *, uintptr_t, size_t, as_t *, unsigned int,
     uintptr_t *, uintptr_t);
 extern errno_t as_area_change_flags(as_t *, unsigned int, uintptr_t);
+extern errno_t as_area_populate(as_t *, uintptr_t, size_t);
 extern as_area_t *as_area_first(as_t *);
 extern as_area_t *as_area_next(as_area_t *);
 
@@ -364,8 +370,14 @@ extern void as_install_arch(as_t *);
 extern void as_deinstall_arch(as_t *);
 #endif /* !def as_deinstall_arch */
 
+/** Default number of pages the anonymous backend maps on one fault. */
+#define ANON_FAULT_AROUND      16
+/** Maximum number of pages the anonymous backend maps on one fault. */
+#define ANON_FAULT_AROUND_MAX  256
+
 /* Backend declarations and functions. */
 extern mem_backend_t anon_backend;
+extern size_t anon_fault_around;
 extern mem_backend_t elf_backend;
 extern mem_backend_t phys_backend;
 extern mem_backend_t user_backend;
@@ -377,6 +389,7 @@ extern sys_errno_t sys_as_area_resize(uintptr_t, size_t, unsigned int);
 extern sys_errno_t sys_as_area_change_flags(uintptr_t, unsigned int);
 extern sys_errno_t sys_as_area_get_info(uintptr_t, uspace_ptr_as_area_info_t);
 extern sys_errno_t sys_as_area_destroy(uintptr_t);
+extern sys_errno_t sys_as_area_populate(uintptr_t, size_t);
 
 /* Introspection functions. */
 extern as_area_info_t *as_get_area_info(as_t *, size_t *);
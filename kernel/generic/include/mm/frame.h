@@ -38,6 +38,7 @@
 
 #include <typedefs.h>
 #include <trace.h>
+#include <atomic.h>
 #include <adt/bitmap.h>
 #include <adt/list.h>
 #include <synch/spinlock.h>
@@ -90,7 +91,7 @@ typedef uint8_t zone_flags_t;
 	    (((zf) & ~ZONE_EF_MASK) & (f)))
 
 typedef struct {
-	size_t refcount;  /**< Tracking of shared frames */
+	atomic_size_t refcount;  /**< Tracking of shared frames */
 	void *parent;     /**< If allocated by slab, this points there */
 } frame_t;
 
@@ -129,6 +130,37 @@ typedef struct {
 
 extern zones_t zones;
 
+/** Maximum number of frames of one kind in a per-CPU frame cache. */
+#define FRAME_CACHE_SIZE   64
+
+/** Number of frames moved between a per-CPU frame cache and the zones. */
+#define FRAME_CACHE_BATCH  16
+
+/** Kinds of frames kept apart in the per-CPU frame caches. */
+typedef enum {
+	FRAME_CACHE_LOWMEM,
+	FRAME_CACHE_HIGHMEM,
+	FRAME_CACHE_KINDS
+} frame_cache_kind_t;
+
+/** Per-CPU cache of free single frames.
+ *
+ * The cached frames stay allocated in their zones with a reference count of
+ * one, so that single frames can be allocated and freed without taking the
+ * zones lock. Frames are kept as stacks so that the most recently freed
+ * (and likely cache-hot) frame is reused first.
+ */
+typedef struct {
+	IRQ_SPINLOCK_DECLARE(lock);
+	size_t count[FRAME_CACHE_KINDS];
+	pfn_t pfn[FRAME_CACHE_KINDS][FRAME_CACHE_SIZE];
+
+	/** Allocations satisfied from the cache. */
+	uint64_t hits;
+	/** Allocations which had to refill the cache from the zones. */
+	uint64_t misses;
+} frame_cache_t;
+
 extern void frame_init(void);
 extern bool frame_adjust_zone_bounds(bool, uintptr_t *, size_t *);
 extern uintptr_t frame_alloc_generic(size_t, frame_flags_t, uintptr_t,
@@ -139,6 +171,7 @@ extern void frame_free(uintptr_t, size_t);
 extern void frame_free_noreserve(uintptr_t, size_t);
 extern void frame_reference_add(pfn_t);
 extern size_t frame_total_free_get(void);
+extern void frame_cache_stats(uint64_t *, uint64_t *);
 
 extern size_t find_zone(pfn_t, size_t, size_t);
 extern size_t zone_create(pfn_t, size_t, pfn_t, zone_flags_t);
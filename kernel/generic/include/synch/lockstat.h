@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup kernel_sync
+ * @{
+ */
+/** @file
+ */
+
+#ifndef KERN_LOCKSTAT_H_
+#define KERN_LOCKSTAT_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <abi/sysinfo.h>
+
+/** Maximum number of lock classes, including the reserved ones. */
+#define LOCK_CLASS_MAX  256
+
+/** Class of a lock which has not been classified yet. */
+#define LOCK_CLASS_NONE  0
+
+/** Class collecting the locks which did not fit into the class table. */
+#define LOCK_CLASS_OTHER  1
+
+/** Contention statistics of one lock class on one CPU.
+ *
+ * Only updated by the owning CPU with preemption disabled.
+ */
+typedef struct {
+	uint64_t acquisitions;
+	uint64_t contentions;
+	uint64_t wait_cycles;
+	uint64_t max_wait_cycles;
+} lockstat_t;
+
+#ifdef CONFIG_LOCK_STATS
+
+extern unsigned int lock_class_get(const void *, bool);
+extern uint64_t lock_class_contended(void);
+extern void lock_class_acquired(unsigned int, uint64_t);
+extern size_t lock_class_stats(stats_lock_t *, size_t);
+extern bool lock_class_stat(unsigned int, stats_lock_t *);
+
+#endif /* CONFIG_LOCK_STATS */
+
+#endif
+
+/** @}
+ */
@@ -37,6 +37,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <atomic.h>
 #include <synch/semaphore.h>
 #include <abi/synch.h>
 
@@ -47,12 +48,19 @@ typedef enum {
 } mutex_type_t;
 
 struct thread;
+struct cpu;
 
 typedef struct {
 	mutex_type_t type;
 	semaphore_t sem;
-	struct thread *owner;
+	/** Thread holding the mutex, if known. Read by contending threads. */
+	_Atomic(struct thread *) owner;
+	/** CPU on which the owner acquired the mutex. */
+	_Atomic(struct cpu *) owner_cpu;
 	unsigned nesting;
+#ifdef CONFIG_LOCK_STATS
+	unsigned int lock_class;
+#endif
 } mutex_t;
 
 #define mutex_lock(mtx) \
@@ -68,6 +76,7 @@ extern void mutex_initialize(mutex_t *, mutex_type_t);
 extern bool mutex_locked(mutex_t *);
 extern errno_t _mutex_lock_timeout(mutex_t *, uint32_t, unsigned int);
 extern void mutex_unlock(mutex_t *);
+extern void mutex_stats(uint64_t *, uint64_t *);
 
 #endif
 
@@ -43,12 +43,25 @@
 
 #ifdef CONFIG_SMP
 
+/*
+ * Spinlocks keep their name and are locked out of line when they are
+ * checked for deadlocks or profiled.
+ */
+#if defined(CONFIG_DEBUG_SPINLOCK) || defined(CONFIG_LOCK_STATS)
+#define SPINLOCK_NAMED
+#endif
+
 typedef struct spinlock {
 	atomic_flag flag;
 
-#ifdef CONFIG_DEBUG_SPINLOCK
+#ifdef SPINLOCK_NAMED
 	const char *name;
-#endif /* CONFIG_DEBUG_SPINLOCK */
+#endif /* SPINLOCK_NAMED */
+
+#ifdef CONFIG_LOCK_STATS
+	/** Lock class for contention statistics, resolved on first use. */
+	atomic_uint lock_class;
+#endif /* CONFIG_LOCK_STATS */
 } spinlock_t;
 
 /*
@@ -63,7 +76,7 @@ typedef struct spinlock {
  * for statically allocated spinlocks. They declare (either as global
  * or static) symbol and initialize the lock.
  */
-#ifdef CONFIG_DEBUG_SPINLOCK
+#ifdef SPINLOCK_NAMED
 
 #define SPINLOCK_INITIALIZE_NAME(lock_name, desc_name) \
 	spinlock_t lock_name = { \
@@ -83,7 +96,7 @@ typedef struct spinlock {
 #define spinlock_lock(lock)    spinlock_lock_debug((lock))
 #define spinlock_unlock(lock)  spinlock_unlock_debug((lock))
 
-#else /* CONFIG_DEBUG_SPINLOCK */
+#else /* SPINLOCK_NAMED */
 
 #define SPINLOCK_INITIALIZE_NAME(lock_name, desc_name) \
 	spinlock_t lock_name = { \
@@ -120,7 +133,7 @@ _NO_TRACE static inline void spinlock_unlock(spinlock_t *lock)
 	preemption_enable();
 }
 
-#endif /* CONFIG_DEBUG_SPINLOCK */
+#endif /* SPINLOCK_NAMED */
 
 #define SPINLOCK_INITIALIZE(lock_name) \
 	SPINLOCK_INITIALIZE_NAME(lock_name, #lock_name)
@@ -208,7 +221,7 @@ typedef struct {
  * for statically allocated interrupts-disabled spinlocks. They declare (either
  * as global or static symbol) and initialize the lock.
  */
-#ifdef CONFIG_DEBUG_SPINLOCK
+#ifdef SPINLOCK_NAMED
 
 #define IRQ_SPINLOCK_INITIALIZE_NAME(lock_name, desc_name) \
 	irq_spinlock_t lock_name = { \
@@ -230,7 +243,7 @@ typedef struct {
 		.ipl = 0 \
 	}
 
-#else /* CONFIG_DEBUG_SPINLOCK */
+#else /* SPINLOCK_NAMED */
 
 #define IRQ_SPINLOCK_INITIALIZE_NAME(lock_name, desc_name) \
 	irq_spinlock_t lock_name = { \
@@ -250,7 +263,7 @@ typedef struct {
 		.ipl = 0 \
 	}
 
-#endif /* CONFIG_DEBUG_SPINLOCK */
+#endif /* SPINLOCK_NAMED */
 
 #else /* CONFIG_SMP */
 
@@ -44,6 +44,7 @@ extern kobject_ops_t waitq_kobject_ops;
 extern void sys_waitq_init(void);
 
 extern void sys_waitq_task_cleanup(void);
+extern void sys_waitq_stats(uint64_t *, uint64_t *);
 
 extern sys_errno_t sys_waitq_create(uspace_ptr_cap_waitq_handle_t);
 extern sys_errno_t sys_waitq_sleep(cap_waitq_handle_t, uint32_t, unsigned int);
@@ -39,6 +39,9 @@
 
 #define HZ  100
 
+/** Length of a clock tick in microseconds */
+#define TICK_USEC  (1000000 / HZ)
+
 /** Uptime structure */
 typedef struct {
 	sysarg_t seconds1;
@@ -46,10 +49,36 @@ typedef struct {
 	sysarg_t seconds2;
 } uptime_t;
 
+struct cpu;
+
+/** One-shot mode of the clock interrupt source of each CPU
+ *
+ * All operations act on the current CPU and are called with
+ * interrupts disabled, except for kick().
+ *
+ */
+typedef struct {
+	/** Stop the periodic tick and interrupt once the given number
+	 *  of microseconds after the last tick. */
+	void (*oneshot)(uint64_t);
+	/** Resume the periodic tick and return the number of microseconds
+	 *  since the last tick before oneshot(). */
+	uint64_t (*periodic)(void);
+	/** Interrupt another CPU which might be sleeping without a tick. */
+	void (*kick)(struct cpu *);
+	/** Return the number of microseconds since the last tick, also
+	 *  while the one-shot is armed. */
+	uint64_t (*elapsed)(void);
+} clock_oneshot_ops_t;
+
 extern uptime_t *uptime;
+extern clock_oneshot_ops_t *clock_oneshot_ops;
 
 extern void clock(void);
 extern void clock_counter_init(void);
+extern void clock_idle_enter(void);
+extern void clock_idle_exit(void);
+extern void clock_idle_kick(struct cpu *);
 
 #endif
 
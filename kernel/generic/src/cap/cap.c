@@ -73,6 +73,14 @@
  * kobject_get() or kobject_add_ref(). When the kernel object is removed from
  * the container, the reference count should go down via a call to
  * kobject_put().
+ *
+ * The capabilities of a task are kept in a two-level table indexed by the
+ * capability handle. The table is modified only under the task's capability
+ * lock, but kobject_get() looks up published capabilities without taking it.
+ * Each lookup runs with preemption disabled and is bracketed by increments of
+ * the per-CPU cap_lookups sequence. Before the reference of an unpublished
+ * capability is handed over or dropped, cap_lookup_sync() waits for all
+ * lookups which might have seen the capability still published.
  */
 
 #include <cap/cap.h>
@@ -87,13 +95,20 @@
 #include <ipc/ipc.h>
 #include <ipc/irq.h>
 
-#include <limits.h>
+#include <preemption.h>
+#include <config.h>
+#include <cpu.h>
+#include <arch.h>
+#include <mem.h>
 #include <stdint.h>
 #include <stdlib.h>
 
 #define CAPS_START	((intptr_t) CAP_NIL + 1)
-#define CAPS_SIZE	(INT_MAX - (int) CAPS_START)
-#define CAPS_LAST	(CAPS_SIZE - 1)
+#define CAPS_SIZE	(CAPS_DIR_SIZE * CAPS_LEAF_SIZE - (int) CAPS_START)
+#define CAPS_LAST	(CAPS_START + CAPS_SIZE - 1)
+
+/** Maximum number of freed capabilities kept for reuse by each task. */
+#define CAPS_FREE_MAX	32
 
 static slab_cache_t *cap_cache;
 static slab_cache_t *kobject_cache;
@@ -105,30 +120,43 @@ kobject_ops_t *kobject_ops[KOBJECT_TYPE_MAX] = {
 	[KOBJECT_TYPE_WAITQ] = &waitq_kobject_ops
 };
 
-static size_t caps_hash(const ht_link_t *item)
+/** Find the capability table slot of a handle
+ *
+ * @param task    Task whose capability table to search.
+ * @param handle  Capability handle.
+ *
+ * @return Address of the slot or NULL if the slot's leaf does not exist.
+ */
+static cap_slot_t *cap_slot(task_t *task, cap_handle_t handle)
 {
-	cap_t *cap = hash_table_get_inst(item, cap_t, caps_link);
-	return hash_mix(cap_handle_raw(cap->handle));
-}
+	intptr_t raw = cap_handle_raw(handle);
+	cap_slot_t *leaf = atomic_load_explicit(
+	    &task->cap_info->table[raw / CAPS_LEAF_SIZE], memory_order_acquire);
 
-static size_t caps_key_hash(const void *key)
-{
-	const cap_handle_t *handle = key;
-	return hash_mix(cap_handle_raw(*handle));
+	if (!leaf)
+		return NULL;
+	return &leaf[raw % CAPS_LEAF_SIZE];
 }
 
-static bool caps_key_equal(const void *key, const ht_link_t *item)
+/** Wait for the lock-free capability lookups in progress
+ *
+ * When this function returns, no lookup can hold a pointer to a kernel object
+ * which had been removed from a capability table before the call.
+ */
+static void cap_lookup_sync(void)
 {
-	const cap_handle_t *handle = key;
-	cap_t *cap = hash_table_get_inst(item, cap_t, caps_link);
-	return *handle == cap->handle;
-}
+	/* Order the removal before reading the lookup sequences. */
+	atomic_thread_fence(memory_order_seq_cst);
 
-static hash_table_ops_t caps_ops = {
-	.hash = caps_hash,
-	.key_hash = caps_key_hash,
-	.key_equal = caps_key_equal
-};
+	for (unsigned int i = 0; i < config.cpu_count; i++) {
+		unsigned int seq = atomic_load(&cpus[i].cap_lookups);
+		if ((seq & 1) == 0)
+			continue;
+
+		while (atomic_load(&cpus[i].cap_lookups) == seq)
+			cpu_spin_hint();
+	}
+}
 
 void caps_init(void)
 {
@@ -147,13 +175,13 @@ errno_t caps_task_alloc(task_t *task)
 	task->cap_info = (cap_info_t *) malloc(sizeof(cap_info_t));
 	if (!task->cap_info)
 		return ENOMEM;
+	for (size_t i = 0; i < CAPS_DIR_SIZE; i++)
+		atomic_init(&task->cap_info->table[i], NULL);
 	task->cap_info->handles = ra_arena_create();
 	if (!task->cap_info->handles)
 		goto error_handles;
 	if (!ra_span_add(task->cap_info->handles, CAPS_START, CAPS_SIZE))
 		goto error_span;
-	if (!hash_table_create(&task->cap_info->caps, 0, 0, &caps_ops))
-		goto error_span;
 	return EOK;
 
 error_span:
@@ -173,6 +201,29 @@ void caps_task_init(task_t *task)
 
 	for (kobject_type_t t = 0; t < KOBJECT_TYPE_MAX; t++)
 		list_initialize(&task->cap_info->type_list[t]);
+
+	list_initialize(&task->cap_info->free_caps);
+	task->cap_info->free_caps_count = 0;
+}
+
+/** Release the capabilities kept for reuse
+ *
+ * The handles reserved by the capabilities are returned to the task's handle
+ * arena.
+ *
+ * @param task  Task whose free capabilities to release.
+ */
+void caps_task_drain(task_t *task)
+{
+	mutex_lock(&task->cap_info->lock);
+	list_foreach_safe(task->cap_info->free_caps, cur, next) {
+		cap_t *cap = list_get_instance(cur, cap_t, type_link);
+		list_remove(&cap->type_link);
+		ra_free(task->cap_info->handles, cap_handle_raw(cap->handle), 1);
+		slab_free(cap_cache, cap);
+	}
+	task->cap_info->free_caps_count = 0;
+	mutex_unlock(&task->cap_info->lock);
 }
 
 /** Deallocate the capability info structure
@@ -181,7 +232,11 @@ void caps_task_init(task_t *task)
  */
 void caps_task_free(task_t *task)
 {
-	hash_table_destroy(&task->cap_info->caps);
+	for (size_t i = 0; i < CAPS_DIR_SIZE; i++) {
+		cap_slot_t *leaf = atomic_load(&task->cap_info->table[i]);
+		if (leaf)
+			free(leaf);
+	}
 	ra_arena_destroy(task->cap_info->handles);
 	free(task->cap_info);
 }
@@ -245,11 +300,11 @@ static cap_t *cap_get(task_t *task, cap_handle_t handle, cap_state_t state)
 	if ((cap_handle_raw(handle) < CAPS_START) ||
 	    (cap_handle_raw(handle) > CAPS_LAST))
 		return NULL;
-	ht_link_t *link = hash_table_find(&task->cap_info->caps, &handle);
-	if (!link)
+	cap_slot_t *slot = cap_slot(task, handle);
+	if (!slot)
 		return NULL;
-	cap_t *cap = hash_table_get_inst(link, cap_t, caps_link);
-	if (cap->state != state)
+	cap_t *cap = slot->cap;
+	if (!cap || cap->state != state)
 		return NULL;
 	return cap;
 }
@@ -260,24 +315,58 @@ static cap_t *cap_get(task_t *task, cap_handle_t handle, cap_state_t state)
  *
  * @param[out] handle  New capability handle on success.
  *
+ * @return ENOMEM if out of memory or if the task already holds the maximum
+ *         number of capabilities.
  * @return An error code in case of error.
  */
 errno_t cap_alloc(task_t *task, cap_handle_t *handle)
 {
 	mutex_lock(&task->cap_info->lock);
-	cap_t *cap = slab_alloc(cap_cache, FRAME_ATOMIC);
-	if (!cap) {
-		mutex_unlock(&task->cap_info->lock);
-		return ENOMEM;
+
+	cap_t *cap;
+	if (!list_empty(&task->cap_info->free_caps)) {
+		/* Reuse a freed capability and the handle it still reserves */
+		cap = list_get_instance(list_first(&task->cap_info->free_caps),
+		    cap_t, type_link);
+		list_remove(&cap->type_link);
+		task->cap_info->free_caps_count--;
+	} else {
+		cap = slab_alloc(cap_cache, FRAME_ATOMIC);
+		if (!cap) {
+			mutex_unlock(&task->cap_info->lock);
+			return ENOMEM;
+		}
+		uintptr_t hbase;
+		if (!ra_alloc(task->cap_info->handles, 1, 1, &hbase)) {
+			slab_free(cap_cache, cap);
+			mutex_unlock(&task->cap_info->lock);
+			return ENOMEM;
+		}
+		cap_initialize(cap, task, (cap_handle_t) hbase);
 	}
-	uintptr_t hbase;
-	if (!ra_alloc(task->cap_info->handles, 1, 1, &hbase)) {
-		slab_free(cap_cache, cap);
-		mutex_unlock(&task->cap_info->lock);
-		return ENOMEM;
+
+	cap_slot_t *slot = cap_slot(task, cap->handle);
+	if (!slot) {
+		cap_slot_t *leaf = malloc(CAPS_LEAF_SIZE * sizeof(cap_slot_t));
+		if (!leaf) {
+			ra_free(task->cap_info->handles,
+			    cap_handle_raw(cap->handle), 1);
+			slab_free(cap_cache, cap);
+			mutex_unlock(&task->cap_info->lock);
+			return ENOMEM;
+		}
+		for (size_t i = 0; i < CAPS_LEAF_SIZE; i++) {
+			leaf[i].cap = NULL;
+			atomic_init(&leaf[i].kobject, NULL);
+		}
+
+		/* Publish the initialized leaf to lock-free lookups */
+		atomic_store_explicit(&task->cap_info->table[
+		    cap_handle_raw(cap->handle) / CAPS_LEAF_SIZE], leaf,
+		    memory_order_release);
+		slot = cap_slot(task, cap->handle);
 	}
-	cap_initialize(cap, task, (cap_handle_t) hbase);
-	hash_table_insert(&task->cap_info->caps, &cap->caps_link);
+	slot->cap = cap;
 
 	cap->state = CAP_STATE_ALLOCATED;
 	*handle = cap->handle;
@@ -308,12 +397,20 @@ cap_publish(task_t *task, cap_handle_t handle, kobject_t *kobj)
 	cap->kobject = kobj;
 	list_append(&cap->kobj_link, &kobj->caps_list);
 	list_append(&cap->type_link, &task->cap_info->type_list[kobj->type]);
+	atomic_store_explicit(&cap_slot(task, handle)->kobject, kobj,
+	    memory_order_release);
 	mutex_unlock(&task->cap_info->lock);
 	mutex_unlock(&kobj->caps_list_lock);
 }
 
+/*
+ * The caller must call cap_lookup_sync() before it hands over or drops the
+ * capability's reference to the kernel object.
+ */
 static void cap_unpublish_unsafe(cap_t *cap)
 {
+	atomic_store_explicit(&cap_slot(cap->task, cap->handle)->kobject, NULL,
+	    memory_order_relaxed);
 	cap->kobject = NULL;
 	list_remove(&cap->kobj_link);
 	list_remove(&cap->type_link);
@@ -357,6 +454,9 @@ restart:
 	}
 	mutex_unlock(&task->cap_info->lock);
 
+	if (kobj)
+		cap_lookup_sync();
+
 	return kobj;
 }
 
@@ -374,6 +474,10 @@ restart:
  */
 void cap_revoke(kobject_t *kobj)
 {
+	/*
+	 * The explicit reference of the caller keeps the kernel object alive
+	 * for lookups in progress until cap_lookup_sync() below.
+	 */
 	mutex_lock(&kobj->caps_list_lock);
 	list_foreach_safe(kobj->caps_list, cur, hlp) {
 		cap_t *cap = list_get_instance(cur, cap_t, kobj_link);
@@ -383,6 +487,7 @@ void cap_revoke(kobject_t *kobj)
 		kobject_put(kobj);
 		mutex_unlock(&cap->task->cap_info->lock);
 	}
+	cap_lookup_sync();
 	mutex_unlock(&kobj->caps_list_lock);
 }
 
@@ -401,9 +506,20 @@ void cap_free(task_t *task, cap_handle_t handle)
 
 	assert(cap);
 
-	hash_table_remove_item(&task->cap_info->caps, &cap->caps_link);
-	ra_free(task->cap_info->handles, cap_handle_raw(handle), 1);
-	slab_free(cap_cache, cap);
+	cap_slot(task, handle)->cap = NULL;
+	if (task->cap_info->free_caps_count < CAPS_FREE_MAX) {
+		/*
+		 * Keep the capability and its handle reserved so that a steady
+		 * stream of calls does not go to the allocators for every new
+		 * capability.
+		 */
+		cap->state = CAP_STATE_FREE;
+		list_prepend(&cap->type_link, &task->cap_info->free_caps);
+		task->cap_info->free_caps_count++;
+	} else {
+		ra_free(task->cap_info->handles, cap_handle_raw(handle), 1);
+		slab_free(cap_cache, cap);
+	}
 	mutex_unlock(&task->cap_info->lock);
 }
 
@@ -447,17 +563,30 @@ void kobject_initialize(kobject_t *kobj, kobject_type_t type, void *raw)
 kobject_t *
 kobject_get(struct task *task, cap_handle_t handle, kobject_type_t type)
 {
+	if ((cap_handle_raw(handle) < CAPS_START) ||
+	    (cap_handle_raw(handle) > CAPS_LAST))
+		return NULL;
+
 	kobject_t *kobj = NULL;
 
-	mutex_lock(&task->cap_info->lock);
-	cap_t *cap = cap_get(task, handle, CAP_STATE_PUBLISHED);
-	if (cap) {
-		if (cap->kobject->type == type) {
-			kobj = cap->kobject;
+	preemption_disable();
+	atomic_uint *seq = &CPU->cap_lookups;
+
+	/* Order the sequence increment before reading the table. */
+	atomic_fetch_add(seq, 1);
+
+	cap_slot_t *slot = cap_slot(task, handle);
+	if (slot) {
+		kobj = atomic_load_explicit(&slot->kobject,
+		    memory_order_acquire);
+		if ((kobj) && (kobj->type == type))
 			atomic_inc(&kobj->refcnt);
-		}
+		else
+			kobj = NULL;
 	}
-	mutex_unlock(&task->cap_info->lock);
+
+	atomic_fetch_add_explicit(seq, 1, memory_order_release);
+	preemption_enable();
 
 	return kobj;
 }
@@ -474,13 +603,17 @@ void kobject_add_ref(kobject_t *kobj)
 /** Drop reference to kernel object
  *
  * The encapsulated object and the kobject_t wrapper are both destroyed when the
- * last reference is dropped.
+ * last reference is dropped, unless the kernel object type recycles them.
  *
  * @param kobj  Kernel object whose reference to drop.
  */
 void kobject_put(kobject_t *kobj)
 {
 	if (atomic_postdec(&kobj->refcnt) == 1) {
+		if ((KOBJECT_OP(kobj)->recycle) &&
+		    (KOBJECT_OP(kobj)->recycle(kobj->raw)))
+			return;
+
 		KOBJECT_OP(kobj)->destroy(kobj->raw);
 		kobject_free(kobj);
 	}
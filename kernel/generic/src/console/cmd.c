@@ -61,6 +61,7 @@
 #include <mm/frame.h>
 #include <main/version.h>
 #include <mm/slab.h>
+#include <mm/as.h>
 #include <proc/scheduler.h>
 #include <proc/thread.h>
 #include <proc/task.h>
@@ -534,6 +535,20 @@ static cmd_info_t zone_info = {
 	.argv = &zone_argv
 };
 
+/* Data and methods for 'faultaround' command */
+static int cmd_faultaround(cmd_arg_t *argv);
+static cmd_arg_t faultaround_argv = {
+	.type = ARG_TYPE_INT,
+};
+
+static cmd_info_t faultaround_info = {
+	.name = "faultaround",
+	.description = "<pages> Set number of pages mapped on an anonymous page fault.",
+	.func = cmd_faultaround,
+	.argc = 1,
+	.argv = &faultaround_argv
+};
+
 /* Data and methods for 'ipc' command */
 static int cmd_ipc(cmd_arg_t *argv);
 static cmd_arg_t ipc_argv = {
@@ -592,6 +607,7 @@ static cmd_info_t *basic_commands[] = {
 	&continue_info,
 	&cpus_info,
 	&desc_info,
+	&faultaround_info,
 	&halt_info,
 	&help_info,
 	&ipc_info,
@@ -1304,6 +1320,19 @@ int cmd_zone(cmd_arg_t *argv)
 	return 1;
 }
 
+/** Command for setting the anonymous memory fault-around window
+ *
+ * @param argv Integer argument from cmdline expected
+ *
+ * return Always 1
+ */
+int cmd_faultaround(cmd_arg_t *argv)
+{
+	anon_fault_around = min(max(argv[0].intval, 1), ANON_FAULT_AROUND_MAX);
+	printf("Fault-around window set to %zu pages\n", anon_fault_around);
+	return 1;
+}
+
 /** Command for printing task IPC details
  *
  * @param argv Integer argument from cmdline expected
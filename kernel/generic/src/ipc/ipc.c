@@ -43,6 +43,7 @@
 #include <synch/mutex.h>
 #include <synch/waitq.h>
 #include <ipc/ipc.h>
+#include <ipc/xfer.h>
 #include <ipc/ipcrsc.h>
 #include <abi/ipc/methods.h>
 #include <ipc/kbox.h>
@@ -70,6 +71,11 @@ answerbox_t *ipc_box_0 = NULL;
 static slab_cache_t *call_cache;
 static slab_cache_t *answerbox_cache;
 
+/** Number of calls taken from the slab allocator. */
+static atomic_size_t call_allocs = 0;
+/** Number of calls reused from an answerbox free list. */
+static atomic_size_t call_reuses = 0;
+
 slab_cache_t *phone_cache = NULL;
 
 /** Initialize a call structure.
@@ -88,21 +94,96 @@ static void _ipc_call_init(call_t *call)
 	call->buffer = NULL;
 }
 
-static void call_destroy(void *arg)
+/** Release the resources held by a call structure. */
+static void call_release(call_t *call)
 {
-	call_t *call = (call_t *) arg;
-
 	if (call->buffer)
 		free(call->buffer);
+	if (call->xfer)
+		ipc_xfer_unpin(&call->xfer);
 	if (call->caller_phone)
 		kobject_put(call->caller_phone->kobject);
+}
+
+static void call_destroy(void *arg)
+{
+	call_t *call = (call_t *) arg;
+
+	call_release(call);
 	slab_free(call_cache, call);
 }
 
+/** Keep a destroyed call for reuse by the current task.
+ *
+ * The call and its kobject_t wrapper are put on the free list of the current
+ * task's answerbox, so that the next ipc_call_alloc() in the task does not
+ * have to go to the slab allocator. A running thread holds a reference to its
+ * task, so the answerbox is guaranteed to exist until task_destroy() drains
+ * it.
+ *
+ * @param arg Call structure.
+ *
+ * @return True if the call was kept for reuse.
+ *
+ */
+static bool call_recycle(void *arg)
+{
+	call_t *call = (call_t *) arg;
+
+	if (!THREAD)
+		return false;
+
+	answerbox_t *box = &THREAD->task->answerbox;
+
+	/* Reserve a slot before releasing the resources without the lock. */
+	irq_spinlock_lock(&box->free_lock, true);
+	bool full = (box->free_count >= IPC_FREE_CALLS_MAX);
+	if (!full)
+		box->free_count++;
+	irq_spinlock_unlock(&box->free_lock, true);
+
+	if (full)
+		return false;
+
+	call_release(call);
+
+	irq_spinlock_lock(&box->free_lock, true);
+	list_prepend(&call->ab_link, &box->free_calls);
+	irq_spinlock_unlock(&box->free_lock, true);
+
+	return true;
+}
+
 kobject_ops_t call_kobject_ops = {
-	.destroy = call_destroy
+	.destroy = call_destroy,
+	.recycle = call_recycle
 };
 
+/** Take a call structure from the current task's free list.
+ *
+ * @return Call structure with its kobject_t wrapper, or NULL.
+ *
+ */
+static call_t *call_reuse(void)
+{
+	if (!THREAD)
+		return NULL;
+
+	answerbox_t *box = &THREAD->task->answerbox;
+	call_t *call = NULL;
+
+	irq_spinlock_lock(&box->free_lock, true);
+	link_t *link = list_first(&box->free_calls);
+	if (link) {
+		call = list_get_instance(link, call_t, ab_link);
+		list_remove(link);
+		box->free_count--;
+	}
+	irq_spinlock_unlock(&box->free_lock, true);
+
+	return call;
+}
+
 /** Allocate and initialize a call structure.
  *
  * The call is initialized, so that the reply will be directed to
@@ -113,16 +194,26 @@ kobject_ops_t call_kobject_ops = {
  */
 call_t *ipc_call_alloc(void)
 {
-	// TODO: Allocate call and kobject in single allocation
+	kobject_t *kobj;
 
-	call_t *call = slab_alloc(call_cache, FRAME_ATOMIC);
-	if (!call)
-		return NULL;
+	call_t *call = call_reuse();
+	if (call) {
+		kobj = call->kobject;
+		atomic_inc(&call_reuses);
+	} else {
+		// TODO: Allocate call and kobject in single allocation
 
-	kobject_t *kobj = kobject_alloc(0);
-	if (!kobj) {
-		slab_free(call_cache, call);
-		return NULL;
+		call = slab_alloc(call_cache, FRAME_ATOMIC);
+		if (!call)
+			return NULL;
+
+		kobj = kobject_alloc(0);
+		if (!kobj) {
+			slab_free(call_cache, call);
+			return NULL;
+		}
+
+		atomic_inc(&call_allocs);
 	}
 
 	_ipc_call_init(call);
@@ -150,6 +241,47 @@ void ipc_answerbox_init(answerbox_t *box, task_t *task)
 	list_initialize(&box->irq_notifs);
 	atomic_store(&box->active_calls, 0);
 	box->task = task;
+
+	irq_spinlock_initialize(&box->free_lock, "ipc.box.freelock");
+	list_initialize(&box->free_calls);
+	box->free_count = 0;
+}
+
+/** Destroy the calls kept for reuse by an answerbox.
+ *
+ * @param box Answerbox whose free list to drain.
+ *
+ */
+void ipc_answerbox_drain(answerbox_t *box)
+{
+	irq_spinlock_lock(&box->free_lock, true);
+	while (!list_empty(&box->free_calls)) {
+		call_t *call = list_get_instance(list_first(&box->free_calls),
+		    call_t, ab_link);
+		list_remove(&call->ab_link);
+		box->free_count--;
+		irq_spinlock_unlock(&box->free_lock, true);
+
+		kobject_free(call->kobject);
+		slab_free(call_cache, call);
+
+		irq_spinlock_lock(&box->free_lock, true);
+	}
+	irq_spinlock_unlock(&box->free_lock, true);
+}
+
+/** Get the call allocation statistics.
+ *
+ * @param allocs Place to store the number of calls taken from the slab
+ *               allocator.
+ * @param reuses Place to store the number of calls reused from the
+ *               answerbox free lists.
+ *
+ */
+void ipc_call_stats(uint64_t *allocs, uint64_t *reuses)
+{
+	*allocs = atomic_load(&call_allocs);
+	*reuses = atomic_load(&call_reuses);
 }
 
 /** Connect a phone to an answerbox.
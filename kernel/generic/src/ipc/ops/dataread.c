@@ -35,6 +35,7 @@
 #include <assert.h>
 #include <ipc/sysipc_ops.h>
 #include <ipc/ipc.h>
+#include <ipc/xfer.h>
 #include <stdlib.h>
 #include <abi/errno.h>
 #include <syscall/copy.h>
@@ -42,17 +43,27 @@
 
 static errno_t request_preprocess(call_t *call, phone_t *phone)
 {
+	uspace_addr_t dst = ipc_get_arg1(&call->data);
 	size_t size = ipc_get_arg2(&call->data);
 
 	if (size > DATA_XFER_LIMIT) {
 		int flags = ipc_get_arg3(&call->data);
 
-		if (flags & IPC_XF_RESTRICT)
-			ipc_set_arg2(&call->data, DATA_XFER_LIMIT);
-		else
+		if (flags & IPC_XF_RESTRICT) {
+			size = DATA_XFER_LIMIT;
+			ipc_set_arg2(&call->data, size);
+		} else
 			return ELIMIT;
 	}
 
+	/*
+	 * Large transfers pin the destination buffer so that the sender of
+	 * the data can copy it there directly when it answers. If the buffer
+	 * cannot be pinned, the data is bounced through a kernel buffer.
+	 */
+	if (size >= IPC_XFER_ZEROCOPY_MIN)
+		(void) ipc_xfer_pin(&call->xfer, dst, size, PF_ACCESS_WRITE);
+
 	return EOK;
 }
 
@@ -74,6 +85,15 @@ static errno_t answer_preprocess(call_t *answer, ipc_data_t *olddata)
 			 */
 			ipc_set_arg1(&answer->data, dst);
 
+			if (answer->xfer) {
+				errno_t rc = ipc_xfer_copy_from_uspace(
+				    answer->xfer, src, size);
+				if (rc)
+					ipc_set_retval(&answer->data, rc);
+				ipc_xfer_unpin(&answer->xfer);
+				return EOK;
+			}
+
 			answer->buffer = malloc(size);
 			if (!answer->buffer) {
 				ipc_set_retval(&answer->data, ENOMEM);
@@ -96,6 +116,10 @@ static errno_t answer_preprocess(call_t *answer, ipc_data_t *olddata)
 		}
 	}
 
+	/* Release the requester's frames if they were not needed. */
+	if (answer->xfer)
+		ipc_xfer_unpin(&answer->xfer);
+
 	return EOK;
 }
 
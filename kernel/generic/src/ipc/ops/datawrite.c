@@ -35,6 +35,7 @@
 #include <assert.h>
 #include <ipc/sysipc_ops.h>
 #include <ipc/ipc.h>
+#include <ipc/xfer.h>
 #include <stdlib.h>
 #include <abi/errno.h>
 #include <syscall/copy.h>
@@ -55,6 +56,16 @@ static errno_t request_preprocess(call_t *call, phone_t *phone)
 			return ELIMIT;
 	}
 
+	/*
+	 * Large transfers pin the source buffer. The data is then copied
+	 * straight to the recipient when it answers. If the buffer cannot be
+	 * pinned, e.g. because it is not anonymous memory, fall back to
+	 * bouncing the data through a kernel buffer.
+	 */
+	if ((size >= IPC_XFER_ZEROCOPY_MIN) &&
+	    (ipc_xfer_pin(&call->xfer, src, size, PF_ACCESS_READ) == EOK))
+		return EOK;
+
 	call->buffer = (uint8_t *) malloc(size);
 	if (!call->buffer)
 		return ENOMEM;
@@ -72,7 +83,7 @@ static errno_t request_preprocess(call_t *call, phone_t *phone)
 
 static errno_t answer_preprocess(call_t *answer, ipc_data_t *olddata)
 {
-	assert(answer->buffer);
+	assert(answer->buffer || answer->xfer);
 
 	if (!ipc_get_retval(&answer->data)) {
 		/* The recipient agreed to receive data. */
@@ -81,8 +92,15 @@ static errno_t answer_preprocess(call_t *answer, ipc_data_t *olddata)
 		size_t max_size = ipc_get_arg2(olddata);
 
 		if (size <= max_size) {
-			errno_t rc = copy_to_uspace(dst,
-			    answer->buffer, size);
+			errno_t rc;
+
+			if (answer->xfer) {
+				rc = ipc_xfer_copy_to_uspace(dst,
+				    answer->xfer, size);
+			} else {
+				rc = copy_to_uspace(dst,
+				    answer->buffer, size);
+			}
 			if (rc)
 				ipc_set_retval(&answer->data, rc);
 		} else {
@@ -90,6 +108,10 @@ static errno_t answer_preprocess(call_t *answer, ipc_data_t *olddata)
 		}
 	}
 
+	/* Release the sender's frames as soon as possible. */
+	if (answer->xfer)
+		ipc_xfer_unpin(&answer->xfer);
+
 	return EOK;
 }
 
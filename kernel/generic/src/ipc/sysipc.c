@@ -409,17 +409,19 @@ sys_errno_t sys_ipc_call_async_fast(cap_phone_handle_t handle, sysarg_t imethod,
 	return EOK;
 }
 
-/** Make an asynchronous IPC call allowing to transmit the entire payload.
+/** Make an asynchronous IPC call with the entire payload.
+ *
+ * Common code for sys_ipc_call_async_slow() and sys_ipc_submit().
  *
  * @param handle  Phone capability for the call.
- * @param data    Userspace address of call data with the request.
+ * @param args    Method and arguments of the call.
  * @param label   User-defined label.
  *
  * @return See sys_ipc_call_async_fast().
  *
  */
-sys_errno_t sys_ipc_call_async_slow(cap_phone_handle_t handle, uspace_ptr_ipc_data_t data,
-    sysarg_t label)
+static errno_t ipc_call_async_internal(cap_phone_handle_t handle,
+    const sysarg_t args[IPC_CALL_LEN], sysarg_t label)
 {
 	kobject_t *kobj = kobject_get(TASK, handle, KOBJECT_TYPE_PHONE);
 	if (!kobj)
@@ -436,13 +438,7 @@ sys_errno_t sys_ipc_call_async_slow(cap_phone_handle_t handle, uspace_ptr_ipc_da
 		return ENOMEM;
 	}
 
-	errno_t rc = copy_from_uspace(&call->data.args, data + offsetof(ipc_data_t, args),
-	    sizeof(call->data.args));
-	if (rc != EOK) {
-		kobject_put(call->kobject);
-		kobject_put(kobj);
-		return (sys_errno_t) rc;
-	}
+	memcpy(call->data.args, args, sizeof(call->data.args));
 
 	/* Set the user-defined label */
 	call->data.answer_label = label;
@@ -458,6 +454,28 @@ sys_errno_t sys_ipc_call_async_slow(cap_phone_handle_t handle, uspace_ptr_ipc_da
 	return EOK;
 }
 
+/** Make an asynchronous IPC call allowing to transmit the entire payload.
+ *
+ * @param handle  Phone capability for the call.
+ * @param data    Userspace address of call data with the request.
+ * @param label   User-defined label.
+ *
+ * @return See sys_ipc_call_async_fast().
+ *
+ */
+sys_errno_t sys_ipc_call_async_slow(cap_phone_handle_t handle, uspace_ptr_ipc_data_t data,
+    sysarg_t label)
+{
+	sysarg_t args[IPC_CALL_LEN];
+
+	errno_t rc = copy_from_uspace(args, data + offsetof(ipc_data_t, args),
+	    sizeof(args));
+	if (rc != EOK)
+		return (sys_errno_t) rc;
+
+	return (sys_errno_t) ipc_call_async_internal(handle, args, label);
+}
+
 /** Forward a received call to another destination
  *
  * Common code for both the fast and the slow version.
@@ -691,15 +709,18 @@ sys_errno_t sys_ipc_answer_fast(cap_call_handle_t chandle, sysarg_t retval,
 	return rc;
 }
 
-/** Answer an IPC call.
+/** Answer an IPC call with the entire payload.
+ *
+ * Common code for sys_ipc_answer_slow() and sys_ipc_submit().
  *
  * @param chandle Call handle to be answered.
- * @param data    Userspace address of call data with the answer.
+ * @param args    Return value and arguments of the answer.
  *
  * @return 0 on success, otherwise an error code.
  *
  */
-sys_errno_t sys_ipc_answer_slow(cap_call_handle_t chandle, uspace_ptr_ipc_data_t data)
+static errno_t ipc_answer_internal(cap_call_handle_t chandle,
+    const sysarg_t args[IPC_CALL_LEN])
 {
 	kobject_t *kobj = cap_unpublish(TASK, chandle, KOBJECT_TYPE_CALL);
 	if (!kobj)
@@ -717,17 +738,9 @@ sys_errno_t sys_ipc_answer_slow(cap_call_handle_t chandle, uspace_ptr_ipc_data_t
 	} else
 		saved = false;
 
-	errno_t rc = copy_from_uspace(&call->data.args, data + offsetof(ipc_data_t, args),
-	    sizeof(call->data.args));
-	if (rc != EOK) {
-		/*
-		 * Republish the capability so that the call does not get lost.
-		 */
-		cap_publish(TASK, chandle, kobj);
-		return rc;
-	}
+	memcpy(call->data.args, args, sizeof(call->data.args));
 
-	rc = answer_preprocess(call, saved ? &saved_data : NULL);
+	errno_t rc = answer_preprocess(call, saved ? &saved_data : NULL);
 
 	ipc_answer(&TASK->answerbox, call);
 
@@ -737,6 +750,78 @@ sys_errno_t sys_ipc_answer_slow(cap_call_handle_t chandle, uspace_ptr_ipc_data_t
 	return rc;
 }
 
+/** Answer an IPC call.
+ *
+ * @param chandle Call handle to be answered.
+ * @param data    Userspace address of call data with the answer.
+ *
+ * @return 0 on success, otherwise an error code.
+ *
+ */
+sys_errno_t sys_ipc_answer_slow(cap_call_handle_t chandle, uspace_ptr_ipc_data_t data)
+{
+	sysarg_t args[IPC_CALL_LEN];
+
+	errno_t rc = copy_from_uspace(args, data + offsetof(ipc_data_t, args),
+	    sizeof(args));
+	if (rc != EOK)
+		return (sys_errno_t) rc;
+
+	return (sys_errno_t) ipc_answer_internal(chandle, args);
+}
+
+/** Submit a batch of asynchronous calls and answers.
+ *
+ * The entries are processed in order as if each one was passed to
+ * sys_ipc_call_async_slow() or sys_ipc_answer_slow(), respectively.
+ * The result of each operation is stored in the rc member of its entry.
+ *
+ * @param entries Userspace address of the array of entries.
+ * @param count   Number of entries, at most IPC_BATCH_MAX.
+ *
+ * @return EOK if all entries were processed.
+ * @return EINVAL if there are too many entries.
+ * @return An error code if an entry could not be read or its result
+ *         could not be stored. The following entries are not processed.
+ *
+ */
+sys_errno_t sys_ipc_submit(uspace_ptr_ipc_submit_t entries, size_t count)
+{
+	if (count > IPC_BATCH_MAX)
+		return EINVAL;
+
+	for (size_t i = 0; i < count; i++) {
+		uspace_ptr_ipc_submit_t uentry = entries + i * sizeof(ipc_submit_t);
+		ipc_submit_t entry;
+
+		errno_t rc = copy_from_uspace(&entry, uentry, sizeof(entry));
+		if (rc != EOK)
+			return (sys_errno_t) rc;
+
+		switch (entry.op) {
+		case IPC_SUBMIT_CALL:
+			entry.rc = ipc_call_async_internal(
+			    (cap_phone_handle_t) entry.handle, entry.args,
+			    entry.label);
+			break;
+		case IPC_SUBMIT_ANSWER:
+			entry.rc = ipc_answer_internal(
+			    (cap_call_handle_t) entry.handle, entry.args);
+			break;
+		default:
+			entry.rc = EINVAL;
+			break;
+		}
+
+		rc = copy_to_uspace(uentry + offsetof(ipc_submit_t, rc),
+		    &entry.rc, sizeof(entry.rc));
+		if (rc != EOK)
+			return (sys_errno_t) rc;
+	}
+
+	return EOK;
+}
+
 /** Hang up a phone.
  *
  * @param handle  Phone capability handle of the phone to be hung up.
@@ -757,6 +842,8 @@ sys_errno_t sys_ipc_hangup(cap_phone_handle_t handle)
 }
 
 /** Wait for an incoming IPC call or an answer.
+ *
+ * Common code for sys_ipc_wait_for_call() and sys_ipc_wait_many().
  *
  * @param calldata Pointer to buffer where the call/answer data is stored.
  * @param usec     Timeout. See waitq_sleep_timeout() for explanation.
@@ -765,7 +852,7 @@ sys_errno_t sys_ipc_hangup(cap_phone_handle_t handle)
  *
  * @return An error code on error.
  */
-sys_errno_t sys_ipc_wait_for_call(uspace_ptr_ipc_data_t calldata, uint32_t usec,
+static errno_t ipc_wait_internal(uspace_ptr_ipc_data_t calldata, uint32_t usec,
     unsigned int flags)
 {
 	call_t *call = NULL;
@@ -865,6 +952,71 @@ error:
 	return rc;
 }
 
+/** Wait for an incoming IPC call or an answer.
+ *
+ * @param calldata Pointer to buffer where the call/answer data is stored.
+ * @param usec     Timeout. See waitq_sleep_timeout() for explanation.
+ * @param flags    Select mode of sleep operation. See waitq_sleep_timeout()
+ *                 for explanation.
+ *
+ * @return An error code on error.
+ */
+sys_errno_t sys_ipc_wait_for_call(uspace_ptr_ipc_data_t calldata, uint32_t usec,
+    unsigned int flags)
+{
+	return (sys_errno_t) ipc_wait_internal(calldata, usec, flags);
+}
+
+/** Wait for incoming IPC calls or answers and receive several at once.
+ *
+ * Wait for the first call or answer like sys_ipc_wait_for_call() does
+ * and then receive those already queued in the answerbox without
+ * blocking again.
+ *
+ * @param calls    Pointer to array where the call/answer data is stored.
+ * @param count    Size of the array, between 1 and IPC_BATCH_MAX.
+ * @param usec     Timeout of waiting for the first call.
+ * @param flags    Sleep flags of waiting for the first call.
+ * @param received Pointer to where the number of received calls is stored.
+ *
+ * @return Error code of waiting for the first call, or of storing the
+ *         number of received calls. No call is received in the latter case.
+ *
+ */
+sys_errno_t sys_ipc_wait_many(uspace_ptr_ipc_data_t calls, size_t count,
+    uint32_t usec, unsigned int flags, uspace_ptr_size_t received)
+{
+	if ((count == 0) || (count > IPC_BATCH_MAX))
+		return EINVAL;
+
+	/*
+	 * Received calls are gone from the answerbox, so make sure that their
+	 * number can be returned before taking any.
+	 */
+	size_t n = 0;
+	errno_t rc = copy_to_uspace(received, &n, sizeof(n));
+	if (rc != EOK)
+		return (sys_errno_t) rc;
+
+	rc = ipc_wait_internal(calls, usec, flags);
+	if (rc != EOK)
+		return (sys_errno_t) rc;
+
+	for (n = 1; n < count; n++) {
+		if (ipc_wait_internal(calls + n * sizeof(ipc_data_t),
+		    SYNCH_NO_TIMEOUT, SYNCH_FLAGS_NON_BLOCKING) != EOK)
+			break;
+	}
+
+	/*
+	 * The location was writable a moment ago. Should the task have
+	 * unmapped it since, the calls are lost just like the data of a call
+	 * copied to an unmapped buffer.
+	 */
+	(void) copy_to_uspace(received, &n, sizeof(n));
+	return EOK;
+}
+
 /** Interrupt one thread from sys_ipc_wait_for_call().
  *
  */
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup kernel_generic_ipc
+ * @{
+ */
+/**
+ * @file
+ * @brief Zero-copy IPC data transfers.
+ *
+ * Large IPC_M_DATA_WRITE and IPC_M_DATA_READ transfers do not bounce the
+ * data through a kernel buffer. Instead, the requester's buffer is pinned
+ * when the request is sent and the data is copied directly between the
+ * pinned frames and the answerer's address space when the request is
+ * answered.
+ */
+
+#include <assert.h>
+#include <align.h>
+#include <config.h>
+#include <ipc/xfer.h>
+#include <macros.h>
+#include <mm/frame.h>
+#include <mm/km.h>
+#include <mm/page.h>
+#include <stdlib.h>
+#include <syscall/copy.h>
+
+/** Pin a buffer of the current address space.
+ *
+ * The transfer structure is allocated here, sized for the number of
+ * pinned frames, so that calls which do not transfer data directly do
+ * not carry it.
+ *
+ * @param xferp  Place to store the new transfer structure.
+ * @param addr   Userspace address of the buffer.
+ * @param size   Size of the buffer, at most DATA_XFER_LIMIT.
+ * @param access PF_ACCESS_READ if the buffer is the source of the data,
+ *               PF_ACCESS_WRITE if it is the destination.
+ *
+ * @return EOK on success or an error code, in which case nothing
+ *         remains pinned and @a xferp is left untouched.
+ */
+errno_t ipc_xfer_pin(ipc_xfer_t **xferp, uspace_addr_t addr, size_t size,
+    pf_access_t access)
+{
+	assert(*xferp == NULL);
+	assert(size <= DATA_XFER_LIMIT);
+
+	if (overflows(addr, size))
+		return EPERM;
+
+	uintptr_t base = ALIGN_DOWN(addr, PAGE_SIZE);
+	size_t count = SIZE2FRAMES(addr - base + size);
+	assert(count <= IPC_XFER_FRAMES_MAX);
+
+	ipc_xfer_t *xfer = malloc(sizeof(ipc_xfer_t) +
+	    count * sizeof(uintptr_t));
+	if (!xfer)
+		return ENOMEM;
+
+	errno_t rc = as_pin_pages(base, count, access, xfer->frames);
+	if (rc != EOK) {
+		free(xfer);
+		return rc;
+	}
+
+	xfer->count = count;
+	xfer->offset = addr - base;
+	*xferp = xfer;
+	return EOK;
+}
+
+/** Release a buffer pinned by ipc_xfer_pin().
+ *
+ * @param xferp Transfer structure, set to NULL after it is freed.
+ */
+void ipc_xfer_unpin(ipc_xfer_t **xferp)
+{
+	ipc_xfer_t *xfer = *xferp;
+
+	as_unpin_pages(xfer->frames, xfer->count);
+	free(xfer);
+	*xferp = NULL;
+}
+
+/** Copy data between the pinned buffer and the current address space.
+ *
+ * Frames outside of the identity mapping are temporarily mapped into the
+ * kernel address space.
+ */
+static errno_t ipc_xfer_copy(ipc_xfer_t *xfer, uspace_addr_t uspace,
+    size_t size, bool to_uspace)
+{
+	size_t offset = xfer->offset;
+
+	for (size_t i = 0; size > 0; i++) {
+		assert(i < xfer->count);
+
+		uintptr_t frame = xfer->frames[i];
+		size_t chunk = min(size, FRAME_SIZE - offset);
+
+		uintptr_t page;
+		if (frame < config.identity_size) {
+			page = PA2KA(frame);
+		} else {
+			page = km_map(frame, FRAME_SIZE, FRAME_SIZE,
+			    PAGE_READ | PAGE_WRITE | PAGE_CACHEABLE);
+		}
+
+		errno_t rc;
+		if (to_uspace)
+			rc = copy_to_uspace(uspace, (void *) (page + offset), chunk);
+		else
+			rc = copy_from_uspace((void *) (page + offset), uspace, chunk);
+
+		if (frame >= config.identity_size)
+			km_unmap(page, FRAME_SIZE);
+
+		if (rc != EOK)
+			return rc;
+
+		uspace += chunk;
+		size -= chunk;
+		offset = 0;
+	}
+
+	return EOK;
+}
+
+/** Copy data from the pinned buffer to the current address space.
+ *
+ * @param dst  Destination userspace address.
+ * @param xfer Pinned source buffer.
+ * @param size Number of bytes to copy, at most the size of the buffer.
+ *
+ * @return EOK on success or an error code from copy_to_uspace().
+ */
+errno_t ipc_xfer_copy_to_uspace(uspace_addr_t dst, ipc_xfer_t *xfer,
+    size_t size)
+{
+	return ipc_xfer_copy(xfer, dst, size, true);
+}
+
+/** Copy data from the current address space to the pinned buffer.
+ *
+ * @param xfer Pinned destination buffer.
+ * @param src  Source userspace address.
+ * @param size Number of bytes to copy, at most the size of the buffer.
+ *
+ * @return EOK on success or an error code from copy_from_uspace().
+ */
+errno_t ipc_xfer_copy_from_uspace(ipc_xfer_t *xfer, uspace_addr_t src,
+    size_t size)
+{
+	return ipc_xfer_copy(xfer, src, size, false);
+}
+
+/** @}
+ */
@@ -183,6 +183,7 @@ as_t *as_create(unsigned int flags)
 
 	refcount_init(&as->refcount);
 	as->cpu_refcount = 0;
+	atomic_store(&as->page_faults, 0);
 
 #ifdef AS_PAGE_TABLE
 	as->genarch.page_table = page_table_create(flags);
@@ -489,6 +490,14 @@ _NO_TRACE static uintptr_t as_get_unmapped_area(as_t *as, uintptr_t bound,
 
 	size_t pages = SIZE2FRAMES(size);
 
+	/*
+	 * Areas which can hold at least one large page start on a large
+	 * page boundary so that the backend can map them by large pages.
+	 */
+	uintptr_t align = PAGE_SIZE;
+	if ((LARGE_PAGE_SIZE != 0) && (size >= LARGE_PAGE_SIZE))
+		align = LARGE_PAGE_SIZE;
+
 	/*
 	 * Find the lowest unmapped address aligned on the size
 	 * boundary, not smaller than bound and of the required size.
@@ -505,7 +514,9 @@ _NO_TRACE static uintptr_t as_get_unmapped_area(as_t *as, uintptr_t bound,
 			addr += P2SZ(1);
 		}
 
-		if (check_area_conflicts(as, addr, pages, guarded, NULL))
+		addr = ALIGN_UP(addr, align);
+		if ((addr >= bound) &&
+		    (check_area_conflicts(as, addr, pages, guarded, NULL)))
 			return addr;
 	}
 
@@ -524,6 +535,8 @@ _NO_TRACE static uintptr_t as_get_unmapped_area(as_t *as, uintptr_t bound,
 			addr += P2SZ(1);
 		}
 
+		addr = ALIGN_UP(addr, align);
+
 		bool avail =
 		    ((addr >= bound) && (addr >= area->base) &&
 		    (check_area_conflicts(as, addr, pages, guarded, area)));
@@ -540,6 +553,45 @@ _NO_TRACE static uintptr_t as_get_unmapped_area(as_t *as, uintptr_t bound,
 	return (uintptr_t) -1;
 }
 
+/** Remove a large page mapping starting at a used page.
+ *
+ * @param as    Address space.
+ * @param page  Used page.
+ * @param count Number of used pages starting at @a page.
+ *
+ * @return True if @a page starts a large page mapping which lies within
+ *         the @a count pages and which has been removed.
+ *
+ */
+_NO_TRACE static bool as_large_page_remove(as_t *as, uintptr_t page,
+    size_t count)
+{
+	if ((LARGE_PAGE_SIZE == 0) || (count < LARGE_PAGE_PAGES) ||
+	    (!IS_ALIGNED(page, LARGE_PAGE_SIZE)))
+		return false;
+
+	return page_mapping_remove_large(as, page);
+}
+
+/** Release the frames of a removed large page mapping.
+ *
+ * @param area  Address space area.
+ * @param page  Virtual address of the large page.
+ * @param frame First frame of the large page.
+ *
+ */
+_NO_TRACE static void as_large_page_frame_free(as_area_t *area,
+    uintptr_t page, uintptr_t frame)
+{
+	if ((!area->backend) || (!area->backend->frame_free))
+		return;
+
+	for (size_t i = 0; i < LARGE_PAGE_PAGES; i++) {
+		area->backend->frame_free(area, page + P2SZ(i),
+		    frame + P2SZ(i));
+	}
+}
+
 /** Get key function for pagemap ordered dictionary.
  *
  * The key is the virtual address of the page (as_page_mapping_t.vaddr)
@@ -950,6 +1002,14 @@ errno_t as_area_resize(as_t *as, uintptr_t address, size_t size, unsigned int fl
 
 		page_table_lock(as, false);
 
+		/*
+		 * A large page straddling the new end of the area is split
+		 * here, while it is still possible to allocate memory.
+		 */
+		if ((LARGE_PAGE_SIZE != 0) &&
+		    (!IS_ALIGNED(start_free, LARGE_PAGE_SIZE)))
+			page_mapping_split(as, start_free);
+
 		/*
 		 * Start TLB shootdown sequence.
 		 */
@@ -1014,6 +1074,14 @@ errno_t as_area_resize(as_t *as, uintptr_t address, size_t size, unsigned int fl
 				assert(PTE_VALID(&pte));
 				assert(PTE_PRESENT(&pte));
 
+				if (as_large_page_remove(as, ptr + P2SZ(i),
+				    pcount - i)) {
+					as_large_page_frame_free(area,
+					    ptr + P2SZ(i), PTE_GET_FRAME(&pte));
+					i += LARGE_PAGE_PAGES - 1;
+					continue;
+				}
+
 				if ((area->backend) &&
 				    (area->backend->frame_free)) {
 					area->backend->frame_free(area,
@@ -1124,6 +1192,14 @@ errno_t as_area_destroy(as_t *as, uintptr_t address)
 			assert(PTE_VALID(&pte));
 			assert(PTE_PRESENT(&pte));
 
+			if (as_large_page_remove(as, ptr + P2SZ(size),
+			    ival->count - size)) {
+				as_large_page_frame_free(area,
+				    ptr + P2SZ(size), PTE_GET_FRAME(&pte));
+				size += LARGE_PAGE_PAGES - 1;
+				continue;
+			}
+
 			if ((area->backend) &&
 			    (area->backend->frame_free)) {
 				area->backend->frame_free(area,
@@ -1428,6 +1504,18 @@ errno_t as_area_change_flags(as_t *as, unsigned int flags, uintptr_t address)
 			assert(PTE_VALID(&pte));
 			assert(PTE_PRESENT(&pte));
 
+			if (as_large_page_remove(as, ptr + P2SZ(size),
+			    ival->count - size)) {
+				/* The pages are mapped back one by one */
+				for (size_t i = 0; i < LARGE_PAGE_PAGES; i++) {
+					old_frame[frame_idx++] =
+					    PTE_GET_FRAME(&pte) + P2SZ(i);
+				}
+
+				size += LARGE_PAGE_PAGES - 1;
+				continue;
+			}
+
 			old_frame[frame_idx++] = PTE_GET_FRAME(&pte);
 
 			/* Remove old mapping */
@@ -1490,6 +1578,72 @@ errno_t as_area_change_flags(as_t *as, unsigned int flags, uintptr_t address)
 	return 0;
 }
 
+/** Populate pages of an address space area.
+ *
+ * Resolve all not yet present pages of the given range in advance, so that
+ * the caller does not take a page fault on each page when it starts using
+ * the memory. The range is clipped to the address space area which
+ * contains @a address.
+ *
+ * @param as      Address space. Must be the current address space, because
+ *                backends operate on AS.
+ * @param address Virtual address of the first byte to populate.
+ * @param size    Size of the range in bytes.
+ *
+ * @return Zero on success or a value from @ref errno.h on failure.
+ *
+ */
+errno_t as_area_populate(as_t *as, uintptr_t address, size_t size)
+{
+	assert(as == AS);
+
+	mutex_lock(&as->lock);
+
+	as_area_t *area = find_area_and_lock(as, address);
+	if (!area) {
+		mutex_unlock(&as->lock);
+		return ENOENT;
+	}
+
+	if ((area->attributes & AS_AREA_ATTR_PARTIAL) ||
+	    (!area->backend) || (!area->backend->page_fault)) {
+		mutex_unlock(&area->lock);
+		mutex_unlock(&as->lock);
+		return ENOTSUP;
+	}
+
+	pf_access_t access = (area->flags & AS_AREA_WRITE) ?
+	    PF_ACCESS_WRITE : PF_ACCESS_READ;
+
+	uintptr_t page = ALIGN_DOWN(address, PAGE_SIZE);
+	uintptr_t end = area->base + P2SZ(area->pages);
+	if (size < end - address)
+		end = ALIGN_UP(address + size, PAGE_SIZE);
+
+	errno_t rc = EOK;
+
+	page_table_lock(as, false);
+
+	for (; page < end; page += PAGE_SIZE) {
+		pte_t pte;
+		bool found = page_mapping_find(as, page, false, &pte);
+		if (found && PTE_PRESENT(&pte))
+			continue;
+
+		if (area->backend->page_fault(area, page, access) !=
+		    AS_PF_OK) {
+			rc = ENOMEM;
+			break;
+		}
+	}
+
+	page_table_unlock(as, false);
+	mutex_unlock(&area->lock);
+	mutex_unlock(&as->lock);
+
+	return rc;
+}
+
 /** Handle page fault within the current address space.
  *
  * This is the high-level page fault handler. It decides whether the page fault
@@ -1573,6 +1727,7 @@ int as_page_fault(uintptr_t address, pf_access_t access, istate_t *istate)
 	/*
 	 * Resort to the backend page fault handler.
 	 */
+	atomic_inc(&AS->page_faults);
 	rc = area->backend->page_fault(area, page, access);
 	if (rc != AS_PF_OK) {
 		page_table_unlock(AS, false);
@@ -1607,6 +1762,111 @@ page_fault:
 	return AS_PF_DEFER;
 }
 
+/** Pin pages of the current address space.
+ *
+ * Make sure that the pages are backed by frames and add a reference to
+ * each of them, so that the frames outlive the destruction or resizing of
+ * the address space area. The frames must be released with
+ * as_unpin_pages().
+ *
+ * Only anonymous memory can be pinned as other backends either do not own
+ * their frames or may decide to replace them.
+ *
+ * @param base   Page-aligned address of the first page.
+ * @param count  Number of pages to pin.
+ * @param access Access the caller intends to perform on the frames.
+ * @param frames Array that will receive physical addresses of the frames.
+ *
+ * @return EOK on success.
+ * @return ENOENT if some of the pages does not belong to any area.
+ * @return ENOTSUP if some of the pages cannot be pinned.
+ * @return EPERM if the access is not permitted by the area.
+ * @return ENOMEM if a page could not be faulted in.
+ *
+ */
+errno_t as_pin_pages(uintptr_t base, size_t count, pf_access_t access,
+    uintptr_t *frames)
+{
+	assert(IS_ALIGNED(base, PAGE_SIZE));
+
+	errno_t rc = EOK;
+	as_area_t *area = NULL;
+	size_t i;
+
+	mutex_lock(&AS->lock);
+
+	for (i = 0; i < count; i++) {
+		uintptr_t page = base + P2SZ(i);
+
+		if ((area) && (page > area->base + (P2SZ(area->pages) - 1))) {
+			mutex_unlock(&area->lock);
+			area = NULL;
+		}
+
+		if (!area) {
+			area = find_area_and_lock(AS, page);
+			if (!area) {
+				rc = ENOENT;
+				break;
+			}
+
+			if ((area->backend != &anon_backend) ||
+			    (area->attributes & AS_AREA_ATTR_PARTIAL)) {
+				rc = ENOTSUP;
+				break;
+			}
+
+			if (!as_area_check_access(area, access)) {
+				rc = EPERM;
+				break;
+			}
+		}
+
+		page_table_lock(AS, false);
+
+		pte_t pte;
+		bool found = page_mapping_find(AS, page, false, &pte);
+		if ((!found) || (!PTE_PRESENT(&pte))) {
+			if (area->backend->page_fault(area, page, access) !=
+			    AS_PF_OK) {
+				page_table_unlock(AS, false);
+				rc = ENOMEM;
+				break;
+			}
+
+			found = page_mapping_find(AS, page, false, &pte);
+			assert(found && PTE_PRESENT(&pte));
+		}
+
+		frames[i] = PTE_GET_FRAME(&pte);
+		frame_reference_add(ADDR2PFN(frames[i]));
+
+		page_table_unlock(AS, false);
+	}
+
+	if (area)
+		mutex_unlock(&area->lock);
+
+	mutex_unlock(&AS->lock);
+
+	if (rc != EOK)
+		as_unpin_pages(frames, i);
+
+	return rc;
+}
+
+/** Release frames pinned by as_pin_pages().
+ *
+ * @param frames Physical addresses of the pinned frames.
+ * @param count  Number of frames.
+ *
+ */
+void as_unpin_pages(uintptr_t *frames, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		frame_free_noreserve(frames[i], 1);
+}
+
 /** Switch address spaces.
  *
  * Note that this function cannot sleep as it is essentially a part of
@@ -2155,6 +2415,11 @@ sys_errno_t sys_as_area_destroy(uintptr_t address)
 	return (sys_errno_t) as_area_destroy(AS, address);
 }
 
+sys_errno_t sys_as_area_populate(uintptr_t address, size_t size)
+{
+	return (sys_errno_t) as_area_populate(AS, address, size);
+}
+
 /** Get list of address space areas.
  *
  * @param as    Address space.
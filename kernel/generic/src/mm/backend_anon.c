@@ -50,6 +50,7 @@
 #include <errno.h>
 #include <typedefs.h>
 #include <align.h>
+#include <macros.h>
 #include <mem.h>
 #include <arch.h>
 
@@ -64,6 +65,9 @@ static bool anon_is_shareable(as_area_t *);
 static int anon_page_fault(as_area_t *, uintptr_t, pf_access_t);
 static void anon_frame_free(as_area_t *, uintptr_t, uintptr_t);
 
+/** Number of pages mapped around a faulting page (including it). */
+size_t anon_fault_around = ANON_FAULT_AROUND;
+
 mem_backend_t anon_backend = {
 	.create = anon_create,
 	.resize = anon_resize,
@@ -170,6 +174,110 @@ bool anon_is_shareable(as_area_t *area)
 	return !(area->flags & AS_AREA_LATE_RESERVE);
 }
 
+/** Map not yet present pages around a faulting page.
+ *
+ * The window of anon_fault_around pages is aligned to its size within the
+ * area, so that a sequential touch takes one fault per window no matter
+ * in which direction it proceeds. Frames are allocated without sleeping
+ * and the first failure ends the fault-around.
+ *
+ * The address space area and page tables must be already locked.
+ *
+ * @param area  Pointer to the non-shared address space area.
+ * @param upage Faulting virtual page which has already been mapped.
+ */
+static void anon_map_around(as_area_t *area, uintptr_t upage)
+{
+	size_t window = anon_fault_around;
+	if (window <= 1)
+		return;
+
+	size_t index = (upage - area->base) >> PAGE_WIDTH;
+	size_t first = index - index % window;
+	size_t last = min(first + window, area->pages);
+	unsigned int flags = as_area_get_flags(area);
+
+	for (size_t i = first; i < last; i++) {
+		uintptr_t page = area->base + P2SZ(i);
+		if (page == upage)
+			continue;
+
+		pte_t pte;
+		bool found = page_mapping_find(AS, page, false, &pte);
+		if (found && PTE_PRESENT(&pte))
+			continue;
+
+		if ((area->flags & AS_AREA_LATE_RESERVE) &&
+		    (!reserve_try_alloc(1)))
+			break;
+
+		uintptr_t frame = frame_alloc(1,
+		    FRAME_LOWMEM | FRAME_ATOMIC | FRAME_NO_RESERVE, 0);
+		if (!frame) {
+			if (area->flags & AS_AREA_LATE_RESERVE)
+				reserve_free(1);
+			break;
+		}
+
+		memsetb((void *) PA2KA(frame), PAGE_SIZE, 0);
+
+		page_mapping_insert(AS, page, frame, flags);
+		if (!used_space_insert(&area->used_space, page, 1))
+			panic("Cannot insert used space.");
+	}
+}
+
+/** Try to back the large page around a faulting page by a single mapping.
+ *
+ * This is done only if the large page lies entirely within the area and
+ * none of its pages has been mapped yet. The frames are allocated as one
+ * naturally aligned block without blocking, so the caller simply falls
+ * back to base pages when physical memory is fragmented.
+ *
+ * @param area  Private anonymous address space area.
+ * @param upage Faulting virtual page.
+ *
+ * @return True if the large page has been mapped.
+ */
+static bool anon_map_large(as_area_t *area, uintptr_t upage)
+{
+	if (LARGE_PAGE_SIZE == 0)
+		return false;
+
+	uintptr_t page = ALIGN_DOWN(upage, LARGE_PAGE_SIZE);
+	if ((page < area->base) ||
+	    (page + LARGE_PAGE_SIZE > area->base + P2SZ(area->pages)))
+		return false;
+
+	if ((area->flags & AS_AREA_LATE_RESERVE) &&
+	    (!reserve_try_alloc(LARGE_PAGE_PAGES)))
+		return false;
+
+	uintptr_t frame = frame_alloc(LARGE_PAGE_PAGES,
+	    FRAME_LOWMEM | FRAME_ATOMIC | FRAME_NO_RESERVE,
+	    LARGE_PAGE_SIZE - 1);
+	if (!frame)
+		goto fail;
+
+	memsetb((void *) PA2KA(frame), LARGE_PAGE_SIZE, 0);
+
+	if (!page_mapping_insert_large(AS, page, frame,
+	    as_area_get_flags(area))) {
+		frame_free_noreserve(frame, LARGE_PAGE_PAGES);
+		goto fail;
+	}
+
+	if (!used_space_insert(&area->used_space, page, LARGE_PAGE_PAGES))
+		panic("Cannot insert used space.");
+
+	return true;
+
+fail:
+	if (area->flags & AS_AREA_LATE_RESERVE)
+		reserve_free(LARGE_PAGE_PAGES);
+	return false;
+}
+
 /** Service a page fault in the anonymous memory address space area.
  *
  * The address space area and page tables must be already locked.
@@ -185,6 +293,7 @@ int anon_page_fault(as_area_t *area, uintptr_t upage, pf_access_t access)
 {
 	uintptr_t kpage;
 	uintptr_t frame;
+	bool shared;
 
 	assert(page_table_locked(AS));
 	assert(mutex_locked(&area->lock));
@@ -194,7 +303,8 @@ int anon_page_fault(as_area_t *area, uintptr_t upage, pf_access_t access)
 		return AS_PF_FAULT;
 
 	mutex_lock(&area->sh_info->lock);
-	if (area->sh_info->shared) {
+	shared = area->sh_info->shared;
+	if (shared) {
 		/*
 		 * The area is shared, chances are that the mapping can be found
 		 * in the pagemap of the address space area share info
@@ -236,6 +346,11 @@ int anon_page_fault(as_area_t *area, uintptr_t upage, pf_access_t access)
 		 *   the different causes
 		 */
 
+		if (anon_map_large(area, upage)) {
+			mutex_unlock(&area->sh_info->lock);
+			return AS_PF_OK;
+		}
+
 		if (area->flags & AS_AREA_LATE_RESERVE) {
 			/*
 			 * Reserve the memory for this page now.
@@ -261,6 +376,13 @@ int anon_page_fault(as_area_t *area, uintptr_t upage, pf_access_t access)
 	if (!used_space_insert(&area->used_space, upage, 1))
 		panic("Cannot insert used space.");
 
+	/*
+	 * Neighbouring pages of a shared area are resolved through the
+	 * pagemap on their own faults.
+	 */
+	if (!shared)
+		anon_map_around(area, upage);
+
 	return AS_PF_OK;
 }
 
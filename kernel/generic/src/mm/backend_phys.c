@@ -116,6 +116,42 @@ bool phys_is_shareable(as_area_t *area)
 	return true;
 }
 
+/** Try to map the large page around a faulting page by a single mapping.
+ *
+ * This is possible if the large page lies entirely within the area and
+ * the physical memory behind it is aligned the same way as the virtual
+ * address.
+ *
+ * @param area  Address space area backed by physical memory.
+ * @param upage Faulting virtual page.
+ *
+ * @return True if the large page has been mapped.
+ */
+static bool phys_map_large(as_area_t *area, uintptr_t upage)
+{
+	if (LARGE_PAGE_SIZE == 0)
+		return false;
+
+	uintptr_t page = ALIGN_DOWN(upage, LARGE_PAGE_SIZE);
+	size_t pages = min(area->pages, area->backend_data.frames);
+	if ((page < area->base) ||
+	    (page + LARGE_PAGE_SIZE > area->base + P2SZ(pages)))
+		return false;
+
+	uintptr_t frame = area->backend_data.base + (page - area->base);
+	if (!IS_ALIGNED(frame, LARGE_PAGE_SIZE))
+		return false;
+
+	if (!page_mapping_insert_large(AS, page, frame,
+	    as_area_get_flags(area)))
+		return false;
+
+	if (!used_space_insert(&area->used_space, page, LARGE_PAGE_PAGES))
+		panic("Cannot insert used space.");
+
+	return true;
+}
+
 /** Service a page fault in the address space area backed by physical memory.
  *
  * The address space area and page tables must be already locked.
@@ -139,6 +175,9 @@ int phys_page_fault(as_area_t *area, uintptr_t upage, pf_access_t access)
 		return AS_PF_FAULT;
 
 	assert(upage - area->base < area->backend_data.frames * FRAME_SIZE);
+	if (phys_map_large(area, upage))
+		return AS_PF_OK;
+
 	page_mapping_insert(AS, upage, base + (upage - area->base),
 	    as_area_get_flags(area));
 
@@ -39,6 +39,7 @@
 #include <mm/as.h>
 #include <mm/page.h>
 #include <mm/frame.h>
+#include <mm/km.h>
 #include <abi/mm/as.h>
 #include <abi/ipc/methods.h>
 #include <ipc/sysipc.h>
@@ -48,6 +49,7 @@
 #include <assert.h>
 #include <errno.h>
 #include <log.h>
+#include <mem.h>
 #include <str.h>
 
 static bool user_create(as_area_t *);
@@ -145,6 +147,24 @@ int user_page_fault(as_area_t *area, uintptr_t upage, pf_access_t access)
 	 */
 
 	uintptr_t frame = ipc_get_arg1(&data);
+
+	if (as_area_get_flags(area) & PAGE_WRITE) {
+		/*
+		 * The pager may keep the frame in its page cache and share it
+		 * with other tasks. Writable mappings get a private copy.
+		 */
+		uintptr_t copy;
+		uintptr_t kcopy = km_temporary_page_get(&copy, 0);
+		uintptr_t ksrc = km_map(frame, PAGE_SIZE, PAGE_SIZE,
+		    PAGE_READ | PAGE_CACHEABLE);
+		memcpy((void *) kcopy, (void *) ksrc, PAGE_SIZE);
+		km_unmap(ksrc, PAGE_SIZE);
+		km_temporary_page_put(kcopy);
+
+		user_frame_free(area, upage, frame);
+		frame = copy;
+	}
+
 	page_mapping_insert(AS, upage, frame, as_area_get_flags(area));
 	if (!used_space_insert(&area->used_space, upage, 1))
 		panic("Cannot insert used space.");
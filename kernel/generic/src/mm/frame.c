@@ -58,7 +58,9 @@
 #include <mm/slab.h>
 #include <bitops.h>
 #include <macros.h>
+#include <mem.h>
 #include <config.h>
+#include <cpu.h>
 #include <str.h>
 #include <proc/thread.h> /* THREAD */
 
@@ -73,6 +75,9 @@ static condvar_t mem_avail_cv;
 static size_t mem_avail_req = 0;  /**< Number of frames requested. */
 static size_t mem_avail_gen = 0;  /**< Generation counter. */
 
+/** True if there is a zone with high memory available for allocation. */
+static bool highmem_present = false;
+
 /** Initialize frame structure.
  *
  * @param frame Frame structure to be initialized.
@@ -521,6 +526,33 @@ _NO_TRACE static void return_config_frames(size_t znum, pfn_t pfn, size_t count)
 		    pfn - zones.info[znum].base + i);
 }
 
+/** Lock the frame caches of all processors.
+ *
+ * The per-CPU frame cache fast paths look up zones without holding the zones
+ * lock. Any change to the layout of the zones array must therefore be done
+ * with all frame cache locks held. The locks must be taken before the zones
+ * lock.
+ *
+ */
+static void frame_caches_lock(void)
+{
+	if (CPU == NULL)
+		return;
+
+	for (unsigned int i = 0; i < config.cpu_count; i++)
+		irq_spinlock_lock(&cpus[i].frame_cache.lock, true);
+}
+
+/** Unlock the frame caches locked by frame_caches_lock(). */
+static void frame_caches_unlock(void)
+{
+	if (CPU == NULL)
+		return;
+
+	for (unsigned int i = config.cpu_count; i > 0; i--)
+		irq_spinlock_unlock(&cpus[i - 1].frame_cache.lock, true);
+}
+
 /** Merge zones z1 and z2.
  *
  * The merged zones must be 2 zones with no zone existing in between
@@ -534,6 +566,7 @@ _NO_TRACE static void return_config_frames(size_t znum, pfn_t pfn, size_t count)
  */
 bool zone_merge(size_t z1, size_t z2)
 {
+	frame_caches_lock();
 	irq_spinlock_lock(&zones.lock, true);
 
 	bool ret = true;
@@ -590,6 +623,7 @@ bool zone_merge(size_t z1, size_t z2)
 
 errout:
 	irq_spinlock_unlock(&zones.lock, true);
+	frame_caches_unlock();
 
 	return ret;
 }
@@ -695,6 +729,7 @@ pfn_t zone_external_conf_alloc(size_t count)
 size_t zone_create(pfn_t start, size_t count, pfn_t confframe,
     zone_flags_t flags)
 {
+	frame_caches_lock();
 	irq_spinlock_lock(&zones.lock, true);
 
 	if (flags & ZONE_AVAILABLE) {  /* Create available zone */
@@ -748,6 +783,7 @@ size_t zone_create(pfn_t start, size_t count, pfn_t confframe,
 		size_t znum = zones_insert_zone(start, count, flags);
 		if (znum == (size_t) -1) {
 			irq_spinlock_unlock(&zones.lock, true);
+			frame_caches_unlock();
 			return (size_t) -1;
 		}
 
@@ -761,7 +797,11 @@ size_t zone_create(pfn_t start, size_t count, pfn_t confframe,
 				    i - zones.info[znum].base);
 		}
 
+		if (flags & ZONE_HIGHMEM)
+			highmem_present = true;
+
 		irq_spinlock_unlock(&zones.lock, true);
+		frame_caches_unlock();
 
 		return znum;
 	}
@@ -770,12 +810,14 @@ size_t zone_create(pfn_t start, size_t count, pfn_t confframe,
 	size_t znum = zones_insert_zone(start, count, flags);
 	if (znum == (size_t) -1) {
 		irq_spinlock_unlock(&zones.lock, true);
+		frame_caches_unlock();
 		return (size_t) -1;
 	}
 
 	zone_construct(&zones.info[znum], start, count, flags, NULL);
 
 	irq_spinlock_unlock(&zones.lock, true);
+	frame_caches_unlock();
 
 	return znum;
 }
@@ -829,6 +871,281 @@ static size_t try_find_zone(size_t count, bool lowmem,
 	    frame_constraint, hint);
 }
 
+/** Wake up threads waiting for free frames.
+ *
+ * @param freed Number of frames which were returned to the zones.
+ *
+ */
+static void frame_avail_signal(size_t freed)
+{
+	/*
+	 * Since the mem_avail_mtx is an active mutex,
+	 * we need to disable interruptsto prevent deadlock
+	 * with TLB shootdown.
+	 */
+
+	ipl_t ipl = interrupts_disable();
+	mutex_lock(&mem_avail_mtx);
+
+	if (mem_avail_req > 0)
+		mem_avail_req -= min(mem_avail_req, freed);
+
+	if (mem_avail_req == 0) {
+		mem_avail_gen++;
+		condvar_broadcast(&mem_avail_cv);
+	}
+
+	mutex_unlock(&mem_avail_mtx);
+	interrupts_restore(ipl);
+}
+
+/************************/
+/* Frame cache functions */
+/************************/
+
+/** Return the frame cache kind matching a zone. */
+_NO_TRACE static frame_cache_kind_t frame_cache_kind(zone_t *zone)
+{
+	return (zone->flags & ZONE_HIGHMEM) ?
+	    FRAME_CACHE_HIGHMEM : FRAME_CACHE_LOWMEM;
+}
+
+/** Return the least recently cached frames to the zones.
+ *
+ * Assume interrupts are disabled and the frame cache is locked.
+ *
+ * @param cache Frame cache.
+ * @param kind  Kind of frames to return.
+ * @param count Maximum number of frames to return.
+ *
+ * @return Number of frames freed in the zones.
+ *
+ */
+_NO_TRACE static size_t frame_cache_drain(frame_cache_t *cache,
+    frame_cache_kind_t kind, size_t count)
+{
+	size_t n = min(count, cache->count[kind]);
+	size_t freed = 0;
+
+	irq_spinlock_lock(&zones.lock, false);
+
+	for (size_t i = 0; i < n; i++) {
+		pfn_t pfn = cache->pfn[kind][i];
+		size_t znum = find_zone(pfn, 1, 0);
+
+		assert(znum != (size_t) -1);
+
+		freed += zone_frame_free(&zones.info[znum],
+		    pfn - zones.info[znum].base);
+	}
+
+	irq_spinlock_unlock(&zones.lock, false);
+
+	cache->count[kind] -= n;
+	memmove(&cache->pfn[kind][0], &cache->pfn[kind][n],
+	    cache->count[kind] * sizeof(pfn_t));
+
+	return freed;
+}
+
+/** Return all cached frames of all processors to the zones.
+ *
+ * @return Number of frames freed in the zones.
+ *
+ */
+static size_t frame_cache_drain_all(void)
+{
+	size_t freed = 0;
+
+	if (CPU == NULL)
+		return 0;
+
+	for (unsigned int i = 0; i < config.cpu_count; i++) {
+		frame_cache_t *cache = &cpus[i].frame_cache;
+
+		irq_spinlock_lock(&cache->lock, true);
+		for (unsigned int kind = 0; kind < FRAME_CACHE_KINDS; kind++)
+			freed += frame_cache_drain(cache, kind, FRAME_CACHE_SIZE);
+		irq_spinlock_unlock(&cache->lock, true);
+	}
+
+	return freed;
+}
+
+/** Refill a frame cache from the zones.
+ *
+ * A contiguous batch is preferred as it needs only one bitmap search.
+ * Under fragmentation, frames are allocated one by one.
+ *
+ * Assume interrupts are disabled and the frame cache is locked.
+ *
+ * @param cache  Frame cache.
+ * @param lowmem Only low memory frames may be allocated.
+ *
+ */
+_NO_TRACE static void frame_cache_refill(frame_cache_t *cache, bool lowmem)
+{
+	irq_spinlock_lock(&zones.lock, false);
+
+	size_t znum = try_find_zone(FRAME_CACHE_BATCH, lowmem, 0, 0);
+	if (znum != (size_t) -1) {
+		zone_t *zone = &zones.info[znum];
+		frame_cache_kind_t kind = frame_cache_kind(zone);
+		size_t count = min((size_t) FRAME_CACHE_BATCH,
+		    FRAME_CACHE_SIZE - cache->count[kind]);
+
+		if (count > 0) {
+			pfn_t pfn = zone->base + zone_frame_alloc(zone, count, 0);
+
+			/* Push in reverse so that the lowest frame is used first. */
+			for (size_t i = count; i > 0; i--)
+				cache->pfn[kind][cache->count[kind]++] = pfn + i - 1;
+		}
+	} else {
+		for (size_t i = 0; i < FRAME_CACHE_BATCH; i++) {
+			znum = try_find_zone(1, lowmem, 0, 0);
+			if (znum == (size_t) -1)
+				break;
+
+			zone_t *zone = &zones.info[znum];
+			frame_cache_kind_t kind = frame_cache_kind(zone);
+			if (cache->count[kind] == FRAME_CACHE_SIZE)
+				break;
+
+			cache->pfn[kind][cache->count[kind]++] = zone->base +
+			    zone_frame_alloc(zone, 1, 0);
+		}
+	}
+
+	irq_spinlock_unlock(&zones.lock, false);
+}
+
+/** Allocate a single frame from the frame cache of the current processor.
+ *
+ * @param lowmem Only a low memory frame may be allocated.
+ * @param pfn    Place to store the allocated frame.
+ * @param pzone  If not NULL, place to store the zone of the frame. The
+ *               original value is used as zone hint.
+ *
+ * @return True on success, false if the slow path must be taken.
+ *
+ */
+static bool frame_cache_alloc(bool lowmem, pfn_t *pfn, size_t *pzone)
+{
+	if (CPU == NULL)
+		return false;
+
+	frame_cache_kind_t kind = (lowmem || !highmem_present) ?
+	    FRAME_CACHE_LOWMEM : FRAME_CACHE_HIGHMEM;
+
+	ipl_t ipl = interrupts_disable();
+	frame_cache_t *cache = &CPU->frame_cache;
+	irq_spinlock_lock(&cache->lock, false);
+
+	bool hit = (cache->count[kind] > 0);
+	if (!hit) {
+		frame_cache_refill(cache, lowmem);
+
+		/* High memory requests may be satisfied from low memory. */
+		if ((cache->count[kind] == 0) && (!lowmem))
+			kind = FRAME_CACHE_LOWMEM;
+	}
+
+	bool ok = (cache->count[kind] > 0);
+	if (ok) {
+		*pfn = cache->pfn[kind][--cache->count[kind]];
+		if (pzone)
+			*pzone = find_zone(*pfn, 1, *pzone);
+		if (hit)
+			cache->hits++;
+		else
+			cache->misses++;
+	}
+
+	irq_spinlock_unlock(&cache->lock, false);
+	interrupts_restore(ipl);
+
+	return ok;
+}
+
+/** Release a reference to a single frame via the current processor's cache.
+ *
+ * If the last reference is dropped, the frame is kept in the frame cache
+ * instead of being returned to its zone.
+ *
+ * @param pfn   Frame to release.
+ * @param freed Place to store the number of frames which became free.
+ *
+ * @return True on success, false if the slow path must be taken.
+ *
+ */
+static bool frame_cache_free(pfn_t pfn, size_t *freed)
+{
+	/* Let the slow path wake up threads waiting for memory. */
+	if ((CPU == NULL) || (mem_avail_req > 0))
+		return false;
+
+	ipl_t ipl = interrupts_disable();
+	frame_cache_t *cache = &CPU->frame_cache;
+	irq_spinlock_lock(&cache->lock, false);
+
+	/* The zones cannot be rearranged while we hold the cache lock. */
+	size_t znum = find_zone(pfn, 1, 0);
+	assert(znum != (size_t) -1);
+
+	zone_t *zone = &zones.info[znum];
+	frame_t *frame = zone_get_frame(zone, pfn - zone->base);
+	frame_cache_kind_t kind = frame_cache_kind(zone);
+
+	size_t drained = 0;
+	if (cache->count[kind] == FRAME_CACHE_SIZE)
+		drained = frame_cache_drain(cache, kind, FRAME_CACHE_BATCH);
+
+	assert(atomic_load(&frame->refcount) > 0);
+
+	*freed = 0;
+	if (atomic_predec(&frame->refcount) == 0) {
+		/* The frame stays allocated on behalf of the cache. */
+		atomic_store(&frame->refcount, 1);
+		cache->pfn[kind][cache->count[kind]++] = pfn;
+		*freed = 1;
+	}
+
+	irq_spinlock_unlock(&cache->lock, false);
+	interrupts_restore(ipl);
+
+	if (drained > 0)
+		frame_avail_signal(drained);
+
+	return true;
+}
+
+/** Get the sum of frame cache statistics of all processors.
+ *
+ * @param hits   Place to store the number of allocations satisfied from
+ *               the frame caches.
+ * @param misses Place to store the number of allocations which had to
+ *               refill the frame caches.
+ *
+ */
+void frame_cache_stats(uint64_t *hits, uint64_t *misses)
+{
+	*hits = 0;
+	*misses = 0;
+
+	if (CPU == NULL)
+		return;
+
+	for (unsigned int i = 0; i < config.cpu_count; i++) {
+		frame_cache_t *cache = &cpus[i].frame_cache;
+
+		irq_spinlock_lock(&cache->lock, true);
+		*hits += cache->hits;
+		*misses += cache->misses;
+		irq_spinlock_unlock(&cache->lock, true);
+	}
+}
+
 /** Allocate frames of physical memory.
  *
  * @param count      Number of continuous frames to allocate.
@@ -854,24 +1171,48 @@ uintptr_t frame_alloc_generic(size_t count, frame_flags_t flags,
 	if (!(flags & FRAME_NO_RESERVE))
 		reserve_force_alloc(count);
 
-loop:
-	irq_spinlock_lock(&zones.lock, true);
-
 	// TODO: Print diagnostic if neither is explicitly specified.
 	bool lowmem = (flags & FRAME_LOWMEM) || !(flags & FRAME_HIGHMEM);
 
+	/*
+	 * Single unconstrained frames are served by the per-CPU frame caches.
+	 */
+	if ((count == 1) && (frame_constraint == 0)) {
+		pfn_t pfn;
+		if (frame_cache_alloc(lowmem, &pfn, pzone))
+			return PFN2ADDR(pfn);
+	}
+
+loop:
+	irq_spinlock_lock(&zones.lock, true);
+
 	/*
 	 * First, find suitable frame zone.
 	 */
 	size_t znum = try_find_zone(count, lowmem, frame_constraint, hint);
 
+	/*
+	 * If no memory, return the frames held by the frame caches.
+	 */
+	if (znum == (size_t) -1) {
+		irq_spinlock_unlock(&zones.lock, true);
+		size_t freed = frame_cache_drain_all();
+		irq_spinlock_lock(&zones.lock, true);
+
+		if (freed > 0)
+			znum = try_find_zone(count, lowmem,
+			    frame_constraint, hint);
+	}
+
 	/*
 	 * If no memory, reclaim some slab memory,
 	 * if it does not help, reclaim all.
+	 * Reclaimed frames may end up in the frame caches.
 	 */
 	if ((znum == (size_t) -1) && (!(flags & FRAME_NO_RECLAIM))) {
 		irq_spinlock_unlock(&zones.lock, true);
 		size_t freed = slab_reclaim(0);
+		freed += frame_cache_drain_all();
 		irq_spinlock_lock(&zones.lock, true);
 
 		if (freed > 0)
@@ -881,6 +1222,7 @@ loop:
 		if (znum == (size_t) -1) {
 			irq_spinlock_unlock(&zones.lock, true);
 			freed = slab_reclaim(SLAB_RECLAIM_ALL);
+			freed += frame_cache_drain_all();
 			irq_spinlock_lock(&zones.lock, true);
 
 			if (freed > 0)
@@ -976,6 +1318,12 @@ void frame_free_generic(uintptr_t start, size_t count, frame_flags_t flags)
 {
 	size_t freed = 0;
 
+	if ((count == 1) && frame_cache_free(ADDR2PFN(start), &freed)) {
+		if (!(flags & FRAME_NO_RESERVE))
+			reserve_free(freed);
+		return;
+	}
+
 	irq_spinlock_lock(&zones.lock, true);
 
 	for (size_t i = 0; i < count; i++) {
@@ -995,24 +1343,8 @@ void frame_free_generic(uintptr_t start, size_t count, frame_flags_t flags)
 
 	/*
 	 * Signal that some memory has been freed.
-	 * Since the mem_avail_mtx is an active mutex,
-	 * we need to disable interruptsto prevent deadlock
-	 * with TLB shootdown.
 	 */
-
-	ipl_t ipl = interrupts_disable();
-	mutex_lock(&mem_avail_mtx);
-
-	if (mem_avail_req > 0)
-		mem_avail_req -= min(mem_avail_req, freed);
-
-	if (mem_avail_req == 0) {
-		mem_avail_gen++;
-		condvar_broadcast(&mem_avail_cv);
-	}
-
-	mutex_unlock(&mem_avail_mtx);
-	interrupts_restore(ipl);
+	frame_avail_signal(freed);
 
 	if (!(flags & FRAME_NO_RESERVE))
 		reserve_free(freed);
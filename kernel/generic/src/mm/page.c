@@ -109,6 +109,45 @@ _NO_TRACE void page_mapping_insert(as_t *as, uintptr_t page, uintptr_t frame,
 	memory_barrier();
 }
 
+/** Insert mapping of a large page to a block of frames.
+ *
+ * The mapping is only created if the whole large page is unmapped so far.
+ * Individual base pages of the large page can be looked up, removed or
+ * remapped as usual; the large mapping is split into base page mappings
+ * first.
+ *
+ * @param as    Address space to which page belongs.
+ * @param page  Virtual address of the large page, aligned to LARGE_PAGE_SIZE.
+ * @param frame Physical address of the first frame, aligned to
+ *              LARGE_PAGE_SIZE.
+ * @param flags Flags to be used for mapping.
+ *
+ * @return True if the large page was mapped, false if the architecture does
+ *         not support large pages or part of the range is already mapped.
+ *
+ */
+_NO_TRACE bool page_mapping_insert_large(as_t *as, uintptr_t page,
+    uintptr_t frame, unsigned int flags)
+{
+	assert(page_table_locked(as));
+
+	assert(page_mapping_operations);
+
+	if (!page_mapping_operations->mapping_insert_large)
+		return false;
+
+	assert(IS_ALIGNED(page, LARGE_PAGE_SIZE));
+	assert(IS_ALIGNED(frame, LARGE_PAGE_SIZE));
+
+	if (!page_mapping_operations->mapping_insert_large(as, page, frame,
+	    flags))
+		return false;
+
+	/* Repel prefetched accesses to the old mapping. */
+	memory_barrier();
+	return true;
+}
+
 /** Remove mapping of page.
  *
  * Remove any mapping of page within address space as.
@@ -133,6 +172,56 @@ _NO_TRACE void page_mapping_remove(as_t *as, uintptr_t page)
 	memory_barrier();
 }
 
+/** Remove mapping of a large page.
+ *
+ * TLB shootdown should follow in order to make effects of
+ * this call visible.
+ *
+ * @param as   Address space to which page belongs.
+ * @param page Virtual address of the large page to be demapped.
+ *
+ * @return True if the large page mapping was removed, false if page is not
+ *         mapped by a large page.
+ *
+ */
+_NO_TRACE bool page_mapping_remove_large(as_t *as, uintptr_t page)
+{
+	assert(page_table_locked(as));
+
+	assert(page_mapping_operations);
+
+	if (!page_mapping_operations->mapping_remove_large)
+		return false;
+
+	if (!page_mapping_operations->mapping_remove_large(as, page))
+		return false;
+
+	/* Repel prefetched accesses to the old mapping. */
+	memory_barrier();
+	return true;
+}
+
+/** Split a large page mapping covering a page into base page mappings.
+ *
+ * The translation does not change, so no TLB shootdown is needed. Removing
+ * only a part of a large page must be preceded by this call outside of the
+ * TLB shootdown sequence, as it may need to allocate memory.
+ *
+ * @param as   Address space to which page belongs.
+ * @param page Virtual address of a page.
+ *
+ */
+_NO_TRACE void page_mapping_split(as_t *as, uintptr_t page)
+{
+	assert(page_table_locked(as));
+
+	assert(page_mapping_operations);
+
+	if (page_mapping_operations->mapping_split)
+		page_mapping_operations->mapping_split(as,
+		    ALIGN_DOWN(page, PAGE_SIZE));
+}
+
 /** Find mapping for virtual page.
  *
  * @param as       Address space to which page belongs.
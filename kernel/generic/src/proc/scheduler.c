@@ -40,12 +40,14 @@
 
 #include <assert.h>
 #include <atomic.h>
+#include <bitops.h>
 #include <proc/scheduler.h>
 #include <proc/thread.h>
 #include <proc/task.h>
 #include <mm/frame.h>
 #include <mm/page.h>
 #include <mm/as.h>
+#include <time/clock.h>
 #include <time/timeout.h>
 #include <time/delay.h>
 #include <arch/asm.h>
@@ -172,6 +174,122 @@ void scheduler_init(void)
 {
 }
 
+#ifdef CONFIG_SMP
+/** Steal a thread from a ready queue of another CPU
+ *
+ * Search the queue from the back for a thread which is allowed
+ * to migrate and remove it from the queue.
+ *
+ * @param cpu CPU to steal from.
+ * @param rq  Index of the ready queue of @a cpu.
+ *
+ * @return Stolen thread to be readied on the current CPU or NULL.
+ *
+ */
+static thread_t *steal_thread(cpu_t *cpu, int rq)
+{
+	if (!(atomic_load(&cpu->rq_ready) & (1U << rq)))
+		return NULL;
+
+	irq_spinlock_lock(&(cpu->rq[rq].lock), true);
+
+	/* Search rq from the back */
+	link_t *link = cpu->rq[rq].rq.head.prev;
+
+	while (link != &(cpu->rq[rq].rq.head)) {
+		thread_t *thread = (thread_t *) list_get_instance(link,
+		    thread_t, rq_link);
+
+		/*
+		 * Do not steal CPU-wired threads, threads
+		 * already stolen, threads for which migration
+		 * was temporarily disabled or threads whose
+		 * FPU context is still in the CPU.
+		 */
+		irq_spinlock_lock(&thread->lock, false);
+
+		if ((!thread->wired) && (!thread->stolen) &&
+		    (!thread->nomigrate) &&
+		    (!thread->fpu_context_engaged)) {
+			/*
+			 * Remove thread from ready queue.
+			 */
+			irq_spinlock_unlock(&thread->lock, false);
+
+			atomic_dec(&cpu->nrdy);
+			atomic_dec(&nrdy);
+
+			if (--cpu->rq[rq].n == 0)
+				atomic_fetch_and(&cpu->rq_ready, ~(1U << rq));
+			list_remove(&thread->rq_link);
+
+			irq_spinlock_pass(&(cpu->rq[rq].lock),
+			    &thread->lock);
+
+			thread->stolen = true;
+			thread->state = Entering;
+
+			irq_spinlock_unlock(&thread->lock, true);
+			return thread;
+		}
+
+		irq_spinlock_unlock(&thread->lock, false);
+		link = link->prev;
+	}
+
+	irq_spinlock_unlock(&(cpu->rq[rq].lock), true);
+	return NULL;
+}
+
+/** Pull a ready thread to the current CPU which is about to go idle
+ *
+ * Steal from the CPU with the most threads waiting for it, starting
+ * with its lowest-priority queue, just like kcpulb() does.
+ *
+ * @return True if a thread has been readied on the current CPU.
+ *
+ */
+static bool idle_pull(void)
+{
+	cpu_t *busiest = NULL;
+	size_t busiest_rdy = 0;
+
+	for (size_t i = 0; i < config.cpu_active; i++) {
+		cpu_t *cpu = &cpus[i];
+
+		/*
+		 * An idle CPU is about to run its ready threads on its own.
+		 */
+		if ((cpu == CPU) || (cpu->idle))
+			continue;
+
+		size_t rdy = atomic_load(&cpu->nrdy);
+		if (rdy > busiest_rdy) {
+			busiest = cpu;
+			busiest_rdy = rdy;
+		}
+	}
+
+	if (busiest == NULL)
+		return false;
+
+	unsigned int ready = atomic_load(&busiest->rq_ready);
+	while (ready != 0) {
+		int rq = fnzb32(ready);
+
+		thread_t *thread = steal_thread(busiest, rq);
+		if (thread != NULL) {
+			thread_ready(thread);
+			return true;
+		}
+
+		ready &= ~(1U << rq);
+	}
+
+	return false;
+}
+#endif /* CONFIG_SMP */
+
 /** Get thread to be scheduled
  *
  * Get the optimal thread to be scheduled
@@ -188,6 +306,15 @@ static thread_t *find_best_thread(void)
 loop:
 
 	if (atomic_load(&CPU->nrdy) == 0) {
+#ifdef CONFIG_SMP
+		/*
+		 * Rather than waiting for kcpulb to balance the load,
+		 * take over a thread waiting on another CPU right away.
+		 */
+		if (idle_pull())
+			goto loop;
+#endif
+
 		/*
 		 * For there was nothing to run, the CPU goes to sleep
 		 * until a hardware interrupt or an IPI comes.
@@ -196,6 +323,11 @@ loop:
 		irq_spinlock_lock(&CPU->lock, false);
 		CPU->idle = true;
 		irq_spinlock_unlock(&CPU->lock, false);
+
+		/*
+		 * Do not wake up for clock ticks in which nothing expires.
+		 */
+		clock_idle_enter();
 		interrupts_enable();
 
 		/*
@@ -205,25 +337,32 @@ loop:
 		 */
 		cpu_sleep();
 		interrupts_disable();
+		clock_idle_exit();
 		goto loop;
 	}
 
 	assert(!CPU->idle);
 
-	unsigned int i;
-	for (i = 0; i < RQ_COUNT; i++) {
+	/*
+	 * The bitmap points directly at the highest-priority non-empty
+	 * queue. A queue can be emptied by kcpulb between reading the
+	 * bitmap and taking the lock, in which case try the next one.
+	 */
+	unsigned int ready = atomic_load(&CPU->rq_ready);
+	while (ready != 0) {
+		unsigned int i = fnzb32(ready & -ready);
+
 		irq_spinlock_lock(&(CPU->rq[i].lock), false);
 		if (CPU->rq[i].n == 0) {
-			/*
-			 * If this queue is empty, try a lower-priority queue.
-			 */
 			irq_spinlock_unlock(&(CPU->rq[i].lock), false);
+			ready &= ~(1U << i);
 			continue;
 		}
 
 		atomic_dec(&CPU->nrdy);
 		atomic_dec(&nrdy);
-		CPU->rq[i].n--;
+		if (--CPU->rq[i].n == 0)
+			atomic_fetch_and(&CPU->rq_ready, ~(1U << i));
 
 		/*
 		 * Take the first thread from the queue.
@@ -272,12 +411,17 @@ static void relink_rq(int start)
 	if (CPU->needs_relink > NEEDS_RELINK_MAX) {
 		int i;
 		for (i = start; i < RQ_COUNT - 1; i++) {
+			/* Nothing to do for an empty rq[i + 1] */
+			if (!(atomic_load(&CPU->rq_ready) & (1U << (i + 1))))
+				continue;
+
 			/* Remember and empty rq[i + 1] */
 
 			irq_spinlock_lock(&CPU->rq[i + 1].lock, false);
 			list_concat(&list, &CPU->rq[i + 1].rq);
 			size_t n = CPU->rq[i + 1].n;
 			CPU->rq[i + 1].n = 0;
+			atomic_fetch_and(&CPU->rq_ready, ~(1U << (i + 1)));
 			irq_spinlock_unlock(&CPU->rq[i + 1].lock, false);
 
 			/* Append rq[i + 1] to rq[i] */
@@ -285,6 +429,8 @@ static void relink_rq(int start)
 			irq_spinlock_lock(&CPU->rq[i].lock, false);
 			list_concat(&CPU->rq[i].rq, &list);
 			CPU->rq[i].n += n;
+			if (CPU->rq[i].n != 0)
+				atomic_fetch_or(&CPU->rq_ready, 1U << i);
 			irq_spinlock_unlock(&CPU->rq[i].lock, false);
 		}
 
@@ -468,6 +614,7 @@ void scheduler_separated_stack(void)
 		THREAD = NULL;
 	}
 
+	atomic_store_explicit(&CPU->running, NULL, memory_order_relaxed);
 	THREAD = find_best_thread();
 
 	irq_spinlock_lock(&THREAD->lock, false);
@@ -507,6 +654,7 @@ void scheduler_separated_stack(void)
 
 	irq_spinlock_lock(&THREAD->lock, false);
 	THREAD->state = Running;
+	atomic_store_explicit(&CPU->running, THREAD, memory_order_relaxed);
 
 #ifdef SCHEDULER_VERBOSE
 	log(LF_OTHER, LVL_DEBUG,
@@ -600,61 +748,8 @@ not_satisfied:
 			if (atomic_load(&cpu->nrdy) <= average)
 				continue;
 
-			irq_spinlock_lock(&(cpu->rq[rq].lock), true);
-			if (cpu->rq[rq].n == 0) {
-				irq_spinlock_unlock(&(cpu->rq[rq].lock), true);
-				continue;
-			}
-
-			thread_t *thread = NULL;
-
-			/* Search rq from the back */
-			link_t *link = cpu->rq[rq].rq.head.prev;
-
-			while (link != &(cpu->rq[rq].rq.head)) {
-				thread = (thread_t *) list_get_instance(link,
-				    thread_t, rq_link);
-
-				/*
-				 * Do not steal CPU-wired threads, threads
-				 * already stolen, threads for which migration
-				 * was temporarily disabled or threads whose
-				 * FPU context is still in the CPU.
-				 */
-				irq_spinlock_lock(&thread->lock, false);
-
-				if ((!thread->wired) && (!thread->stolen) &&
-				    (!thread->nomigrate) &&
-				    (!thread->fpu_context_engaged)) {
-					/*
-					 * Remove thread from ready queue.
-					 */
-					irq_spinlock_unlock(&thread->lock,
-					    false);
-
-					atomic_dec(&cpu->nrdy);
-					atomic_dec(&nrdy);
-
-					cpu->rq[rq].n--;
-					list_remove(&thread->rq_link);
-
-					break;
-				}
-
-				irq_spinlock_unlock(&thread->lock, false);
-
-				link = link->prev;
-				thread = NULL;
-			}
-
+			thread_t *thread = steal_thread(cpu, rq);
 			if (thread) {
-				/*
-				 * Ready thread on local CPU
-				 */
-
-				irq_spinlock_pass(&(cpu->rq[rq].lock),
-				    &thread->lock);
-
 #ifdef KCPULB_VERBOSE
 				log(LF_OTHER, LVL_DEBUG,
 				    "kcpulb%u: TID %" PRIu64 " -> cpu%u, "
@@ -663,10 +758,9 @@ not_satisfied:
 				    atomic_load(&nrdy) / config.cpu_active);
 #endif
 
-				thread->stolen = true;
-				thread->state = Entering;
-
-				irq_spinlock_unlock(&thread->lock, true);
+				/*
+				 * Ready thread on local CPU
+				 */
 				thread_ready(thread);
 
 				if (--count == 0)
@@ -678,11 +772,7 @@ not_satisfied:
 				 *
 				 */
 				acpu_bias++;
-
-				continue;
-			} else
-				irq_spinlock_unlock(&(cpu->rq[rq].lock), true);
-
+			}
 		}
 	}
 
@@ -720,9 +810,10 @@ void sched_print_list(void)
 
 		irq_spinlock_lock(&cpus[cpu].lock, true);
 
-		printf("cpu%u: address=%p, nrdy=%zu, needs_relink=%zu\n",
-		    cpus[cpu].id, &cpus[cpu], atomic_load(&cpus[cpu].nrdy),
-		    cpus[cpu].needs_relink);
+		printf("cpu%u: address=%p, nrdy=%zu, rq_ready=%#x, "
+		    "needs_relink=%zu\n", cpus[cpu].id, &cpus[cpu],
+		    atomic_load(&cpus[cpu].nrdy),
+		    atomic_load(&cpus[cpu].rq_ready), cpus[cpu].needs_relink);
 
 		unsigned int i;
 		for (i = 0; i < RQ_COUNT; i++) {
@@ -284,6 +284,12 @@ void task_destroy(task_t *task)
 	 */
 	as_release(task->as);
 
+	/*
+	 * Release the calls and capabilities kept for reuse.
+	 */
+	ipc_answerbox_drain(&task->answerbox);
+	caps_task_drain(task);
+
 	slab_free(task_cache, task);
 }
 
@@ -300,6 +300,17 @@ void thread_ready(thread_t *thread)
 		/* Prefer the CPU on which the thread ran last */
 		assert(thread->cpu != NULL);
 		cpu = thread->cpu;
+
+		/*
+		 * Unless that CPU has more work queued than the waking one.
+		 * The cache of the waker is likely to hold the data the thread
+		 * is being woken up to consume, so the thread does not lose much
+		 * by moving there, while it would have to wait in the queue of
+		 * its previous CPU.
+		 */
+		if ((cpu != CPU) &&
+		    (atomic_load(&cpu->nrdy) > atomic_load(&CPU->nrdy)))
+			cpu = CPU;
 	} else {
 		cpu = CPU;
 	}
@@ -314,11 +325,14 @@ void thread_ready(thread_t *thread)
 	 */
 
 	list_append(&thread->rq_link, &cpu->rq[i].rq);
-	cpu->rq[i].n++;
+	if (cpu->rq[i].n++ == 0)
+		atomic_fetch_or(&cpu->rq_ready, 1U << i);
 	irq_spinlock_unlock(&(cpu->rq[i].lock), true);
 
 	atomic_inc(&nrdy);
 	atomic_inc(&cpu->nrdy);
+
+	clock_idle_kick(cpu);
 }
 
 /** Create new thread
@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup kernel_sync
+ * @{
+ */
+
+/**
+ * @file
+ * @brief Lock contention statistics.
+ *
+ * Locks are grouped into classes. All spinlocks with the same name form one
+ * class, all mutexes initialized at the same place in the code form another.
+ * Each CPU counts the acquisitions, the contended acquisitions and the
+ * cycles spent waiting for the locks of each class. The counters are summed
+ * up only when the statistics are read through sysinfo.
+ *
+ * The class table is protected by a bare atomic flag, as the statistics
+ * are collected from within the spinlock implementation itself.
+ */
+
+#include <synch/lockstat.h>
+#include <stdatomic.h>
+#include <arch.h>
+#include <config.h>
+#include <cpu.h>
+#include <preemption.h>
+#include <errno.h>
+#include <str.h>
+#include <symtab.h>
+#include <arch/asm.h>
+#include <arch/cycle.h>
+
+#ifdef CONFIG_LOCK_STATS
+
+/** Size of the hash table used to look up lock classes. */
+#define LOCK_CLASS_HASH  (2 * LOCK_CLASS_MAX)
+
+typedef struct {
+	/** Name of a spinlock class or initialization site of a mutex class. */
+	const void *key;
+	bool mutex;
+} lock_class_t;
+
+static lock_class_t lock_classes[LOCK_CLASS_MAX] = {
+	[LOCK_CLASS_OTHER] = {
+		.key = "(other)",
+		.mutex = false
+	}
+};
+
+/** Hash table of lock class numbers, zero denotes an empty slot. */
+static uint16_t lock_class_hash[LOCK_CLASS_HASH];
+
+static unsigned int lock_class_count = LOCK_CLASS_OTHER + 1;
+static atomic_flag lock_classes_lock = ATOMIC_FLAG_INIT;
+
+static size_t lock_class_key_hash(const void *key, bool mutex)
+{
+	if (mutex)
+		return ((uintptr_t) key >> 2) % LOCK_CLASS_HASH;
+
+	size_t hash = 5381;
+	for (const char *c = key; *c != 0; c++)
+		hash = hash * 33 + (unsigned char) *c;
+
+	return hash % LOCK_CLASS_HASH;
+}
+
+static bool lock_class_key_equal(lock_class_t *cls, const void *key,
+    bool mutex)
+{
+	if (cls->mutex != mutex)
+		return false;
+
+	if (mutex)
+		return cls->key == key;
+
+	return (cls->key == key) || (str_cmp(cls->key, key) == 0);
+}
+
+/** Find or create a lock class
+ *
+ * @param key    Name of a spinlock or initialization site of a mutex.
+ * @param mutex  True if the class is a class of mutexes.
+ *
+ * @return Lock class number.
+ *
+ */
+unsigned int lock_class_get(const void *key, bool mutex)
+{
+	if (key == NULL)
+		return LOCK_CLASS_OTHER;
+
+	unsigned int cls = LOCK_CLASS_OTHER;
+	size_t slot = lock_class_key_hash(key, mutex);
+
+	ipl_t ipl = interrupts_disable();
+	while (atomic_flag_test_and_set_explicit(&lock_classes_lock,
+	    memory_order_acquire))
+		;
+
+	for (size_t i = 0; i < LOCK_CLASS_HASH; i++) {
+		unsigned int cur = lock_class_hash[slot];
+		if (cur == 0) {
+			if (lock_class_count < LOCK_CLASS_MAX) {
+				cls = lock_class_count++;
+				lock_classes[cls].key = key;
+				lock_classes[cls].mutex = mutex;
+				lock_class_hash[slot] = cls;
+			}
+			break;
+		}
+
+		if (lock_class_key_equal(&lock_classes[cur], key, mutex)) {
+			cls = cur;
+			break;
+		}
+
+		slot = (slot + 1) % LOCK_CLASS_HASH;
+	}
+
+	atomic_flag_clear_explicit(&lock_classes_lock, memory_order_release);
+	interrupts_restore(ipl);
+
+	return cls;
+}
+
+/** Note the beginning of a wait for a contended lock
+ *
+ * @return Non-zero timestamp to pass to lock_class_acquired().
+ *
+ */
+uint64_t lock_class_contended(void)
+{
+	uint64_t start = get_cycle();
+	return (start != 0) ? start : 1;
+}
+
+/** Account for an acquisition of a lock
+ *
+ * @param cls    Lock class number.
+ * @param start  Value returned by lock_class_contended() when the lock
+ *               was found contended, zero if it was not contended.
+ *
+ */
+void lock_class_acquired(unsigned int cls, uint64_t start)
+{
+	uint64_t wait = 0;
+	if (start != 0) {
+		wait = get_cycle() - start;
+		if (wait == 0)
+			wait = 1;
+	}
+
+	preemption_disable();
+
+	if (CPU != NULL) {
+		lockstat_t *stat = &CPU->lockstats[cls];
+
+		stat->acquisitions++;
+		if (wait > 0) {
+			stat->contentions++;
+			stat->wait_cycles += wait;
+			if (wait > stat->max_wait_cycles)
+				stat->max_wait_cycles = wait;
+		}
+	}
+
+	preemption_enable();
+}
+
+/** Summarize the statistics of a lock class
+ *
+ * The per-CPU counters are read without synchronization, so the result is
+ * only approximate while the locks are in use. The class table lock must
+ * be held.
+ *
+ * @param cls   Lock class number.
+ * @param stat  Statistics to fill.
+ *
+ */
+static void lock_class_produce(unsigned int cls, stats_lock_t *stat)
+{
+	lock_class_t *lc = &lock_classes[cls];
+
+	stat->id = cls;
+	stat->mutex = lc->mutex;
+	stat->acquisitions = 0;
+	stat->contentions = 0;
+	stat->wait_cycles = 0;
+	stat->max_wait_cycles = 0;
+
+	const char *name = lc->key;
+	if (lc->mutex) {
+		uintptr_t offset;
+		if (symtab_name_lookup((uintptr_t) lc->key, &name,
+		    &offset) != EOK)
+			name = "(mutex)";
+	}
+	str_cpy(stat->name, LOCK_NAME_BUFLEN, name);
+
+	for (unsigned int i = 0; i < config.cpu_count; i++) {
+		lockstat_t *cpu_stat = &cpus[i].lockstats[cls];
+
+		stat->acquisitions += cpu_stat->acquisitions;
+		stat->contentions += cpu_stat->contentions;
+		stat->wait_cycles += cpu_stat->wait_cycles;
+		if (cpu_stat->max_wait_cycles > stat->max_wait_cycles)
+			stat->max_wait_cycles = cpu_stat->max_wait_cycles;
+	}
+}
+
+/** Collect the statistics of all lock classes
+ *
+ * @param stats  Array to fill.
+ * @param count  Number of items of the array.
+ *
+ * @return Number of filled items.
+ *
+ */
+size_t lock_class_stats(stats_lock_t *stats, size_t count)
+{
+	size_t n = 0;
+
+	ipl_t ipl = interrupts_disable();
+	while (atomic_flag_test_and_set_explicit(&lock_classes_lock,
+	    memory_order_acquire))
+		;
+
+	for (unsigned int cls = LOCK_CLASS_OTHER;
+	    (cls < lock_class_count) && (n < count); cls++)
+		lock_class_produce(cls, &stats[n++]);
+
+	atomic_flag_clear_explicit(&lock_classes_lock, memory_order_release);
+	interrupts_restore(ipl);
+
+	return n;
+}
+
+/** Collect the statistics of one lock class
+ *
+ * @param cls   Lock class number.
+ * @param stat  Statistics to fill.
+ *
+ * @return True if the lock class exists.
+ *
+ */
+bool lock_class_stat(unsigned int cls, stats_lock_t *stat)
+{
+	bool found = false;
+
+	ipl_t ipl = interrupts_disable();
+	while (atomic_flag_test_and_set_explicit(&lock_classes_lock,
+	    memory_order_acquire))
+		;
+
+	if ((cls >= LOCK_CLASS_OTHER) && (cls < lock_class_count)) {
+		lock_class_produce(cls, stat);
+		found = true;
+	}
+
+	atomic_flag_clear_explicit(&lock_classes_lock, memory_order_release);
+	interrupts_restore(ipl);
+
+	return found;
+}
+
+#endif /* CONFIG_LOCK_STATS */
+
+/** @}
+ */
@@ -42,7 +42,9 @@
 #include <arch.h>
 #include <stacktrace.h>
 #include <cpu.h>
+#include <debug.h>
 #include <proc/thread.h>
+#include <synch/lockstat.h>
 
 /** Initialize mutex.
  *
@@ -52,9 +54,13 @@
 void mutex_initialize(mutex_t *mtx, mutex_type_t type)
 {
 	mtx->type = type;
-	mtx->owner = NULL;
+	atomic_init(&mtx->owner, NULL);
+	atomic_init(&mtx->owner_cpu, NULL);
 	mtx->nesting = 0;
 	semaphore_initialize(&mtx->sem, 1);
+#ifdef CONFIG_LOCK_STATS
+	mtx->lock_class = lock_class_get((void *) CALLER, true);
+#endif
 }
 
 /** Find out whether the mutex is currently locked.
@@ -70,6 +76,93 @@ bool mutex_locked(mutex_t *mtx)
 
 #define MUTEX_DEADLOCK_THRESHOLD	100000000
 
+/** Maximum number of polls of a contended mutex before going to sleep. */
+#define MUTEX_SPIN_MAX	1000
+
+/** Number of contended acquisitions which succeeded while spinning. */
+static atomic_size_t mutex_spin_acquires = 0;
+/** Number of contended acquisitions which fell back to sleeping. */
+static atomic_size_t mutex_sleeps = 0;
+
+/** Spin on a contended mutex while its owner is running
+ *
+ * The owner may exit and its thread structure may be freed at any time,
+ * so it is never dereferenced. Instead, the owner is looked for on the
+ * CPU on which it acquired the mutex. Should the owner have migrated
+ * since, the caller just goes to sleep.
+ *
+ * @param mtx  Mutex.
+ *
+ * @return True if the mutex was acquired.
+ *
+ */
+static bool mutex_spin(mutex_t *mtx)
+{
+#ifdef CONFIG_SMP
+	for (unsigned int i = 0; i < MUTEX_SPIN_MAX; i++) {
+		thread_t *owner = atomic_load_explicit(&mtx->owner,
+		    memory_order_relaxed);
+		cpu_t *cpu = atomic_load_explicit(&mtx->owner_cpu,
+		    memory_order_relaxed);
+
+		if (owner == NULL) {
+			/* Released, or the owner is just being recorded */
+			if (semaphore_trydown(&mtx->sem) == EOK)
+				return true;
+		} else if ((owner == THREAD) || (cpu == NULL) ||
+		    (atomic_load_explicit(&cpu->running,
+		    memory_order_relaxed) != owner)) {
+			break;
+		}
+
+		cpu_spin_hint();
+	}
+#endif
+
+	return false;
+}
+
+/** Acquire a contended mutex, spinning first while the owner is running
+ *
+ * @param mtx    Mutex.
+ * @param usec   Timeout in microseconds.
+ * @param flags  Specify mode of operation.
+ *
+ * @return See comment for waitq_sleep_timeout().
+ *
+ */
+static errno_t mutex_acquire(mutex_t *mtx, uint32_t usec, unsigned int flags)
+{
+	errno_t rc;
+#ifdef CONFIG_LOCK_STATS
+	uint64_t start = 0;
+#endif
+
+	if (flags & SYNCH_FLAGS_NON_BLOCKING) {
+		rc = _semaphore_down_timeout(&mtx->sem, usec, flags);
+	} else if (semaphore_trydown(&mtx->sem) == EOK) {
+		rc = EOK;
+	} else {
+#ifdef CONFIG_LOCK_STATS
+		start = lock_class_contended();
+#endif
+		if (mutex_spin(mtx)) {
+			atomic_inc(&mutex_spin_acquires);
+			rc = EOK;
+		} else {
+			atomic_inc(&mutex_sleeps);
+			rc = _semaphore_down_timeout(&mtx->sem, usec, flags);
+		}
+	}
+
+#ifdef CONFIG_LOCK_STATS
+	if (rc == EOK)
+		lock_class_acquired(mtx->lock_class, start);
+#endif
+
+	return rc;
+}
+
 /** Acquire mutex.
  *
  * Timeout mode and non-blocking mode can be requested.
@@ -89,17 +182,27 @@ errno_t _mutex_lock_timeout(mutex_t *mtx, uint32_t usec, unsigned int flags)
 	errno_t rc;
 
 	if (mtx->type == MUTEX_PASSIVE && THREAD) {
-		rc = _semaphore_down_timeout(&mtx->sem, usec, flags);
+		rc = mutex_acquire(mtx, usec, flags);
+		if (rc == EOK) {
+			atomic_store_explicit(&mtx->owner_cpu, CPU,
+			    memory_order_relaxed);
+			atomic_store_explicit(&mtx->owner, THREAD,
+			    memory_order_relaxed);
+		}
 	} else if (mtx->type == MUTEX_RECURSIVE) {
 		assert(THREAD);
 
-		if (mtx->owner == THREAD) {
+		if (atomic_load_explicit(&mtx->owner, memory_order_relaxed) ==
+		    THREAD) {
 			mtx->nesting++;
 			return EOK;
 		} else {
-			rc = _semaphore_down_timeout(&mtx->sem, usec, flags);
+			rc = mutex_acquire(mtx, usec, flags);
 			if (rc == EOK) {
-				mtx->owner = THREAD;
+				atomic_store_explicit(&mtx->owner_cpu, CPU,
+				    memory_order_relaxed);
+				atomic_store_explicit(&mtx->owner, THREAD,
+				    memory_order_relaxed);
 				mtx->nesting = 1;
 			}
 		}
@@ -134,13 +237,27 @@ errno_t _mutex_lock_timeout(mutex_t *mtx, uint32_t usec, unsigned int flags)
 void mutex_unlock(mutex_t *mtx)
 {
 	if (mtx->type == MUTEX_RECURSIVE) {
-		assert(mtx->owner == THREAD);
+		assert(atomic_load_explicit(&mtx->owner, memory_order_relaxed) ==
+		    THREAD);
 		if (--mtx->nesting > 0)
 			return;
-		mtx->owner = NULL;
 	}
+	atomic_store_explicit(&mtx->owner, NULL, memory_order_relaxed);
 	semaphore_up(&mtx->sem);
 }
 
+/** Get the statistics of contended mutex acquisitions.
+ *
+ * @param spins   Place to store the number of acquisitions which succeeded
+ *                while spinning.
+ * @param sleeps  Place to store the number of acquisitions which fell back
+ *                to sleeping.
+ */
+void mutex_stats(uint64_t *spins, uint64_t *sleeps)
+{
+	*spins = atomic_load(&mutex_spin_acquires);
+	*sleeps = atomic_load(&mutex_sleeps);
+}
+
 /** @}
  */
@@ -45,6 +45,7 @@
 #include <symtab.h>
 #include <stacktrace.h>
 #include <cpu.h>
+#include <synch/lockstat.h>
 
 #ifdef CONFIG_SMP
 
@@ -56,29 +57,71 @@
 void spinlock_initialize(spinlock_t *lock, const char *name)
 {
 	atomic_flag_clear_explicit(&lock->flag, memory_order_relaxed);
-#ifdef CONFIG_DEBUG_SPINLOCK
+#ifdef SPINLOCK_NAMED
 	lock->name = name;
 #endif
+#ifdef CONFIG_LOCK_STATS
+	atomic_store_explicit(&lock->lock_class, LOCK_CLASS_NONE,
+	    memory_order_relaxed);
+#endif
 }
 
-#ifdef CONFIG_DEBUG_SPINLOCK
+#ifdef CONFIG_LOCK_STATS
+
+/** Account for an acquisition of a spinlock
+ *
+ * @param lock   Spinlock which was acquired.
+ * @param start  Start of the wait for the lock, zero if the lock was not
+ *               contended.
+ *
+ */
+static void spinlock_account(spinlock_t *lock, uint64_t start)
+{
+	unsigned int cls = atomic_load_explicit(&lock->lock_class,
+	    memory_order_relaxed);
+	if (cls == LOCK_CLASS_NONE) {
+		cls = lock_class_get(lock->name, false);
+		atomic_store_explicit(&lock->lock_class, cls,
+		    memory_order_relaxed);
+	}
+
+	lock_class_acquired(cls, start);
+}
+
+#endif
+
+#ifdef SPINLOCK_NAMED
 
 /** Lock spinlock
  *
  * Lock spinlock.
  * This version has limitted ability to report
- * possible occurence of deadlock.
+ * possible occurence of deadlock and collects
+ * contention statistics if configured.
  *
  * @param lock Pointer to spinlock_t structure.
  *
  */
 void spinlock_lock_debug(spinlock_t *lock)
 {
+#ifdef CONFIG_DEBUG_SPINLOCK
 	size_t i = 0;
 	bool deadlock_reported = false;
+#endif
+#ifdef CONFIG_LOCK_STATS
+	uint64_t start = 0;
+#endif
 
 	preemption_disable();
 	while (atomic_flag_test_and_set_explicit(&lock->flag, memory_order_acquire)) {
+		cpu_spin_hint();
+
+#ifdef CONFIG_LOCK_STATS
+		if (start == 0)
+			start = lock_class_contended();
+#endif
+
+#ifdef CONFIG_DEBUG_SPINLOCK
 		/*
 		 * We need to be careful about particular locks
 		 * which are directly used to report deadlocks
@@ -110,10 +153,17 @@ void spinlock_lock_debug(spinlock_t *lock)
 			i = 0;
 			deadlock_reported = true;
 		}
+#endif
 	}
 
+#ifdef CONFIG_DEBUG_SPINLOCK
 	if (deadlock_reported)
 		printf("cpu%u: not deadlocked\n", CPU->id);
+#endif
+
+#ifdef CONFIG_LOCK_STATS
+	spinlock_account(lock, start);
+#endif
 }
 
 /** Unlock spinlock
@@ -149,6 +199,10 @@ bool spinlock_trylock(spinlock_t *lock)
 
 	if (!ret)
 		preemption_enable();
+#ifdef CONFIG_LOCK_STATS
+	else
+		spinlock_account(lock, 0);
+#endif
 
 	return ret;
 }
@@ -47,6 +47,11 @@
 
 static slab_cache_t *waitq_cache;
 
+/** Number of futex sleeps which actually blocked the thread. */
+static atomic_size_t waitq_sleeps = 0;
+/** Number of futex sleeps satisfied by a pending wakeup. */
+static atomic_size_t waitq_nosleeps = 0;
+
 static void waitq_destroy(void *arg)
 {
 	waitq_t *wq = (waitq_t *) arg;
@@ -158,8 +163,14 @@ sys_errno_t sys_waitq_sleep(cap_waitq_handle_t whandle, uint32_t timeout,
 	udebug_stoppable_begin();
 #endif
 
+	bool blocked;
 	errno_t rc = waitq_sleep_timeout(kobj->waitq, timeout,
-	    SYNCH_FLAGS_INTERRUPTIBLE | flags, NULL);
+	    SYNCH_FLAGS_INTERRUPTIBLE | flags, &blocked);
+
+	if (blocked)
+		atomic_inc(&waitq_sleeps);
+	else
+		atomic_inc(&waitq_nosleeps);
 
 #ifdef CONFIG_UDEBUG
 	udebug_stoppable_end();
@@ -170,6 +181,18 @@ sys_errno_t sys_waitq_sleep(cap_waitq_handle_t whandle, uint32_t timeout,
 	return (sys_errno_t) rc;
 }
 
+/** Get the statistics of userspace wait queue sleeps
+ *
+ * @param sleeps    Place to store the number of sleeps which blocked.
+ * @param nosleeps  Place to store the number of sleeps which returned
+ *                  without blocking.
+ */
+void sys_waitq_stats(uint64_t *sleeps, uint64_t *nosleeps)
+{
+	*sleeps = atomic_load(&waitq_sleeps);
+	*nosleeps = atomic_load(&waitq_nosleeps);
+}
+
 /** Wakeup a thread sleeping in the waitq
  *
  * @param whandle  Waitq capability handle of the waitq to invoke wakeup on.
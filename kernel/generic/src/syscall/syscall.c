@@ -85,6 +85,7 @@ static syshandler_t syscall_table[] = {
 	[SYS_AS_AREA_CHANGE_FLAGS] = (syshandler_t) sys_as_area_change_flags,
 	[SYS_AS_AREA_GET_INFO] = (syshandler_t) sys_as_area_get_info,
 	[SYS_AS_AREA_DESTROY] = (syshandler_t) sys_as_area_destroy,
+	[SYS_AS_AREA_POPULATE] = (syshandler_t) sys_as_area_populate,
 
 	/* Page mapping related syscalls. */
 	[SYS_PAGE_FIND_MAPPING] = (syshandler_t) sys_page_find_mapping,
@@ -97,6 +98,8 @@ static syshandler_t syscall_table[] = {
 	[SYS_IPC_FORWARD_FAST] = (syshandler_t) sys_ipc_forward_fast,
 	[SYS_IPC_FORWARD_SLOW] = (syshandler_t) sys_ipc_forward_slow,
 	[SYS_IPC_WAIT] = (syshandler_t) sys_ipc_wait_for_call,
+	[SYS_IPC_WAIT_MANY] = (syshandler_t) sys_ipc_wait_many,
+	[SYS_IPC_SUBMIT] = (syshandler_t) sys_ipc_submit,
 	[SYS_IPC_POKE] = (syshandler_t) sys_ipc_poke,
 	[SYS_IPC_HANGUP] = (syshandler_t) sys_ipc_hangup,
 	[SYS_IPC_CONNECT_KBOX] = (syshandler_t) sys_ipc_connect_kbox,
@@ -41,8 +41,11 @@
 #include <sysinfo/sysinfo.h>
 #include <synch/spinlock.h>
 #include <synch/mutex.h>
+#include <synch/syswaitq.h>
+#include <synch/lockstat.h>
 #include <time/clock.h>
 #include <mm/frame.h>
+#include <ipc/ipc.h>
 #include <proc/task.h>
 #include <proc/thread.h>
 #include <interrupt.h>
@@ -226,6 +229,7 @@ static void produce_stats_task(task_t *task, stats_task_t *stats_task)
 	stats_task->threads = atomic_load(&task->refcount);
 	task_get_accounting(task, &(stats_task->ucycles),
 	    &(stats_task->kcycles));
+	stats_task->page_faults = atomic_load(&task->as->page_faults);
 	stats_task->ipc_info = task->ipc_info;
 }
 
@@ -759,6 +763,99 @@ static sysinfo_return_t get_stats_exception(const char *name, bool dry_run,
 	return ret;
 }
 
+/** Get lock contention statistics
+ *
+ * @param item    Sysinfo item (unused).
+ * @param size    Size of the returned data.
+ * @param dry_run Do not get the data, just calculate the size.
+ * @param data    Unused.
+ *
+ * @return Data containing several stats_lock_t structures.
+ *         If the return value is not NULL, it should be freed
+ *         in the context of the sysinfo request.
+ */
+static void *get_stats_locks(struct sysinfo_item *item, size_t *size,
+    bool dry_run, void *data)
+{
+#ifdef CONFIG_LOCK_STATS
+	size_t count = LOCK_CLASS_MAX - LOCK_CLASS_OTHER;
+	*size = sizeof(stats_lock_t) * count;
+
+	if (dry_run)
+		return NULL;
+
+	stats_lock_t *stats_locks = (stats_lock_t *) malloc(*size);
+	if (stats_locks == NULL) {
+		/* No free space for allocation */
+		*size = 0;
+		return NULL;
+	}
+
+	*size = sizeof(stats_lock_t) * lock_class_stats(stats_locks, count);
+	return ((void *) stats_locks);
+#else
+	*size = 0;
+	return NULL;
+#endif
+}
+
+/** Get lock class statistics
+ *
+ * Get statistics of a given lock class. The class number
+ * is passed as a string.
+ *
+ * @param name    Lock class number (string-encoded number).
+ * @param dry_run Do not get the data, just calculate the size.
+ * @param data    Unused.
+ *
+ * @return Sysinfo return holder. The type of the returned
+ *         data is either SYSINFO_VAL_UNDEFINED (unknown
+ *         lock class or memory allocation error) or
+ *         SYSINFO_VAL_FUNCTION_DATA (in that case the
+ *         generated data should be freed within the
+ *         sysinfo request context).
+ *
+ */
+static sysinfo_return_t get_stats_lock(const char *name, bool dry_run,
+    void *data)
+{
+	/* Initially no return value */
+	sysinfo_return_t ret;
+	ret.tag = SYSINFO_VAL_UNDEFINED;
+
+#ifdef CONFIG_LOCK_STATS
+	/* Parse the lock class number */
+	uint64_t cls;
+	if (str_uint64_t(name, NULL, 0, true, &cls) != EOK)
+		return ret;
+
+	if ((cls < LOCK_CLASS_OTHER) || (cls >= LOCK_CLASS_MAX))
+		return ret;
+
+	if (dry_run) {
+		ret.tag = SYSINFO_VAL_FUNCTION_DATA;
+		ret.data.data = NULL;
+		ret.data.size = sizeof(stats_lock_t);
+	} else {
+		stats_lock_t *stats_lock =
+		    (stats_lock_t *) malloc(sizeof(stats_lock_t));
+		if (stats_lock == NULL)
+			return ret;
+
+		if (!lock_class_stat(cls, stats_lock)) {
+			free(stats_lock);
+			return ret;
+		}
+
+		ret.tag = SYSINFO_VAL_FUNCTION_DATA;
+		ret.data.data = (void *) stats_lock;
+		ret.data.size = sizeof(stats_lock_t);
+	}
+#endif
+
+	return ret;
+}
+
 /** Get physical memory statistics
  *
  * @param item    Sysinfo item (unused).
@@ -790,6 +887,139 @@ static void *get_stats_physmem(struct sysinfo_item *item, size_t *size,
 	return ((void *) stats_physmem);
 }
 
+/** Get number of allocations satisfied from the per-CPU frame caches
+ *
+ * @param item Sysinfo item (unused).
+ * @param data Unused.
+ *
+ * @return Number of frame cache hits.
+ */
+static sysarg_t get_stats_frame_cache_hits(struct sysinfo_item *item,
+    void *data)
+{
+	uint64_t hits;
+	uint64_t misses;
+
+	frame_cache_stats(&hits, &misses);
+	return (sysarg_t) hits;
+}
+
+/** Get number of allocations which had to refill the per-CPU frame caches
+ *
+ * @param item Sysinfo item (unused).
+ * @param data Unused.
+ *
+ * @return Number of frame cache misses.
+ */
+static sysarg_t get_stats_frame_cache_misses(struct sysinfo_item *item,
+    void *data)
+{
+	uint64_t hits;
+	uint64_t misses;
+
+	frame_cache_stats(&hits, &misses);
+	return (sysarg_t) misses;
+}
+
+/** Get number of IPC calls taken from the slab allocator
+ *
+ * @param item Sysinfo item (unused).
+ * @param data Unused.
+ *
+ * @return Number of allocated IPC calls.
+ */
+static sysarg_t get_stats_ipc_call_allocs(struct sysinfo_item *item,
+    void *data)
+{
+	uint64_t allocs;
+	uint64_t reuses;
+
+	ipc_call_stats(&allocs, &reuses);
+	return (sysarg_t) allocs;
+}
+
+/** Get number of IPC calls reused from the answerbox free lists
+ *
+ * @param item Sysinfo item (unused).
+ * @param data Unused.
+ *
+ * @return Number of reused IPC calls.
+ */
+static sysarg_t get_stats_ipc_call_reuses(struct sysinfo_item *item,
+    void *data)
+{
+	uint64_t allocs;
+	uint64_t reuses;
+
+	ipc_call_stats(&allocs, &reuses);
+	return (sysarg_t) reuses;
+}
+
+/** Get number of mutex acquisitions which succeeded by spinning
+ *
+ * @param item Sysinfo item (unused).
+ * @param data Unused.
+ *
+ * @return Number of spinning mutex acquisitions.
+ */
+static sysarg_t get_stats_mutex_spins(struct sysinfo_item *item, void *data)
+{
+	uint64_t spins;
+	uint64_t sleeps;
+
+	mutex_stats(&spins, &sleeps);
+	return (sysarg_t) spins;
+}
+
+/** Get number of mutex acquisitions which fell back to sleeping
+ *
+ * @param item Sysinfo item (unused).
+ * @param data Unused.
+ *
+ * @return Number of sleeping mutex acquisitions.
+ */
+static sysarg_t get_stats_mutex_sleeps(struct sysinfo_item *item, void *data)
+{
+	uint64_t spins;
+	uint64_t sleeps;
+
+	mutex_stats(&spins, &sleeps);
+	return (sysarg_t) sleeps;
+}
+
+/** Get number of userspace futex sleeps which blocked
+ *
+ * @param item Sysinfo item (unused).
+ * @param data Unused.
+ *
+ * @return Number of blocking futex sleeps.
+ */
+static sysarg_t get_stats_futex_sleeps(struct sysinfo_item *item, void *data)
+{
+	uint64_t sleeps;
+	uint64_t nosleeps;
+
+	sys_waitq_stats(&sleeps, &nosleeps);
+	return (sysarg_t) sleeps;
+}
+
+/** Get number of userspace futex sleeps which did not block
+ *
+ * @param item Sysinfo item (unused).
+ * @param data Unused.
+ *
+ * @return Number of non-blocking futex sleeps.
+ */
+static sysarg_t get_stats_futex_nosleeps(struct sysinfo_item *item,
+    void *data)
+{
+	uint64_t sleeps;
+	uint64_t nosleeps;
+
+	sys_waitq_stats(&sleeps, &nosleeps);
+	return (sysarg_t) nosleeps;
+}
+
 /** Get system load
  *
  * @param item    Sysinfo item (unused).
@@ -873,14 +1103,32 @@ void stats_init(void)
 
 	sysinfo_set_item_gen_data("system.cpus", NULL, get_stats_cpus, NULL);
 	sysinfo_set_item_gen_data("system.physmem", NULL, get_stats_physmem, NULL);
+	sysinfo_set_item_gen_val("system.frame_cache.hits", NULL,
+	    get_stats_frame_cache_hits, NULL);
+	sysinfo_set_item_gen_val("system.frame_cache.misses", NULL,
+	    get_stats_frame_cache_misses, NULL);
+	sysinfo_set_item_gen_val("system.ipc_calls.allocs", NULL,
+	    get_stats_ipc_call_allocs, NULL);
+	sysinfo_set_item_gen_val("system.ipc_calls.reuses", NULL,
+	    get_stats_ipc_call_reuses, NULL);
+	sysinfo_set_item_gen_val("system.synch.mutex_spins", NULL,
+	    get_stats_mutex_spins, NULL);
+	sysinfo_set_item_gen_val("system.synch.mutex_sleeps", NULL,
+	    get_stats_mutex_sleeps, NULL);
+	sysinfo_set_item_gen_val("system.synch.futex_sleeps", NULL,
+	    get_stats_futex_sleeps, NULL);
+	sysinfo_set_item_gen_val("system.synch.futex_nosleeps", NULL,
+	    get_stats_futex_nosleeps, NULL);
 	sysinfo_set_item_gen_data("system.load", NULL, get_stats_load, NULL);
 	sysinfo_set_item_gen_data("system.tasks", NULL, get_stats_tasks, NULL);
 	sysinfo_set_item_gen_data("system.threads", NULL, get_stats_threads, NULL);
 	sysinfo_set_item_gen_data("system.ipccs", NULL, get_stats_ipccs, NULL);
 	sysinfo_set_item_gen_data("system.exceptions", NULL, get_stats_exceptions, NULL);
+	sysinfo_set_item_gen_data("system.locks", NULL, get_stats_locks, NULL);
 	sysinfo_set_subtree_fn("system.tasks", NULL, get_stats_task, NULL);
 	sysinfo_set_subtree_fn("system.threads", NULL, get_stats_thread, NULL);
 	sysinfo_set_subtree_fn("system.exceptions", NULL, get_stats_exception, NULL);
+	sysinfo_set_subtree_fn("system.locks", NULL, get_stats_lock, NULL);
 }
 
 /** @}
@@ -61,6 +61,9 @@
 /* Pointer to variable with uptime */
 uptime_t *uptime;
 
+/** One-shot mode of the clock source, NULL if it only ticks periodically */
+clock_oneshot_ops_t *clock_oneshot_ops = NULL;
+
 /** Physical memory area of the real time clock */
 static parea_t clock_parea;
 
@@ -110,11 +113,14 @@ void clock_counter_init(void)
  * Update it only on first processor
  * TODO: Do we really need so many write barriers?
  *
+ * @param usec Microseconds elapsed since the last update, at most
+ *             one second.
+ *
  */
-static void clock_update_counters(void)
+static void clock_update_counters(uint64_t usec)
 {
 	if (CPU->id == 0) {
-		secfrag += 1000000 / HZ;
+		secfrag += usec;
 		if (secfrag >= 1000000) {
 			secfrag -= 1000000;
 			uptime->seconds1++;
@@ -123,7 +129,7 @@ static void clock_update_counters(void)
 			write_barrier();
 			uptime->seconds2 = uptime->seconds1;
 		} else
-			uptime->useconds += 1000000 / HZ;
+			uptime->useconds += usec;
 	}
 }
 
@@ -136,6 +142,67 @@ static void cpu_update_accounting(void)
 	irq_spinlock_unlock(&CPU->lock, false);
 }
 
+/** Stop the clock tick on an idle CPU
+ *
+ * Arm a one-shot clock interrupt for the exact deadline of the next
+ * timeout of the current CPU instead of ticking periodically. The first
+ * CPU maintains the uptime counters, so it only does so for deadlines
+ * which come before its next tick. Must be called with interrupts
+ * disabled right before the CPU goes to sleep.
+ *
+ */
+void clock_idle_enter(void)
+{
+	if (clock_oneshot_ops == NULL)
+		return;
+
+	uint64_t usec = timeout_next(TIMEOUT_WHEEL_SIZE * TICK_USEC);
+	if ((CPU->id == 0) && (usec >= TICK_USEC))
+		return;
+
+	/*
+	 * A thread readied to this CPU from now on finds the flag set and
+	 * kicks the CPU out of its sleep. A thread readied earlier is seen
+	 * here, in which case the tick keeps running.
+	 */
+	atomic_store(&CPU->tickless, true);
+	if (atomic_load(&CPU->nrdy) != 0) {
+		atomic_store(&CPU->tickless, false);
+		return;
+	}
+
+	clock_oneshot_ops->oneshot(usec);
+}
+
+/** Resume the clock tick on a CPU woken up from idle sleep
+ *
+ * Run the timeouts whose deadline passed while the tick was stopped.
+ * Must be called with interrupts disabled.
+ *
+ */
+void clock_idle_exit(void)
+{
+	if (!atomic_load(&CPU->tickless))
+		return;
+
+	uint64_t usec = clock_oneshot_ops->periodic();
+	atomic_store(&CPU->tickless, false);
+
+	clock_update_counters(usec);
+	timeout_advance(usec);
+}
+
+/** Wake up a CPU sleeping without the clock tick
+ *
+ * @param cpu CPU to which a thread has just been readied.
+ *
+ */
+void clock_idle_kick(cpu_t *cpu)
+{
+	if ((cpu != CPU) && (atomic_load(&cpu->tickless)))
+		clock_oneshot_ops->kick(cpu);
+}
+
 /** Clock routine
  *
  * Clock routine executed from clock interrupt handler
@@ -145,6 +212,14 @@ static void cpu_update_accounting(void)
  */
 void clock(void)
 {
+	/*
+	 * This is the one-shot interrupt of an idle CPU without the tick.
+	 */
+	if (atomic_load(&CPU->tickless)) {
+		clock_idle_exit();
+		return;
+	}
+
 	size_t missed_clock_ticks = CPU->missed_clock_ticks;
 
 	/* Account CPU usage */
@@ -158,36 +233,10 @@ void clock(void)
 	size_t i;
 	for (i = 0; i <= missed_clock_ticks; i++) {
 		/* Update counters and accounting */
-		clock_update_counters();
+		clock_update_counters(TICK_USEC);
 		cpu_update_accounting();
 
-		irq_spinlock_lock(&CPU->timeoutlock, false);
-
-		link_t *cur;
-		while ((cur = list_first(&CPU->timeout_active_list)) != NULL) {
-			timeout_t *timeout = list_get_instance(cur, timeout_t,
-			    link);
-
-			irq_spinlock_lock(&timeout->lock, false);
-			if (timeout->ticks-- != 0) {
-				irq_spinlock_unlock(&timeout->lock, false);
-				break;
-			}
-
-			list_remove(cur);
-			timeout_handler_t handler = timeout->handler;
-			void *arg = timeout->arg;
-			timeout_reinitialize(timeout);
-
-			irq_spinlock_unlock(&timeout->lock, false);
-			irq_spinlock_unlock(&CPU->timeoutlock, false);
-
-			handler(arg);
-
-			irq_spinlock_lock(&CPU->timeoutlock, false);
-		}
-
-		irq_spinlock_unlock(&CPU->timeoutlock, false);
+		timeout_advance(TICK_USEC);
 	}
 	CPU->missed_clock_ticks = 0;
 
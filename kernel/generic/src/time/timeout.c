@@ -36,6 +36,7 @@
  */
 
 #include <time/timeout.h>
+#include <time/clock.h>
 #include <typedefs.h>
 #include <config.h>
 #include <panic.h>
@@ -44,6 +45,28 @@
 #include <cpu.h>
 #include <arch/asm.h>
 #include <arch.h>
+#include <macros.h>
+
+/** Slot of the timeout wheel of a CPU for the given time in usec. */
+static inline list_t *timeout_slot(cpu_t *cpu, uint64_t usec)
+{
+	return &cpu->timeout_wheel[(usec / TICK_USEC) % TIMEOUT_WHEEL_SIZE];
+}
+
+/** Current time of the timeout clock of the current CPU in usec
+ *
+ * Without a clock source which can tell the time between the ticks,
+ * the time is rounded up to the next tick so that no timeout fires
+ * early.
+ *
+ */
+static uint64_t timeout_now(void)
+{
+	if (clock_oneshot_ops != NULL)
+		return CPU->timeout_clock + clock_oneshot_ops->elapsed();
+
+	return CPU->timeout_clock + TICK_USEC;
+}
 
 /** Initialize timeouts
  *
@@ -53,7 +76,10 @@
 void timeout_init(void)
 {
 	irq_spinlock_initialize(&CPU->timeoutlock, "cpu.timeoutlock");
-	list_initialize(&CPU->timeout_active_list);
+	CPU->timeout_clock = 0;
+
+	for (size_t i = 0; i < TIMEOUT_WHEEL_SIZE; i++)
+		list_initialize(&CPU->timeout_wheel[i]);
 }
 
 /** Reinitialize timeout
@@ -66,7 +92,7 @@ void timeout_init(void)
 void timeout_reinitialize(timeout_t *timeout)
 {
 	timeout->cpu = NULL;
-	timeout->ticks = 0;
+	timeout->deadline = 0;
 	timeout->handler = NULL;
 	timeout->arg = NULL;
 	link_initialize(&timeout->link);
@@ -88,7 +114,7 @@ void timeout_initialize(timeout_t *timeout)
 /** Register timeout
  *
  * Insert timeout handler f (with argument arg)
- * to timeout list and make it execute in
+ * to the timeout wheel and make it execute in
  * time microseconds (or slightly more).
  *
  * @param timeout Timeout structure.
@@ -107,49 +133,17 @@ void timeout_register(timeout_t *timeout, uint64_t time,
 		panic("Unexpected: timeout->cpu != 0.");
 
 	timeout->cpu = CPU;
-	timeout->ticks = us2ticks(time);
+	timeout->deadline = timeout_now() + time;
 
 	timeout->handler = handler;
 	timeout->arg = arg;
 
 	/*
-	 * Insert timeout into the active timeouts list according to timeout->ticks.
+	 * The slot is visited in every tick congruent with the deadline,
+	 * so the timeout fires in the first such visit past the deadline.
+	 * Timeouts of the same slot are kept in the order of registration.
 	 */
-	uint64_t sum = 0;
-	timeout_t *target = NULL;
-	link_t *cur;
-	for (cur = CPU->timeout_active_list.head.next;
-	    cur != &CPU->timeout_active_list.head; cur = cur->next) {
-		target = list_get_instance(cur, timeout_t, link);
-		irq_spinlock_lock(&target->lock, false);
-
-		if (timeout->ticks < sum + target->ticks) {
-			irq_spinlock_unlock(&target->lock, false);
-			break;
-		}
-
-		sum += target->ticks;
-		irq_spinlock_unlock(&target->lock, false);
-	}
-
-	/* Avoid using cur->prev directly */
-	link_t *prev = cur->prev;
-	list_insert_after(&timeout->link, prev);
-
-	/*
-	 * Adjust timeout->ticks according to ticks
-	 * accumulated in target's predecessors.
-	 */
-	timeout->ticks -= sum;
-
-	/*
-	 * Decrease ticks of timeout's immediate succesor by timeout->ticks.
-	 */
-	if (cur != &CPU->timeout_active_list.head) {
-		irq_spinlock_lock(&target->lock, false);
-		target->ticks -= timeout->ticks;
-		irq_spinlock_unlock(&target->lock, false);
-	}
+	list_append(&timeout->link, timeout_slot(CPU, timeout->deadline));
 
 	irq_spinlock_unlock(&timeout->lock, false);
 	irq_spinlock_unlock(&CPU->timeoutlock, true);
@@ -157,7 +151,7 @@ void timeout_register(timeout_t *timeout, uint64_t time,
 
 /** Unregister timeout
  *
- * Remove timeout from timeout list.
+ * Remove timeout from the timeout wheel.
  *
  * @param timeout Timeout to unregister.
  *
@@ -183,17 +177,9 @@ grab_locks:
 
 	/*
 	 * Now we know for sure that timeout hasn't been activated yet
-	 * and is lurking in timeout->cpu->timeout_active_list.
+	 * and is lurking in the timeout wheel of timeout->cpu.
 	 */
 
-	link_t *cur = timeout->link.next;
-	if (cur != &timeout->cpu->timeout_active_list.head) {
-		timeout_t *tmp = list_get_instance(cur, timeout_t, link);
-		irq_spinlock_lock(&tmp->lock, false);
-		tmp->ticks += timeout->ticks;
-		irq_spinlock_unlock(&tmp->lock, false);
-	}
-
 	list_remove(&timeout->link);
 	irq_spinlock_unlock(&timeout->cpu->timeoutlock, false);
 
@@ -203,5 +189,117 @@ grab_locks:
 	return true;
 }
 
+/** Get the time of the next timeout of the current CPU
+ *
+ * Must be called with interrupts disabled.
+ *
+ * @param max Maximum number of usec to look ahead.
+ *
+ * @return Number of usec between the last clock tick of the current CPU
+ *         and the earliest deadline, or @a max if no timeout expires
+ *         earlier.
+ *
+ */
+uint64_t timeout_next(uint64_t max)
+{
+	irq_spinlock_lock(&CPU->timeoutlock, false);
+
+	uint64_t now = CPU->timeout_clock;
+	uint64_t next = now + max;
+	uint64_t tick = now / TICK_USEC;
+
+	/*
+	 * Visiting the slots in tick order finds the tick of the earliest
+	 * deadline. Timeouts further than one wheel turn away are never
+	 * found, which is why the look-ahead is limited to the size of the
+	 * wheel.
+	 */
+	for (uint64_t t = tick; t < tick + TIMEOUT_WHEEL_SIZE; t++) {
+		if (t * TICK_USEC >= next)
+			break;
+
+		list_t *slot = &CPU->timeout_wheel[t % TIMEOUT_WHEEL_SIZE];
+
+		list_foreach(*slot, link, timeout_t, timeout) {
+			if (timeout->deadline / TICK_USEC <= t)
+				next = min(next, timeout->deadline);
+		}
+
+		if (next < (t + 1) * TICK_USEC)
+			break;
+	}
+
+	irq_spinlock_unlock(&CPU->timeoutlock, false);
+	return (next > now) ? next - now : 0;
+}
+
+/** Advance the timeout clock and run expired timeouts
+ *
+ * Advance the timeout clock of the current CPU by the given time
+ * and run all handlers of timeouts whose deadline has passed. Must
+ * be called with interrupts disabled.
+ *
+ * @param usec Number of usec elapsed since the last call.
+ *
+ */
+void timeout_advance(uint64_t usec)
+{
+	irq_spinlock_lock(&CPU->timeoutlock, false);
+
+	uint64_t first = CPU->timeout_clock / TICK_USEC;
+	uint64_t now = CPU->timeout_clock += usec;
+	uint64_t last = min(now / TICK_USEC, first + TIMEOUT_WHEEL_SIZE - 1);
+
+	/*
+	 * Collect the expired timeouts first. The handlers may register
+	 * new timeouts in the same slot and other CPUs may unregister the
+	 * collected ones until they are run, which is why the list is only
+	 * manipulated with the timeout lock held. The slot of the previous
+	 * tick is visited again as it may hold deadlines which fell between
+	 * the two ticks.
+	 */
+	list_t expired;
+	list_initialize(&expired);
+
+	for (uint64_t t = first; t <= last; t++) {
+		list_t *slot = &CPU->timeout_wheel[t % TIMEOUT_WHEEL_SIZE];
+
+		link_t *cur = list_first(slot);
+		while (cur != NULL) {
+			link_t *next = list_next(cur, slot);
+			timeout_t *timeout = list_get_instance(cur, timeout_t,
+			    link);
+
+			if (timeout->deadline <= now) {
+				list_remove(cur);
+				list_append(cur, &expired);
+			}
+
+			cur = next;
+		}
+	}
+
+	link_t *cur;
+	while ((cur = list_first(&expired)) != NULL) {
+		timeout_t *timeout = list_get_instance(cur, timeout_t, link);
+
+		irq_spinlock_lock(&timeout->lock, false);
+
+		list_remove(cur);
+		timeout_handler_t handler = timeout->handler;
+		void *arg = timeout->arg;
+		timeout_reinitialize(timeout);
+
+		irq_spinlock_unlock(&timeout->lock, false);
+		irq_spinlock_unlock(&CPU->timeoutlock, false);
+
+		handler(arg);
+
+		irq_spinlock_lock(&CPU->timeoutlock, false);
+	}
+
+	irq_spinlock_unlock(&CPU->timeoutlock, false);
+}
+
 /** @}
  */
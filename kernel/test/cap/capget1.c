@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <test.h>
+#include <arch.h>
+#include <atomic.h>
+#include <config.h>
+#include <cpu.h>
+#include <proc/thread.h>
+#include <proc/task.h>
+#include <ipc/ipcrsc.h>
+#include <cap/cap.h>
+#include <arch/cycle.h>
+
+/** Number of lookups done by each reader. */
+#define LOOKUPS  100000
+
+/** Maximum number of concurrent readers. */
+#define READERS_MAX  16
+
+static cap_phone_handle_t phone_handle;
+static kobject_t *phone_kobj;
+
+static atomic_bool writer_stop;
+static atomic_size_t failures;
+static atomic_size_t churns;
+static uint64_t cycles[READERS_MAX];
+
+static void reader(void *arg)
+{
+	uint64_t *total = (uint64_t *) arg;
+	uint64_t start = get_cycle();
+
+	for (unsigned int i = 0; i < LOOKUPS; i++) {
+		kobject_t *kobj = kobject_get(TASK, (cap_handle_t) phone_handle,
+		    KOBJECT_TYPE_PHONE);
+		if (kobj != phone_kobj) {
+			atomic_inc(&failures);
+			if (kobj == NULL)
+				continue;
+		}
+
+		kobject_put(kobj);
+	}
+
+	*total = get_cycle() - start;
+}
+
+/** Keep publishing and unpublishing other capabilities of the task */
+static void writer(void *arg)
+{
+	while (!atomic_load(&writer_stop)) {
+		cap_phone_handle_t handle;
+		if (phone_alloc(TASK, true, &handle, NULL) != EOK)
+			continue;
+
+		phone_dealloc(handle);
+		atomic_inc(&churns);
+	}
+}
+
+/** Measure concurrent capability lookups
+ *
+ * One reader per active CPU (up to READERS_MAX) looks up the same phone
+ * capability in a loop while another thread keeps allocating, publishing,
+ * unpublishing and freeing other capabilities of the same task.
+ *
+ */
+const char *test_capget1(void)
+{
+	thread_t *readers[READERS_MAX];
+	size_t nreaders = 0;
+
+	if (phone_alloc(TASK, true, &phone_handle, &phone_kobj) != EOK)
+		return "Unable to allocate phone";
+
+	atomic_store(&writer_stop, false);
+	atomic_store(&failures, 0);
+	atomic_store(&churns, 0);
+
+	thread_t *twriter = thread_create(writer, NULL, TASK, THREAD_FLAG_NONE,
+	    "capwriter");
+	if (twriter == NULL) {
+		phone_dealloc(phone_handle);
+		return "Unable to create threads";
+	}
+
+	for (unsigned int i = 0; i < config.cpu_count; i++) {
+		if ((!cpus[i].active) || (nreaders == READERS_MAX))
+			continue;
+
+		thread_t *t = thread_create(reader, &cycles[nreaders], TASK,
+		    THREAD_FLAG_NONE, "capreader");
+		if (t == NULL)
+			break;
+
+		thread_wire(t, &cpus[i]);
+		readers[nreaders++] = t;
+	}
+
+	thread_ready(twriter);
+	for (size_t i = 0; i < nreaders; i++)
+		thread_ready(readers[i]);
+
+	uint64_t total = 0;
+	for (size_t i = 0; i < nreaders; i++) {
+		thread_join(readers[i]);
+		thread_detach(readers[i]);
+		total += cycles[i];
+	}
+
+	atomic_store(&writer_stop, true);
+	thread_join(twriter);
+	thread_detach(twriter);
+
+	phone_dealloc(phone_handle);
+
+	if (nreaders == 0)
+		return "Unable to create threads";
+
+	TPRINTF("%zu readers: %" PRIu64 " cycles per lookup, %zu writer "
+	    "rounds\n", nreaders, total / (nreaders * LOOKUPS),
+	    atomic_load(&churns));
+
+	if (atomic_load(&failures) > 0)
+		return "Lookup returned wrong kernel object";
+
+	return NULL;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <test.h>
+#include <print.h>
+#include <proc/task.h>
+#include <ipc/ipc.h>
+#include <cap/cap.h>
+
+/** Number of request/answer rounds per measurement. */
+#define ROUNDS  10000
+
+/** Emulate the life cycle of a call on its way from a request to an answer
+ *
+ * The call is allocated, received into a capability of the current task and
+ * then answered, which frees the capability and drops the last reference to
+ * the call.
+ *
+ * @return Error message or NULL on success.
+ *
+ */
+static const char *round_trip(void)
+{
+	call_t *call = ipc_call_alloc();
+	if (!call)
+		return "Failed to allocate call";
+
+	cap_handle_t handle;
+	if (cap_alloc(TASK, &handle) != EOK) {
+		kobject_put(call->kobject);
+		return "Failed to allocate capability";
+	}
+
+	cap_publish(TASK, handle, call->kobject);
+
+	kobject_t *kobj = cap_unpublish(TASK, handle, KOBJECT_TYPE_CALL);
+	if (kobj != call->kobject)
+		return "Unpublished wrong kernel object";
+
+	cap_free(TASK, handle);
+	kobject_put(kobj);
+
+	return NULL;
+}
+
+const char *test_calls1(void)
+{
+	const char *err;
+
+	/* Fill the free lists of the current task */
+	for (unsigned int i = 0; i < IPC_FREE_CALLS_MAX; i++) {
+		err = round_trip();
+		if (err != NULL)
+			return err;
+	}
+
+	uint64_t allocs0;
+	uint64_t reuses0;
+	ipc_call_stats(&allocs0, &reuses0);
+
+	for (unsigned int i = 0; i < ROUNDS; i++) {
+		err = round_trip();
+		if (err != NULL)
+			return err;
+	}
+
+	uint64_t allocs1;
+	uint64_t reuses1;
+	ipc_call_stats(&allocs1, &reuses1);
+
+	uint64_t allocs = allocs1 - allocs0;
+	uint64_t reuses = reuses1 - reuses0;
+
+	if (!test_quiet) {
+		printf("%u round trips: %" PRIu64 " call allocations, %" PRIu64
+		    " reuses\n", ROUNDS, allocs, reuses);
+	}
+
+	/*
+	 * The counters are global, so allow for some concurrent IPC in other
+	 * tasks.
+	 */
+	if (reuses < ROUNDS)
+		return "Calls were not reused";
+	if (allocs > ROUNDS / 100)
+		return "Too many call allocations per round trip";
+
+	return NULL;
+}
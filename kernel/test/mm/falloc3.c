@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <test.h>
+#include <mm/frame.h>
+#include <mm/page.h>
+#include <arch/mm/page.h>
+#include <arch/cycle.h>
+#include <typedefs.h>
+#include <atomic.h>
+#include <proc/thread.h>
+#include <config.h>
+#include <cpu.h>
+#include <arch.h>
+
+/** Number of frames held by a thread at once. */
+#define BURST   32
+
+/** Number of allocate/free bursts per thread. */
+#define ROUNDS  4096
+
+static atomic_t thread_cnt;
+static atomic_t thread_fail;
+static atomic_t thread_go;
+static atomic_t total_cycles;
+
+static void falloc(void *arg)
+{
+	uintptr_t frames[BURST];
+
+	thread_detach(THREAD);
+
+	while (atomic_load(&thread_go) == 0)
+		thread_usleep(1000);
+
+	uint64_t start = get_cycle();
+
+	for (unsigned int run = 0; run < ROUNDS; run++) {
+		unsigned int allocated;
+
+		for (allocated = 0; allocated < BURST; allocated++) {
+			frames[allocated] = frame_alloc(1,
+			    FRAME_LOWMEM | FRAME_ATOMIC, 0);
+			if (frames[allocated] == 0)
+				break;
+
+			*((uintptr_t *) PA2KA(frames[allocated])) =
+			    frames[allocated];
+		}
+
+		for (unsigned int i = 0; i < allocated; i++) {
+			if (*((uintptr_t *) PA2KA(frames[i])) != frames[i]) {
+				TPRINTF("cpu%u: frame %p handed out twice\n",
+				    CPU->id, (void *) frames[i]);
+				atomic_inc(&thread_fail);
+			}
+			frame_free(frames[i], 1);
+		}
+
+		if (allocated < BURST) {
+			TPRINTF("cpu%u: out of memory\n", CPU->id);
+			atomic_inc(&thread_fail);
+			break;
+		}
+	}
+
+	atomic_fetch_add(&total_cycles, (size_t) (get_cycle() - start));
+	atomic_dec(&thread_cnt);
+}
+
+const char *test_falloc3(void)
+{
+	uint64_t hits0, misses0, hits1, misses1;
+	unsigned int threads = 0;
+
+	atomic_store(&thread_cnt, 0);
+	atomic_store(&thread_fail, 0);
+	atomic_store(&thread_go, 0);
+	atomic_store(&total_cycles, 0);
+
+	frame_cache_stats(&hits0, &misses0);
+
+	for (unsigned int i = 0; i < config.cpu_count; i++) {
+		if (!cpus[i].active)
+			continue;
+
+		thread_t *thrd = thread_create(falloc, NULL, TASK,
+		    THREAD_FLAG_NONE, "falloc3");
+		if (!thrd) {
+			TPRINTF("Could not create thread %u\n", i);
+			break;
+		}
+
+		thread_wire(thrd, &cpus[i]);
+		atomic_inc(&thread_cnt);
+		threads++;
+		thread_ready(thrd);
+	}
+
+	atomic_store(&thread_go, 1);
+
+	while (atomic_load(&thread_cnt) > 0)
+		thread_usleep(10000);
+
+	frame_cache_stats(&hits1, &misses1);
+
+	uint64_t ops = (uint64_t) threads * ROUNDS * BURST;
+	uint64_t hits = hits1 - hits0;
+	uint64_t misses = misses1 - misses0;
+
+	TPRINTF("%u threads, %" PRIu64 " frame alloc/free pairs, "
+	    "%" PRIu64 " cycles per pair per thread\n", threads, ops,
+	    ops ? (uint64_t) atomic_load(&total_cycles) / ops : 0);
+	TPRINTF("Frame cache: %" PRIu64 " hits, %" PRIu64 " misses\n",
+	    hits, misses);
+
+	if (atomic_load(&thread_fail) != 0)
+		return "Test failed";
+
+	return NULL;
+}
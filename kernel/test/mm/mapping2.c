@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <test.h>
+#include <mm/page.h>
+#include <mm/frame.h>
+#include <mm/km.h>
+#include <mm/tlb.h>
+#include <mm/as.h>
+#include <mm/asid.h>
+#include <genarch/mm/page_pt.h>
+#include <genarch/mm/page_ht.h>
+#include <typedefs.h>
+#include <arch.h>
+
+#define TEST_MAGIC  UINT32_C(0x01234567)
+
+/** Base page removed from the large page to force a split */
+#define SPLIT_PAGE  1
+
+static void unmap_pages(uintptr_t vaddr, size_t first, size_t count)
+{
+	page_table_lock(AS_KERNEL, true);
+
+	ipl_t ipl = tlb_shootdown_start(TLB_INVL_ASID, ASID_KERNEL, 0, 0);
+
+	for (size_t i = first; i < first + count; i++)
+		page_mapping_remove(AS_KERNEL, vaddr + P2SZ(i));
+
+	tlb_invalidate_asid(ASID_KERNEL);
+	as_invalidate_translation_cache(AS_KERNEL, 0, -1);
+	tlb_shootdown_finalize(ipl);
+
+	page_table_unlock(AS_KERNEL, true);
+}
+
+static const char *check_pages(uintptr_t vaddr, uintptr_t frame, bool split)
+{
+	for (size_t i = 0; i < LARGE_PAGE_PAGES; i++) {
+		pte_t pte;
+
+		page_table_lock(AS_KERNEL, true);
+		bool found = page_mapping_find(AS_KERNEL, vaddr + P2SZ(i),
+		    false, &pte);
+		page_table_unlock(AS_KERNEL, true);
+
+		if (split && (i == SPLIT_PAGE)) {
+			if (found && PTE_PRESENT(&pte))
+				return "Removed base page is still mapped.";
+			continue;
+		}
+
+		if ((!found) || (!PTE_PRESENT(&pte)))
+			return "Base page of a large page is not mapped.";
+
+		if (PTE_GET_FRAME(&pte) != frame + P2SZ(i))
+			return "Base page is mapped to a wrong frame.";
+
+		if (*((uint32_t *) (vaddr + P2SZ(i))) != TEST_MAGIC + i)
+			return "Read does not match the value written.";
+	}
+
+	return NULL;
+}
+
+const char *test_mapping2(void)
+{
+	if (LARGE_PAGE_SIZE == 0) {
+		TPRINTF("Large pages not supported, skipping.\n");
+		return NULL;
+	}
+
+	uintptr_t frame = frame_alloc(LARGE_PAGE_PAGES, FRAME_ATOMIC,
+	    LARGE_PAGE_SIZE - 1);
+	if (!frame)
+		return "Unable to allocate frames for a large page.";
+
+	uintptr_t vaddr = km_page_alloc(LARGE_PAGE_SIZE, LARGE_PAGE_SIZE);
+	if (!vaddr) {
+		frame_free(frame, LARGE_PAGE_PAGES);
+		return "Unable to allocate virtual space for a large page.";
+	}
+
+	const char *err = NULL;
+	unsigned int flags = PAGE_READ | PAGE_WRITE | PAGE_CACHEABLE;
+
+	TPRINTF("Mapping large page %p to %p.\n", (void *) vaddr,
+	    (void *) frame);
+
+	page_table_lock(AS_KERNEL, true);
+	bool mapped = page_mapping_insert_large(AS_KERNEL, vaddr, frame, flags);
+	page_table_unlock(AS_KERNEL, true);
+
+	if (!mapped) {
+		err = "Large page mapping was not created.";
+		goto out;
+	}
+
+	for (size_t i = 0; i < LARGE_PAGE_PAGES; i++)
+		*((uint32_t *) (vaddr + P2SZ(i))) = TEST_MAGIC + i;
+
+	err = check_pages(vaddr, frame, false);
+	if (err != NULL) {
+		unmap_pages(vaddr, 0, LARGE_PAGE_PAGES);
+		goto out;
+	}
+
+	TPRINTF("Removing the large page as a whole.\n");
+
+	page_table_lock(AS_KERNEL, true);
+	ipl_t ipl = tlb_shootdown_start(TLB_INVL_ASID, ASID_KERNEL, 0, 0);
+	bool removed = page_mapping_remove_large(AS_KERNEL, vaddr);
+	tlb_invalidate_asid(ASID_KERNEL);
+	as_invalidate_translation_cache(AS_KERNEL, 0, -1);
+	tlb_shootdown_finalize(ipl);
+
+	pte_t pte;
+	bool found = page_mapping_find(AS_KERNEL, vaddr, false, &pte);
+	page_table_unlock(AS_KERNEL, true);
+
+	if (!removed) {
+		unmap_pages(vaddr, 0, LARGE_PAGE_PAGES);
+		err = "Large page mapping was not removed.";
+		goto out;
+	}
+
+	if (found && PTE_PRESENT(&pte)) {
+		err = "Removed large page is still mapped.";
+		goto out;
+	}
+
+	TPRINTF("Mapping the large page again and removing base page %u.\n",
+	    SPLIT_PAGE);
+
+	page_table_lock(AS_KERNEL, true);
+	mapped = page_mapping_insert_large(AS_KERNEL, vaddr, frame, flags);
+	if (mapped)
+		page_mapping_split(AS_KERNEL, vaddr + P2SZ(SPLIT_PAGE));
+	page_table_unlock(AS_KERNEL, true);
+
+	if (!mapped) {
+		err = "Large page mapping was not created again.";
+		goto out;
+	}
+
+	unmap_pages(vaddr, SPLIT_PAGE, 1);
+
+	err = check_pages(vaddr, frame, true);
+
+	unmap_pages(vaddr, 0, SPLIT_PAGE);
+	unmap_pages(vaddr, SPLIT_PAGE + 1,
+	    LARGE_PAGE_PAGES - SPLIT_PAGE - 1);
+
+out:
+	km_page_free(vaddr, LARGE_PAGE_SIZE);
+	frame_free(frame, LARGE_PAGE_PAGES);
+
+	return err;
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <test.h>
+#include <synch/lockstat.h>
+#include <synch/mutex.h>
+#include <synch/spinlock.h>
+
+#define ROUNDS  100
+
+const char *test_lockstat1(void)
+{
+#ifdef CONFIG_LOCK_STATS
+	SPINLOCK_DECLARE(lock);
+	spinlock_initialize(&lock, "lockstat1_lock");
+
+	mutex_t mtx;
+	mutex_initialize(&mtx, MUTEX_PASSIVE);
+
+	for (unsigned int i = 0; i < ROUNDS; i++) {
+		spinlock_lock(&lock);
+		spinlock_unlock(&lock);
+
+		mutex_lock(&mtx);
+		mutex_unlock(&mtx);
+	}
+
+	unsigned int spin_cls = atomic_load(&lock.lock_class);
+	if (spin_cls == LOCK_CLASS_NONE)
+		return "Spinlock has not been classified";
+
+	if (spin_cls != lock_class_get("lockstat1_lock", false))
+		return "Spinlock class lookup mismatch";
+
+	stats_lock_t stat;
+	if (!lock_class_stat(spin_cls, &stat))
+		return "Spinlock class statistics not found";
+
+	TPRINTF("%s: %" PRIu64 " acquisitions, %" PRIu64 " contended\n",
+	    stat.name, stat.acquisitions, stat.contentions);
+
+	if ((spin_cls != LOCK_CLASS_OTHER) && (stat.acquisitions < ROUNDS))
+		return "Spinlock acquisitions not accounted";
+
+	if (!lock_class_stat(mtx.lock_class, &stat))
+		return "Mutex class statistics not found";
+
+	TPRINTF("%s: %" PRIu64 " acquisitions, %" PRIu64 " contended\n",
+	    stat.name, stat.acquisitions, stat.contentions);
+
+	if (!stat.mutex && (mtx.lock_class != LOCK_CLASS_OTHER))
+		return "Mutex class has wrong type";
+
+	if ((mtx.lock_class != LOCK_CLASS_OTHER) &&
+	    (stat.acquisitions < ROUNDS))
+		return "Mutex acquisitions not accounted";
+#else
+	TPRINTF("Lock statistics are not configured\n");
+#endif
+
+	return NULL;
+}
@@ -40,13 +40,18 @@ bool test_quiet;
 
 test_t tests[] = {
 #include <atomic/atomic1.def>
+#include <cap/capget1.def>
 #include <debug/mips1.def>
 #include <fault/fault1.def>
+#include <ipc/calls1.def>
 #include <mm/falloc1.def>
 #include <mm/falloc2.def>
+#include <mm/falloc3.def>
 #include <mm/mapping1.def>
+#include <mm/mapping2.def>
 #include <mm/slab1.def>
 #include <mm/slab2.def>
+#include <synch/lockstat1.def>
 #include <synch/semaphore1.def>
 #include <synch/semaphore2.def>
 #include <print/print1.def>
@@ -55,6 +60,8 @@ test_t tests[] = {
 #include <print/print4.def>
 #include <print/print5.def>
 #include <thread/thread1.def>
+#include <thread/wakeup1.def>
+#include <time/timeout1.def>
 	{
 		.name = NULL,
 		.desc = NULL,
@@ -57,14 +57,19 @@ typedef struct {
 } test_t;
 
 extern const char *test_atomic1(void);
+extern const char *test_capget1(void);
 extern const char *test_mips1(void);
 extern const char *test_fault1(void);
+extern const char *test_calls1(void);
 extern const char *test_falloc1(void);
 extern const char *test_falloc2(void);
+extern const char *test_falloc3(void);
 extern const char *test_mapping1(void);
+extern const char *test_mapping2(void);
 extern const char *test_purge1(void);
 extern const char *test_slab1(void);
 extern const char *test_slab2(void);
+extern const char *test_lockstat1(void);
 extern const char *test_semaphore1(void);
 extern const char *test_semaphore2(void);
 extern const char *test_print1(void);
@@ -73,6 +78,8 @@ extern const char *test_print3(void);
 extern const char *test_print4(void);
 extern const char *test_print5(void);
 extern const char *test_thread1(void);
+extern const char *test_wakeup1(void);
+extern const char *test_timeout1(void);
 
 extern test_t tests[];
 
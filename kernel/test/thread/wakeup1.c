@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <test.h>
+#include <arch.h>
+#include <config.h>
+#include <cpu.h>
+#include <proc/thread.h>
+#include <synch/semaphore.h>
+#include <arch/cycle.h>
+
+/** Number of ping-pong round trips per measurement. */
+#define ROUNDS  10000
+
+static semaphore_t ping;
+static semaphore_t pong;
+static uint64_t cycles;
+
+static void pinger(void *arg)
+{
+	uint64_t total = 0;
+
+	for (unsigned int i = 0; i < ROUNDS; i++) {
+		uint64_t start = get_cycle();
+		semaphore_up(&ping);
+		semaphore_down(&pong);
+		total += get_cycle() - start;
+	}
+
+	cycles = total;
+}
+
+static void ponger(void *arg)
+{
+	for (unsigned int i = 0; i < ROUNDS; i++) {
+		semaphore_down(&ping);
+		semaphore_up(&pong);
+	}
+}
+
+/** Measure the time between waking up a thread and the thread running
+ *
+ * Two threads wired to the given CPUs wake each other up in turns. Each
+ * round trip consists of two wake-ups, so half of the average round trip
+ * is the wake-up-to-run latency. The cycles are counted by one thread
+ * only, so the cycle counters of the CPUs need not be synchronized.
+ *
+ * @return Average latency in cycles or zero on error.
+ *
+ */
+static uint64_t measure(cpu_t *ping_cpu, cpu_t *pong_cpu)
+{
+	semaphore_initialize(&ping, 0);
+	semaphore_initialize(&pong, 0);
+
+	thread_t *tping = thread_create(pinger, NULL, TASK, THREAD_FLAG_NONE,
+	    "pinger");
+	if (tping == NULL)
+		return 0;
+
+	thread_t *tpong = thread_create(ponger, NULL, TASK, THREAD_FLAG_NONE,
+	    "ponger");
+	if (tpong == NULL) {
+		thread_detach(tping);
+		return 0;
+	}
+
+	thread_wire(tping, ping_cpu);
+	thread_wire(tpong, pong_cpu);
+
+	thread_ready(tpong);
+	thread_ready(tping);
+
+	thread_join(tping);
+	thread_detach(tping);
+	thread_join(tpong);
+	thread_detach(tpong);
+
+	return cycles / ROUNDS / 2;
+}
+
+const char *test_wakeup1(void)
+{
+	cpu_t *first = NULL;
+	cpu_t *second = NULL;
+
+	for (unsigned int i = 0; i < config.cpu_count; i++) {
+		if (!cpus[i].active)
+			continue;
+
+		if (first == NULL)
+			first = &cpus[i];
+		else if (second == NULL)
+			second = &cpus[i];
+	}
+
+	uint64_t local = measure(first, first);
+	if (local == 0)
+		return "Unable to create threads";
+
+	TPRINTF("cpu%u -> cpu%u: %" PRIu64 " cycles\n", first->id, first->id,
+	    local);
+
+	if (second == NULL) {
+		TPRINTF("Only one active CPU, skipping cross-CPU wake-ups\n");
+		return NULL;
+	}
+
+	uint64_t remote = measure(first, second);
+	if (remote == 0)
+		return "Unable to create threads";
+
+	TPRINTF("cpu%u -> cpu%u: %" PRIu64 " cycles\n", first->id, second->id,
+	    remote);
+
+	return NULL;
+}
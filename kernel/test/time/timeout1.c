@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <test.h>
+#include <atomic.h>
+#include <time/timeout.h>
+#include <proc/thread.h>
+#include <arch/cycle.h>
+#include <stdlib.h>
+
+/** Number of timeouts armed and cancelled by the benchmark part. */
+#define TIMEOUTS  100000
+
+/** Number of timeouts in the ordering part. */
+#define ORDERED  4
+
+static atomic_t fired;
+static int order[ORDERED];
+
+static void order_handler(void *arg)
+{
+	size_t i = atomic_postinc(&fired);
+	if (i < ORDERED)
+		order[i] = (int) (uintptr_t) arg;
+}
+
+static void fail_handler(void *arg)
+{
+	atomic_inc(&fired);
+}
+
+const char *test_timeout1(void)
+{
+	/* Expiration order does not follow the order of registration. */
+	static const int delay[ORDERED] = { 3, 1, 4, 2 };
+	timeout_t ordered[ORDERED];
+
+	atomic_store(&fired, 0);
+
+	for (unsigned int i = 0; i < ORDERED; i++) {
+		timeout_initialize(&ordered[i]);
+		timeout_register(&ordered[i], delay[i] * 100000, order_handler,
+		    (void *) (uintptr_t) delay[i]);
+	}
+
+	thread_usleep(600000);
+
+	for (unsigned int i = 0; i < ORDERED; i++)
+		timeout_unregister(&ordered[i]);
+
+	if (atomic_load(&fired) != ORDERED)
+		return "Not all timeouts fired";
+
+	for (unsigned int i = 0; i < ORDERED; i++) {
+		if (order[i] != (int) i + 1)
+			return "Timeouts fired out of order";
+	}
+
+	timeout_t *timeouts = malloc(TIMEOUTS * sizeof(timeout_t));
+	if (timeouts == NULL)
+		return "Unable to allocate timeouts";
+
+	atomic_store(&fired, 0);
+
+	for (unsigned int i = 0; i < TIMEOUTS; i++)
+		timeout_initialize(&timeouts[i]);
+
+	/* Spread the deadlines over many seconds so that none fires. */
+	uint64_t start = get_cycle();
+	for (unsigned int i = 0; i < TIMEOUTS; i++) {
+		timeout_register(&timeouts[i], 60000000 + (i % 1000) * 1000,
+		    fail_handler, NULL);
+	}
+	uint64_t armed = get_cycle();
+
+	const char *rc = NULL;
+	for (unsigned int i = 0; i < TIMEOUTS; i++) {
+		if (!timeout_unregister(&timeouts[i]))
+			rc = "Unable to cancel timeout";
+	}
+	uint64_t cancelled = get_cycle();
+
+	TPRINTF("Armed %d timeouts in %" PRIu64 " cycles, cancelled them in %"
+	    PRIu64 " cycles\n", TIMEOUTS, armed - start, cancelled - armed);
+
+	free(timeouts);
+
+	if ((rc == NULL) && (atomic_load(&fired) != 0))
+		rc = "Cancelled timeout fired";
+
+	return rc;
+}
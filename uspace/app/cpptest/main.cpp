@@ -47,6 +47,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <deque>
@@ -68,6 +69,7 @@
 #include <numeric>
 #include <ostream>
 #include <ratio>
+#include <regex>
 #include <sstream>
 #include <stack>
 #include <streambuf>
@@ -100,8 +102,19 @@
 
 #include <__bits/trycatch.hpp>
 
-int main()
+#include "regex_bench.hpp"
+#include "sort_bench.hpp"
+
+int main(int argc, char* argv[])
 {
+    if (argc > 1 && std::strcmp(argv[1], "--bench") == 0)
+    {
+        cpptest::sort_bench();
+        cpptest::regex_bench();
+
+        return 0;
+    }
+
     std::test::test_set ts{};
     ts.add<std::test::vector_test>();
     ts.add<std::test::string_test>();
@@ -121,6 +134,8 @@ int main()
     ts.add<std::test::functional_test>();
     ts.add<std::test::algorithm_test>();
     ts.add<std::test::future_test>();
+    ts.add<std::test::atomic_test>();
+    ts.add<std::test::regex_test>();
 
     return ts.run(true) ? 0 : 1;
 }
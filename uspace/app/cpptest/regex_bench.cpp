@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <chrono>
+#include <cstdio>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "regex_bench.hpp"
+
+namespace cpptest
+{
+    namespace
+    {
+        constexpr std::size_t bench_lines{20'000};
+        constexpr unsigned int bench_rounds{3};
+
+        using lines_t = std::vector<std::string>;
+        using bench_clock = std::chrono::steady_clock;
+        using engine_t = std::aux::regex_engine;
+
+        struct pattern_t
+        {
+            const char* name;
+            const char* pattern;
+            bool full;
+            bool icase;
+            lines_t (*generate)();
+        };
+
+        struct engine_desc_t
+        {
+            const char* name;
+            engine_t engine;
+        };
+
+        class bench_rand
+        {
+            public:
+                unsigned int operator()()
+                {
+                    state_ ^= state_ << 13;
+                    state_ ^= state_ >> 17;
+                    state_ ^= state_ << 5;
+
+                    return state_;
+                }
+
+            private:
+                unsigned int state_{2463534242u};
+        };
+
+        lines_t generate_log()
+        {
+            static const char* levels[] = { "INFO", "INFO", "INFO", "DEBUG", "WARN", "ERROR" };
+            static const char* methods[] = { "GET", "GET", "POST", "PUT" };
+            static const char* resources[] = { "users", "orders", "items", "sessions" };
+            static const char* statuses[] = { "200", "200", "201", "304", "404", "500", "503" };
+            static const char* notes[] = { "", "", "", " upstream timeout", " connection reset" };
+
+            bench_rand gen{};
+            lines_t res{};
+            res.reserve(bench_lines);
+
+            char buffer[256];
+            for (std::size_t i = 0; i < bench_lines; ++i)
+            {
+                std::snprintf(
+                    buffer, sizeof(buffer),
+                    "2026-10-%02u %02u:%02u:%02u [%s] %s /api/v%u/%s/%u %s %ums%s",
+                    1 + gen() % 28, gen() % 24, gen() % 60, gen() % 60,
+                    levels[gen() % 6], methods[gen() % 4], 1 + gen() % 2,
+                    resources[gen() % 4], gen() % 100000, statuses[gen() % 7],
+                    gen() % 2000, notes[gen() % 5]
+                );
+                res.push_back(buffer);
+            }
+
+            return res;
+        }
+
+        lines_t generate_pathological()
+        {
+            // Exponential for backtracking, few lines are enough.
+            return lines_t(16, std::string(24, 'a'));
+        }
+
+        const pattern_t patterns[] = {
+            { "level", "\\[(WARN|ERROR)\\]", false, false, generate_log },
+            { "errors", "timeout|refused|reset", false, false, generate_log },
+            { "routing", "\\d{4}-\\d\\d-\\d\\d \\d\\d:\\d\\d:\\d\\d \\[\\w+\\] "
+                         "(GET|POST) /api/v\\d+/(\\w+)/\\d+ 5\\d\\d \\d+ms.*", true, false, generate_log },
+            { "icase", "post /API/V2/ORDERS", false, true, generate_log },
+            { "(a|aa)*b", "(a|aa)*b", false, false, generate_pathological }
+        };
+
+        const engine_desc_t engines[] = {
+            { "default", engine_t::automatic },
+            { "nfa", engine_t::nfa },
+            { "backtrack", engine_t::backtrack }
+        };
+
+        std::size_t run(const std::regex& re, const lines_t& lines, bool full,
+                        engine_t engine)
+        {
+            std::size_t matches{};
+            for (const auto& line: lines)
+            {
+                bool res{};
+                if (engine == engine_t::automatic)
+                {
+                    // What a filter would do, no submatches needed.
+                    if (full)
+                        res = std::regex_match(line, re);
+                    else
+                        res = std::regex_search(line, re);
+                }
+                else
+                {
+                    std::smatch m{};
+                    res = std::aux::regex_run(
+                        line.begin(), line.end(), m, re,
+                        std::regex_constants::match_default, full, engine
+                    );
+                }
+
+                if (res)
+                    ++matches;
+            }
+
+            return matches;
+        }
+    }
+
+    void regex_bench()
+    {
+        std::printf("Regex throughput, best of %u rounds [MiB/s]:\n", bench_rounds);
+
+        std::printf("%-12s", "");
+        for (const auto& engine: engines)
+            std::printf("%12s", engine.name);
+        std::printf("%10s\n", "matches");
+
+        for (const auto& pattern: patterns)
+        {
+            std::printf("%-12s", pattern.name);
+
+            auto flags = std::regex::ECMAScript;
+            if (pattern.icase)
+                flags = flags | std::regex::icase;
+            std::regex re{pattern.pattern, flags};
+
+            auto lines = pattern.generate();
+            std::size_t bytes{};
+            for (const auto& line: lines)
+                bytes += line.size();
+
+            std::size_t expected{};
+            bool consistent{true};
+            for (const auto& engine: engines)
+            {
+                bench_clock::rep best{};
+                for (unsigned int i = 0; i < bench_rounds; ++i)
+                {
+                    auto start = bench_clock::now();
+                    auto matches = run(re, lines, pattern.full, engine.engine);
+                    auto end = bench_clock::now();
+
+                    auto elapsed = (end - start).count();
+                    if (i == 0 || elapsed < best)
+                        best = elapsed;
+
+                    if (engine.engine == engine_t::automatic)
+                        expected = matches;
+                    else if (matches != expected)
+                        consistent = false;
+                }
+
+                // The clock ticks in microseconds.
+                if (best == 0)
+                    best = 1;
+                std::printf("%12.2f", (double)bytes * 1'000'000 / best / (1024 * 1024));
+            }
+
+            if (consistent)
+                std::printf("%10zu\n", expected);
+            else
+                std::printf("%10s\n", "MISMATCH");
+        }
+    }
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+#include "sort_bench.hpp"
+
+namespace cpptest
+{
+    namespace
+    {
+        constexpr std::size_t bench_size{100'000};
+        constexpr unsigned int bench_rounds{5};
+
+        using data_t = std::vector<int>;
+        using bench_clock = std::chrono::steady_clock;
+
+        struct input_t
+        {
+            const char* name;
+            data_t (*generate)(std::size_t);
+        };
+
+        struct algorithm_t
+        {
+            const char* name;
+            void (*sort)(data_t&);
+        };
+
+        /**
+         * Simple xorshift generator, we want the same input
+         * on every run and every algorithm.
+         */
+        class bench_rand
+        {
+            public:
+                unsigned int operator()()
+                {
+                    state_ ^= state_ << 13;
+                    state_ ^= state_ >> 17;
+                    state_ ^= state_ << 5;
+
+                    return state_;
+                }
+
+            private:
+                unsigned int state_{2463534242u};
+        };
+
+        data_t generate_random(std::size_t size)
+        {
+            bench_rand gen{};
+
+            data_t res(size);
+            for (auto& x: res)
+                x = static_cast<int>(gen());
+
+            return res;
+        }
+
+        data_t generate_sorted(std::size_t size)
+        {
+            data_t res(size);
+            for (std::size_t i = 0; i < size; ++i)
+                res[i] = static_cast<int>(i);
+
+            return res;
+        }
+
+        data_t generate_reversed(std::size_t size)
+        {
+            data_t res(size);
+            for (std::size_t i = 0; i < size; ++i)
+                res[i] = static_cast<int>(size - i);
+
+            return res;
+        }
+
+        data_t generate_duplicates(std::size_t size)
+        {
+            bench_rand gen{};
+
+            data_t res(size);
+            for (auto& x: res)
+                x = static_cast<int>(gen() % 16);
+
+            return res;
+        }
+
+        void sort_std(data_t& data)
+        {
+            std::sort(data.begin(), data.end());
+        }
+
+        void sort_stable(data_t& data)
+        {
+            std::stable_sort(data.begin(), data.end());
+        }
+
+        void sort_heap(data_t& data)
+        {
+            // This is what std::sort used to be.
+            std::make_heap(data.begin(), data.end());
+            std::sort_heap(data.begin(), data.end());
+        }
+
+        const input_t inputs[] = {
+            { "random", generate_random },
+            { "sorted", generate_sorted },
+            { "reversed", generate_reversed },
+            { "duplicates", generate_duplicates }
+        };
+
+        const algorithm_t algorithms[] = {
+            { "sort", sort_std },
+            { "stable_sort", sort_stable },
+            { "heapsort", sort_heap }
+        };
+    }
+
+    void sort_bench()
+    {
+        std::printf("Sorting %zu ints, best of %u rounds [ms]:\n",
+                    bench_size, bench_rounds);
+
+        std::printf("%-12s", "");
+        for (const auto& alg: algorithms)
+            std::printf("%14s", alg.name);
+        std::printf("\n");
+
+        for (const auto& input: inputs)
+        {
+            std::printf("%-12s", input.name);
+
+            auto original = input.generate(bench_size);
+            for (const auto& alg: algorithms)
+            {
+                bench_clock::rep best{};
+                bool sorted{true};
+
+                for (unsigned int i = 0; i < bench_rounds; ++i)
+                {
+                    auto data = original;
+
+                    auto start = bench_clock::now();
+                    alg.sort(data);
+                    auto end = bench_clock::now();
+
+                    auto elapsed = (end - start).count();
+                    if (i == 0 || elapsed < best)
+                        best = elapsed;
+
+                    sorted &= std::is_sorted(data.begin(), data.end());
+                }
+
+                if (sorted)
+                    std::printf("%11lld.%02lld", (long long)(best / 1000),
+                                (long long)((best % 1000) / 10));
+                else
+                    std::printf("%14s", "FAILED");
+            }
+
+            std::printf("\n");
+        }
+    }
+}
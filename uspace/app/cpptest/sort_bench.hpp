@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018 Jaroslav Jindrak
+ * Copyright (c) 2026 HelenOS contributors
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -26,9 +26,17 @@
  * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#ifndef LIBCPP_BITS_REGEX
-#define LIBCPP_BITS_REGEX
 
-#error "<regex> is not implemented"
+#ifndef CPPTEST_SORT_BENCH_HPP
+#define CPPTEST_SORT_BENCH_HPP
+
+namespace cpptest
+{
+    /**
+     * Compares the running time of std::sort, std::stable_sort
+     * and plain heapsort on differently shaped inputs.
+     */
+    void sort_bench();
+}
 
 #endif
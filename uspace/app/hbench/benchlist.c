@@ -38,13 +38,25 @@
 #include "hbench.h"
 
 benchmark_t *benchmarks[] = {
+	&benchmark_chash_table,
+	&benchmark_data_read,
+	&benchmark_data_write,
 	&benchmark_dir_read,
 	&benchmark_fibril_mutex,
+	&benchmark_fibril_yield,
 	&benchmark_file_read,
+	&benchmark_file_write,
+	&benchmark_fill_write,
 	&benchmark_malloc1,
 	&benchmark_malloc2,
+	&benchmark_malloc3,
+	&benchmark_mpmc_queue,
+	&benchmark_path_open,
+	&benchmark_path_stat,
 	&benchmark_ns_ping,
-	&benchmark_ping_pong
+	&benchmark_ping_pong,
+	&benchmark_short_lock,
+	&benchmark_touch
 };
 
 size_t benchmark_count = sizeof(benchmarks) / sizeof(benchmarks[0]);
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <stdlib.h>
+#include <str.h>
+#include <str_error.h>
+#include <vfs/vfs.h>
+#include "../hbench.h"
+
+#define BUFFER_SIZE (64 * 1024)
+
+/** Execute file writing benchmark.
+ *
+ * Every iteration creates the file, writes it sequentially and removes
+ * it again, so that all of its blocks are allocated anew. Point it to
+ * a freshly created file system image (e.g. one made by mkext4) to
+ * measure the block allocator rather than overwriting of cached blocks.
+ */
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	const char *path = bench_env_param_get(env, "filename", "/tmp/hbench-write");
+	const char *size_str = bench_env_param_get(env, "filesize", "8388608");
+	size_t file_size;
+
+	errno_t rc = str_size_t(size_str, NULL, 10, true, &file_size);
+	if (rc != EOK)
+		return bench_run_fail(run, "invalid file size '%s'", size_str);
+
+	char *buf = malloc(BUFFER_SIZE);
+	if (buf == NULL) {
+		return bench_run_fail(run, "failed to allocate %dB buffer", BUFFER_SIZE);
+	}
+	memset(buf, 0x5a, BUFFER_SIZE);
+
+	bool ret = true;
+
+	bench_run_start(run);
+	for (uint64_t i = 0; i < size; i++) {
+		int fd;
+		rc = vfs_lookup_open(path, WALK_MAY_CREATE | WALK_REGULAR,
+		    MODE_WRITE, &fd);
+		if (rc != EOK) {
+			bench_run_fail(run, "failed to create %s: %s",
+			    path, str_error(rc));
+			ret = false;
+			goto leave_free_buf;
+		}
+
+		aoff64_t pos = 0;
+		while (pos < file_size) {
+			size_t nwritten;
+			rc = vfs_write(fd, &pos, buf,
+			    min(file_size - pos, BUFFER_SIZE), &nwritten);
+			if (rc != EOK)
+				break;
+		}
+
+		vfs_put(fd);
+		if (rc == EOK)
+			rc = vfs_unlink_path(path);
+		if (rc != EOK) {
+			bench_run_fail(run, "failed to write %s: %s",
+			    path, str_error(rc));
+			ret = false;
+			goto leave_free_buf;
+		}
+	}
+	bench_run_stop(run);
+
+leave_free_buf:
+	free(buf);
+
+	return ret;
+}
+
+benchmark_t benchmark_file_write = {
+	.name = "file_write",
+	.desc = "Sequentially write a new file (use 'filename' and 'filesize' params to alter the defaults).",
+	.entry = &runner,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+/**
+ * @}
+ */
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <str.h>
+#include <str_error.h>
+#include <vfs/vfs.h>
+#include "../hbench.h"
+
+#define BUFFER_SIZE (64 * 1024)
+#define BALLAST_FILE_SIZE (16 * 1024 * 1024)
+
+/*
+ * The setup fills the file system under 'dirname' with ballast files until
+ * only 'free' percent of it is left free. The benchmark then repeatedly
+ * writes a file of 'filesize' bytes and truncates it again, so that each
+ * iteration allocates and frees clusters on a nearly full file system.
+ * Run it against a FAT32 image mounted with different 'free' values to
+ * see how write throughput depends on free space.
+ */
+static char *buffer = NULL;
+static size_t ballast_count = 0;
+static size_t file_size;
+
+static char *ballast_path(bench_env_t *env, size_t i)
+{
+	char *path;
+	const char *dir = bench_env_param_get(env, "dirname", "/tmp");
+
+	if (asprintf(&path, "%s/hbench-ballast-%zu", dir, i) < 0)
+		return NULL;
+	return path;
+}
+
+static errno_t write_file(int fd, size_t size)
+{
+	aoff64_t pos = 0;
+
+	while (size > 0) {
+		size_t nwritten;
+		size_t chunk = min(size, BUFFER_SIZE);
+		errno_t rc = vfs_write(fd, &pos, buffer, chunk, &nwritten);
+		if (rc != EOK)
+			return rc;
+		size -= nwritten;
+	}
+
+	return EOK;
+}
+
+static bool teardown(bench_env_t *env, bench_run_t *run)
+{
+	for (size_t i = 0; i < ballast_count; i++) {
+		char *path = ballast_path(env, i);
+		if (path != NULL) {
+			(void) vfs_unlink_path(path);
+			free(path);
+		}
+	}
+	ballast_count = 0;
+
+	free(buffer);
+	buffer = NULL;
+
+	return true;
+}
+
+static bool setup(bench_env_t *env, bench_run_t *run)
+{
+	const char *dir = bench_env_param_get(env, "dirname", "/tmp");
+	const char *free_str = bench_env_param_get(env, "free", "10");
+	const char *size_str = bench_env_param_get(env, "filesize", "1048576");
+	vfs_statfs_t st;
+	size_t free_pct;
+
+	errno_t rc = str_size_t(free_str, NULL, 10, true, &free_pct);
+	if ((rc != EOK) || (free_pct > 100))
+		return bench_run_fail(run, "invalid free space '%s' (0 to 100)", free_str);
+
+	rc = str_size_t(size_str, NULL, 10, true, &file_size);
+	if ((rc != EOK) || (file_size == 0))
+		return bench_run_fail(run, "invalid file size '%s'", size_str);
+
+	buffer = malloc(BUFFER_SIZE);
+	if (buffer == NULL)
+		return bench_run_fail(run, "failed to allocate %dB buffer", BUFFER_SIZE);
+	memset(buffer, 0xa5, BUFFER_SIZE);
+
+	rc = vfs_statfs_path(dir, &st);
+	if (rc != EOK) {
+		teardown(env, run);
+		return bench_run_fail(run, "failed to stat file system of %s: %s",
+		    dir, str_error(rc));
+	}
+
+	uint64_t total = st.f_blocks * st.f_bsize;
+	uint64_t avail = st.f_bfree * st.f_bsize;
+	uint64_t keep = total / 100 * free_pct + file_size;
+	uint64_t ballast = (avail > keep) ? avail - keep : 0;
+
+	while (ballast > 0) {
+		size_t size = min(ballast, BALLAST_FILE_SIZE);
+		char *path = ballast_path(env, ballast_count);
+		if (path == NULL) {
+			teardown(env, run);
+			return bench_run_fail(run, "out of memory");
+		}
+
+		int fd;
+		rc = vfs_lookup_open(path, WALK_MAY_CREATE | WALK_REGULAR,
+		    MODE_WRITE, &fd);
+		if (rc == EOK) {
+			ballast_count++;
+			rc = write_file(fd, size);
+			vfs_put(fd);
+		}
+		if (rc != EOK) {
+			bench_run_fail(run, "failed to fill %s: %s", path,
+			    str_error(rc));
+			free(path);
+			teardown(env, run);
+			return false;
+		}
+
+		free(path);
+		ballast -= size;
+	}
+
+	return true;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	const char *dir = bench_env_param_get(env, "dirname", "/tmp");
+	char *path;
+	int fd;
+
+	if (asprintf(&path, "%s/hbench-write", dir) < 0)
+		return bench_run_fail(run, "out of memory");
+
+	errno_t rc = vfs_lookup_open(path, WALK_MAY_CREATE | WALK_REGULAR,
+	    MODE_WRITE, &fd);
+	if (rc != EOK) {
+		bench_run_fail(run, "failed to create %s: %s", path,
+		    str_error(rc));
+		free(path);
+		return false;
+	}
+
+	bool ret = true;
+
+	bench_run_start(run);
+	for (uint64_t i = 0; i < size; i++) {
+		rc = write_file(fd, file_size);
+		if (rc == EOK)
+			rc = vfs_resize(fd, 0);
+		if (rc != EOK) {
+			bench_run_fail(run, "failed to write %s: %s", path,
+			    str_error(rc));
+			ret = false;
+			break;
+		}
+	}
+	bench_run_stop(run);
+
+	vfs_put(fd);
+	(void) vfs_unlink_path(path);
+	free(path);
+
+	return ret;
+}
+
+benchmark_t benchmark_fill_write = {
+	.name = "fill_write",
+	.desc = "Write and truncate a file on a nearly full file system (use 'dirname', 'free' and 'filesize' params).",
+	.entry = &runner,
+	.setup = &setup,
+	.teardown = &teardown
+};
+
+/**
+ * @}
+ */
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <str_error.h>
+#include <vfs/vfs.h>
+#include "../hbench.h"
+
+/** Execute path stat benchmark.
+ *
+ * Every iteration resolves the whole path again, so this mostly measures
+ * the cost of the path walk in VFS rather than that of the file system.
+ */
+static bool runner_stat(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	const char *path = bench_env_param_get(env, "path",
+	    "/data/web/helenos.png");
+	vfs_stat_t st;
+
+	bench_run_start(run);
+	for (uint64_t i = 0; i < size; i++) {
+		errno_t rc = vfs_stat_path(path, &st);
+		if (rc != EOK) {
+			return bench_run_fail(run, "failed to stat %s: %s",
+			    path, str_error(rc));
+		}
+	}
+	bench_run_stop(run);
+
+	return true;
+}
+
+/** Execute path open benchmark. */
+static bool runner_open(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	const char *path = bench_env_param_get(env, "path",
+	    "/data/web/helenos.png");
+
+	bench_run_start(run);
+	for (uint64_t i = 0; i < size; i++) {
+		int fd;
+		errno_t rc = vfs_lookup_open(path, WALK_REGULAR, MODE_READ, &fd);
+		if (rc != EOK) {
+			return bench_run_fail(run, "failed to open %s: %s",
+			    path, str_error(rc));
+		}
+		vfs_put(fd);
+	}
+	bench_run_stop(run);
+
+	return true;
+}
+
+benchmark_t benchmark_path_stat = {
+	.name = "path_stat",
+	.desc = "Repeatedly stat a deep path (use 'path' param to alter the default).",
+	.entry = &runner_stat,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+benchmark_t benchmark_path_open = {
+	.name = "path_open",
+	.desc = "Repeatedly open and close a deep path (use 'path' param to alter the default).",
+	.entry = &runner_open,
+	.setup = NULL,
+	.teardown = NULL
+};
+
+/**
+ * @}
+ */
@@ -99,6 +99,7 @@ typedef struct {
 
 extern void bench_run_init(bench_run_t *, char *, size_t);
 extern bool bench_run_fail(bench_run_t *, const char *, ...);
+extern size_t bench_runners_spawn(size_t);
 
 /*
  * We keep the following two functions inline to ensure that we start
@@ -131,13 +132,25 @@ extern benchmark_t *benchmarks[];
 extern size_t benchmark_count;
 
 /* Put your benchmark descriptors here (and also to benchlist.c). */
+extern benchmark_t benchmark_chash_table;
+extern benchmark_t benchmark_data_read;
+extern benchmark_t benchmark_data_write;
 extern benchmark_t benchmark_dir_read;
 extern benchmark_t benchmark_fibril_mutex;
+extern benchmark_t benchmark_fibril_yield;
 extern benchmark_t benchmark_file_read;
+extern benchmark_t benchmark_file_write;
+extern benchmark_t benchmark_fill_write;
 extern benchmark_t benchmark_malloc1;
 extern benchmark_t benchmark_malloc2;
+extern benchmark_t benchmark_malloc3;
+extern benchmark_t benchmark_mpmc_queue;
+extern benchmark_t benchmark_path_open;
+extern benchmark_t benchmark_path_stat;
 extern benchmark_t benchmark_ns_ping;
 extern benchmark_t benchmark_ping_pong;
+extern benchmark_t benchmark_short_lock;
+extern benchmark_t benchmark_touch;
 
 #endif
 
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <ipc_test.h>
+#include <mem.h>
+#include <async.h>
+#include <errno.h>
+#include <str.h>
+#include <str_error.h>
+#include "../hbench.h"
+
+/*
+ * Transfer size used when the 'size' parameter is not given. Measure
+ * several sizes (e.g. 512, 4096, 16384 and 65536) to see where the kernel
+ * switches from bouncing the data to copying it directly.
+ */
+#define DEFAULT_XFER_SIZE "65536"
+
+static ipc_test_t *test = NULL;
+static void *buffer = NULL;
+static size_t xfer_size;
+
+static bool setup(bench_env_t *env, bench_run_t *run)
+{
+	const char *size_str = bench_env_param_get(env, "size",
+	    DEFAULT_XFER_SIZE);
+
+	errno_t rc = str_size_t(size_str, NULL, 10, true, &xfer_size);
+	if ((rc != EOK) || (xfer_size == 0) || (xfer_size > DATA_XFER_LIMIT)) {
+		return bench_run_fail(run, "invalid transfer size '%s' (1 to %d)",
+		    size_str, DATA_XFER_LIMIT);
+	}
+
+	/* Heap memory, which the kernel is able to transfer directly. */
+	buffer = malloc(xfer_size);
+	if (buffer == NULL) {
+		return bench_run_fail(run, "failed to allocate %zuB buffer",
+		    xfer_size);
+	}
+
+	memset(buffer, 0x5a, xfer_size);
+
+	rc = ipc_test_create(&test);
+	if (rc != EOK) {
+		free(buffer);
+		buffer = NULL;
+		return bench_run_fail(run,
+		    "failed contacting IPC test server (have you run /srv/test/ipc-test?): %s (%d)",
+		    str_error(rc), rc);
+	}
+
+	return true;
+}
+
+static bool teardown(bench_env_t *env, bench_run_t *run)
+{
+	ipc_test_destroy(test);
+	free(buffer);
+	buffer = NULL;
+	return true;
+}
+
+static bool write_runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	bench_run_start(run);
+
+	for (uint64_t count = 0; count < niter; count++) {
+		errno_t rc = ipc_test_data_write(test, buffer, xfer_size);
+
+		if (rc != EOK) {
+			return bench_run_fail(run, "failed writing %zuB: %s (%d)",
+			    xfer_size, str_error(rc), rc);
+		}
+	}
+
+	bench_run_stop(run);
+
+	return true;
+}
+
+static bool read_runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	bench_run_start(run);
+
+	for (uint64_t count = 0; count < niter; count++) {
+		errno_t rc = ipc_test_data_read(test, buffer, xfer_size);
+
+		if (rc != EOK) {
+			return bench_run_fail(run, "failed reading %zuB: %s (%d)",
+			    xfer_size, str_error(rc), rc);
+		}
+	}
+
+	bench_run_stop(run);
+
+	return true;
+}
+
+benchmark_t benchmark_data_write = {
+	.name = "data_write",
+	.desc = "IPC data write bandwidth, one transfer per iteration (use 'size' param to alter the default of " DEFAULT_XFER_SIZE "B).",
+	.entry = &write_runner,
+	.setup = &setup,
+	.teardown = &teardown
+};
+
+benchmark_t benchmark_data_read = {
+	.name = "data_read",
+	.desc = "IPC data read bandwidth, one transfer per iteration (use 'size' param to alter the default of " DEFAULT_XFER_SIZE "B).",
+	.entry = &read_runner,
+	.setup = &setup,
+	.teardown = &teardown
+};
+
+/** @}
+ */
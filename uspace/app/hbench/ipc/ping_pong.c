@@ -34,14 +34,31 @@
 #include <ipc_test.h>
 #include <async.h>
 #include <errno.h>
+#include <macros.h>
+#include <str.h>
 #include <str_error.h>
 #include "../hbench.h"
 
+/*
+ * With the 'pipeline' parameter greater than one, that many pings are
+ * sent before waiting for the answers, which lets both sides batch the
+ * calls and answers in fewer syscalls.
+ */
 static ipc_test_t *test = NULL;
+static size_t pipeline;
 
 static bool setup(bench_env_t *env, bench_run_t *run)
 {
-	errno_t rc = ipc_test_create(&test);
+	const char *pipeline_str = bench_env_param_get(env, "pipeline", "1");
+
+	errno_t rc = str_size_t(pipeline_str, NULL, 10, true, &pipeline);
+	if ((rc != EOK) || (pipeline == 0) ||
+	    (pipeline > IPC_MAX_ASYNC_CALLS)) {
+		return bench_run_fail(run, "invalid pipeline depth '%s' (1 to %d)",
+		    pipeline_str, IPC_MAX_ASYNC_CALLS);
+	}
+
+	rc = ipc_test_create(&test);
 	if (rc != EOK) {
 		return bench_run_fail(run,
 		    "failed contacting IPC test server (have you run /srv/test/ipc-test?): %s (%d)",
@@ -61,8 +78,13 @@ static bool runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
 {
 	bench_run_start(run);
 
-	for (uint64_t count = 0; count < niter; count++) {
-		errno_t rc = ipc_test_ping(test);
+	for (uint64_t count = 0; count < niter; count += pipeline) {
+		errno_t rc;
+
+		if (pipeline == 1)
+			rc = ipc_test_ping(test);
+		else
+			rc = ipc_test_ping_many(test, min(pipeline, niter - count));
 
 		if (rc != EOK) {
 			return bench_run_fail(run, "failed sending ping message: %s (%d)",
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <errno.h>
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <str.h>
+#include "../hbench.h"
+
+/*
+ * Number of fibrils allocating at the same time when the 'threads'
+ * parameter is not given. The same number of runner threads is used,
+ * so comparing e.g. 1, 2, 4 and 8 shows how malloc scales.
+ */
+#define DEFAULT_THREADS "4"
+
+/** Number of blocks each fibril keeps allocated */
+#define WORKING_SET 64
+
+static FIBRIL_SEMAPHORE_INITIALIZE(workers_finished, 0);
+static atomic_bool workers_failed;
+
+static size_t threads;
+
+static errno_t worker(void *arg)
+{
+	uint64_t niter = *((uint64_t *) arg);
+	void *p[WORKING_SET] = { NULL };
+	unsigned int seed = (uintptr_t) &p;
+
+	for (uint64_t count = 0; count < niter; count++) {
+		size_t i = count % WORKING_SET;
+		free(p[i]);
+
+		/* Mostly small sizes, with an occasional bigger block. */
+		seed = seed * 1103515245 + 12345;
+		size_t size = (seed >> 16) % 256 + 1;
+		if ((seed >> 8) % 64 == 0)
+			size *= 16;
+
+		p[i] = malloc(size);
+		if (p[i] == NULL) {
+			atomic_store(&workers_failed, true);
+			break;
+		}
+	}
+
+	for (size_t i = 0; i < WORKING_SET; i++)
+		free(p[i]);
+
+	fibril_semaphore_up(&workers_finished);
+	return EOK;
+}
+
+static bool setup(bench_env_t *env, bench_run_t *run)
+{
+	const char *threads_str = bench_env_param_get(env, "threads",
+	    DEFAULT_THREADS);
+
+	errno_t rc = str_size_t(threads_str, NULL, 10, true, &threads);
+	if ((rc != EOK) || (threads == 0) || (threads > 64)) {
+		return bench_run_fail(run, "invalid thread count '%s' (1 to 64)",
+		    threads_str);
+	}
+
+	if (bench_runners_spawn(threads) < threads)
+		return bench_run_fail(run, "failed to spawn runner threads");
+
+	return true;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	uint64_t per_worker = niter / threads;
+	size_t started = 0;
+
+	atomic_store(&workers_failed, false);
+
+	bench_run_start(run);
+
+	for (size_t i = 0; i < threads; i++) {
+		fid_t fid = fibril_create(worker, &per_worker);
+		if (fid == 0)
+			break;
+
+		fibril_detach(fid);
+		fibril_add_ready(fid);
+		started++;
+	}
+
+	for (size_t i = 0; i < started; i++)
+		fibril_semaphore_down(&workers_finished);
+
+	bench_run_stop(run);
+
+	if (started < threads)
+		return bench_run_fail(run, "failed to create worker fibril");
+
+	if (atomic_load(&workers_failed))
+		return bench_run_fail(run, "failed to allocate memory");
+
+	return true;
+}
+
+benchmark_t benchmark_malloc3 = {
+	.name = "malloc3",
+	.desc = "User-space memory allocator benchmark, allocate and free from several threads",
+	.entry = &runner,
+	.setup = &setup,
+	.teardown = NULL
+};
+
+/** @}
+ */
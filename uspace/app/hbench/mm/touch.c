@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <align.h>
+#include <as.h>
+#include <errno.h>
+#include <stats.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <str.h>
+#include <str_error.h>
+#include <task.h>
+#include "../hbench.h"
+
+/*
+ * Area size used when the 'size' parameter is not given. Setting the
+ * 'populate' parameter to 'true' backs the whole area by a single
+ * as_area_populate() call instead of letting the first touch of each
+ * page fault it in, which shows the cost of the page fault path.
+ */
+#define DEFAULT_AREA_SIZE "16777216"
+
+static size_t area_size;
+static bool populate;
+static uint64_t faults;
+static uint64_t pages;
+
+static bool page_faults_get(uint64_t *count)
+{
+	stats_task_t *stats = stats_get_task(task_get_id());
+	if (stats == NULL)
+		return false;
+
+	*count = stats->page_faults;
+	free(stats);
+	return true;
+}
+
+static bool setup(bench_env_t *env, bench_run_t *run)
+{
+	const char *size_str = bench_env_param_get(env, "size",
+	    DEFAULT_AREA_SIZE);
+	const char *populate_str = bench_env_param_get(env, "populate",
+	    "false");
+
+	errno_t rc = str_size_t(size_str, NULL, 10, true, &area_size);
+	if ((rc != EOK) || (area_size < PAGE_SIZE)) {
+		return bench_run_fail(run, "invalid area size '%s' (at least %u)",
+		    size_str, PAGE_SIZE);
+	}
+
+	area_size = ALIGN_UP(area_size, PAGE_SIZE);
+	populate = (str_cmp(populate_str, "true") == 0);
+	faults = 0;
+	pages = 0;
+
+	return true;
+}
+
+static bool teardown(bench_env_t *env, bench_run_t *run)
+{
+	if (pages > 0) {
+		printf("touch: %" PRIu64 " page faults for %" PRIu64
+		    " pages touched\n", faults, pages);
+	}
+
+	return true;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t niter)
+{
+	uint64_t faults_before;
+	uint64_t faults_after;
+
+	if (!page_faults_get(&faults_before))
+		return bench_run_fail(run, "failed to read task statistics");
+
+	bench_run_start(run);
+
+	for (uint64_t count = 0; count < niter; count++) {
+		volatile uint8_t *area = as_area_create(AS_AREA_ANY, area_size,
+		    AS_AREA_READ | AS_AREA_WRITE | AS_AREA_CACHEABLE,
+		    AS_AREA_UNPAGED);
+		if (area == AS_MAP_FAILED) {
+			return bench_run_fail(run, "failed to create %zuB area",
+			    area_size);
+		}
+
+		if (populate) {
+			errno_t rc = as_area_populate((void *) area, area_size);
+			if (rc != EOK) {
+				as_area_destroy((void *) area);
+				return bench_run_fail(run,
+				    "failed to populate area: %s (%d)",
+				    str_error(rc), rc);
+			}
+		}
+
+		for (size_t off = 0; off < area_size; off += PAGE_SIZE)
+			area[off] = 1;
+
+		as_area_destroy((void *) area);
+	}
+
+	bench_run_stop(run);
+
+	if (page_faults_get(&faults_after))
+		faults += faults_after - faults_before;
+	pages += niter * (area_size / PAGE_SIZE);
+
+	return true;
+}
+
+benchmark_t benchmark_touch = {
+	.name = "touch",
+	.desc = "Anonymous memory benchmark, touch every page of a fresh area",
+	.entry = &runner,
+	.setup = &setup,
+	.teardown = &teardown
+};
+
+/** @}
+ */
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <adt/chash_table.h>
+#include <adt/mpmc_queue.h>
+#include <errno.h>
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <str.h>
+#include "../hbench.h"
+
+/*
+ * Contention benchmarks of the concurrent containers. The given number
+ * of fibrils, each on its own runner thread, hammer one shared queue or
+ * hash table at the same time.
+ */
+
+#define DEFAULT_THREADS "4"
+
+/** Number of hash table items owned by each worker */
+#define WORKER_KEYS 256
+
+typedef struct {
+	cht_link_t link;
+	size_t key;
+} item_t;
+
+static FIBRIL_SEMAPHORE_INITIALIZE(workers_finished, 0);
+static atomic_bool workers_failed;
+
+static size_t threads;
+static uint64_t per_worker;
+
+static mpmc_queue_t queue;
+static chash_table_t table;
+
+static size_t item_hash(const cht_link_t *item)
+{
+	return chash_table_get_inst(item, item_t, link)->key;
+}
+
+static size_t item_key_hash(const void *key)
+{
+	return *(const size_t *) key;
+}
+
+static bool item_equal(const cht_link_t *item1, const cht_link_t *item2)
+{
+	return item_hash(item1) == item_hash(item2);
+}
+
+static bool item_key_equal(const void *key, const cht_link_t *item)
+{
+	return *(const size_t *) key == item_hash(item);
+}
+
+static chash_table_ops_t item_ops = {
+	.hash = item_hash,
+	.key_hash = item_key_hash,
+	.equal = item_equal,
+	.key_equal = item_key_equal
+};
+
+static bool setup(bench_env_t *env, bench_run_t *run)
+{
+	const char *threads_str = bench_env_param_get(env, "threads",
+	    DEFAULT_THREADS);
+
+	errno_t rc = str_size_t(threads_str, NULL, 10, true, &threads);
+	if ((rc != EOK) || (threads == 0) || (threads > 64)) {
+		return bench_run_fail(run, "invalid thread count '%s' (1 to 64)",
+		    threads_str);
+	}
+
+	if (bench_runners_spawn(threads) < threads)
+		return bench_run_fail(run, "failed to spawn runner threads");
+
+	return true;
+}
+
+static errno_t queue_worker(void *arg)
+{
+	for (uint64_t i = 0; i < per_worker; i++) {
+		uint64_t value = i;
+
+		while (mpmc_queue_push(&queue, &value) != EOK)
+			fibril_yield();
+
+		while (mpmc_queue_pop(&queue, &value) != EOK)
+			fibril_yield();
+	}
+
+	fibril_semaphore_up(&workers_finished);
+	return EOK;
+}
+
+static errno_t table_worker(void *arg)
+{
+	size_t base = (uintptr_t) arg * WORKER_KEYS;
+	item_t *items = calloc(WORKER_KEYS, sizeof(item_t));
+	if (items == NULL) {
+		atomic_store(&workers_failed, true);
+		fibril_semaphore_up(&workers_finished);
+		return ENOMEM;
+	}
+
+	for (size_t i = 0; i < WORKER_KEYS; i++) {
+		items[i].key = base + i;
+		chash_table_insert(&table, &items[i].link);
+	}
+
+	for (uint64_t i = 0; i < per_worker; i++) {
+		size_t key = base + (i % WORKER_KEYS);
+		item_t *item = &items[i % WORKER_KEYS];
+
+		if (chash_table_find(&table, &key) != &item->link)
+			atomic_store(&workers_failed, true);
+
+		/* Every fourth operation modifies the table. */
+		if (i % 4 == 3) {
+			chash_table_remove_item(&table, &item->link);
+			chash_table_insert(&table, &item->link);
+		}
+	}
+
+	for (size_t i = 0; i < WORKER_KEYS; i++)
+		chash_table_remove_item(&table, &items[i].link);
+
+	free(items);
+	fibril_semaphore_up(&workers_finished);
+	return EOK;
+}
+
+static bool run_workers(bench_run_t *run, errno_t (*worker)(void *),
+    uint64_t size)
+{
+	size_t started = 0;
+
+	per_worker = size / threads;
+	atomic_store(&workers_failed, false);
+
+	bench_run_start(run);
+
+	for (size_t i = 0; i < threads; i++) {
+		fid_t fid = fibril_create(worker, (void *) i);
+		if (fid == 0)
+			break;
+
+		fibril_add_ready(fid);
+		started++;
+	}
+
+	for (size_t i = 0; i < started; i++)
+		fibril_semaphore_down(&workers_finished);
+
+	bench_run_stop(run);
+
+	if (started < threads)
+		return bench_run_fail(run, "failed to create worker fibril");
+
+	if (atomic_load(&workers_failed))
+		return bench_run_fail(run, "worker failed");
+
+	return true;
+}
+
+static bool queue_runner(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	if (mpmc_queue_init(&queue, 256, sizeof(uint64_t)) != EOK)
+		return bench_run_fail(run, "failed to create queue");
+
+	bool ok = run_workers(run, queue_worker, size);
+
+	mpmc_queue_fini(&queue);
+	return ok;
+}
+
+static bool table_runner(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	if (!chash_table_create(&table, threads * WORKER_KEYS, &item_ops))
+		return bench_run_fail(run, "failed to create hash table");
+
+	bool ok = run_workers(run, table_worker, size);
+
+	chash_table_destroy(&table);
+	return ok;
+}
+
+benchmark_t benchmark_mpmc_queue = {
+	.name = "mpmc_queue",
+	.desc = "Push and pop on a shared lock-free queue from several threads",
+	.entry = &queue_runner,
+	.setup = &setup,
+	.teardown = NULL
+};
+
+benchmark_t benchmark_chash_table = {
+	.name = "chash_table",
+	.desc = "Look up and update a shared concurrent hash table from several threads",
+	.entry = &table_runner,
+	.setup = &setup,
+	.teardown = NULL
+};
+
+/** @}
+ */
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <errno.h>
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <stdlib.h>
+#include <str.h>
+#include "../hbench.h"
+
+/*
+ * Throughput of fibril wake-ups and yields. Pairs of fibrils wake each
+ * other up through semaphores, yielding in between, on the given number
+ * of runner threads. There are as many pairs as there are runners.
+ */
+
+#define DEFAULT_RUNNERS "4"
+
+typedef struct {
+	fibril_semaphore_t ping;
+	fibril_semaphore_t pong;
+	uint64_t rounds;
+} pair_t;
+
+static FIBRIL_SEMAPHORE_INITIALIZE(fibrils_finished, 0);
+
+static size_t runners;
+
+static errno_t pinger(void *arg)
+{
+	pair_t *pair = arg;
+
+	for (uint64_t i = 0; i < pair->rounds; i++) {
+		fibril_semaphore_up(&pair->pong);
+		fibril_yield();
+		fibril_semaphore_down(&pair->ping);
+	}
+
+	fibril_semaphore_up(&fibrils_finished);
+	return EOK;
+}
+
+static errno_t ponger(void *arg)
+{
+	pair_t *pair = arg;
+
+	for (uint64_t i = 0; i < pair->rounds; i++) {
+		fibril_semaphore_down(&pair->pong);
+		fibril_yield();
+		fibril_semaphore_up(&pair->ping);
+	}
+
+	fibril_semaphore_up(&fibrils_finished);
+	return EOK;
+}
+
+static bool setup(bench_env_t *env, bench_run_t *run)
+{
+	const char *runners_str = bench_env_param_get(env, "runners",
+	    DEFAULT_RUNNERS);
+
+	errno_t rc = str_size_t(runners_str, NULL, 10, true, &runners);
+	if ((rc != EOK) || (runners == 0) || (runners > 32)) {
+		return bench_run_fail(run, "invalid runner count '%s' (1 to 32)",
+		    runners_str);
+	}
+
+	if (bench_runners_spawn(runners) < runners)
+		return bench_run_fail(run, "failed to spawn runner threads");
+
+	return true;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	pair_t *pairs = calloc(runners, sizeof(pair_t));
+	if (pairs == NULL)
+		return bench_run_fail(run, "failed to allocate fibril pairs");
+
+	for (size_t i = 0; i < runners; i++) {
+		fibril_semaphore_initialize(&pairs[i].ping, 0);
+		fibril_semaphore_initialize(&pairs[i].pong, 0);
+		pairs[i].rounds = size / runners;
+	}
+
+	size_t started = 0;
+
+	bench_run_start(run);
+
+	for (size_t i = 0; i < runners; i++) {
+		fid_t ping = fibril_create(pinger, &pairs[i]);
+		if (ping == 0)
+			break;
+
+		fid_t pong = fibril_create(ponger, &pairs[i]);
+		if (pong == 0) {
+			fibril_destroy(ping);
+			break;
+		}
+
+		fibril_add_ready(ping);
+		fibril_add_ready(pong);
+		started += 2;
+	}
+
+	for (size_t i = 0; i < started; i++)
+		fibril_semaphore_down(&fibrils_finished);
+
+	bench_run_stop(run);
+
+	free(pairs);
+
+	if (started < 2 * runners)
+		return bench_run_fail(run, "failed to create fibrils");
+
+	return true;
+}
+
+benchmark_t benchmark_fibril_yield = {
+	.name = "fibril_yield",
+	.desc = "Throughput of fibril wake-ups and yields on several runners",
+	.entry = &runner,
+	.setup = &setup,
+	.teardown = NULL
+};
+
+/** @}
+ */
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup hbench
+ * @{
+ */
+
+#include <as.h>
+#include <errno.h>
+#include <fibril.h>
+#include <fibril_synch.h>
+#include <stdatomic.h>
+#include <str.h>
+#include "../hbench.h"
+
+/*
+ * Contention benchmark for short critical sections. The given number of
+ * fibrils, each on its own runner thread, repeatedly take a lock held only
+ * for a moment, so contending threads should mostly get it without going
+ * to sleep. The lock parameter selects the lock:
+ *
+ * - futex: Each worker locks a fibril mutex of its own. No fibril is ever
+ *   parked, so the workers only contend on the futex which libc takes
+ *   briefly to protect the state of all fibril mutexes.
+ * - kernel: Each worker asks for the physical address of a page, which
+ *   takes the kernel mutex of the address space of the task.
+ * - fibril: All workers lock one fibril mutex, so contending fibrils are
+ *   parked on its wait list.
+ */
+
+#define DEFAULT_THREADS "4"
+#define DEFAULT_LOCK "futex"
+#define MAX_THREADS 64
+
+typedef enum {
+	LOCK_FUTEX,
+	LOCK_KERNEL,
+	LOCK_FIBRIL
+} lock_kind_t;
+
+static FIBRIL_SEMAPHORE_INITIALIZE(workers_finished, 0);
+static FIBRIL_MUTEX_INITIALIZE(lock);
+
+static fibril_mutex_t worker_locks[MAX_THREADS];
+static uint64_t worker_counters[MAX_THREADS];
+
+static lock_kind_t lock_kind;
+static size_t threads;
+static uint64_t per_worker;
+static uint64_t counter;
+static atomic_bool failed;
+
+static bool setup(bench_env_t *env, bench_run_t *run)
+{
+	const char *threads_str = bench_env_param_get(env, "threads",
+	    DEFAULT_THREADS);
+	const char *lock_str = bench_env_param_get(env, "lock", DEFAULT_LOCK);
+
+	errno_t rc = str_size_t(threads_str, NULL, 10, true, &threads);
+	if ((rc != EOK) || (threads == 0) || (threads > MAX_THREADS)) {
+		return bench_run_fail(run, "invalid thread count '%s' (1 to %d)",
+		    threads_str, MAX_THREADS);
+	}
+
+	if (str_cmp(lock_str, "futex") == 0) {
+		lock_kind = LOCK_FUTEX;
+	} else if (str_cmp(lock_str, "kernel") == 0) {
+		lock_kind = LOCK_KERNEL;
+	} else if (str_cmp(lock_str, "fibril") == 0) {
+		lock_kind = LOCK_FIBRIL;
+	} else {
+		return bench_run_fail(run, "invalid lock '%s' (futex, kernel "
+		    "or fibril)", lock_str);
+	}
+
+	for (size_t i = 0; i < threads; i++)
+		fibril_mutex_initialize(&worker_locks[i]);
+
+	if (bench_runners_spawn(threads) < threads)
+		return bench_run_fail(run, "failed to spawn runner threads");
+
+	return true;
+}
+
+static errno_t worker(void *arg)
+{
+	size_t idx = (size_t) arg;
+	uint64_t done = 0;
+	uintptr_t phys;
+
+	for (uint64_t i = 0; i < per_worker; i++) {
+		switch (lock_kind) {
+		case LOCK_FUTEX:
+			fibril_mutex_lock(&worker_locks[idx]);
+			done++;
+			fibril_mutex_unlock(&worker_locks[idx]);
+			break;
+		case LOCK_KERNEL:
+			if (as_get_physical_mapping(&worker_counters[idx],
+			    &phys) != EOK)
+				atomic_store(&failed, true);
+			done++;
+			break;
+		case LOCK_FIBRIL:
+			fibril_mutex_lock(&lock);
+			counter++;
+			fibril_mutex_unlock(&lock);
+			break;
+		}
+	}
+
+	/* Kept local until now not to share cache lines among workers. */
+	worker_counters[idx] = done;
+
+	fibril_semaphore_up(&workers_finished);
+	return EOK;
+}
+
+static bool runner(bench_env_t *env, bench_run_t *run, uint64_t size)
+{
+	size_t started = 0;
+
+	per_worker = size / threads;
+	counter = 0;
+	atomic_store(&failed, false);
+	for (size_t i = 0; i < threads; i++)
+		worker_counters[i] = 0;
+
+	bench_run_start(run);
+
+	for (size_t i = 0; i < threads; i++) {
+		fid_t fid = fibril_create(worker, (void *) i);
+		if (fid == 0)
+			break;
+
+		fibril_add_ready(fid);
+		started++;
+	}
+
+	for (size_t i = 0; i < started; i++)
+		fibril_semaphore_down(&workers_finished);
+
+	bench_run_stop(run);
+
+	if (started < threads)
+		return bench_run_fail(run, "failed to create worker fibril");
+
+	if (atomic_load(&failed))
+		return bench_run_fail(run, "failed to look up page mapping");
+
+	for (size_t i = 0; i < threads; i++)
+		counter += worker_counters[i];
+
+	if (counter != per_worker * threads) {
+		return bench_run_fail(run, "lost updates (%" PRIu64 " of %"
+		    PRIu64 ")", counter, per_worker * threads);
+	}
+
+	return true;
+}
+
+benchmark_t benchmark_short_lock = {
+	.name = "short_lock",
+	.desc = "Contended lock with short critical sections (use 'threads' and 'lock' params).",
+	.entry = &runner,
+	.setup = &setup,
+	.teardown = NULL
+};
+
+/** @}
+ */
@@ -33,10 +33,14 @@
  * @file
  */
 
+#include <fibril.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include "hbench.h"
 
+/** Number of fibril runner threads, including the main thread. */
+static size_t runners = 1;
+
 /** Initialize bench run structure.
  *
  * @param run Structure to intialize.
@@ -75,5 +79,21 @@ bool bench_run_fail(bench_run_t *run, const char *fmt, ...)
 	return false;
 }
 
+/** Make sure fibrils run on at least the given number of threads.
+ *
+ * Runner threads cannot be stopped, so benchmarks comparing
+ * different thread counts should be run in separate tasks.
+ *
+ * @param count Requested number of runner threads.
+ * @return Number of runner threads available.
+ */
+size_t bench_runners_spawn(size_t count)
+{
+	if (runners < count)
+		runners += fibril_test_spawn_runners(count - runners);
+
+	return runners;
+}
+
 /** @}
  */
@@ -54,11 +54,15 @@
 #define KERNEL_NAME  "kernel"
 #define INIT_PREFIX  "init:"
 
+/** Number of the most contended lock classes listed. */
+#define LOCKS_TOP  20
+
 typedef enum {
 	LIST_TASKS,
 	LIST_THREADS,
 	LIST_IPCCS,
 	LIST_CPUS,
+	LIST_LOCKS,
 	PRINT_LOAD,
 	PRINT_UPTIME,
 	PRINT_ARCH
@@ -193,6 +197,56 @@ static void list_cpus(void)
 	free(cpus);
 }
 
+static int cmp_locks(const void *a, const void *b)
+{
+	const stats_lock_t *la = (const stats_lock_t *) a;
+	const stats_lock_t *lb = (const stats_lock_t *) b;
+
+	if (la->contentions != lb->contentions)
+		return (la->contentions < lb->contentions) ? 1 : -1;
+
+	if (la->wait_cycles != lb->wait_cycles)
+		return (la->wait_cycles < lb->wait_cycles) ? 1 : -1;
+
+	return 0;
+}
+
+static void list_locks(void)
+{
+	size_t count;
+	stats_lock_t *locks = stats_get_locks(&count);
+
+	if ((locks == NULL) || (count == 0)) {
+		fprintf(stderr, "%s: Lock statistics not available "
+		    "(kernel built without CONFIG_LOCK_STATS?)\n", NAME);
+		free(locks);
+		return;
+	}
+
+	qsort(locks, count, sizeof(stats_lock_t), cmp_locks);
+
+	printf("[id ] [type ] [acquired] [contended] [wait cycles] "
+	    "[max wait ] [name]\n");
+
+	for (size_t i = 0; (i < count) && (i < LOCKS_TOP); i++) {
+		uint64_t acq, cont, wait, max;
+		char acq_suffix, cont_suffix, wait_suffix, max_suffix;
+
+		order_suffix(locks[i].acquisitions, &acq, &acq_suffix);
+		order_suffix(locks[i].contentions, &cont, &cont_suffix);
+		order_suffix(locks[i].wait_cycles, &wait, &wait_suffix);
+		order_suffix(locks[i].max_wait_cycles, &max, &max_suffix);
+
+		printf("%-5u %-7s %9" PRIu64 "%c %10" PRIu64 "%c "
+		    "%12" PRIu64 "%c %10" PRIu64 "%c %s\n",
+		    locks[i].id, locks[i].mutex ? "mutex" : "spin",
+		    acq, acq_suffix, cont, cont_suffix, wait, wait_suffix,
+		    max, max_suffix, locks[i].name);
+	}
+
+	free(locks);
+}
+
 static void print_load(void)
 {
 	size_t count;
@@ -367,7 +421,7 @@ static void print_arch(void)
 static void usage(const char *name)
 {
 	printf(
-	    "Usage: %s [-t task_id] [-i task_id] [-at] [-ai] [-c] [-l] [-u] [-d]\n"
+	    "Usage: %s [-t task_id] [-i task_id] [-at] [-ai] [-c] [-k] [-l] [-u] [-d]\n"
 	    "\n"
 	    "Options:\n"
 	    "\t-t task_id | --task=task_id\n"
@@ -385,6 +439,9 @@ static void usage(const char *name)
 	    "\t-c | --cpus\n"
 	    "\t\tList CPUs\n"
 	    "\n"
+	    "\t-k | --locks\n"
+	    "\t\tList the most contended kernel locks\n"
+	    "\n"
 	    "\t-l | --load\n"
 	    "\t\tPrint system load\n"
 	    "\n"
@@ -468,6 +525,12 @@ int main(int argc, char *argv[])
 			continue;
 		}
 
+		/* Locks */
+		if ((off = arg_parse_short_long(argv[i], "-k", "--locks")) != -1) {
+			output_toggle = LIST_LOCKS;
+			continue;
+		}
+
 		/* Load */
 		if ((off = arg_parse_short_long(argv[i], "-l", "--load")) != -1) {
 			output_toggle = PRINT_LOAD;
@@ -500,6 +563,9 @@ int main(int argc, char *argv[])
 	case LIST_CPUS:
 		list_cpus();
 		break;
+	case LIST_LOCKS:
+		list_locks();
+		break;
 	case PRINT_LOAD:
 		print_load();
 		break;
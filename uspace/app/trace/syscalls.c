@@ -66,6 +66,7 @@ const sc_desc_t syscall_desc[] = {
 	[SYS_AS_AREA_CHANGE_FLAGS] = { "as_area_change_flags", 2, V_ERRNO },
 	[SYS_AS_AREA_GET_INFO] = { "as_area_get_info", 2, V_ERRNO },
 	[SYS_AS_AREA_DESTROY] = { "as_area_destroy", 1, V_ERRNO },
+	[SYS_AS_AREA_POPULATE] = { "as_area_populate", 2, V_ERRNO },
 
 	/* Page mapping related syscalls. */
 	[SYS_PAGE_FIND_MAPPING] = { "page_find_mapping", 2, V_ERRNO },
@@ -78,6 +79,8 @@ const sc_desc_t syscall_desc[] = {
 	[SYS_IPC_FORWARD_FAST] = { "ipc_forward_fast", 6, V_ERRNO },
 	[SYS_IPC_FORWARD_SLOW] = { "ipc_forward_slow", 3, V_ERRNO },
 	[SYS_IPC_WAIT] = { "ipc_wait_for_call", 3, V_HASH },
+	[SYS_IPC_WAIT_MANY] = { "ipc_wait_many", 5, V_ERRNO },
+	[SYS_IPC_SUBMIT] = { "ipc_submit", 2, V_ERRNO },
 	[SYS_IPC_POKE] = { "ipc_poke", 0, V_ERRNO },
 	[SYS_IPC_HANGUP] = { "ipc_hangup", 1, V_ERRNO },
 	[SYS_IPC_CONNECT_KBOX] = { "ipc_connect_kbox", 2, V_ERRNO },
@@ -58,20 +58,60 @@
 
 #define MAX_WRITE_RETRIES 10
 
+/** Cache size in bytes used when the client does not specify block count. */
+#define CACHE_DEFAULT_SIZE	(4 * 1024 * 1024)
+/** Minimum number of blocks kept in the cache. */
+#define CACHE_MIN_BLOCKS	32
+
+/** Share (in percent) of the cache which the protected segment may occupy. */
+#define CACHE_PROTECTED_SHARE	75
+
+/** Initial read-ahead window in blocks. */
+#define READAHEAD_MIN	4
+/** Maximum read-ahead window in blocks. */
+#define READAHEAD_MAX	64
+/** Number of the most recent evictions remembered by the cache. */
+#define EVICT_LOG	64
+
+/** Interval in which the write-behind flusher wakes up. */
+#define FLUSH_INTERVAL_USEC	1000000
+/** Maximum number of dirty blocks collected in one flusher pass. */
+#define FLUSH_BATCH	64
+
 /** Lock protecting the device connection list */
 static FIBRIL_MUTEX_INITIALIZE(dcl_lock);
 /** Device connection list head. */
 static LIST_INITIALIZE(dcl);
 
+/** Block cache.
+ *
+ * Unreferenced blocks are kept in a segmented LRU. Blocks which were used
+ * only once since they entered the cache sit on the probation list, blocks
+ * which were referenced again are moved to the protected list. Blocks are
+ * recycled from the probation list first, so that a sequential scan cannot
+ * evict the working set. Both lists are kept in LRU order with the least
+ * recently used block at the head.
+ */
 typedef struct {
 	fibril_mutex_t lock;
 	size_t lblock_size;       /**< Logical block size. */
 	unsigned blocks_cluster;  /**< Physical blocks per block_t */
-	unsigned block_count;     /**< Total number of blocks. */
+	unsigned block_count;     /**< Maximum number of cached blocks. */
 	unsigned blocks_cached;   /**< Number of cached blocks. */
 	hash_table_t block_hash;
-	list_t free_list;
+	list_t probation_list;    /**< Unreferenced blocks used once. */
+	list_t protected_list;    /**< Unreferenced blocks used repeatedly. */
+	unsigned protected_cnt;   /**< Number of blocks on protected_list. */
 	enum cache_mode mode;
+	aoff64_t seq_next;        /**< Expected next block of a sequential read. */
+	size_t ra_window;         /**< Current read-ahead window. */
+	unsigned generation;      /**< Bumped when a block leaves the cache. */
+	/** Addresses of the blocks which left the cache, by generation. */
+	aoff64_t evicted[EVICT_LOG];
+	fibril_condvar_t flush_cv;
+	bool flusher_run;         /**< Flusher fibril should keep running. */
+	bool flusher_active;      /**< Flusher fibril has not terminated yet. */
+	block_cache_stats_t stats;
 } cache_t;
 
 typedef struct {
@@ -267,6 +307,244 @@ static hash_table_ops_t cache_ops = {
 	.remove_callback = NULL
 };
 
+/** Put an unreferenced block on the tail of its LRU segment.
+ *
+ * If the protected segment grows over its share of the cache, its least
+ * recently used block is demoted to the probation segment.
+ *
+ * Must be called with the cache lock held.
+ */
+static void cache_release(cache_t *cache, block_t *b)
+{
+	if (!b->reused) {
+		list_append(&b->free_link, &cache->probation_list);
+		return;
+	}
+
+	list_append(&b->free_link, &cache->protected_list);
+	cache->protected_cnt++;
+
+	if (cache->protected_cnt * 100 >
+	    cache->block_count * CACHE_PROTECTED_SHARE) {
+		block_t *old = list_get_instance(
+		    list_first(&cache->protected_list), block_t, free_link);
+
+		list_remove(&old->free_link);
+		cache->protected_cnt--;
+		old->reused = false;
+		list_append(&old->free_link, &cache->probation_list);
+	}
+}
+
+/** Take an unreferenced block off its LRU segment.
+ *
+ * Must be called with the cache lock held.
+ */
+static void cache_unlink(cache_t *cache, block_t *b)
+{
+	list_remove(&b->free_link);
+	if (b->reused)
+		cache->protected_cnt--;
+}
+
+/** Find the unreferenced block which should be recycled first.
+ *
+ * Must be called with the cache lock held.
+ */
+static block_t *cache_victim(cache_t *cache)
+{
+	link_t *link = list_first(&cache->probation_list);
+	if (link == NULL)
+		link = list_first(&cache->protected_list);
+	if (link == NULL)
+		return NULL;
+
+	return list_get_instance(link, block_t, free_link);
+}
+
+static int block_pba_cmp(const void *a, const void *b)
+{
+	const block_t *ba = *(const block_t * const *) a;
+	const block_t *bb = *(const block_t * const *) b;
+
+	if (ba->pba < bb->pba)
+		return -1;
+	if (ba->pba > bb->pba)
+		return 1;
+	return 0;
+}
+
+/** Collect dirty unreferenced blocks from one LRU segment.
+ *
+ * The collected blocks get a reference so that they cannot be recycled
+ * while they are being written back.
+ *
+ * Must be called with the cache lock held.
+ *
+ * @return Number of blocks in @a batch.
+ */
+static size_t cache_collect_dirty(cache_t *cache, list_t *list,
+    block_t **batch, size_t cnt)
+{
+	list_foreach_safe(*list, cur, next) {
+		if (cnt == FLUSH_BATCH)
+			break;
+
+		block_t *b = list_get_instance(cur, block_t, free_link);
+		fibril_mutex_lock(&b->lock);
+		if (b->dirty && !b->toxic) {
+			cache_unlink(cache, b);
+			b->refcnt++;
+			batch[cnt++] = b;
+		}
+		fibril_mutex_unlock(&b->lock);
+	}
+
+	return cnt;
+}
+
+/** Write back a run of blocks with adjacent physical addresses.
+ *
+ * The dirty flag is cleared before the contents are copied, so that a
+ * modification made in the meantime marks the block dirty again.
+ */
+static errno_t cache_write_run(devcon_t *devcon, block_t **run, size_t n)
+{
+	cache_t *cache = devcon->cache;
+	size_t size = n * cache->lblock_size;
+	void *buf = NULL;
+	errno_t rc = EOK;
+	size_t i;
+
+	if (n > 1)
+		buf = malloc(size);
+
+	if (buf == NULL) {
+		for (i = 0; i < n; i++) {
+			block_t *b = run[i];
+
+			fibril_mutex_lock(&b->lock);
+			b->dirty = false;
+			errno_t wrc = write_blocks(devcon, b->pba,
+			    cache->blocks_cluster, b->data, b->size);
+			if (wrc != EOK) {
+				b->dirty = true;
+				b->write_failures++;
+				rc = wrc;
+			} else {
+				b->write_failures = 0;
+			}
+			fibril_mutex_unlock(&b->lock);
+		}
+		return rc;
+	}
+
+	for (i = 0; i < n; i++) {
+		fibril_mutex_lock(&run[i]->lock);
+		run[i]->dirty = false;
+		memcpy(buf + i * cache->lblock_size, run[i]->data,
+		    cache->lblock_size);
+		fibril_mutex_unlock(&run[i]->lock);
+	}
+
+	rc = write_blocks(devcon, run[0]->pba, n * cache->blocks_cluster,
+	    buf, size);
+
+	for (i = 0; i < n; i++) {
+		fibril_mutex_lock(&run[i]->lock);
+		if (rc != EOK) {
+			run[i]->dirty = true;
+			run[i]->write_failures++;
+		} else {
+			run[i]->write_failures = 0;
+		}
+		fibril_mutex_unlock(&run[i]->lock);
+	}
+
+	free(buf);
+	return rc;
+}
+
+/** Write all dirty unreferenced blocks back to the device.
+ *
+ * Dirty blocks are sorted by their physical address and each run of
+ * adjacent blocks is written by a single request.
+ *
+ * @param devcon Device connection
+ * @return EOK on success or an error code
+ */
+static errno_t cache_flush(devcon_t *devcon)
+{
+	cache_t *cache = devcon->cache;
+	block_t *batch[FLUSH_BATCH];
+	errno_t rc = EOK;
+	size_t cnt;
+
+	do {
+		fibril_mutex_lock(&cache->lock);
+		cnt = cache_collect_dirty(cache, &cache->probation_list,
+		    batch, 0);
+		cnt = cache_collect_dirty(cache, &cache->protected_list,
+		    batch, cnt);
+		fibril_mutex_unlock(&cache->lock);
+
+		qsort(batch, cnt, sizeof(block_t *), block_pba_cmp);
+
+		size_t i = 0;
+		size_t writes = 0;
+		while (i < cnt) {
+			size_t n = 1;
+			while (i + n < cnt && batch[i + n]->pba ==
+			    batch[i + n - 1]->pba + cache->blocks_cluster)
+				n++;
+
+			errno_t wrc = cache_write_run(devcon, &batch[i], n);
+			if (wrc != EOK)
+				rc = wrc;
+			writes++;
+			i += n;
+		}
+
+		fibril_mutex_lock(&cache->lock);
+		cache->stats.flush_writes += writes;
+		cache->stats.flush_blocks += cnt;
+		fibril_mutex_unlock(&cache->lock);
+
+		for (i = 0; i < cnt; i++)
+			(void) block_put(batch[i]);
+	} while (cnt == FLUSH_BATCH && rc == EOK);
+
+	return rc;
+}
+
+/** Write-behind flusher fibril.
+ *
+ * Periodically writes dirty blocks of a write-back cache to the device so
+ * that block_get() rarely has to write back a block it wants to recycle.
+ */
+static errno_t cache_flusher(void *arg)
+{
+	devcon_t *devcon = (devcon_t *) arg;
+	cache_t *cache = devcon->cache;
+
+	fibril_mutex_lock(&cache->lock);
+	while (cache->flusher_run) {
+		(void) fibril_condvar_wait_timeout(&cache->flush_cv,
+		    &cache->lock, FLUSH_INTERVAL_USEC);
+		if (!cache->flusher_run)
+			break;
+
+		fibril_mutex_unlock(&cache->lock);
+		(void) cache_flush(devcon);
+		fibril_mutex_lock(&cache->lock);
+	}
+
+	cache->flusher_active = false;
+	fibril_condvar_broadcast(&cache->flush_cv);
+	fibril_mutex_unlock(&cache->lock);
+	return EOK;
+}
+
 errno_t block_cache_init(service_id_t service_id, size_t size, unsigned blocks,
     enum cache_mode mode)
 {
@@ -281,11 +559,20 @@ errno_t block_cache_init(service_id_t service_id, size_t size, unsigned blocks,
 		return ENOMEM;
 
 	fibril_mutex_initialize(&cache->lock);
-	list_initialize(&cache->free_list);
+	list_initialize(&cache->probation_list);
+	list_initialize(&cache->protected_list);
+	cache->protected_cnt = 0;
 	cache->lblock_size = size;
 	cache->block_count = blocks;
 	cache->blocks_cached = 0;
 	cache->mode = mode;
+	cache->seq_next = 0;
+	cache->ra_window = 0;
+	cache->generation = 0;
+	fibril_condvar_initialize(&cache->flush_cv);
+	cache->flusher_run = false;
+	cache->flusher_active = false;
+	memset(&cache->stats, 0, sizeof(cache->stats));
 
 	/* Allow 1:1 or small-to-large block size translation */
 	if (cache->lblock_size % devcon->pblock_size != 0) {
@@ -295,12 +582,33 @@ errno_t block_cache_init(service_id_t service_id, size_t size, unsigned blocks,
 
 	cache->blocks_cluster = cache->lblock_size / devcon->pblock_size;
 
+	if (cache->block_count == 0) {
+		cache->block_count = max(CACHE_DEFAULT_SIZE / cache->lblock_size,
+		    CACHE_MIN_BLOCKS);
+	}
+
 	if (!hash_table_create(&cache->block_hash, 0, 0, &cache_ops)) {
 		free(cache);
 		return ENOMEM;
 	}
 
+	fid_t flusher = 0;
+	if (mode == CACHE_MODE_WB) {
+		flusher = fibril_create(cache_flusher, devcon);
+		if (flusher == 0) {
+			hash_table_destroy(&cache->block_hash);
+			free(cache);
+			return ENOMEM;
+		}
+		cache->flusher_run = true;
+		cache->flusher_active = true;
+	}
+
 	devcon->cache = cache;
+
+	if (flusher != 0)
+		fibril_add_ready(flusher);
+
 	return EOK;
 }
 
@@ -316,16 +624,26 @@ errno_t block_cache_fini(service_id_t service_id)
 		return EOK;
 	cache = devcon->cache;
 
+	/* Stop the write-behind flusher. */
+	fibril_mutex_lock(&cache->lock);
+	cache->flusher_run = false;
+	fibril_condvar_broadcast(&cache->flush_cv);
+	while (cache->flusher_active)
+		fibril_condvar_wait(&cache->flush_cv, &cache->lock);
+	fibril_mutex_unlock(&cache->lock);
+
+	rc = cache_flush(devcon);
+	if (rc != EOK)
+		return rc;
+
 	/*
 	 * We are expecting to find all blocks for this device handle on the
-	 * free list, i.e. the block reference count should be zero. Do not
+	 * free lists, i.e. the block reference count should be zero. Do not
 	 * bother with the cache and block locks because we are single-threaded.
 	 */
-	while (!list_empty(&cache->free_list)) {
-		block_t *b = list_get_instance(list_first(&cache->free_list),
-		    block_t, free_link);
-
-		list_remove(&b->free_link);
+	block_t *b;
+	while ((b = cache_victim(cache)) != NULL) {
+		cache_unlink(cache, b);
 		if (b->dirty) {
 			rc = write_blocks(devcon, b->pba, cache->blocks_cluster,
 			    b->data, b->size);
@@ -346,13 +664,35 @@ errno_t block_cache_fini(service_id_t service_id)
 	return EOK;
 }
 
-#define CACHE_LO_WATERMARK	10
-#define CACHE_HI_WATERMARK	20
+/** Get block cache statistics.
+ *
+ * @param service_id Service ID of the block device
+ * @param stats Place to store the statistics
+ * @return EOK on success, ENOENT if the device has no cache
+ */
+errno_t block_cache_get_stats(service_id_t service_id,
+    block_cache_stats_t *stats)
+{
+	devcon_t *devcon = devcon_search(service_id);
+	cache_t *cache;
+
+	if (!devcon || !devcon->cache)
+		return ENOENT;
+	cache = devcon->cache;
+
+	fibril_mutex_lock(&cache->lock);
+	*stats = cache->stats;
+	fibril_mutex_unlock(&cache->lock);
+
+	return EOK;
+}
+
 static bool cache_can_grow(cache_t *cache)
 {
-	if (cache->blocks_cached < CACHE_LO_WATERMARK)
+	if (cache->blocks_cached < cache->block_count)
 		return true;
-	if (!list_empty(&cache->free_list))
+	if (!list_empty(&cache->probation_list) ||
+	    !list_empty(&cache->protected_list))
 		return false;
 	return true;
 }
@@ -364,10 +704,158 @@ static void block_initialize(block_t *b)
 	b->write_failures = 0;
 	b->dirty = false;
 	b->toxic = false;
+	b->reused = false;
+	b->readahead = false;
 	fibril_rwlock_initialize(&b->contents_lock);
 	link_initialize(&b->free_link);
 }
 
+/** Detect sequential access and compute the read-ahead window.
+ *
+ * Called on a cache miss with the cache lock held. The window opens when a
+ * miss hits the block following the previous read and doubles with every
+ * further sequential miss. Any other miss closes it again.
+ *
+ * @param devcon Device connection
+ * @param ba Logical address of the missed block
+ * @return Number of blocks following @a ba to read along with it
+ */
+static size_t cache_readahead_window(devcon_t *devcon, aoff64_t ba)
+{
+	cache_t *cache = devcon->cache;
+	aoff64_t last;
+	size_t window;
+
+	if (ba == cache->seq_next) {
+		cache->ra_window = min(max(2 * cache->ra_window,
+		    (size_t) READAHEAD_MIN), (size_t) READAHEAD_MAX);
+	} else {
+		cache->ra_window = 0;
+	}
+
+	/* Stay within the blocks which block_get() would accept. */
+	last = (devcon->pblocks - 1) / cache->blocks_cluster - 1;
+	window = min(cache->ra_window, last - ba);
+	window = min(window, cache->block_count / 2);
+
+	cache->seq_next = ba + 1 + window;
+	return window;
+}
+
+/** Record that a block has left the cache.
+ *
+ * @param cache Cache
+ * @param lba Logical address of the block
+ */
+static void cache_evicted(cache_t *cache, aoff64_t lba)
+{
+	cache->generation++;
+	cache->evicted[cache->generation % EVICT_LOG] = lba;
+}
+
+/** Find out whether a block may have left the cache since a generation.
+ *
+ * Only the most recent evictions are remembered. Should more blocks have
+ * left the cache since, any block is assumed to be among them.
+ *
+ * @param cache Cache
+ * @param generation Cache generation
+ * @param lba Logical address of the block
+ */
+static bool cache_evicted_since(cache_t *cache, unsigned generation,
+    aoff64_t lba)
+{
+	if (cache->generation - generation > EVICT_LOG)
+		return true;
+
+	for (unsigned g = generation + 1; g != cache->generation + 1; g++) {
+		if (cache->evicted[g % EVICT_LOG] == lba)
+			return true;
+	}
+
+	return false;
+}
+
+/** Insert blocks read ahead into the cache.
+ *
+ * Blocks which are already cached are skipped as the cached copy may be
+ * newer. The new blocks go to the probation segment without a reference.
+ * Only clean blocks from the probation segment are recycled, so read-ahead
+ * neither causes writes nor evicts the protected segment.
+ *
+ * The blocks were read without the cache lock held. A block which left the
+ * cache in the meantime may have been written back after the read, so its
+ * data read ahead is dropped.
+ *
+ * @param devcon Device connection
+ * @param ba Logical address of the first block
+ * @param cnt Number of blocks
+ * @param data Contents of the blocks
+ * @param generation Cache generation at the time the read was started
+ */
+static void cache_readahead_insert(devcon_t *devcon, aoff64_t ba, size_t cnt,
+    void *data, unsigned generation)
+{
+	cache_t *cache = devcon->cache;
+
+	fibril_mutex_lock(&cache->lock);
+
+	for (size_t i = 0; i < cnt; i++) {
+		aoff64_t lba = ba + i;
+		block_t *b;
+
+		if (hash_table_find(&cache->block_hash, &lba) != NULL)
+			continue;
+
+		if (cache_evicted_since(cache, generation, lba)) {
+			cache->stats.readahead_dropped++;
+			continue;
+		}
+
+		if (cache->blocks_cached < cache->block_count) {
+			b = malloc(sizeof(block_t));
+			if (!b)
+				break;
+			b->data = malloc(cache->lblock_size);
+			if (!b->data) {
+				free(b);
+				break;
+			}
+			cache->blocks_cached++;
+		} else {
+			link_t *link = list_first(&cache->probation_list);
+			if (link == NULL)
+				break;
+			b = list_get_instance(link, block_t, free_link);
+
+			/* The block may be being written back by block_get(). */
+			if (!fibril_mutex_trylock(&b->lock))
+				break;
+			bool dirty = b->dirty;
+			fibril_mutex_unlock(&b->lock);
+			if (dirty)
+				break;
+
+			cache_unlink(cache, b);
+			hash_table_remove_item(&cache->block_hash, &b->hash_link);
+			cache_evicted(cache, b->lba);
+		}
+
+		block_initialize(b);
+		b->refcnt = 0;
+		b->readahead = true;
+		b->service_id = devcon->service_id;
+		b->size = cache->lblock_size;
+		b->lba = lba;
+		b->pba = ba_ltop(devcon, lba);
+		memcpy(b->data, data + i * cache->lblock_size, cache->lblock_size);
+		hash_table_insert(&cache->block_hash, &b->hash_link);
+		cache_release(cache, b);
+		cache->stats.readahead++;
+	}
+	fibril_mutex_unlock(&cache->lock);
+}
+
 /** Instantiate a block in memory and get a reference to it.
  *
  * @param block			Pointer to where the function will store the
@@ -385,8 +873,10 @@ errno_t block_get(block_t **block, service_id_t service_id, aoff64_t ba, int fla
 	devcon_t *devcon;
 	cache_t *cache;
 	block_t *b;
-	link_t *link;
 	aoff64_t p_ba;
+	size_t ra;
+	void *ra_buf;
+	unsigned ra_gen;
 	errno_t rc;
 
 	devcon = devcon_search(service_id);
@@ -421,7 +911,15 @@ retry:
 		b = hash_table_get_inst(hlink, block_t, hash_link);
 		fibril_mutex_lock(&b->lock);
 		if (b->refcnt++ == 0)
-			list_remove(&b->free_link);
+			cache_unlink(cache, b);
+		if (b->readahead) {
+			/* This is the first use of a block read ahead. */
+			b->readahead = false;
+			cache->stats.readahead_hits++;
+		} else {
+			b->reused = true;
+		}
+		cache->stats.hits++;
 		if (b->toxic)
 			rc = EIO;
 		fibril_mutex_unlock(&b->lock);
@@ -430,6 +928,7 @@ retry:
 		/*
 		 * The block was not found in the cache.
 		 */
+		cache->stats.misses++;
 		if (cache_can_grow(cache)) {
 			/*
 			 * We can grow the cache by allocating new blocks.
@@ -448,16 +947,15 @@ retry:
 			cache->blocks_cached++;
 		} else {
 			/*
-			 * Try to recycle a block from the free list.
+			 * Try to recycle a block from the free lists.
 			 */
 		recycle:
-			if (list_empty(&cache->free_list)) {
+			b = cache_victim(cache);
+			if (b == NULL) {
 				fibril_mutex_unlock(&cache->lock);
 				rc = ENOMEM;
 				goto out;
 			}
-			link = list_first(&cache->free_list);
-			b = list_get_instance(link, block_t, free_link);
 
 			fibril_mutex_lock(&b->lock);
 			if (b->dirty) {
@@ -466,12 +964,13 @@ retry:
 				 * device before it changes identity. Do this
 				 * while not holding the cache lock so that
 				 * concurrency is not impeded. Also move the
-				 * block to the end of the free list so that we
-				 * do not slow down other instances of
-				 * block_get() draining the free list.
+				 * block to the end of the probation list so
+				 * that we do not slow down other instances of
+				 * block_get() draining the free lists.
 				 */
-				list_remove(&b->free_link);
-				list_append(&b->free_link, &cache->free_list);
+				cache_unlink(cache, b);
+				b->reused = false;
+				list_append(&b->free_link, &cache->probation_list);
 				fibril_mutex_unlock(&cache->lock);
 				rc = write_blocks(devcon, b->pba,
 				    cache->blocks_cluster, b->data, b->size);
@@ -526,8 +1025,9 @@ retry:
 			 * Unlink the block from the free list and the hash
 			 * table.
 			 */
-			list_remove(&b->free_link);
+			cache_unlink(cache, b);
 			hash_table_remove_item(&cache->block_hash, &b->hash_link);
+			cache_evicted(cache, b->lba);
 		}
 
 		block_initialize(b);
@@ -537,6 +1037,11 @@ retry:
 		b->pba = ba_ltop(devcon, b->lba);
 		hash_table_insert(&cache->block_hash, &b->hash_link);
 
+		ra = 0;
+		if (!(flags & BLOCK_FLAGS_NOREAD))
+			ra = cache_readahead_window(devcon, ba);
+		ra_gen = cache->generation;
+
 		/*
 		 * Lock the block before releasing the cache lock. Thus we don't
 		 * kill concurrent operations on the cache while doing I/O on
@@ -545,19 +1050,50 @@ retry:
 		fibril_mutex_lock(&b->lock);
 		fibril_mutex_unlock(&cache->lock);
 
+		ra_buf = NULL;
 		if (!(flags & BLOCK_FLAGS_NOREAD)) {
-			/*
-			 * The block contains old or no data. We need to read
-			 * the new contents from the device.
-			 */
-			rc = read_blocks(devcon, b->pba, cache->blocks_cluster,
-			    b->data, cache->lblock_size);
-			if (rc != EOK)
-				b->toxic = true;
+			rc = ENOMEM;
+			if (ra > 0) {
+				/*
+				 * The access looks sequential. Read the
+				 * following blocks using the same request.
+				 */
+				ra_buf = malloc((ra + 1) * cache->lblock_size);
+				if (ra_buf != NULL) {
+					rc = read_blocks(devcon, b->pba,
+					    (ra + 1) * cache->blocks_cluster,
+					    ra_buf, (ra + 1) * cache->lblock_size);
+				}
+				if (rc == EOK) {
+					memcpy(b->data, ra_buf,
+					    cache->lblock_size);
+				}
+			}
+			if (rc != EOK) {
+				/*
+				 * The block contains old or no data. We need
+				 * to read the new contents from the device.
+				 */
+				ra = 0;
+				rc = read_blocks(devcon, b->pba,
+				    cache->blocks_cluster, b->data,
+				    cache->lblock_size);
+				if (rc != EOK)
+					b->toxic = true;
+			}
 		} else
 			rc = EOK;
 
 		fibril_mutex_unlock(&b->lock);
+
+		/*
+		 * The read-ahead blocks must be inserted without holding the
+		 * block lock to respect the cache -> block locking order.
+		 */
+		if (ra > 0)
+			cache_readahead_insert(devcon, ba + 1, ra,
+			    ra_buf + cache->lblock_size, ra_gen);
+		free(ra_buf);
 	}
 out:
 	if ((rc != EOK) && b) {
@@ -571,7 +1107,8 @@ out:
 
 /** Release a reference to a block.
  *
- * If the last reference is dropped, the block is put on the free list.
+ * If the last reference is dropped, the block is put on the free list of the
+ * segment it belongs to.
  *
  * @param block		Block of which a reference is to be released.
  *
@@ -608,7 +1145,7 @@ retry:
 	if (block->toxic)
 		block->dirty = false;	/* will not write back toxic block */
 	if (block->dirty && (block->refcnt == 1) &&
-	    (blocks_cached > CACHE_HI_WATERMARK || mode != CACHE_MODE_WB)) {
+	    (blocks_cached > cache->block_count || mode != CACHE_MODE_WB)) {
 		rc = write_blocks(devcon, block->pba, cache->blocks_cluster,
 		    block->data, block->size);
 		if (rc == EOK)
@@ -625,7 +1162,7 @@ retry:
 		 * block or put it on the free list. In case of an I/O error,
 		 * free the block.
 		 */
-		if ((cache->blocks_cached > CACHE_HI_WATERMARK) ||
+		if ((cache->blocks_cached > cache->block_count) ||
 		    (rc != EOK)) {
 			/*
 			 * Currently there are too many cached blocks or there
@@ -655,6 +1192,7 @@ retry:
 			 * Take the block out of the cache and free it.
 			 */
 			hash_table_remove_item(&cache->block_hash, &block->hash_link);
+			cache_evicted(cache, block->lba);
 			fibril_mutex_unlock(&block->lock);
 			free(block->data);
 			free(block);
@@ -675,7 +1213,7 @@ retry:
 			fibril_mutex_unlock(&cache->lock);
 			goto retry;
 		}
-		list_append(&block->free_link, &cache->free_list);
+		cache_release(cache, block);
 	}
 	fibril_mutex_unlock(&block->lock);
 	fibril_mutex_unlock(&cache->lock);
@@ -82,6 +82,10 @@ typedef struct block {
 	size_t size;
 	/** Number of write failures. */
 	int write_failures;
+	/** If true, the block was referenced again while it was cached. */
+	bool reused;
+	/** If true, the block was read ahead and has not been referenced yet. */
+	bool readahead;
 	/** Link for placing the block into the free block list. */
 	link_t free_link;
 	/** Link for placing the block into the block hash table. */
@@ -98,6 +102,24 @@ enum cache_mode {
 	CACHE_MODE_WB
 };
 
+/** Block cache statistics */
+typedef struct {
+	/** Number of block_get() calls satisfied from the cache. */
+	uint64_t hits;
+	/** Number of block_get() calls which had to instantiate the block. */
+	uint64_t misses;
+	/** Number of blocks brought into the cache by read-ahead. */
+	uint64_t readahead;
+	/** Number of read-ahead blocks which were later referenced. */
+	uint64_t readahead_hits;
+	/** Number of read-ahead blocks dropped as they may be stale. */
+	uint64_t readahead_dropped;
+	/** Number of write requests issued by the background flusher. */
+	uint64_t flush_writes;
+	/** Number of blocks written by the background flusher. */
+	uint64_t flush_blocks;
+} block_cache_stats_t;
+
 extern errno_t block_init(service_id_t, size_t);
 extern void block_fini(service_id_t);
 
@@ -106,6 +128,7 @@ extern void *block_bb_get(service_id_t);
 
 extern errno_t block_cache_init(service_id_t, size_t, unsigned, enum cache_mode);
 extern errno_t block_cache_fini(service_id_t);
+extern errno_t block_cache_get_stats(service_id_t, block_cache_stats_t *);
 
 extern errno_t block_get(block_t **, service_id_t, aoff64_t, int);
 extern errno_t block_put(block_t *);
@@ -35,6 +35,11 @@
 #ifndef _LIBC_abs32le_THREAD_H_
 #define _LIBC_abs32le_THREAD_H_
 
+/** Spin-wait loop hint, nothing to do on the abstract architecture. */
+static inline void cpu_spin_hint(void)
+{
+}
+
 #endif
 
 /** @}
@@ -36,6 +36,14 @@
 #ifndef _LIBC_arm32_THREAD_H_
 #define _LIBC_arm32_THREAD_H_
 
+/** Hint the CPU that this is a spin-wait loop, available since ARMv7. */
+static inline void cpu_spin_hint(void)
+{
+#if defined(__ARM_ARCH) && (__ARM_ARCH >= 7)
+	asm volatile ("yield");
+#endif
+}
+
 #endif
 
 /** @}
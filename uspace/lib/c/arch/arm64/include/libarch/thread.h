@@ -35,6 +35,12 @@
 #ifndef _LIBC_arm64_THREAD_H_
 #define _LIBC_arm64_THREAD_H_
 
+/** Hint the CPU that this is a spin-wait loop. */
+static inline void cpu_spin_hint(void)
+{
+	asm volatile ("yield");
+}
+
 #endif
 
 /** @}
@@ -35,6 +35,15 @@
 #ifndef _LIBC_ia32_THREAD_H_
 #define _LIBC_ia32_THREAD_H_
 
+/** Tell the CPU that this is a spin-wait loop.
+ *
+ * PAUSE executes as a NOP on processors which predate it.
+ */
+static inline void cpu_spin_hint(void)
+{
+	asm volatile ("pause");
+}
+
 #endif
 
 /** @}
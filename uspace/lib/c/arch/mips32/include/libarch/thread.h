@@ -36,6 +36,11 @@
 #ifndef _LIBC_mips32_THREAD_H_
 #define _LIBC_mips32_THREAD_H_
 
+/** Spin-wait loop hint, MIPS32 has none. */
+static inline void cpu_spin_hint(void)
+{
+}
+
 #endif
 
 /** @}
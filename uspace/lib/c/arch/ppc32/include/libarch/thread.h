@@ -35,6 +35,11 @@
 #ifndef _LIBC_ppc32_THREAD_H_
 #define _LIBC_ppc32_THREAD_H_
 
+/** Spin-wait loop hint, not used on ppc32. */
+static inline void cpu_spin_hint(void)
+{
+}
+
 #endif
 
 /** @}
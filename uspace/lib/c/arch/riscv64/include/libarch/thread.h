@@ -35,6 +35,11 @@
 #ifndef _LIBC_riscv64_THREAD_H_
 #define _LIBC_riscv64_THREAD_H_
 
+/** Spin-wait loop hint, a no-op as Zihintpause is not assumed. */
+static inline void cpu_spin_hint(void)
+{
+}
+
 #endif
 
 /** @}
@@ -34,6 +34,11 @@
 #ifndef _LIBC_sparc64_THREAD_H_
 #define _LIBC_sparc64_THREAD_H_
 
+/** Spin-wait loop hint, none is used on sparc64. */
+static inline void cpu_spin_hint(void)
+{
+}
+
 #endif
 
 /** @}
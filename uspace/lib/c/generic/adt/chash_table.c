@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** @addtogroup libc
+ * @{
+ */
+
+/** @file Concurrent hash table
+ *
+ * The table is an array of singly linked buckets. Buckets are guarded by
+ * a fixed number of restricted mutexes, bucket i by lock i % CHT_LOCKS.
+ * The number of buckets is a power of two and a multiple of CHT_LOCKS,
+ * so the lock of an item depends only on its hash and stays the same
+ * when the table grows. Growing takes all locks in ascending order.
+ */
+
+#include <adt/chash_table.h>
+#include <assert.h>
+#include <errno.h>
+#include <stdlib.h>
+
+#include "../private/fibril.h"
+
+/** Number of bucket locks. */
+#define CHT_LOCKS  64
+
+/** Average number of items per bucket which triggers growing. */
+#define CHT_MAX_LOAD  2
+
+static inline fibril_rmutex_t *cht_lock(chash_table_t *h, size_t hash)
+{
+	return &((fibril_rmutex_t *) h->locks)[hash % CHT_LOCKS];
+}
+
+/** Must be called with the lock for @a hash held. */
+static inline cht_link_t **cht_bucket(chash_table_t *h, size_t hash)
+{
+	return &h->bucket[hash & (h->bucket_cnt - 1)];
+}
+
+/** Create concurrent hash table.
+ *
+ * @param h         Hash table structure. Will be initialized by this call.
+ * @param init_size Number of items the table should hold before it
+ *                  grows for the first time. Zero for a default.
+ * @param op        Hash table operations structure.
+ *
+ * @return True on success
+ */
+bool chash_table_create(chash_table_t *h, size_t init_size,
+    chash_table_ops_t *op)
+{
+	assert(h);
+	assert(op && op->hash && op->key_hash && op->key_equal);
+
+	size_t bucket_cnt = CHT_LOCKS;
+	while (bucket_cnt * CHT_MAX_LOAD < init_size)
+		bucket_cnt <<= 1;
+
+	h->bucket = calloc(bucket_cnt, sizeof(cht_link_t *));
+	if (!h->bucket)
+		return false;
+
+	fibril_rmutex_t *locks = malloc(CHT_LOCKS * sizeof(fibril_rmutex_t));
+	if (!locks) {
+		free(h->bucket);
+		return false;
+	}
+
+	for (size_t i = 0; i < CHT_LOCKS; i++) {
+		if (fibril_rmutex_initialize(&locks[i]) != EOK) {
+			while (i-- > 0)
+				fibril_rmutex_destroy(&locks[i]);
+
+			free(locks);
+			free(h->bucket);
+			return false;
+		}
+	}
+
+	h->op = op;
+	h->bucket_cnt = bucket_cnt;
+	h->locks = locks;
+	atomic_init(&h->item_cnt, 0);
+	return true;
+}
+
+/** Destroy concurrent hash table.
+ *
+ * The table must not be used by anyone else. Items still in the
+ * table are left untouched.
+ *
+ * @param h Hash table
+ */
+void chash_table_destroy(chash_table_t *h)
+{
+	fibril_rmutex_t *locks = h->locks;
+
+	for (size_t i = 0; i < CHT_LOCKS; i++)
+		fibril_rmutex_destroy(&locks[i]);
+
+	free(locks);
+	free(h->bucket);
+
+	h->locks = NULL;
+	h->bucket = NULL;
+}
+
+/** Return number of items in the table.
+ *
+ * The value is only a snapshot when other threads modify the table.
+ */
+size_t chash_table_size(chash_table_t *h)
+{
+	return atomic_load_explicit(&h->item_cnt, memory_order_relaxed);
+}
+
+/** Double the number of buckets if nobody else has done so already. */
+static void cht_grow(chash_table_t *h, size_t old_cnt)
+{
+	size_t new_cnt = 2 * old_cnt;
+	cht_link_t **new_bucket = calloc(new_cnt, sizeof(cht_link_t *));
+	if (!new_bucket)
+		return;
+
+	fibril_rmutex_t *locks = h->locks;
+	for (size_t i = 0; i < CHT_LOCKS; i++)
+		fibril_rmutex_lock(&locks[i]);
+
+	cht_link_t **old_bucket = h->bucket;
+
+	if (h->bucket_cnt == old_cnt) {
+		for (size_t b = 0; b < old_cnt; b++) {
+			cht_link_t *cur = old_bucket[b];
+
+			while (cur) {
+				cht_link_t *next = cur->next;
+				size_t idx = h->op->hash(cur) & (new_cnt - 1);
+
+				cur->next = new_bucket[idx];
+				new_bucket[idx] = cur;
+				cur = next;
+			}
+		}
+
+		h->bucket = new_bucket;
+		h->bucket_cnt = new_cnt;
+	} else {
+		old_bucket = new_bucket;
+	}
+
+	for (size_t i = CHT_LOCKS; i-- > 0;)
+		fibril_rmutex_unlock(&locks[i]);
+
+	free(old_bucket);
+}
+
+/** Account for a new item and return number of buckets to grow from.
+ *
+ * Must be called with a bucket lock held.
+ */
+static size_t cht_added(chash_table_t *h)
+{
+	size_t cnt = atomic_fetch_add_explicit(&h->item_cnt, 1,
+	    memory_order_relaxed) + 1;
+
+	return (cnt > h->bucket_cnt * CHT_MAX_LOAD) ? h->bucket_cnt : 0;
+}
+
+/** Insert item into the table.
+ *
+ * @param h    Hash table
+ * @param item Item to be inserted into the hash table
+ */
+void chash_table_insert(chash_table_t *h, cht_link_t *item)
+{
+	size_t hash = h->op->hash(item);
+	fibril_rmutex_t *lock = cht_lock(h, hash);
+
+	fibril_rmutex_lock(lock);
+
+	cht_link_t **bucket = cht_bucket(h, hash);
+	item->next = *bucket;
+	*bucket = item;
+
+	size_t grow = cht_added(h);
+
+	fibril_rmutex_unlock(lock);
+
+	if (grow)
+		cht_grow(h, grow);
+}
+
+/** Insert item into the table if it is not already present.
+ *
+ * @param h    Hash table
+ * @param item Item to be inserted into the hash table
+ *
+ * @return False if an equal item was already in the table
+ */
+bool chash_table_insert_unique(chash_table_t *h, cht_link_t *item)
+{
+	assert(h->op->equal);
+
+	size_t hash = h->op->hash(item);
+	fibril_rmutex_t *lock = cht_lock(h, hash);
+
+	fibril_rmutex_lock(lock);
+
+	cht_link_t **bucket = cht_bucket(h, hash);
+	for (cht_link_t *cur = *bucket; cur; cur = cur->next) {
+		if (h->op->equal(cur, item)) {
+			fibril_rmutex_unlock(lock);
+			return false;
+		}
+	}
+
+	item->next = *bucket;
+	*bucket = item;
+
+	size_t grow = cht_added(h);
+
+	fibril_rmutex_unlock(lock);
+
+	if (grow)
+		cht_grow(h, grow);
+
+	return true;
+}
+
+/** Search the table for an item matching a key.
+ *
+ * Unless the items are kept alive by other means, the acquire operation
+ * should be used to take a reference to the returned item.
+ *
+ * @param h   Hash table
+ * @param key Search key
+ *
+ * @return Matching item on success, NULL if there is no such item
+ */
+cht_link_t *chash_table_find(chash_table_t *h, const void *key)
+{
+	size_t hash = h->op->key_hash(key);
+	fibril_rmutex_t *lock = cht_lock(h, hash);
+
+	fibril_rmutex_lock(lock);
+
+	cht_link_t *cur = *cht_bucket(h, hash);
+	while (cur && !h->op->key_equal(key, cur))
+		cur = cur->next;
+
+	if (cur && h->op->acquire)
+		h->op->acquire(cur);
+
+	fibril_rmutex_unlock(lock);
+	return cur;
+}
+
+/** Remove all matching items from the table.
+ *
+ * For each removed item, the remove callback is called.
+ *
+ * @param h   Hash table
+ * @param key Search key
+ *
+ * @return Number of removed items
+ */
+size_t chash_table_remove(chash_table_t *h, const void *key)
+{
+	size_t hash = h->op->key_hash(key);
+	fibril_rmutex_t *lock = cht_lock(h, hash);
+	size_t removed = 0;
+
+	fibril_rmutex_lock(lock);
+
+	cht_link_t **prev = cht_bucket(h, hash);
+	while (*prev) {
+		cht_link_t *cur = *prev;
+
+		if (h->op->key_equal(key, cur)) {
+			*prev = cur->next;
+			removed++;
+
+			if (h->op->remove_callback)
+				h->op->remove_callback(cur);
+		} else {
+			prev = &cur->next;
+		}
+	}
+
+	atomic_fetch_sub_explicit(&h->item_cnt, removed, memory_order_relaxed);
+
+	fibril_rmutex_unlock(lock);
+	return removed;
+}
+
+/** Remove item from the table.
+ *
+ * @param h    Hash table
+ * @param item Item to remove
+ *
+ * @return False if the item was not in the table
+ */
+bool chash_table_remove_item(chash_table_t *h, cht_link_t *item)
+{
+	size_t hash = h->op->hash(item);
+	fibril_rmutex_t *lock = cht_lock(h, hash);
+
+	fibril_rmutex_lock(lock);
+
+	cht_link_t **prev = cht_bucket(h, hash);
+	while (*prev && *prev != item)
+		prev = &(*prev)->next;
+
+	bool found = (*prev != NULL);
+	if (found) {
+		*prev = item->next;
+		atomic_fetch_sub_explicit(&h->item_cnt, 1, memory_order_relaxed);
+
+		if (h->op->remove_callback)
+			h->op->remove_callback(item);
+	}
+
+	fibril_rmutex_unlock(lock);
+	return found;
+}
+
+/** @}
+ */
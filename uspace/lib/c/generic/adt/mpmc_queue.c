@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** @addtogroup libc
+ * @{
+ */
+
+/** @file Bounded multi-producer, multi-consumer queue
+ *
+ * This is the array-based queue by Dmitry Vyukov. Each cell carries a
+ * sequence number telling which lap of the write position may fill it
+ * and which lap of the read position may empty it. Producers and
+ * consumers claim a position with a single compare-and-swap and then
+ * publish the cell by updating its sequence number.
+ */
+
+#include <adt/mpmc_queue.h>
+#include <align.h>
+#include <errno.h>
+#include <mem.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/** Cell header, followed by the entry data */
+typedef struct {
+	atomic_size_t seq;
+} mpmc_cell_t;
+
+static inline mpmc_cell_t *mpmc_cell(mpmc_queue_t *queue, size_t pos)
+{
+	return queue->buf + (pos & queue->mask) * queue->cell_size;
+}
+
+/** Initialize queue.
+ *
+ * @param queue Queue
+ * @param nmemb Minimum number of entries, rounded up to a power of 2
+ * @param size Size of individual queue entry
+ * @return EOK on success, ENOMEM if out of memory
+ */
+errno_t mpmc_queue_init(mpmc_queue_t *queue, size_t nmemb, size_t size)
+{
+	size_t cells = 2;
+	while (cells < nmemb)
+		cells <<= 1;
+
+	queue->mask = cells - 1;
+	queue->size = size;
+	queue->cell_size = ALIGN_UP(sizeof(mpmc_cell_t) + size,
+	    alignof(max_align_t));
+
+	queue->buf = malloc(cells * queue->cell_size);
+	if (queue->buf == NULL)
+		return ENOMEM;
+
+	for (size_t i = 0; i < cells; i++)
+		atomic_init(&mpmc_cell(queue, i)->seq, i);
+
+	atomic_init(&queue->wp, 0);
+	atomic_init(&queue->rp, 0);
+	return EOK;
+}
+
+/** Finalize queue.
+ *
+ * The queue must not be in use by anyone else.
+ *
+ * @param queue Queue
+ */
+void mpmc_queue_fini(mpmc_queue_t *queue)
+{
+	free(queue->buf);
+	queue->buf = NULL;
+}
+
+/** Push new entry into queue.
+ *
+ * @param queue Queue
+ * @param data Pointer to entry data
+ * @return EOK on success, EAGAIN if the queue is full
+ */
+errno_t mpmc_queue_push(mpmc_queue_t *queue, const void *data)
+{
+	size_t pos = atomic_load_explicit(&queue->wp, memory_order_relaxed);
+	mpmc_cell_t *cell;
+
+	while (true) {
+		cell = mpmc_cell(queue, pos);
+		size_t seq = atomic_load_explicit(&cell->seq,
+		    memory_order_acquire);
+		intptr_t diff = (intptr_t) seq - (intptr_t) pos;
+
+		if (diff == 0) {
+			/* The cell is free in this lap, try to claim it. */
+			if (atomic_compare_exchange_weak_explicit(&queue->wp,
+			    &pos, pos + 1, memory_order_relaxed,
+			    memory_order_relaxed))
+				break;
+		} else if (diff < 0) {
+			/* The cell still holds an entry from the last lap. */
+			return EAGAIN;
+		} else {
+			/* Another producer got here first. */
+			pos = atomic_load_explicit(&queue->wp,
+			    memory_order_relaxed);
+		}
+	}
+
+	memcpy(cell + 1, data, queue->size);
+	atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+	return EOK;
+}
+
+/** Pop entry from queue.
+ *
+ * @param queue Queue
+ * @param datab Pointer to data buffer for storing entry
+ * @return EOK on success, EAGAIN if the queue is empty
+ */
+errno_t mpmc_queue_pop(mpmc_queue_t *queue, void *datab)
+{
+	size_t pos = atomic_load_explicit(&queue->rp, memory_order_relaxed);
+	mpmc_cell_t *cell;
+
+	while (true) {
+		cell = mpmc_cell(queue, pos);
+		size_t seq = atomic_load_explicit(&cell->seq,
+		    memory_order_acquire);
+		intptr_t diff = (intptr_t) seq - (intptr_t) (pos + 1);
+
+		if (diff == 0) {
+			/* The cell was filled in this lap, try to claim it. */
+			if (atomic_compare_exchange_weak_explicit(&queue->rp,
+			    &pos, pos + 1, memory_order_relaxed,
+			    memory_order_relaxed))
+				break;
+		} else if (diff < 0) {
+			/* The cell has not been filled yet. */
+			return EAGAIN;
+		} else {
+			/* Another consumer got here first. */
+			pos = atomic_load_explicit(&queue->rp,
+			    memory_order_relaxed);
+		}
+	}
+
+	memcpy(datab, cell + 1, queue->size);
+	atomic_store_explicit(&cell->seq, pos + queue->mask + 1,
+	    memory_order_release);
+	return EOK;
+}
+
+/** @}
+ */
@@ -92,6 +92,23 @@ errno_t as_area_destroy(void *address)
 	return (errno_t) __SYSCALL1(SYS_AS_AREA_DESTROY, (sysarg_t) address);
 }
 
+/** Pre-fault a range of an address space area.
+ *
+ * Backs every page of the range with memory up front so that later
+ * accesses do not take a page fault each.
+ *
+ * @param address Virtual address where the range starts.
+ * @param size    Size of the range in bytes.
+ *
+ * @return zero on success or a code from @ref errno.h on failure.
+ *
+ */
+errno_t as_area_populate(void *address, size_t size)
+{
+	return (errno_t) __SYSCALL2(SYS_AS_AREA_POPULATE, (sysarg_t) address,
+	    (sysarg_t) size);
+}
+
 /** Change address-space area flags.
  *
  * @param address Virtual address pointing into the address space area being
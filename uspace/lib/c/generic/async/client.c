@@ -232,6 +232,41 @@ void async_reply_received(ipc_call_t *data)
 	fibril_rmutex_unlock(&message_mutex);
 }
 
+/** Send message in a batch with other messages.
+ *
+ * The kernel does nothing but pass the arguments to the server for calls
+ * with user-defined methods, so these are deferred and submitted in one
+ * batch. The batch is submitted when the sending fibril yields, blocks,
+ * exits or forgets an answer, when it is done handling its own call, or
+ * before any other IPC operation, whichever comes first. Should the call
+ * fail, the error is delivered as its answer.
+ *
+ * @param exch    Exchange for sending the message.
+ * @param imethod Service-defined interface and method.
+ * @param arg1    Service-defined payload argument.
+ * @param arg2    Service-defined payload argument.
+ * @param arg3    Service-defined payload argument.
+ * @param arg4    Service-defined payload argument.
+ * @param arg5    Service-defined payload argument.
+ * @param msg     Message record to receive the answer.
+ *
+ */
+static void async_send_deferred(async_exch_t *exch, sysarg_t imethod,
+    sysarg_t arg1, sysarg_t arg2, sysarg_t arg3, sysarg_t arg4, sysarg_t arg5,
+    amsg_t *msg)
+{
+	ipc_call_t call;
+
+	ipc_set_imethod(&call, imethod);
+	ipc_set_arg1(&call, arg1);
+	ipc_set_arg2(&call, arg2);
+	ipc_set_arg3(&call, arg3);
+	ipc_set_arg4(&call, arg4);
+	ipc_set_arg5(&call, arg5);
+
+	fibril_ipc_call(exch->phone, &call, async_reply_received, msg);
+}
+
 /** Send message and return id of the sent message.
  *
  * The return value can be used as input for async_wait() to wait for
@@ -260,6 +295,12 @@ static aid_t async_send_fast(async_exch_t *exch, sysarg_t imethod, sysarg_t arg1
 
 	msg->dataptr = dataptr;
 
+	if (imethod >= IPC_FIRST_USER_METHOD) {
+		async_send_deferred(exch, imethod, arg1, arg2, arg3, arg4, 0,
+		    msg);
+		return (aid_t) msg;
+	}
+
 	errno_t rc = ipc_call_async_4(exch->phone, imethod, arg1, arg2, arg3,
 	    arg4, msg);
 	if (rc != EOK) {
@@ -301,6 +342,12 @@ static aid_t async_send_slow(async_exch_t *exch, sysarg_t imethod, sysarg_t arg1
 
 	msg->dataptr = dataptr;
 
+	if (imethod >= IPC_FIRST_USER_METHOD) {
+		async_send_deferred(exch, imethod, arg1, arg2, arg3, arg4, arg5,
+		    msg);
+		return (aid_t) msg;
+	}
+
 	errno_t rc = ipc_call_async_5(exch->phone, imethod, arg1, arg2, arg3,
 	    arg4, arg5, msg);
 	if (rc != EOK) {
@@ -363,6 +410,9 @@ void async_wait_for(aid_t amsgid, errno_t *retval)
 		return;
 	}
 
+	/* Make sure the message has been sent. */
+	fibril_ipc_flush();
+
 	amsg_t *msg = (amsg_t *) amsgid;
 	fibril_wait_for(&msg->received);
 
@@ -394,6 +444,9 @@ errno_t async_wait_timeout(aid_t amsgid, errno_t *retval, usec_t timeout)
 		return EOK;
 	}
 
+	/* Make sure the message has been sent. */
+	fibril_ipc_flush();
+
 	amsg_t *msg = (amsg_t *) amsgid;
 
 	/*
@@ -432,6 +485,9 @@ void async_forget(aid_t amsgid)
 	if (amsgid == 0)
 		return;
 
+	/* Nobody is going to wait for the message, send it now. */
+	fibril_ipc_flush();
+
 	amsg_t *msg = (amsg_t *) amsgid;
 
 	assert(!msg->forget);
@@ -346,6 +346,9 @@ static errno_t connection_fibril(void *arg)
 	fibril_connection->handler(&fibril_connection->call,
 	    fibril_connection->data);
 
+	/* Do not hold back calls made by the handler. */
+	fibril_ipc_flush();
+
 	/*
 	 * Remove the reference for this client task connection.
 	 */
@@ -600,8 +603,10 @@ static errno_t notification_fibril_func(void *arg)
 
 		fibril_rmutex_unlock(&notification_mutex);
 
-		if (handler)
+		if (handler) {
 			handler(&calldata, arg);
+			fibril_ipc_flush();
+		}
 
 		free(m);
 	}
@@ -848,6 +853,9 @@ bool async_get_call_timeout(ipc_call_t *call, usec_t usecs)
 	assert(call);
 	assert(fibril_connection);
 
+	/* The handler is done with the previous call. */
+	fibril_ipc_flush();
+
 	struct timespec ts;
 	struct timespec *expires = NULL;
 	if (usecs) {
@@ -1047,56 +1055,73 @@ errno_t async_accept_0(ipc_call_t *call)
 	return ipc_answer_5(chandle, EOK, 0, 0, 0, 0, async_get_label());
 }
 
-errno_t async_answer_0(ipc_call_t *call, errno_t retval)
+/** Answer a call.
+ *
+ * The kernel does nothing but pass the return values back for answers
+ * to user-defined methods, so these are submitted in one batch with the
+ * calls the task has deferred. Answers to system methods may transfer
+ * data and go through the dedicated syscalls.
+ *
+ */
+static errno_t async_answer_call(ipc_call_t *call, errno_t retval,
+    sysarg_t arg1, sysarg_t arg2, sysarg_t arg3, sysarg_t arg4, sysarg_t arg5)
 {
 	cap_call_handle_t chandle = call->cap_handle;
 	assert(chandle != CAP_NIL);
 	call->cap_handle = CAP_NIL;
-	return ipc_answer_0(chandle, retval);
+
+	if (ipc_get_imethod(call) < IPC_FIRST_USER_METHOD) {
+		if (arg5 == 0)
+			return ipc_answer_4(chandle, retval, arg1, arg2, arg3, arg4);
+
+		return ipc_answer_5(chandle, retval, arg1, arg2, arg3, arg4,
+		    arg5);
+	}
+
+	ipc_call_t answer;
+
+	ipc_set_retval(&answer, retval);
+	ipc_set_arg1(&answer, arg1);
+	ipc_set_arg2(&answer, arg2);
+	ipc_set_arg3(&answer, arg3);
+	ipc_set_arg4(&answer, arg4);
+	ipc_set_arg5(&answer, arg5);
+
+	return fibril_ipc_answer(chandle, &answer);
+}
+
+errno_t async_answer_0(ipc_call_t *call, errno_t retval)
+{
+	return async_answer_call(call, retval, 0, 0, 0, 0, 0);
 }
 
 errno_t async_answer_1(ipc_call_t *call, errno_t retval, sysarg_t arg1)
 {
-	cap_call_handle_t chandle = call->cap_handle;
-	assert(chandle != CAP_NIL);
-	call->cap_handle = CAP_NIL;
-	return ipc_answer_1(chandle, retval, arg1);
+	return async_answer_call(call, retval, arg1, 0, 0, 0, 0);
 }
 
 errno_t async_answer_2(ipc_call_t *call, errno_t retval, sysarg_t arg1,
     sysarg_t arg2)
 {
-	cap_call_handle_t chandle = call->cap_handle;
-	assert(chandle != CAP_NIL);
-	call->cap_handle = CAP_NIL;
-	return ipc_answer_2(chandle, retval, arg1, arg2);
+	return async_answer_call(call, retval, arg1, arg2, 0, 0, 0);
 }
 
 errno_t async_answer_3(ipc_call_t *call, errno_t retval, sysarg_t arg1,
     sysarg_t arg2, sysarg_t arg3)
 {
-	cap_call_handle_t chandle = call->cap_handle;
-	assert(chandle != CAP_NIL);
-	call->cap_handle = CAP_NIL;
-	return ipc_answer_3(chandle, retval, arg1, arg2, arg3);
+	return async_answer_call(call, retval, arg1, arg2, arg3, 0, 0);
 }
 
 errno_t async_answer_4(ipc_call_t *call, errno_t retval, sysarg_t arg1,
     sysarg_t arg2, sysarg_t arg3, sysarg_t arg4)
 {
-	cap_call_handle_t chandle = call->cap_handle;
-	assert(chandle != CAP_NIL);
-	call->cap_handle = CAP_NIL;
-	return ipc_answer_4(chandle, retval, arg1, arg2, arg3, arg4);
+	return async_answer_call(call, retval, arg1, arg2, arg3, arg4, 0);
 }
 
 errno_t async_answer_5(ipc_call_t *call, errno_t retval, sysarg_t arg1,
     sysarg_t arg2, sysarg_t arg3, sysarg_t arg4, sysarg_t arg5)
 {
-	cap_call_handle_t chandle = call->cap_handle;
-	assert(chandle != CAP_NIL);
-	call->cap_handle = CAP_NIL;
-	return ipc_answer_5(chandle, retval, arg1, arg2, arg3, arg4, arg5);
+	return async_answer_call(call, retval, arg1, arg2, arg3, arg4, arg5);
 }
 
 static errno_t async_forward_fast(ipc_call_t *call, async_exch_t *exch,
@@ -47,6 +47,7 @@
 #include <adt/list.h>
 #include <fibril.h>
 #include <macros.h>
+#include "private/fibril.h"
 
 /** Fast asynchronous call.
  *
@@ -69,6 +70,8 @@
 errno_t ipc_call_async_fast(cap_phone_handle_t phandle, sysarg_t imethod,
     sysarg_t arg1, sysarg_t arg2, sysarg_t arg3, void *label)
 {
+	fibril_ipc_flush();
+
 	return __SYSCALL6(SYS_IPC_CALL_ASYNC_FAST,
 	    cap_handle_raw(phandle), imethod, arg1, arg2, arg3,
 	    (sysarg_t) label);
@@ -104,6 +107,8 @@ errno_t ipc_call_async_slow(cap_phone_handle_t phandle, sysarg_t imethod,
 	ipc_set_arg4(&data, arg4);
 	ipc_set_arg5(&data, arg5);
 
+	fibril_ipc_flush();
+
 	return __SYSCALL3(SYS_IPC_CALL_ASYNC_SLOW,
 	    cap_handle_raw(phandle), (sysarg_t) &data,
 	    (sysarg_t) label);
@@ -128,6 +133,8 @@ errno_t ipc_call_async_slow(cap_phone_handle_t phandle, sysarg_t imethod,
 errno_t ipc_answer_fast(cap_call_handle_t chandle, errno_t retval,
     sysarg_t arg1, sysarg_t arg2, sysarg_t arg3, sysarg_t arg4)
 {
+	fibril_ipc_flush();
+
 	return (errno_t) __SYSCALL6(SYS_IPC_ANSWER_FAST,
 	    cap_handle_raw(chandle), (sysarg_t) retval, arg1, arg2, arg3, arg4);
 }
@@ -158,6 +165,8 @@ errno_t ipc_answer_slow(cap_call_handle_t chandle, errno_t retval,
 	ipc_set_arg4(&data, arg4);
 	ipc_set_arg5(&data, arg5);
 
+	fibril_ipc_flush();
+
 	return (errno_t) __SYSCALL2(SYS_IPC_ANSWER_SLOW,
 	    cap_handle_raw(chandle), (sysarg_t) &data);
 }
@@ -176,6 +185,45 @@ errno_t ipc_wait(ipc_call_t *call, sysarg_t usec, unsigned int flags)
 	return __SYSCALL3(SYS_IPC_WAIT, (sysarg_t) call, usec, flags);
 }
 
+/** Wait for several calls or answers at once.
+ *
+ * Wait for the first call or answer just like ipc_wait() and then
+ * receive those already pending without waiting again.
+ *
+ * @param calls     Array where to store the received calls and answers.
+ * @param count     Size of the array, at most IPC_BATCH_MAX.
+ * @param received  Place to store the number of received calls and answers.
+ * @param usec      Timeout of waiting for the first call.
+ * @param flags     Flags of waiting for the first call.
+ *
+ * @return  Result of waiting for the first call.
+ *
+ */
+errno_t ipc_wait_many(ipc_call_t *calls, size_t count, size_t *received,
+    sysarg_t usec, unsigned int flags)
+{
+	return __SYSCALL5(SYS_IPC_WAIT_MANY, (sysarg_t) calls, count, usec,
+	    flags, (sysarg_t) received);
+}
+
+/** Make several asynchronous calls and answer several calls at once.
+ *
+ * The result of each call or answer is stored in its entry. Unlike the
+ * other operations, this one does not submit the calls deferred by the
+ * async framework first.
+ *
+ * @param entries  Array of calls and answers to submit.
+ * @param count    Number of entries, at most IPC_BATCH_MAX.
+ *
+ * @return  Zero if all entries were processed.
+ * @return  Value from @ref errno.h if the batch could not be processed.
+ *
+ */
+errno_t ipc_submit(ipc_submit_t *entries, size_t count)
+{
+	return (errno_t) __SYSCALL2(SYS_IPC_SUBMIT, (sysarg_t) entries, count);
+}
+
 /** Hang up a phone.
  *
  * @param phandle  Handle of the phone to be hung up.
@@ -185,6 +233,8 @@ errno_t ipc_wait(ipc_call_t *call, sysarg_t usec, unsigned int flags)
  */
 errno_t ipc_hangup(cap_phone_handle_t phandle)
 {
+	fibril_ipc_flush();
+
 	return (errno_t) __SYSCALL1(SYS_IPC_HANGUP, cap_handle_raw(phandle));
 }
 
@@ -208,6 +258,8 @@ errno_t ipc_hangup(cap_phone_handle_t phandle)
 errno_t ipc_forward_fast(cap_call_handle_t chandle, cap_phone_handle_t phandle,
     sysarg_t imethod, sysarg_t arg1, sysarg_t arg2, unsigned int mode)
 {
+	fibril_ipc_flush();
+
 	return (errno_t) __SYSCALL6(SYS_IPC_FORWARD_FAST,
 	    cap_handle_raw(chandle), cap_handle_raw(phandle), imethod, arg1,
 	    arg2, mode);
@@ -226,6 +278,8 @@ errno_t ipc_forward_slow(cap_call_handle_t chandle, cap_phone_handle_t phandle,
 	ipc_set_arg4(&data, arg4);
 	ipc_set_arg5(&data, arg5);
 
+	fibril_ipc_flush();
+
 	return (errno_t) __SYSCALL4(SYS_IPC_FORWARD_SLOW,
 	    cap_handle_raw(chandle), cap_handle_raw(phandle), (sysarg_t) &data,
 	    mode);
@@ -111,6 +111,38 @@ errno_t ipc_test_ping(ipc_test_t *test)
 	return EOK;
 }
 
+/** Pipelined ping.
+ *
+ * Send all pings before waiting for the first answer.
+ *
+ * @param test IPC test service
+ * @param count Number of pings, at most IPC_MAX_ASYNC_CALLS
+ * @return EOK on success or an error code
+ */
+errno_t ipc_test_ping_many(ipc_test_t *test, size_t count)
+{
+	aid_t req[IPC_MAX_ASYNC_CALLS];
+	async_exch_t *exch;
+	errno_t retval;
+	errno_t rc = EOK;
+
+	if (count > IPC_MAX_ASYNC_CALLS)
+		return EINVAL;
+
+	exch = async_exchange_begin(test->sess);
+	for (size_t i = 0; i < count; i++)
+		req[i] = async_send_0(exch, IPC_TEST_PING, NULL);
+	async_exchange_end(exch);
+
+	for (size_t i = 0; i < count; i++) {
+		async_wait_for(req[i], &retval);
+		if (retval != EOK)
+			rc = retval;
+	}
+
+	return rc;
+}
+
 /** Get size of shared read-only memory area.
  *
  * @param test IPC test service
@@ -220,5 +252,63 @@ errno_t ipc_test_share_in_rw(ipc_test_t *test, size_t size, void **rptr)
 	return EOK;
 }
 
+/** Test IPC data write.
+ *
+ * @param test IPC test service
+ * @param data Data to send
+ * @param size Number of bytes to send, at most DATA_XFER_LIMIT
+ * @return EOK on success or an error code
+ */
+errno_t ipc_test_data_write(ipc_test_t *test, const void *data, size_t size)
+{
+	async_exch_t *exch;
+	ipc_call_t answer;
+	aid_t req;
+	errno_t retval;
+	errno_t rc;
+
+	exch = async_exchange_begin(test->sess);
+	req = async_send_0(exch, IPC_TEST_DATA_WRITE, &answer);
+
+	rc = async_data_write_start(exch, data, size);
+	async_exchange_end(exch);
+	if (rc != EOK) {
+		async_forget(req);
+		return rc;
+	}
+
+	async_wait_for(req, &retval);
+	return retval;
+}
+
+/** Test IPC data read.
+ *
+ * @param test IPC test service
+ * @param data Buffer for the received data
+ * @param size Number of bytes to receive, at most DATA_XFER_LIMIT
+ * @return EOK on success or an error code
+ */
+errno_t ipc_test_data_read(ipc_test_t *test, void *data, size_t size)
+{
+	async_exch_t *exch;
+	ipc_call_t answer;
+	aid_t req;
+	errno_t retval;
+	errno_t rc;
+
+	exch = async_exchange_begin(test->sess);
+	req = async_send_0(exch, IPC_TEST_DATA_READ, &answer);
+
+	rc = async_data_read_start(exch, data, size);
+	async_exchange_end(exch);
+	if (rc != EOK) {
+		async_forget(req);
+		return rc;
+	}
+
+	async_wait_for(req, &retval);
+	return retval;
+}
+
 /** @}
  */
@@ -168,6 +168,9 @@ void __libc_fini(void)
 
 void __libc_exit(int status)
 {
+	/* Do not let the task exit before its deferred calls are made. */
+	fibril_ipc_flush();
+
 	/*
 	 * GCC extension __attribute__((destructor)),
 	 * C++ destructors are added to __cxa_finalize call
@@ -45,6 +45,7 @@
 #include <mem.h>
 #include <stdlib.h>
 #include <adt/gcdlcm.h>
+#include <adt/list.h>
 
 #include "private/malloc.h"
 #include "private/fibril.h"
@@ -58,6 +59,12 @@
 /** Magic used in heap descriptor. */
 #define HEAP_AREA_MAGIC  UINT32_C(0xBEEFCAFE)
 
+/** Magic used in headers of small objects. */
+#define SMALL_BLOCK_HEAD_MAGIC  UINT32_C(0xBEEF0303)
+
+/** Magic used in descriptors of areas holding a single large block. */
+#define LARGE_AREA_MAGIC  UINT32_C(0xBEEFFACE)
+
 /** Allocation alignment.
  *
  * This also covers the alignment of fields
@@ -76,6 +83,36 @@
  */
 #define SHRINK_GRANULARITY  (64 * PAGE_SIZE)
 
+/** Smallest large allocation
+ *
+ * Large allocations get an address space area of their own,
+ * which is returned to the system as soon as they are freed.
+ *
+ */
+#define LARGE_MIN  (64 * PAGE_SIZE)
+
+/** Largest small allocation
+ *
+ * Small allocations are served from size class caches
+ * without taking the heap lock most of the time.
+ *
+ */
+#define SMALL_MAX  1024
+
+/** Number of small object size classes. */
+#define SMALL_CLASSES  20
+
+/** Size of a run of small objects carved from the heap. */
+#define RUN_SIZE  (16 * 4096)
+
+/** Number of small object caches
+ *
+ * Fibrils running on different threads at the same time
+ * end up using different caches.
+ *
+ */
+#define MALLOC_CACHES  8
+
 /** Overhead of each heap block. */
 #define STRUCT_OVERHEAD \
 	(sizeof(heap_block_head_t) + sizeof(heap_block_foot_t))
@@ -166,8 +203,13 @@ typedef struct {
 	/* Indication of a free block */
 	bool free;
 
-	/** Heap area this block belongs to */
-	heap_area_t *area;
+	union {
+		/** Heap area this block belongs to */
+		heap_area_t *area;
+
+		/** Run this small object belongs to */
+		struct malloc_run *run;
+	};
 
 	/* A magic value to detect overwrite of heap header */
 	uint32_t magic;
@@ -196,6 +238,78 @@ static heap_block_head_t *next_fit = NULL;
 /** Futex for thread-safe heap manipulation */
 static fibril_rmutex_t malloc_mutex;
 
+/** Run of small objects of the same size class
+ *
+ * Runs are ordinary heap blocks divided into slots. Each slot
+ * starts with a heap block header marked with SMALL_BLOCK_HEAD_MAGIC,
+ * so that free() can tell small objects from heap blocks.
+ *
+ */
+typedef struct malloc_run {
+	/** Link to the list of partial runs of the size class */
+	link_t link;
+
+	/** Slots returned to the run */
+	heap_block_head_t *free;
+
+	/** First slot which has never been used */
+	void *fresh;
+
+	/** End of the slots */
+	void *end;
+
+	/** Number of slots given out to caches */
+	size_t used;
+
+	/** Size class of the slots */
+	unsigned int cls;
+
+	/** Indication of the run being on the list of partial runs */
+	bool partial;
+} malloc_run_t;
+
+/** Free small objects of one size class cached for reuse
+ *
+ * The objects are linked through the run field of their headers.
+ *
+ */
+typedef struct {
+	heap_block_head_t *head;
+	size_t count;
+} malloc_bin_t;
+
+/** Next cached small object, stored at the start of the object itself */
+#define SMALL_NEXT(head) \
+	(*((heap_block_head_t **) (((void *) (head)) + sizeof(heap_block_head_t))))
+
+/** Small object cache */
+typedef struct {
+	fibril_rmutex_t lock;
+	malloc_bin_t bins[SMALL_CLASSES];
+} malloc_cache_t;
+
+/** Net sizes of the small object size classes */
+static const size_t small_class_size[SMALL_CLASSES] = {
+	16, 32, 48, 64, 80, 96, 112, 128,
+	160, 192, 224, 256, 320, 384, 448, 512,
+	640, 768, 896, 1024
+};
+
+/** Size class of small objects indexed by size in BASE_ALIGN units */
+static uint8_t small_class_of[SMALL_MAX / BASE_ALIGN + 1];
+
+/** Small object caches */
+static malloc_cache_t malloc_caches[MALLOC_CACHES];
+
+/** Cache the current fibril succeeded to lock the last time */
+static fibril_local unsigned int malloc_cache_hint;
+
+/** Futex protecting the runs */
+static fibril_rmutex_t small_mutex;
+
+/** Runs with unused slots for each size class */
+static list_t small_partial[SMALL_CLASSES];
+
 #define malloc_assert(expr) safe_assert(expr)
 
 /** Serializes access to the heap from multiple threads. */
@@ -486,12 +600,35 @@ void __malloc_init(void)
 	if (fibril_rmutex_initialize(&malloc_mutex) != EOK)
 		abort();
 
+	if (fibril_rmutex_initialize(&small_mutex) != EOK)
+		abort();
+
+	for (unsigned int i = 0; i < MALLOC_CACHES; i++) {
+		if (fibril_rmutex_initialize(&malloc_caches[i].lock) != EOK)
+			abort();
+	}
+
+	unsigned int cls = 0;
+	for (size_t i = 0; i <= SMALL_MAX / BASE_ALIGN; i++) {
+		while (small_class_size[cls] < i * BASE_ALIGN)
+			cls++;
+
+		small_class_of[i] = cls;
+	}
+
+	for (unsigned int i = 0; i < SMALL_CLASSES; i++)
+		list_initialize(&small_partial[i]);
+
 	if (!area_create(PAGE_SIZE))
 		abort();
 }
 
 void __malloc_fini(void)
 {
+	for (unsigned int i = 0; i < MALLOC_CACHES; i++)
+		fibril_rmutex_destroy(&malloc_caches[i].lock);
+
+	fibril_rmutex_destroy(&small_mutex);
 	fibril_rmutex_destroy(&malloc_mutex);
 }
 
@@ -763,6 +900,368 @@ static void *malloc_internal(const size_t size, const size_t align)
 	return heap_grow_and_alloc(gross_size, falign);
 }
 
+/** Free a heap block
+ *
+ * Should be called only inside the critical section.
+ *
+ * @param head Header of the block.
+ *
+ */
+static void free_internal(heap_block_head_t *head)
+{
+	block_check(head);
+	malloc_assert(!head->free);
+
+	heap_area_t *area = head->area;
+
+	area_check(area);
+	malloc_assert((void *) head >= (void *) AREA_FIRST_BLOCK_HEAD(area));
+	malloc_assert((void *) head < area->end);
+
+	/* Mark the block itself as free. */
+	head->free = true;
+
+	/* Look at the next block. If it is free, merge the two. */
+	heap_block_head_t *next_head =
+	    (heap_block_head_t *) (((void *) head) + head->size);
+
+	if ((void *) next_head < area->end) {
+		block_check(next_head);
+		if (next_head->free)
+			block_init(head, head->size + next_head->size, true, area);
+	}
+
+	/* Look at the previous block. If it is free, merge the two. */
+	if ((void *) head > (void *) AREA_FIRST_BLOCK_HEAD(area)) {
+		heap_block_foot_t *prev_foot =
+		    (heap_block_foot_t *) (((void *) head) - sizeof(heap_block_foot_t));
+
+		heap_block_head_t *prev_head =
+		    (heap_block_head_t *) (((void *) head) - prev_foot->size);
+
+		block_check(prev_head);
+
+		if (prev_head->free)
+			block_init(prev_head, prev_head->size + head->size, true,
+			    area);
+	}
+
+	heap_shrink(area);
+}
+
+/** Lock one of the small object caches
+ *
+ * Prefer the cache the current fibril used the last time and move on
+ * to another cache if it is in use by a different thread. This way,
+ * threads allocating at the same time spread over the caches and
+ * rarely contend.
+ *
+ * @return Locked cache.
+ *
+ */
+static malloc_cache_t *cache_lock(void)
+{
+	unsigned int hint = malloc_cache_hint;
+
+	for (unsigned int i = 0; i < MALLOC_CACHES; i++) {
+		unsigned int idx = (hint + i) % MALLOC_CACHES;
+
+		if (fibril_rmutex_trylock(&malloc_caches[idx].lock)) {
+			malloc_cache_hint = idx;
+			return &malloc_caches[idx];
+		}
+	}
+
+	fibril_rmutex_lock(&malloc_caches[hint].lock);
+	return &malloc_caches[hint];
+}
+
+static void cache_unlock(malloc_cache_t *cache)
+{
+	fibril_rmutex_unlock(&cache->lock);
+}
+
+/** Number of small objects moved between a cache and the runs at once
+ *
+ * @param cls Size class.
+ *
+ */
+static size_t small_batch(unsigned int cls)
+{
+	return min(max(4096 / small_class_size[cls], 4), 32);
+}
+
+/** Create a new run of small objects
+ *
+ * Should be called only with small_mutex held.
+ *
+ * @param cls Size class of the run.
+ *
+ * @return New run on the list of partial runs or NULL.
+ *
+ */
+static malloc_run_t *run_create(unsigned int cls)
+{
+	heap_lock();
+	malloc_run_t *run = malloc_internal(RUN_SIZE, BASE_ALIGN);
+	heap_unlock();
+
+	if (run == NULL)
+		return NULL;
+
+	size_t slot = sizeof(heap_block_head_t) + small_class_size[cls];
+	size_t count = (RUN_SIZE - ALIGN_UP(sizeof(malloc_run_t), BASE_ALIGN)) /
+	    slot;
+
+	link_initialize(&run->link);
+	run->free = NULL;
+	run->fresh = (void *) ALIGN_UP((uintptr_t) run + sizeof(malloc_run_t),
+	    BASE_ALIGN);
+	run->end = run->fresh + count * slot;
+	run->used = 0;
+	run->cls = cls;
+	run->partial = true;
+
+	list_append(&run->link, &small_partial[cls]);
+	return run;
+}
+
+/** Move small objects from the runs to a cache bin
+ *
+ * @param bin   Bin to refill.
+ * @param cls   Size class of the bin.
+ * @param count Number of objects to move.
+ *
+ * @return Number of objects moved.
+ *
+ */
+static size_t small_refill(malloc_bin_t *bin, unsigned int cls, size_t count)
+{
+	size_t slot = sizeof(heap_block_head_t) + small_class_size[cls];
+	size_t moved = 0;
+
+	fibril_rmutex_lock(&small_mutex);
+
+	while (moved < count) {
+		malloc_run_t *run;
+		link_t *link = list_first(&small_partial[cls]);
+		if (link != NULL)
+			run = list_get_instance(link, malloc_run_t, link);
+		else
+			run = run_create(cls);
+
+		if (run == NULL)
+			break;
+
+		while ((moved < count) &&
+		    ((run->free != NULL) || (run->fresh < run->end))) {
+			heap_block_head_t *head;
+
+			if (run->free != NULL) {
+				head = run->free;
+				run->free = SMALL_NEXT(head);
+			} else {
+				head = run->fresh;
+				run->fresh += slot;
+
+				head->size = slot;
+				head->free = true;
+				head->run = run;
+				head->magic = SMALL_BLOCK_HEAD_MAGIC;
+			}
+
+			SMALL_NEXT(head) = bin->head;
+			bin->head = head;
+			bin->count++;
+			run->used++;
+			moved++;
+		}
+
+		if ((run->free == NULL) && (run->fresh >= run->end)) {
+			list_remove(&run->link);
+			run->partial = false;
+		}
+	}
+
+	fibril_rmutex_unlock(&small_mutex);
+	return moved;
+}
+
+/** Return small objects from a cache bin to their runs
+ *
+ * Runs which become unused are returned to the heap unless
+ * they are the last partial run of their size class.
+ *
+ * @param bin   Bin to flush.
+ * @param count Number of objects to return.
+ *
+ */
+static void small_flush(malloc_bin_t *bin, size_t count)
+{
+	fibril_rmutex_lock(&small_mutex);
+
+	while (count-- > 0) {
+		heap_block_head_t *head = bin->head;
+		bin->head = SMALL_NEXT(head);
+		bin->count--;
+
+		malloc_run_t *run = head->run;
+		list_t *partial = &small_partial[run->cls];
+
+		SMALL_NEXT(head) = run->free;
+		run->free = head;
+		run->used--;
+
+		if (!run->partial) {
+			list_append(&run->link, partial);
+			run->partial = true;
+		}
+
+		if ((run->used == 0) && ((list_first(partial) != &run->link) ||
+		    (list_last(partial) != &run->link))) {
+			list_remove(&run->link);
+
+			heap_lock();
+			free_internal((heap_block_head_t *)
+			    ((void *) run - sizeof(heap_block_head_t)));
+			heap_unlock();
+		}
+	}
+
+	fibril_rmutex_unlock(&small_mutex);
+}
+
+/** Allocate a small object
+ *
+ * @param size Size of the object, at most SMALL_MAX.
+ *
+ * @return Allocated object or NULL.
+ *
+ */
+static void *small_alloc(size_t size)
+{
+	unsigned int cls = small_class_of[(size + BASE_ALIGN - 1) / BASE_ALIGN];
+	malloc_cache_t *cache = cache_lock();
+	malloc_bin_t *bin = &cache->bins[cls];
+
+	if ((bin->head == NULL) &&
+	    (small_refill(bin, cls, small_batch(cls)) == 0)) {
+		cache_unlock(cache);
+		return NULL;
+	}
+
+	heap_block_head_t *head = bin->head;
+	bin->head = SMALL_NEXT(head);
+	bin->count--;
+
+	cache_unlock(cache);
+
+	malloc_assert(head->free);
+	head->free = false;
+
+	return ((void *) head) + sizeof(heap_block_head_t);
+}
+
+/** Free a small object
+ *
+ * @param head Header of the object.
+ *
+ */
+static void small_free(heap_block_head_t *head)
+{
+	malloc_assert(!head->free);
+	head->free = true;
+
+	unsigned int cls = head->run->cls;
+	malloc_cache_t *cache = cache_lock();
+	malloc_bin_t *bin = &cache->bins[cls];
+
+	SMALL_NEXT(head) = bin->head;
+	bin->head = head;
+	bin->count++;
+
+	if (bin->count > 2 * small_batch(cls))
+		small_flush(bin, small_batch(cls));
+
+	cache_unlock(cache);
+}
+
+/** Allocate a large block in an address space area of its own
+ *
+ * The area is laid out as a heap area with a single used block,
+ * but it is not linked to the list of heap areas.
+ *
+ * @param size Size of the block.
+ *
+ * @return Allocated block or NULL.
+ *
+ */
+static void *large_alloc(size_t size)
+{
+	size_t gross_size = GROSS_SIZE(ALIGN_UP(size, BASE_ALIGN));
+	if (gross_size < size)
+		return NULL;
+
+	size_t asize = ALIGN_UP(AREA_OVERHEAD(gross_size) + BASE_ALIGN,
+	    PAGE_SIZE);
+	void *astart = as_area_create(AS_AREA_ANY, asize,
+	    AS_AREA_WRITE | AS_AREA_READ | AS_AREA_CACHEABLE, AS_AREA_UNPAGED);
+	if (astart == AS_MAP_FAILED)
+		return NULL;
+
+	heap_area_t *area = (heap_area_t *) astart;
+
+	area->start = astart;
+	area->end = (void *) ((uintptr_t) astart + asize);
+	area->prev = NULL;
+	area->next = NULL;
+	area->magic = LARGE_AREA_MAGIC;
+
+	void *block = (void *) AREA_FIRST_BLOCK_HEAD(area);
+	block_init(block, (size_t) (area->end - block), false, area);
+
+	return block + sizeof(heap_block_head_t);
+}
+
+/** Resize a large block
+ *
+ * @param head Header of the block.
+ * @param size New size of the block.
+ *
+ * @return True if the block was resized in place.
+ *
+ */
+static bool large_resize(heap_block_head_t *head, size_t size)
+{
+	heap_area_t *area = head->area;
+	size_t gross_size = GROSS_SIZE(ALIGN_UP(size, BASE_ALIGN));
+
+	if ((size < LARGE_MIN) || (gross_size < size))
+		return false;
+
+	if (gross_size <= head->size)
+		return true;
+
+	size_t asize = ALIGN_UP(AREA_OVERHEAD(gross_size) + BASE_ALIGN,
+	    PAGE_SIZE);
+	if (as_area_resize(area->start, asize, 0) != EOK)
+		return false;
+
+	area->end = (void *) ((uintptr_t) area->start + asize);
+	block_init(head, (size_t) (area->end - (void *) head), false, area);
+	return true;
+}
+
+/** Check whether a block is a large block
+ *
+ * @param head Header of the block.
+ *
+ */
+static bool large_block(heap_block_head_t *head)
+{
+	return head->area->magic == LARGE_AREA_MAGIC;
+}
+
 /** Allocate memory by number of elements
  *
  * @param nmemb Number of members to allocate.
@@ -792,6 +1291,14 @@ void *calloc(const size_t nmemb, const size_t size)
  */
 void *malloc(const size_t size)
 {
+	if (size <= SMALL_MAX) {
+		void *block = small_alloc(size);
+		if (block != NULL)
+			return block;
+	} else if (size >= LARGE_MIN) {
+		return large_alloc(size);
+	}
+
 	heap_lock();
 	void *block = malloc_internal(size, BASE_ALIGN);
 	heap_unlock();
@@ -815,6 +1322,9 @@ void *memalign(const size_t align, const size_t size)
 	size_t palign =
 	    1 << (fnzb(max(sizeof(void *), align) - 1) + 1);
 
+	if (palign <= BASE_ALIGN)
+		return malloc(size);
+
 	heap_lock();
 	void *block = malloc_internal(size, palign);
 	heap_unlock();
@@ -822,24 +1332,16 @@ void *memalign(const size_t align, const size_t size)
 	return block;
 }
 
-/** Reallocate memory block
+/** Reallocate a heap block
  *
- * @param addr Already allocated memory or NULL.
+ * @param addr Already allocated heap block.
  * @param size New size of the memory block.
  *
  * @return Reallocated memory or NULL.
  *
  */
-void *realloc(void *const addr, const size_t size)
+static void *heap_realloc(void *const addr, const size_t size)
 {
-	if (size == 0) {
-		free(addr);
-		return NULL;
-	}
-
-	if (addr == NULL)
-		return malloc(size);
-
 	heap_lock();
 
 	/* Calculate the position of the header. */
@@ -939,64 +1441,93 @@ void *realloc(void *const addr, const size_t size)
 	return ptr;
 }
 
-/** Free a memory block
+
+/** Reallocate memory block
  *
- * @param addr The address of the block.
+ * @param addr Already allocated memory or NULL.
+ * @param size New size of the memory block.
+ *
+ * @return Reallocated memory or NULL.
  *
  */
-void free(void *const addr)
+void *realloc(void *const addr, const size_t size)
 {
-	if (addr == NULL)
-		return;
+	if (size == 0) {
+		free(addr);
+		return NULL;
+	}
 
-	heap_lock();
+	if (addr == NULL)
+		return malloc(size);
 
 	/* Calculate the position of the header. */
 	heap_block_head_t *head =
 	    (heap_block_head_t *) (addr - sizeof(heap_block_head_t));
 
-	block_check(head);
-	malloc_assert(!head->free);
+	size_t orig_size;
 
-	heap_area_t *area = head->area;
+	if (head->magic == SMALL_BLOCK_HEAD_MAGIC) {
+		malloc_assert(!head->free);
 
-	area_check(area);
-	malloc_assert((void *) head >= (void *) AREA_FIRST_BLOCK_HEAD(area));
-	malloc_assert((void *) head < area->end);
+		orig_size = small_class_size[head->run->cls];
+		if (size <= orig_size)
+			return addr;
+	} else {
+		block_check(head);
+		malloc_assert(!head->free);
 
-	/* Mark the block itself as free. */
-	head->free = true;
+		if (!large_block(head))
+			return heap_realloc(addr, size);
 
-	/* Look at the next block. If it is free, merge the two. */
-	heap_block_head_t *next_head =
-	    (heap_block_head_t *) (((void *) head) + head->size);
+		if (large_resize(head, size))
+			return addr;
 
-	if ((void *) next_head < area->end) {
-		block_check(next_head);
-		if (next_head->free)
-			block_init(head, head->size + next_head->size, true, area);
+		orig_size = NET_SIZE(head->size);
 	}
 
-	/* Look at the previous block. If it is free, merge the two. */
-	if ((void *) head > (void *) AREA_FIRST_BLOCK_HEAD(area)) {
-		heap_block_foot_t *prev_foot =
-		    (heap_block_foot_t *) (((void *) head) - sizeof(heap_block_foot_t));
+	void *ptr = malloc(size);
+	if (ptr != NULL) {
+		memcpy(ptr, addr, min(orig_size, size));
+		free(addr);
+	}
 
-		heap_block_head_t *prev_head =
-		    (heap_block_head_t *) (((void *) head) - prev_foot->size);
+	return ptr;
+}
 
-		block_check(prev_head);
+/** Free a memory block
+ *
+ * @param addr The address of the block.
+ *
+ */
+void free(void *const addr)
+{
+	if (addr == NULL)
+		return;
 
-		if (prev_head->free)
-			block_init(prev_head, prev_head->size + head->size, true,
-			    area);
+	/* Calculate the position of the header. */
+	heap_block_head_t *head =
+	    (heap_block_head_t *) (addr - sizeof(heap_block_head_t));
+
+	if (head->magic == SMALL_BLOCK_HEAD_MAGIC) {
+		small_free(head);
+		return;
 	}
 
-	heap_shrink(area);
+	block_check(head);
+	malloc_assert(!head->free);
+
+	if (large_block(head)) {
+		heap_area_t *area = head->area;
 
+		malloc_assert((void *) head == (void *) AREA_FIRST_BLOCK_HEAD(area));
+		(void) as_area_destroy(area->start);
+		return;
+	}
+
+	heap_lock();
+	free_internal(head);
 	heap_unlock();
 }
-
 void *heap_check(void)
 {
 	heap_lock();
@@ -62,6 +62,12 @@ struct fibril {
 
 	fibril_t *thread_ctx;
 
+	/*
+	 * Runner which ran the fibril the last time.
+	 * For helper fibrils, the runner they belong to.
+	 */
+	unsigned int runner;
+
 	bool is_running : 1;
 	bool is_writer : 1;
 	/* In some places, we use fibril structs that can't be freed. */
@@ -87,6 +93,13 @@ extern void fibril_notify(fibril_event_t *);
 
 extern errno_t fibril_ipc_wait(ipc_call_t *, const struct timespec *);
 extern void fibril_ipc_poke(void);
+/** Handler of the answer to a deferred call which could not be made. */
+typedef void (*fibril_ipc_failed_t)(ipc_call_t *);
+
+extern void fibril_ipc_call(cap_phone_handle_t, const ipc_call_t *,
+    fibril_ipc_failed_t, void *);
+extern errno_t fibril_ipc_answer(cap_call_handle_t, const ipc_call_t *);
+extern void fibril_ipc_flush(void);
 
 /**
  * "Restricted" fibril mutex.
@@ -43,16 +43,25 @@
 #include <fibril.h>
 #include <abi/cap.h>
 #include <abi/synch.h>
+#include <libarch/thread.h>
 
 typedef struct futex {
 	volatile atomic_int val;
 	volatile cap_waitq_handle_t whandle;
 
-#ifdef CONFIG_DEBUG_FUTEX
+	/** Fibril holding the futex as a lock, if known. */
 	_Atomic(fibril_t *) owner;
-#endif
+
+	/** Average number of polls spent waiting for the lock. */
+	atomic_int spins;
 } futex_t;
 
+/**
+ * Ceiling of the number of polls of a contended futex lock before sleeping.
+ * The actual limit follows the measured time for which the lock is held.
+ */
+#define FUTEX_SPIN_MAX  200
+
 extern errno_t futex_initialize(futex_t *futex, int value);
 
 static inline errno_t futex_destroy(futex_t *futex)
@@ -85,11 +94,12 @@ void __futex_give_to(futex_t *, void *, const char *);
 
 #else
 
-#define futex_lock(fut)     (void) futex_down((fut))
+#define futex_lock(fut)     futex_lock_adaptive((fut))
 #define futex_trylock(fut)  futex_trydown((fut))
-#define futex_unlock(fut)   (void) futex_up((fut))
+#define futex_unlock(fut)   futex_unlock_adaptive((fut))
 
-#define futex_give_to(fut, owner) ((void)0)
+#define futex_give_to(fut, new_owner) \
+	atomic_store_explicit(&(fut)->owner, (new_owner), memory_order_relaxed)
 #define futex_assert_is_locked(fut) assert(atomic_load_explicit(&(fut)->val, memory_order_relaxed) <= 0)
 #define futex_assert_is_not_locked(fut) ((void)0)
 
@@ -223,6 +233,72 @@ static inline errno_t futex_down(futex_t *futex)
 	return futex_down_timeout(futex, NULL);
 }
 
+/** Wait a while for a futex lock held by another fibril to be released.
+ *
+ * Userspace cannot tell whether the owner's thread is running, so the spin
+ * is bounded and it stops as soon as there are sleeping waiters, i.e. when
+ * the owner is not expected to release the lock shortly.
+ *
+ * The bound is twice the average number of polls spent on the futex before,
+ * so locks which are held for long quickly stop being spun on, as in the
+ * adaptive mutexes of other systems.
+ *
+ * @param futex Futex used as a lock.
+ *
+ */
+static inline void futex_spin(futex_t *futex)
+{
+	fibril_t *owner = atomic_load_explicit(&futex->owner,
+	    memory_order_relaxed);
+	if (owner == NULL || owner == (fibril_t *) fibril_get_id())
+		return;
+
+	int spins = atomic_load_explicit(&futex->spins, memory_order_relaxed);
+	int limit = 2 * spins + 10;
+	if (limit > FUTEX_SPIN_MAX)
+		limit = FUTEX_SPIN_MAX;
+
+	int i;
+	for (i = 0; i < limit; i++) {
+		if (atomic_load_explicit(&futex->val, memory_order_relaxed) != 0)
+			break;
+		if (atomic_load_explicit(&futex->owner,
+		    memory_order_relaxed) != owner)
+			break;
+
+		cpu_spin_hint();
+	}
+
+	atomic_store_explicit(&futex->spins, spins + (i - spins) / 8,
+	    memory_order_relaxed);
+}
+
+/** Lock a futex, spinning first while it is held by another fibril.
+ *
+ * @param futex Futex used as a lock.
+ *
+ */
+static inline void futex_lock_adaptive(futex_t *futex)
+{
+	if (atomic_load_explicit(&futex->val, memory_order_relaxed) <= 0)
+		futex_spin(futex);
+
+	(void) futex_down(futex);
+	atomic_store_explicit(&futex->owner, (fibril_t *) fibril_get_id(),
+	    memory_order_relaxed);
+}
+
+/** Unlock a futex locked by futex_lock_adaptive().
+ *
+ * @param futex Futex used as a lock.
+ *
+ */
+static inline void futex_unlock_adaptive(futex_t *futex)
+{
+	atomic_store_explicit(&futex->owner, NULL, memory_order_relaxed);
+	(void) futex_up(futex);
+}
+
 #endif
 
 /** @}
@@ -262,6 +262,62 @@ stats_exc_t *stats_get_exception(unsigned int excn)
 	return stats_exception;
 }
 
+/** Get lock contention statistics.
+ *
+ * The statistics are only available if the kernel has been
+ * configured to collect them.
+ *
+ * @param count Number of records returned.
+ *
+ * @return Array of stats_lock_t structures.
+ *         If non-NULL then it should be eventually freed
+ *         by free().
+ *
+ */
+stats_lock_t *stats_get_locks(size_t *count)
+{
+	size_t size = 0;
+	stats_lock_t *stats_locks =
+	    (stats_lock_t *) sysinfo_get_data("system.locks", &size);
+
+	if ((size % sizeof(stats_lock_t)) != 0) {
+		if (stats_locks != NULL)
+			free(stats_locks);
+		*count = 0;
+		return NULL;
+	}
+
+	*count = size / sizeof(stats_lock_t);
+	return stats_locks;
+}
+
+/** Get single lock class statistics
+ *
+ * @param id Lock class we are interested in.
+ *
+ * @return Pointer to the stats_lock_t structure.
+ *         If non-NULL then it should be eventually freed
+ *         by free().
+ *
+ */
+stats_lock_t *stats_get_lock(unsigned int id)
+{
+	char name[SYSINFO_STATS_MAX_PATH];
+	snprintf(name, SYSINFO_STATS_MAX_PATH, "system.locks.%u", id);
+
+	size_t size = 0;
+	stats_lock_t *stats_lock =
+	    (stats_lock_t *) sysinfo_get_data(name, &size);
+
+	if (size != sizeof(stats_lock_t)) {
+		if (stats_lock != NULL)
+			free(stats_lock);
+		return NULL;
+	}
+
+	return stats_lock;
+}
+
 /** Get system load
  *
  * @param count Number of load records returned.
@@ -42,6 +42,7 @@
 #include <as.h>
 #include <context.h>
 #include <assert.h>
+#include <macros.h>
 
 #include <mem.h>
 #include <str.h>
@@ -56,9 +57,26 @@
 #define DPRINTF(...) ((void)0)
 #undef READY_DEBUG
 
-/** Member of timeout_list. */
-typedef struct {
-	link_t link;
+/** Maximum number of runners with a ready queue of their own. */
+#define RUNNERS_MAX 32
+
+/** Maximum number of calls received by one blocking IPC wait. */
+#define IPC_WAIT_BATCH 8
+
+/** Maximum number of calls deferred by fibril_ipc_call(). */
+#define IPC_SUBMIT_BATCH 16
+
+/** Node of a runner's timeout heap. */
+typedef struct _timeout {
+	/** First child in the pairing heap. */
+	struct _timeout *child;
+	/** Next sibling in the pairing heap. */
+	struct _timeout *next;
+	/** Left sibling, or parent of the first child. NULL for the root. */
+	struct _timeout *prev;
+	/** Root of the heap the timeout is armed in, NULL if not armed. */
+	struct _timeout **heap;
+
 	struct timespec expires;
 	fibril_event_t *event;
 } _timeout_t;
@@ -83,6 +101,14 @@ typedef enum {
 	SWITCH_FROM_BLOCKED,
 } _switch_type_t;
 
+/** Per-runner scheduling state, protected by fibril_futex. */
+typedef struct {
+	/** Fibrils which last ran on this runner and are ready again. */
+	list_t ready;
+	/** Timeouts armed by fibrils which went to sleep on this runner. */
+	_timeout_t *timeouts;
+} _runner_t;
+
 static bool multithreaded = false;
 
 /* This futex serializes access to global data. */
@@ -90,15 +116,31 @@ static futex_t fibril_futex;
 static futex_t ready_semaphore;
 static long ready_st_count;
 
-static LIST_INITIALIZE(ready_list);
+static _runner_t runners[RUNNERS_MAX];
+static atomic_uint runners_started;
 static LIST_INITIALIZE(fibril_list);
-static LIST_INITIALIZE(timeout_list);
 
 static futex_t ipc_lists_futex;
 static LIST_INITIALIZE(ipc_waiter_list);
 static LIST_INITIALIZE(ipc_buffer_list);
 static LIST_INITIALIZE(ipc_buffer_free_list);
 
+/*
+ * Calls waiting to be submitted in one batch, protected by ipc_submit_futex.
+ * One more entry is reserved for an answer submitted along with them.
+ */
+static futex_t ipc_submit_futex;
+static ipc_submit_t ipc_submits[IPC_SUBMIT_BATCH + 1];
+static fibril_ipc_failed_t ipc_submit_handlers[IPC_SUBMIT_BATCH + 1];
+static atomic_size_t ipc_submits_count;
+
+/** Deferred call which could not be made. */
+typedef struct {
+	fibril_ipc_failed_t handler;
+	sysarg_t label;
+	errno_t rc;
+} _ipc_failed_t;
+
 /* Only used as unique markers for triggered events. */
 static fibril_t _fibril_event_triggered;
 static fibril_t _fibril_event_timed_out;
@@ -110,8 +152,9 @@ static inline void _ready_debug_check(void)
 {
 #ifdef READY_DEBUG
 	assert(!multithreaded);
-	long count = (long) list_count(&ready_list) +
-	    (long) list_count(&ipc_buffer_free_list);
+	long count = (long) list_count(&ipc_buffer_free_list);
+	for (unsigned int i = 0; i < RUNNERS_MAX; i++)
+		count += (long) list_count(&runners[i].ready);
 	assert(ready_st_count == count);
 #endif
 }
@@ -136,8 +179,74 @@ static inline errno_t _ready_down(const struct timespec *expires)
 	return EOK;
 }
 
+/** Take a ready_semaphore token if one is available without blocking. */
+static inline bool _ready_trydown(void)
+{
+	if (multithreaded)
+		return futex_trydown(&ready_semaphore);
+
+	_ready_debug_check();
+	if (ready_st_count == 0)
+		return false;
+
+	ready_st_count--;
+	return true;
+}
+
 static atomic_int threads_in_ipc_wait;
 
+/** Assign a runner to a new helper fibril. */
+static void _runner_assign(fibril_t *helper)
+{
+	helper->runner = atomic_fetch_add_explicit(&runners_started, 1,
+	    memory_order_relaxed) % RUNNERS_MAX;
+}
+
+/** Number of runners which may hold ready fibrils. */
+static unsigned int _runner_count(void)
+{
+	return min(max(atomic_load_explicit(&runners_started,
+	    memory_order_relaxed), 1), RUNNERS_MAX);
+}
+
+/**
+ * Index of the runner executing the current fibril.
+ * Threads which never had to block yet share the first runner.
+ */
+static unsigned int _runner_index(void)
+{
+	fibril_t *helper = fibril_self()->thread_ctx;
+	return (helper != NULL) ? helper->runner : 0;
+}
+
+/**
+ * Take a ready fibril for the current runner.
+ *
+ * The runner's own queue is served in FIFO order. When it is empty,
+ * the most recently readied fibril of another runner is stolen, which
+ * is the one least likely to still be warm in that runner's cache.
+ */
+static fibril_t *_ready_list_take(void)
+{
+	futex_assert_is_locked(&fibril_futex);
+
+	unsigned int self = _runner_index();
+	fibril_t *f = list_pop(&runners[self].ready, fibril_t, link);
+	if (f)
+		return f;
+
+	unsigned int count = _runner_count();
+	for (unsigned int i = 1; i < count; i++) {
+		link_t *link = list_last(&runners[(self + i) % count].ready);
+		if (link) {
+			list_remove(link);
+			return list_get_instance(link, fibril_t, link);
+		}
+	}
+
+	return NULL;
+}
+
 /** Function that spans the whole life-cycle of a fibril.
  *
  * Each fibril begins execution in this function. Then the function implementing
@@ -237,22 +346,126 @@ static fibril_t *_fibril_trigger_internal(fibril_event_t *event, fibril_t *reaso
 	return f;
 }
 
-static errno_t _ipc_wait(ipc_call_t *call, const struct timespec *expires)
+static void _ready_list_push(fibril_t *f)
 {
-	if (!expires)
-		return ipc_wait(call, SYNCH_NO_TIMEOUT, SYNCH_FLAGS_NONE);
+	if (!f)
+		return;
+
+	futex_assert_is_locked(&fibril_futex);
 
-	if (expires->tv_sec == 0)
-		return ipc_wait(call, SYNCH_NO_TIMEOUT, SYNCH_FLAGS_NON_BLOCKING);
+	/* Enqueue on the runner which ran the fibril the last time. */
+	list_append(&f->link, &runners[f->runner].ready);
+	_ready_up();
+
+	if (atomic_load_explicit(&threads_in_ipc_wait, memory_order_relaxed)) {
+		DPRINTF("Poking.\n");
+		/* Wakeup one thread sleeping in SYS_IPC_WAIT. */
+		ipc_poke();
+	}
+}
+
+static errno_t _ipc_wait(ipc_call_t *calls, size_t count, size_t *received,
+    const struct timespec *expires)
+{
+	if (!expires) {
+		return ipc_wait_many(calls, count, received, SYNCH_NO_TIMEOUT,
+		    SYNCH_FLAGS_NONE);
+	}
+
+	if (expires->tv_sec == 0) {
+		return ipc_wait_many(calls, count, received, SYNCH_NO_TIMEOUT,
+		    SYNCH_FLAGS_NON_BLOCKING);
+	}
 
 	struct timespec now;
 	getuptime(&now);
 
-	if (ts_gteq(&now, expires))
-		return ipc_wait(call, SYNCH_NO_TIMEOUT, SYNCH_FLAGS_NON_BLOCKING);
+	if (ts_gteq(&now, expires)) {
+		return ipc_wait_many(calls, count, received, SYNCH_NO_TIMEOUT,
+		    SYNCH_FLAGS_NON_BLOCKING);
+	}
+
+	return ipc_wait_many(calls, count, received,
+	    NSEC2USEC(ts_sub_diff(expires, &now)), SYNCH_FLAGS_NONE);
+}
+
+/** Submit the pending entries.
+ *
+ * Must be called with ipc_submit_futex held. Calls which could not be
+ * made are stored in @a failed so that the caller can complete them once
+ * the futex is released.
+ *
+ * @param count   Number of entries to submit.
+ * @param failed  Array with room for each call among the entries.
+ *
+ * @return Number of failed calls.
+ *
+ */
+static size_t _ipc_submit(size_t count, _ipc_failed_t *failed)
+{
+	futex_assert_is_locked(&ipc_submit_futex);
+
+	for (size_t i = 0; i < count; i++)
+		ipc_submits[i].rc = EINPROGRESS;
+
+	/* Entries after the one which could not be read are not processed. */
+	errno_t rc = ipc_submit(ipc_submits, count);
+
+	size_t nfailed = 0;
+	for (size_t i = 0; i < count; i++) {
+		if (ipc_submits[i].rc == EINPROGRESS)
+			ipc_submits[i].rc = (rc != EOK) ? rc : EIO;
+
+		if ((ipc_submits[i].op == IPC_SUBMIT_CALL) &&
+		    (ipc_submits[i].rc != EOK)) {
+			failed[nfailed++] = (_ipc_failed_t) {
+				.handler = ipc_submit_handlers[i],
+				.label = ipc_submits[i].label,
+				.rc = ipc_submits[i].rc
+			};
+		}
+	}
+
+	atomic_store_explicit(&ipc_submits_count, 0, memory_order_relaxed);
+	return nfailed;
+}
+
+/** Complete calls which could not be made.
+ *
+ * No answer is going to arrive for them, so one carrying the error is
+ * passed to the handler given to fibril_ipc_call() in its place.
+ *
+ */
+static void _ipc_complete_failed(_ipc_failed_t *failed, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		ipc_call_t answer = { 0 };
+
+		ipc_set_retval(&answer, failed[i].rc);
+		answer.answer_label = failed[i].label;
+		failed[i].handler(&answer);
+	}
+}
+
+/** Submit the calls deferred by fibril_ipc_call(). */
+static void _ipc_flush(void)
+{
+	if (atomic_load_explicit(&ipc_submits_count, memory_order_relaxed) == 0)
+		return;
+
+	_ipc_failed_t failed[IPC_SUBMIT_BATCH];
+	size_t nfailed = 0;
+
+	futex_lock(&ipc_submit_futex);
+
+	size_t count = atomic_load_explicit(&ipc_submits_count,
+	    memory_order_relaxed);
+	if (count > 0)
+		nfailed = _ipc_submit(count, failed);
 
-	return ipc_wait(call, NSEC2USEC(ts_sub_diff(expires, &now)),
-	    SYNCH_FLAGS_NONE);
+	futex_unlock(&ipc_submit_futex);
+
+	_ipc_complete_failed(failed, nfailed);
 }
 
 /*
@@ -284,7 +497,7 @@ static fibril_t *_ready_list_pop(const struct timespec *expires, bool locked)
 
 	if (!locked)
 		futex_lock(&fibril_futex);
-	fibril_t *f = list_pop(&ready_list, fibril_t, link);
+	fibril_t *f = _ready_list_take();
 	if (!f)
 		atomic_fetch_add_explicit(&threads_in_ipc_wait, 1,
 		    memory_order_relaxed);
@@ -297,16 +510,33 @@ static fibril_t *_ready_list_pop(const struct timespec *expires, bool locked)
 	if (!multithreaded)
 		assert(list_empty(&ipc_buffer_list));
 
-	/* No fibril is ready, IPC wait it is. */
-	ipc_call_t call = { 0 };
-	rc = _ipc_wait(&call, expires);
+	/*
+	 * No fibril is ready, IPC wait it is.
+	 *
+	 * Each call we receive may need a buffer bucket and thus a token.
+	 * When we are going to block anyway, take the tokens which are
+	 * available right away and receive as many calls as possible in
+	 * one go.
+	 */
+	ipc_call_t calls[IPC_WAIT_BATCH];
+	size_t tokens = 1;
+
+	if (!locked && (!expires || expires->tv_sec != 0)) {
+		while (tokens < IPC_WAIT_BATCH && _ready_trydown())
+			tokens++;
+	}
+
+	calls[0] = (ipc_call_t) { 0 };
+	size_t received = 0;
+	rc = _ipc_wait(calls, tokens, &received, expires);
 
 	atomic_fetch_sub_explicit(&threads_in_ipc_wait, 1,
 	    memory_order_relaxed);
 
 	if (rc != EOK && rc != ENOENT) {
-		/* Return token. */
-		_ready_up();
+		/* Return tokens. */
+		while (tokens-- > 0)
+			_ready_up();
 		return NULL;
 	}
 
@@ -315,6 +545,12 @@ static fibril_t *_ready_list_pop(const struct timespec *expires, bool locked)
 	 * In that case, we propagate the null call out of fibril_ipc_wait(),
 	 * because poke must result in that call returning.
 	 */
+	if (rc == ENOENT)
+		received = 1;
+
+	/* Return the tokens we have no calls for. */
+	for (size_t i = received; i < tokens; i++)
+		_ready_up();
 
 	/*
 	 * If a fibril is already waiting for IPC, we wake up the fibril,
@@ -329,20 +565,39 @@ static fibril_t *_ready_list_pop(const struct timespec *expires, bool locked)
 
 	futex_lock(&ipc_lists_futex);
 
-	_ipc_waiter_t *w = list_pop(&ipc_waiter_list, _ipc_waiter_t, link);
-	if (w) {
-		*w->call = call;
-		w->rc = rc;
-		/* We switch to the woken up fibril immediately if possible. */
-		f = _fibril_trigger_internal(&w->event, _EVENT_TRIGGERED);
-
-		/* Return token. */
-		_ready_up();
-	} else {
-		_ipc_buffer_t *buf = list_pop(&ipc_buffer_free_list, _ipc_buffer_t, link);
-		assert(buf);
-		*buf = (_ipc_buffer_t) { .call = call, .rc = rc };
-		list_append(&buf->link, &ipc_buffer_list);
+	for (size_t i = 0; i < received; i++) {
+		_ipc_waiter_t *w = list_pop(&ipc_waiter_list, _ipc_waiter_t,
+		    link);
+		if (w) {
+			*w->call = calls[i];
+			w->rc = rc;
+			/*
+			 * We switch to the first woken up fibril immediately
+			 * if possible.
+			 */
+			fibril_t *wf = _fibril_trigger_internal(&w->event,
+			    _EVENT_TRIGGERED);
+
+			/*
+			 * Unless it last ran on a different runner. Then it is
+			 * queued there and this runner steals it only if it is
+			 * still waiting when we come back for more work.
+			 */
+			if (wf && (f || (multithreaded &&
+			    wf->runner != _runner_index())))
+				_ready_list_push(wf);
+			else if (wf)
+				f = wf;
+
+			/* Return token. */
+			_ready_up();
+		} else {
+			_ipc_buffer_t *buf = list_pop(&ipc_buffer_free_list,
+			    _ipc_buffer_t, link);
+			assert(buf);
+			*buf = (_ipc_buffer_t) { .call = calls[i], .rc = rc };
+			list_append(&buf->link, &ipc_buffer_list);
+		}
 	}
 
 	futex_unlock(&ipc_lists_futex);
@@ -359,24 +614,6 @@ static fibril_t *_ready_list_pop_nonblocking(bool locked)
 	return _ready_list_pop(&tv, locked);
 }
 
-static void _ready_list_push(fibril_t *f)
-{
-	if (!f)
-		return;
-
-	futex_assert_is_locked(&fibril_futex);
-
-	/* Enqueue in ready_list. */
-	list_append(&f->link, &ready_list);
-	_ready_up();
-
-	if (atomic_load_explicit(&threads_in_ipc_wait, memory_order_relaxed)) {
-		DPRINTF("Poking.\n");
-		/* Wakeup one thread sleeping in SYS_IPC_WAIT. */
-		ipc_poke();
-	}
-}
-
 /* Blocks the current fibril until an IPC call arrives. */
 static errno_t _wait_ipc(ipc_call_t *call, const struct timespec *expires)
 {
@@ -414,6 +651,104 @@ static errno_t _wait_ipc(ipc_call_t *call, const struct timespec *expires)
 	return rc;
 }
 
+/** Meld two timeout heaps. */
+static _timeout_t *_timeout_meld(_timeout_t *a, _timeout_t *b)
+{
+	if (!a)
+		return b;
+	if (!b)
+		return a;
+
+	if (ts_gt(&a->expires, &b->expires)) {
+		_timeout_t *tmp = a;
+		a = b;
+		b = tmp;
+	}
+
+	b->prev = a;
+	b->next = a->child;
+	if (a->child)
+		a->child->prev = b;
+	a->child = b;
+
+	return a;
+}
+
+/** Meld a list of sibling heaps into one, pairing them in two passes. */
+static _timeout_t *_timeout_merge_pairs(_timeout_t *first)
+{
+	_timeout_t *pairs = NULL;
+
+	while (first) {
+		_timeout_t *a = first;
+		_timeout_t *b = a->next;
+		first = b ? b->next : NULL;
+
+		a->prev = a->next = NULL;
+		if (b)
+			b->prev = b->next = NULL;
+
+		_timeout_t *pair = _timeout_meld(a, b);
+		pair->next = pairs;
+		pairs = pair;
+	}
+
+	_timeout_t *root = NULL;
+
+	while (pairs) {
+		_timeout_t *pair = pairs;
+		pairs = pair->next;
+		pair->next = NULL;
+
+		root = _timeout_meld(root, pair);
+	}
+
+	return root;
+}
+
+/** Arm a timeout on the current runner. Takes constant time. */
+static void _insert_timeout(_timeout_t *timeout)
+{
+	futex_assert_is_locked(&fibril_futex);
+	assert(timeout);
+	assert(!timeout->heap);
+
+	_timeout_t **heap = &runners[_runner_index()].timeouts;
+
+	timeout->child = timeout->next = timeout->prev = NULL;
+	timeout->heap = heap;
+	*heap = _timeout_meld(*heap, timeout);
+}
+
+/** Disarm a timeout, if it is armed. Takes amortized logarithmic time. */
+static void _remove_timeout(_timeout_t *timeout)
+{
+	futex_assert_is_locked(&fibril_futex);
+
+	_timeout_t **heap = timeout->heap;
+	if (!heap)
+		return;
+
+	_timeout_t *children = _timeout_merge_pairs(timeout->child);
+
+	if (timeout == *heap) {
+		*heap = children;
+	} else {
+		if (timeout->prev->child == timeout)
+			timeout->prev->child = timeout->next;
+		else
+			timeout->prev->next = timeout->next;
+
+		if (timeout->next)
+			timeout->next->prev = timeout->prev;
+
+		*heap = _timeout_meld(*heap, children);
+	}
+
+	timeout->child = timeout->next = timeout->prev = NULL;
+	timeout->heap = NULL;
+}
+
 /** Fire all timeouts that expired. */
 static struct timespec *_handle_expired_timeouts(struct timespec *next_timeout)
 {
@@ -422,24 +757,34 @@ static struct timespec *_handle_expired_timeouts(struct timespec *next_timeout)
 
 	futex_lock(&fibril_futex);
 
-	while (!list_empty(&timeout_list)) {
-		link_t *cur = list_first(&timeout_list);
-		_timeout_t *to = list_get_instance(cur, _timeout_t, link);
+	/*
+	 * Any runner fires expired timeouts of all runners, so that
+	 * a runner busy with a long-running fibril doesn't delay them.
+	 */
+	struct timespec *next = NULL;
+	unsigned int count = _runner_count();
 
-		if (ts_gt(&to->expires, &ts)) {
-			*next_timeout = to->expires;
-			futex_unlock(&fibril_futex);
-			return next_timeout;
-		}
+	for (unsigned int i = 0; i < count; i++) {
+		_timeout_t *to;
 
-		list_remove(&to->link);
+		while ((to = runners[i].timeouts) != NULL) {
+			if (ts_gt(&to->expires, &ts)) {
+				if (!next || ts_gt(next, &to->expires)) {
+					*next_timeout = to->expires;
+					next = next_timeout;
+				}
+				break;
+			}
 
-		_ready_list_push(_fibril_trigger_internal(
-		    to->event, _EVENT_TIMED_OUT));
+			_remove_timeout(to);
+
+			_ready_list_push(_fibril_trigger_internal(
+			    to->event, _EVENT_TIMED_OUT));
+		}
 	}
 
 	futex_unlock(&fibril_futex);
-	return NULL;
+	return next;
 }
 
 /**
@@ -488,6 +833,10 @@ static void _fibril_switch_to(_switch_type_t type, fibril_t *dstf, bool locked)
 	dstf->thread_ctx = srcf->thread_ctx;
 	srcf->thread_ctx = NULL;
 
+	/* Remember where the fibril ran, so that it returns there when woken. */
+	if (dstf->thread_ctx)
+		dstf->runner = dstf->thread_ctx->runner;
+
 	/* Just some bookkeeping to allow better debugging of futex locks. */
 	futex_give_to(&fibril_futex, dstf);
 
@@ -595,24 +944,6 @@ void fibril_destroy(fid_t fid)
 	fibril_teardown(fibril);
 }
 
-static void _insert_timeout(_timeout_t *timeout)
-{
-	futex_assert_is_locked(&fibril_futex);
-	assert(timeout);
-
-	link_t *tmp = timeout_list.head.next;
-	while (tmp != &timeout_list.head) {
-		_timeout_t *cur = list_get_instance(tmp, _timeout_t, link);
-
-		if (ts_gteq(&cur->expires, &timeout->expires))
-			break;
-
-		tmp = tmp->next;
-	}
-
-	list_insert_before(&timeout->link, tmp);
-}
-
 /**
  * Same as `fibril_wait_for()`, except with a timeout.
  *
@@ -630,11 +961,16 @@ errno_t fibril_wait_timeout(fibril_event_t *event,
 
 	DPRINTF("### Fibril %p sleeping on event %p.\n", fibril_self(), event);
 
+	/* The calls must not wait for other fibrils to run first. */
+	_ipc_flush();
+
 	if (!fibril_self()->thread_ctx) {
 		fibril_self()->thread_ctx =
 		    fibril_create_generic(_helper_fibril_fn, NULL, PAGE_SIZE);
 		if (!fibril_self()->thread_ctx)
 			return ENOMEM;
+
+		_runner_assign(fibril_self()->thread_ctx);
 	}
 
 	futex_lock(&fibril_futex);
@@ -697,7 +1033,7 @@ errno_t fibril_wait_timeout(fibril_event_t *event,
 	assert(event->fibril != _EVENT_INITIAL);
 	assert(event->fibril == _EVENT_TIMED_OUT || event->fibril == _EVENT_TRIGGERED);
 
-	list_remove(&timeout.link);
+	_remove_timeout(&timeout);
 	errno_t rc = (event->fibril == _EVENT_TIMED_OUT) ? ETIMEOUT : EOK;
 	event->fibril = _EVENT_INITIAL;
 
@@ -736,6 +1072,8 @@ void fibril_start(fibril_t *fibril)
 	if (!link_in_use(&fibril->all_link))
 		list_append(&fibril->all_link, &fibril_list);
 
+	/* New fibrils start on the runner which created them. */
+	fibril->runner = _runner_index();
 	_ready_list_push(fibril);
 
 	futex_unlock(&fibril_futex);
@@ -775,6 +1113,8 @@ void fibril_yield(void)
 	if (fibril_self()->rmutex_locks > 0)
 		return;
 
+	_ipc_flush();
+
 	fibril_t *f = _ready_list_pop_nonblocking(false);
 	if (f)
 		_fibril_switch_to(SWITCH_FROM_YIELD, f, false);
@@ -782,6 +1122,7 @@ void fibril_yield(void)
 
 static void _runner_fn(void *arg)
 {
+	_runner_assign(fibril_self());
 	_helper_fibril_fn(arg);
 }
 
@@ -855,6 +1196,8 @@ _Noreturn void fibril_exit(long retval)
 	// TODO: implement fibril_join() and remember retval
 	(void) retval;
 
+	_ipc_flush();
+
 	fibril_t *f = _ready_list_pop_nonblocking(false);
 	if (!f)
 		f = fibril_self()->thread_ctx;
@@ -869,6 +1212,11 @@ void __fibrils_init(void)
 		abort();
 	if (futex_initialize(&ipc_lists_futex, 1) != EOK)
 		abort();
+	if (futex_initialize(&ipc_submit_futex, 1) != EOK)
+		abort();
+
+	for (unsigned int i = 0; i < RUNNERS_MAX; i++)
+		list_initialize(&runners[i].ready);
 
 	/*
 	 * We allow a fixed, small amount of parallelism for IPC reads, but
@@ -923,5 +1271,92 @@ errno_t fibril_ipc_wait(ipc_call_t *call, const struct timespec *expires)
 	return _wait_ipc(call, expires);
 }
 
+/** Make an asynchronous call in a batch with other calls.
+ *
+ * The call is submitted along with other deferred calls in a single
+ * syscall, at the latest when the fibril yields, blocks or exits, or
+ * before any other IPC operation of the task. If the call cannot be made,
+ * an answer with the error code is passed to @a failed_handler. Only calls
+ * which do not make the kernel touch the memory of the task may be deferred.
+ *
+ * @param phandle        Phone to make the call over.
+ * @param call           Method and arguments of the call.
+ * @param failed_handler Handler of the answer if the call cannot be made.
+ *                       It is called without any fibril locks held.
+ * @param label          Label of the answer.
+ *
+ */
+void fibril_ipc_call(cap_phone_handle_t phandle, const ipc_call_t *call,
+    fibril_ipc_failed_t failed_handler, void *label)
+{
+	_ipc_failed_t failed[IPC_SUBMIT_BATCH];
+	size_t nfailed = 0;
+
+	futex_lock(&ipc_submit_futex);
+
+	size_t count = atomic_load_explicit(&ipc_submits_count,
+	    memory_order_relaxed);
+	if (count == IPC_SUBMIT_BATCH) {
+		nfailed = _ipc_submit(count, failed);
+		count = 0;
+	}
+
+	ipc_submits[count].op = IPC_SUBMIT_CALL;
+	ipc_submit_handlers[count] = failed_handler;
+	ipc_submits[count].handle = (cap_handle_t) phandle;
+	ipc_submits[count].label = (sysarg_t) label;
+	memcpy(ipc_submits[count].args, call->args,
+	    sizeof(ipc_submits[count].args));
+
+	atomic_store_explicit(&ipc_submits_count, count + 1,
+	    memory_order_relaxed);
+
+	futex_unlock(&ipc_submit_futex);
+
+	_ipc_complete_failed(failed, nfailed);
+}
+
+/** Answer a call along with the deferred calls.
+ *
+ * The answer and all calls deferred by fibril_ipc_call() are submitted in
+ * a single syscall right away. Only answers which do not make the kernel
+ * touch the memory of the task may be submitted this way.
+ *
+ * @param chandle Handle of the call to answer.
+ * @param answer  Return value and arguments of the answer.
+ *
+ * @return Result of the answer.
+ *
+ */
+errno_t fibril_ipc_answer(cap_call_handle_t chandle, const ipc_call_t *answer)
+{
+	_ipc_failed_t failed[IPC_SUBMIT_BATCH];
+
+	futex_lock(&ipc_submit_futex);
+
+	size_t count = atomic_load_explicit(&ipc_submits_count,
+	    memory_order_relaxed);
+
+	ipc_submits[count].op = IPC_SUBMIT_ANSWER;
+	ipc_submits[count].handle = (cap_handle_t) chandle;
+	ipc_submits[count].label = 0;
+	memcpy(ipc_submits[count].args, answer->args,
+	    sizeof(ipc_submits[count].args));
+
+	size_t nfailed = _ipc_submit(count + 1, failed);
+	errno_t rc = ipc_submits[count].rc;
+
+	futex_unlock(&ipc_submit_futex);
+
+	_ipc_complete_failed(failed, nfailed);
+	return rc;
+}
+
+/** Submit the deferred calls right away. */
+void fibril_ipc_flush(void)
+{
+	_ipc_flush();
+}
+
 /** @}
  */
@@ -53,6 +53,8 @@
 errno_t futex_initialize(futex_t *futex, int val)
 {
 	atomic_store_explicit(&futex->val, val, memory_order_relaxed);
+	atomic_store_explicit(&futex->owner, NULL, memory_order_relaxed);
+	atomic_store_explicit(&futex->spins, 0, memory_order_relaxed);
 	futex->whandle = CAP_NIL;
 	return futex_allocate_waitq(futex);
 }
@@ -91,6 +93,8 @@ void __futex_lock(futex_t *futex, const char *name)
 	fibril_t *self = (fibril_t *) fibril_get_id();
 	DPRINTF("Locking futex %s (%p) by fibril %p.\n", name, futex, self);
 	__futex_assert_is_not_locked(futex, name);
+	if (atomic_load_explicit(&futex->val, memory_order_relaxed) <= 0)
+		futex_spin(futex);
 	futex_down(futex);
 
 	void *prev_owner = atomic_load_explicit(&futex->owner,
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** @addtogroup libc
+ * @{
+ */
+/** @file Concurrent hash table
+ */
+
+#ifndef _LIBC_CHASH_TABLE_H_
+#define _LIBC_CHASH_TABLE_H_
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <macros.h>
+
+/** Opaque concurrent hash table link type. */
+typedef struct cht_link {
+	struct cht_link *next;
+} cht_link_t;
+
+/** Set of operations for concurrent hash table.
+ *
+ * All operations are called with a bucket lock held. They must not
+ * block, use any fibril synchronization or touch the table itself.
+ */
+typedef struct {
+	/** Returns the hash of the key stored in the item (ie its lookup key). */
+	size_t (*hash)(const cht_link_t *item);
+
+	/** Returns the hash of the key. */
+	size_t (*key_hash)(const void *key);
+
+	/** True if the items are equal (have the same lookup keys). */
+	bool (*equal)(const cht_link_t *item1, const cht_link_t *item2);
+
+	/** Returns true if the key is equal to the item's lookup key. */
+	bool (*key_equal)(const void *key, const cht_link_t *item);
+
+	/** Item lookup callback (optional).
+	 *
+	 * Lets the caller of chash_table_find() take a reference to the
+	 * item before anyone else may remove it from the table.
+	 *
+	 * @param item Item that was found.
+	 */
+	void (*acquire)(cht_link_t *item);
+
+	/** Item removal callback (optional).
+	 *
+	 * @param item Item that was removed from the hash table.
+	 */
+	void (*remove_callback)(cht_link_t *item);
+} chash_table_ops_t;
+
+/** Concurrent hash table structure.
+ *
+ * Buckets are protected by a fixed set of locks, each covering every
+ * n-th bucket, so threads working with different keys rarely contend.
+ */
+typedef struct {
+	chash_table_ops_t *op;
+	cht_link_t **bucket;
+	size_t bucket_cnt;
+	atomic_size_t item_cnt;
+	/** Bucket locks */
+	void *locks;
+} chash_table_t;
+
+#define chash_table_get_inst(item, type, member) \
+	member_to_inst((item), type, member)
+
+extern bool chash_table_create(chash_table_t *, size_t, chash_table_ops_t *);
+extern void chash_table_destroy(chash_table_t *);
+
+extern size_t chash_table_size(chash_table_t *);
+
+extern void chash_table_insert(chash_table_t *, cht_link_t *);
+extern bool chash_table_insert_unique(chash_table_t *, cht_link_t *);
+extern cht_link_t *chash_table_find(chash_table_t *, const void *);
+extern size_t chash_table_remove(chash_table_t *, const void *);
+extern bool chash_table_remove_item(chash_table_t *, cht_link_t *);
+
+#endif
+
+/** @}
+ */
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** @addtogroup libc
+ * @{
+ */
+/** @file Bounded multi-producer, multi-consumer queue
+ */
+
+#ifndef _LIBC_MPMC_QUEUE_H_
+#define _LIBC_MPMC_QUEUE_H_
+
+#include <errno.h>
+#include <stdatomic.h>
+#include <stddef.h>
+
+/** Bounded lock-free multi-producer, multi-consumer queue
+ *
+ * The queue may be used by any number of threads and fibrils at the
+ * same time without external locking. Neither pushing nor popping
+ * ever blocks, a full or empty queue is reported to the caller.
+ */
+typedef struct {
+	/** Cells holding a sequence number followed by the entry */
+	void *buf;
+	/** Number of cells minus one (the number of cells is a power of 2) */
+	size_t mask;
+	/** Entry size */
+	size_t size;
+	/** Cell size */
+	size_t cell_size;
+
+	/** Write position */
+	atomic_size_t wp;
+	/** Keep producers and consumers on separate cache lines */
+	char pad[64];
+	/** Read position */
+	atomic_size_t rp;
+} mpmc_queue_t;
+
+extern errno_t mpmc_queue_init(mpmc_queue_t *, size_t, size_t);
+extern void mpmc_queue_fini(mpmc_queue_t *);
+extern errno_t mpmc_queue_push(mpmc_queue_t *, const void *);
+extern errno_t mpmc_queue_pop(mpmc_queue_t *, void *);
+
+#endif
+
+/** @}
+ */
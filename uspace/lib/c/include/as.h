@@ -60,6 +60,7 @@ extern errno_t as_area_resize(void *, size_t, unsigned int);
 extern errno_t as_area_change_flags(void *, unsigned int);
 extern errno_t as_area_get_info(void *, as_area_info_t *);
 extern errno_t as_area_destroy(void *);
+extern errno_t as_area_populate(void *, size_t);
 extern void *set_maxheapsize(size_t);
 extern errno_t as_get_physical_mapping(const void *, uintptr_t *);
 
@@ -46,6 +46,9 @@
 #include <abi/cap.h>
 
 extern errno_t ipc_wait(ipc_call_t *, sysarg_t, unsigned int);
+extern errno_t ipc_wait_many(ipc_call_t *, size_t, size_t *, sysarg_t,
+    unsigned int);
+extern errno_t ipc_submit(ipc_submit_t *, size_t);
 extern void ipc_poke(void);
 
 /*
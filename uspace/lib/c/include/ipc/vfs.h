@@ -61,6 +61,14 @@ typedef struct {
 	unsigned int instance;
 	bool concurrent_read_write;
 	bool write_retains_size;
+	/** File contents may be cached by VFS. */
+	bool page_cache;
+	/**
+	 * Namespace is only modified through VFS and may be cached. Names
+	 * are cached verbatim, so a writable file system which matches
+	 * names case-insensitively must leave this off.
+	 */
+	bool dentry_cache;
 } vfs_info_t;
 
 /** Data returned by filesystem probe regarding a specific volume. */
@@ -69,6 +77,16 @@ typedef struct {
 	char vuid[FS_VUID_MAXLEN + 1];
 } vfs_fs_probe_info_t;
 
+/** Maximum number of nodes reported by a lookup with L_TRACE. */
+#define VFS_LOOKUP_STEPS_MAX  32
+
+/** Node found on the way by a lookup with L_TRACE. */
+typedef struct {
+	uint64_t size;
+	fs_index_t index;
+	bool directory;
+} vfs_lookup_step_t;
+
 typedef enum {
 	VFS_IN_CLONE = IPC_FIRST_USER_METHOD,
 	VFS_IN_FSPROBE,
@@ -162,6 +180,13 @@ typedef enum {
  */
 #define L_UNLINK		64
 
+/**
+ * L_TRACE makes the file system report the node found for each path component
+ * in an IPC_M_DATA_READ which follows the lookup request. Like L_UNLINK, it is
+ * only set by VFS, which uses it to fill its path component cache.
+ */
+#define L_TRACE			128
+
 /*
  * Walk flags.
  */
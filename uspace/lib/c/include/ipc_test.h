@@ -45,10 +45,13 @@ typedef struct {
 extern errno_t ipc_test_create(ipc_test_t **);
 extern void ipc_test_destroy(ipc_test_t *);
 extern errno_t ipc_test_ping(ipc_test_t *);
+extern errno_t ipc_test_ping_many(ipc_test_t *, size_t);
 extern errno_t ipc_test_get_ro_area_size(ipc_test_t *, size_t *);
 extern errno_t ipc_test_get_rw_area_size(ipc_test_t *, size_t *);
 extern errno_t ipc_test_share_in_ro(ipc_test_t *, size_t, const void **);
 extern errno_t ipc_test_share_in_rw(ipc_test_t *, size_t, void **);
+extern errno_t ipc_test_data_write(ipc_test_t *, const void *, size_t);
+extern errno_t ipc_test_data_read(ipc_test_t *, void *, size_t);
 
 #endif
 
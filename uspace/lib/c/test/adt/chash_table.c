@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <adt/chash_table.h>
+#include <pcut/pcut.h>
+#include <stdlib.h>
+
+PCUT_INIT;
+
+PCUT_TEST_SUITE(chash_table);
+
+typedef struct {
+	cht_link_t link;
+	int key;
+	int refs;
+	bool removed;
+} test_item_t;
+
+static size_t test_hash(const cht_link_t *item)
+{
+	return chash_table_get_inst(item, test_item_t, link)->key;
+}
+
+static size_t test_key_hash(const void *key)
+{
+	return *(const int *) key;
+}
+
+static bool test_equal(const cht_link_t *item1, const cht_link_t *item2)
+{
+	return chash_table_get_inst(item1, test_item_t, link)->key ==
+	    chash_table_get_inst(item2, test_item_t, link)->key;
+}
+
+static bool test_key_equal(const void *key, const cht_link_t *item)
+{
+	return *(const int *) key ==
+	    chash_table_get_inst(item, test_item_t, link)->key;
+}
+
+static void test_acquire(cht_link_t *item)
+{
+	chash_table_get_inst(item, test_item_t, link)->refs++;
+}
+
+static void test_remove_callback(cht_link_t *item)
+{
+	chash_table_get_inst(item, test_item_t, link)->removed = true;
+}
+
+static chash_table_ops_t test_ops = {
+	.hash = test_hash,
+	.key_hash = test_key_hash,
+	.equal = test_equal,
+	.key_equal = test_key_equal,
+	.acquire = test_acquire,
+	.remove_callback = test_remove_callback
+};
+
+enum {
+	item_count = 1000
+};
+
+/** Insert, find and remove items, growing the table on the way. */
+PCUT_TEST(insert_find_remove)
+{
+	chash_table_t table;
+	test_item_t *items;
+	bool ok;
+
+	items = calloc(item_count, sizeof(test_item_t));
+	PCUT_ASSERT_NOT_NULL(items);
+
+	ok = chash_table_create(&table, 0, &test_ops);
+	PCUT_ASSERT_TRUE(ok);
+
+	for (int i = 0; i < item_count; i++) {
+		items[i].key = i;
+		ok = chash_table_insert_unique(&table, &items[i].link);
+		PCUT_ASSERT_TRUE(ok);
+	}
+
+	PCUT_ASSERT_INT_EQUALS(item_count, chash_table_size(&table));
+
+	test_item_t dup = { .key = 42 };
+	ok = chash_table_insert_unique(&table, &dup.link);
+	PCUT_ASSERT_FALSE(ok);
+
+	for (int i = 0; i < item_count; i++) {
+		cht_link_t *link = chash_table_find(&table, &i);
+		PCUT_ASSERT_EQUALS(&items[i].link, link);
+		PCUT_ASSERT_INT_EQUALS(1, items[i].refs);
+	}
+
+	int missing = item_count;
+	PCUT_ASSERT_NULL(chash_table_find(&table, &missing));
+
+	for (int i = 0; i < item_count; i += 2) {
+		ok = chash_table_remove_item(&table, &items[i].link);
+		PCUT_ASSERT_TRUE(ok);
+		PCUT_ASSERT_TRUE(items[i].removed);
+	}
+
+	for (int i = 1; i < item_count; i += 2) {
+		PCUT_ASSERT_INT_EQUALS(1, chash_table_remove(&table, &i));
+		PCUT_ASSERT_TRUE(items[i].removed);
+	}
+
+	PCUT_ASSERT_INT_EQUALS(0, chash_table_size(&table));
+	PCUT_ASSERT_FALSE(chash_table_remove_item(&table, &items[0].link));
+
+	chash_table_destroy(&table);
+	free(items);
+}
+
+PCUT_EXPORT(chash_table);
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <adt/mpmc_queue.h>
+#include <pcut/pcut.h>
+
+PCUT_INIT;
+
+PCUT_TEST_SUITE(mpmc_queue);
+
+enum {
+	queue_size = 16
+};
+
+/** Basic insertion/deletion test.
+ *
+ * Push entries until the queue is full, then empty it again
+ * and check the entries come out in the same order.
+ */
+PCUT_TEST(push_pop)
+{
+	mpmc_queue_t queue;
+	int i;
+	int j;
+	errno_t rc;
+
+	rc = mpmc_queue_init(&queue, queue_size, sizeof(int));
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	for (i = 0; i < queue_size; i++) {
+		rc = mpmc_queue_push(&queue, &i);
+		PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+	}
+
+	rc = mpmc_queue_push(&queue, &i);
+	PCUT_ASSERT_ERRNO_VAL(EAGAIN, rc);
+
+	for (i = 0; i < queue_size; i++) {
+		rc = mpmc_queue_pop(&queue, &j);
+		PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+		PCUT_ASSERT_INT_EQUALS(i, j);
+	}
+
+	rc = mpmc_queue_pop(&queue, &j);
+	PCUT_ASSERT_ERRNO_VAL(EAGAIN, rc);
+
+	mpmc_queue_fini(&queue);
+}
+
+/** Entries survive many wrap-arounds of the positions. */
+PCUT_TEST(wrap_around)
+{
+	mpmc_queue_t queue;
+	int j;
+	errno_t rc;
+
+	rc = mpmc_queue_init(&queue, 3, sizeof(int));
+	PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+	for (int i = 0; i < 1000; i++) {
+		rc = mpmc_queue_push(&queue, &i);
+		PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+
+		if (i % 3 == 2) {
+			for (int k = i - 2; k <= i; k++) {
+				rc = mpmc_queue_pop(&queue, &j);
+				PCUT_ASSERT_ERRNO_VAL(EOK, rc);
+				PCUT_ASSERT_INT_EQUALS(k, j);
+			}
+		}
+	}
+
+	mpmc_queue_fini(&queue);
+}
+
+PCUT_EXPORT(mpmc_queue);
@@ -33,6 +33,7 @@ PCUT_INIT;
 
 PCUT_IMPORT(capa);
 PCUT_IMPORT(casting);
+PCUT_IMPORT(chash_table);
 PCUT_IMPORT(circ_buf);
 PCUT_IMPORT(double_to_str);
 PCUT_IMPORT(fibril_timer);
@@ -42,6 +43,7 @@ PCUT_IMPORT(ieee_double);
 PCUT_IMPORT(imath);
 PCUT_IMPORT(inttypes);
 PCUT_IMPORT(mem);
+PCUT_IMPORT(mpmc_queue);
 PCUT_IMPORT(odict);
 PCUT_IMPORT(perf);
 PCUT_IMPORT(perm);
@@ -34,6 +34,7 @@
  * @brief Test General utilities (stdlib.h)
  */
 
+#include <macros.h>
 #include <pcut/pcut.h>
 #include <stdlib.h>
 
@@ -133,6 +134,29 @@ PCUT_TEST(malloc)
 	free(p);
 }
 
+/** realloc preserves contents when moving between small and large blocks */
+PCUT_TEST(realloc_grow_shrink)
+{
+	static const size_t sizes[] = { 8, 100, 1000, 5000, 512 * 1024, 24 };
+	unsigned char *p = NULL;
+	size_t prev = 0;
+
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		p = realloc(p, sizes[i]);
+		PCUT_ASSERT_NOT_NULL(p);
+
+		for (size_t j = 0; j < min(prev, sizes[i]); j++)
+			PCUT_ASSERT_INT_EQUALS((unsigned char) j, p[j]);
+
+		for (size_t j = 0; j < sizes[i]; j++)
+			p[j] = (unsigned char) j;
+
+		prev = sizes[i];
+	}
+
+	free(p);
+}
+
 /** Just check abort() is defined */
 PCUT_TEST(abort)
 {
@@ -82,15 +82,19 @@ namespace std
                 data_ = allocator_.allocate(capacity_);
 
                 for (size_type i = 0; i < size_; ++i)
-                    data_[i] = val;
+                    allocator_traits<Allocator>::construct(allocator_, data_ + i, val);
             }
 
-            template<class InputIterator>
+            template<
+                class InputIterator,
+                class = enable_if_t<!is_integral<InputIterator>::value>
+            >
             vector(InputIterator first, InputIterator last,
                    const Allocator& alloc = Allocator{})
+                : data_{nullptr}, size_{}, capacity_{}, allocator_{alloc}
             {
-                // TODO: research constraints and provide multiple
-                //       implementations via enable_if
+                while (first != last)
+                    emplace_back(*first++);
             }
 
             vector(const vector& other)
@@ -100,7 +104,7 @@ namespace std
                 data_ = allocator_.allocate(capacity_);
 
                 for (size_type i = 0; i < size_; ++i)
-                    data_[i] = other.data_[i];
+                    allocator_traits<Allocator>::construct(allocator_, data_ + i, other.data_[i]);
             }
 
             vector(vector&& other) noexcept
@@ -119,7 +123,7 @@ namespace std
                 data_ = allocator_.allocate(capacity_);
 
                 for (size_type i = 0; i < size_; ++i)
-                    data_[i] = other.data_[i];
+                    allocator_traits<Allocator>::construct(allocator_, data_ + i, other.data_[i]);
             }
 
             vector(initializer_list<T> init, const Allocator& alloc = Allocator{})
@@ -131,12 +135,13 @@ namespace std
                 auto it = init.begin();
                 for (size_type i = 0; it != init.end(); ++i, ++it)
                 {
-                    data_[i] = *it;
+                    allocator_traits<Allocator>::construct(allocator_, data_ + i, *it);
                 }
             }
 
             ~vector()
             {
+                destroy_from_end_until_(begin());
                 allocator_.deallocate(data_, capacity_);
             }
 
@@ -153,7 +158,10 @@ namespace std
                          allocator_traits<Allocator>::is_always_equal::value)
             {
                 if (data_)
+                {
+                    destroy_from_end_until_(begin());
                     allocator_.deallocate(data_, capacity_);
+                }
 
                 // TODO: test this
                 data_ = other.data_;
@@ -176,7 +184,10 @@ namespace std
                 return *this;
             }
 
-            template<class InputIterator>
+            template<
+                class InputIterator,
+                class = enable_if_t<!is_integral<InputIterator>::value>
+            >
             void assign(InputIterator first, InputIterator last)
             {
                 vector tmp{first, last};
@@ -274,16 +285,26 @@ namespace std
 
             void resize(size_type sz)
             {
-                resize_with_copy_(size_, capacity_);
+                if (sz <= size_)
+                    resize_with_copy_(sz, capacity_);
+                else
+                {
+                    reserve(sz);
+                    while (size_ < sz)
+                        emplace_back();
+                }
             }
 
             void resize(size_type sz, const value_type& val)
             {
-                auto old_size = size_;
-                resize_with_copy_(sz, capacity_);
-
-                for (size_type i = old_size - 1; i < size_; ++i)
-                    data_[i] = val;
+                if (sz <= size_)
+                    resize_with_copy_(sz, capacity_);
+                else
+                {
+                    reserve(sz);
+                    while (size_ < sz)
+                        emplace_back(val);
+                }
             }
 
             size_type capacity() const noexcept
@@ -377,22 +398,19 @@ namespace std
 
                 allocator_traits<Allocator>::construct(allocator_,
                                                        begin() + size_, forward<Args>(args)...);
+                ++size_;
 
                 return back();
             }
 
             void push_back(const T& x)
             {
-                if (size_ >= capacity_)
-                    resize_with_copy_(size_, next_capacity_());
-                data_[size_++] = x;
+                emplace_back(x);
             }
 
             void push_back(T&& x)
             {
-                if (size_ >= capacity_)
-                    resize_with_copy_(size_, next_capacity_());
-                data_[size_++] = forward<T>(x);
+                emplace_back(forward<T>(x));
             }
 
             void pop_back()
@@ -404,83 +422,70 @@ namespace std
             template<class... Args>
             iterator emplace(const_iterator position, Args&&... args)
             {
-                auto pos = const_cast<iterator>(position);
-
-                pos = shift_(pos, 1);
-                allocator_.construct(pos, forward<Args>(args)...);
-
-                return pos;
+                return insert_with_(position, 1, [&](iterator target){
+                    allocator_traits<Allocator>::construct(
+                        allocator_, target, forward<Args>(args)...
+                    );
+                });
             }
 
             iterator insert(const_iterator position, const value_type& x)
             {
-                auto pos = const_cast<iterator>(position);
-
-                pos = shift_(pos, 1);
-                *pos = x;
-
-                return pos;
+                return insert_with_(position, 1, [&](iterator target){
+                    allocator_traits<Allocator>::construct(allocator_, target, x);
+                });
             }
 
             iterator insert(const_iterator position, value_type&& x)
             {
-                auto pos = const_cast<iterator>(position);
-
-                pos = shift_(pos, 1);
-                *pos = forward<value_type>(x);
-
-                return pos;
+                return insert_with_(position, 1, [&](iterator target){
+                    allocator_traits<Allocator>::construct(
+                        allocator_, target, forward<value_type>(x)
+                    );
+                });
             }
 
             iterator insert(const_iterator position, size_type count, const value_type& x)
             {
-                auto pos = const_cast<iterator>(position);
-
-                pos = shift_(pos, count);
-                auto copy_target = pos;
-                for (size_type i = 0; i < count; ++i)
-                    *copy_target++ = x;
-
-                return pos;
+                return insert_with_(position, count, [&](iterator target){
+                    for (size_type i = 0; i < count; ++i)
+                        allocator_traits<Allocator>::construct(allocator_, target++, x);
+                });
             }
 
-            template<class InputIterator>
+            template<
+                class InputIterator,
+                class = enable_if_t<!is_integral<InputIterator>::value>
+            >
             iterator insert(const_iterator position, InputIterator first,
                             InputIterator last)
             {
-                auto pos = const_cast<iterator>(position);
-                auto count = static_cast<size_type>(last - first);
-
-                pos = shift_(pos, count);
-                copy(first, last, pos);
+                auto count = static_cast<size_type>(distance(first, last));
 
-                return pos;
+                return insert_with_(position, count, [&](iterator target){
+                    while (first != last)
+                        allocator_traits<Allocator>::construct(allocator_, target++, *first++);
+                });
             }
 
             iterator insert(const_iterator position, initializer_list<T> init)
             {
-                auto pos = const_cast<iterator>(position);
-
-                pos = shift_(pos, init.size());
-                copy(init.begin(), init.end(), pos);
-
-                return pos;
+                return insert(position, init.begin(), init.end());
             }
 
             iterator erase(const_iterator position)
             {
-                iterator pos = const_cast<iterator>(position);
-                copy(position + 1, cend(), pos);
-                --size_;
-
-                return pos;
+                return erase(position, position + 1);
             }
 
             iterator erase(const_iterator first, const_iterator last)
             {
                 iterator pos = const_cast<iterator>(first);
-                copy(last, cend(), pos);
-                size_ -= static_cast<size_type>(last - first);
+                auto count = static_cast<size_type>(last - first);
+
+                move(const_cast<iterator>(last), end(), pos);
+                destroy_from_end_until_(end() - count);
+                size_ -= count;
 
                 return pos;
             }
@@ -528,14 +533,19 @@ namespace std
 
                     auto to_copy = min(size, size_);
                     for (size_type i = 0; i < to_copy; ++i)
-                        new_data[i] = move(data_[i]);
+                    {
+                        allocator_traits<Allocator>::construct(
+                            allocator_, new_data + i, move(data_[i])
+                        );
+                    }
 
+                    destroy_from_end_until_(begin());
                     std::swap(data_, new_data);
 
                     allocator_.deallocate(new_data, capacity_);
+                    capacity_ = capacity;
                 }
 
-                capacity_ = capacity;
                 size_ = size;
             }
 
@@ -557,37 +567,57 @@ namespace std
                     return max(capacity_ * 2, size_type{2u});
             }
 
-            iterator shift_(iterator position, size_type count)
+            /**
+             * Creates count elements before position using
+             * the constructor. The new elements are constructed
+             * before any existing element is moved, so the
+             * constructor may refer to elements of this vector.
+             */
+            template<class Constructor>
+            iterator insert_with_(const_iterator position, size_type count,
+                                  Constructor constructor)
             {
-                if (size_ + count < capacity_)
+                auto start_idx = static_cast<size_type>(position - cbegin());
+
+                if (size_ + count <= capacity_)
                 {
-                    copy_backward(position, end(), end() + count);
+                    /**
+                     * Construct the new elements in the spare
+                     * capacity and rotate them into place.
+                     */
+                    constructor(end());
                     size_ += count;
 
-                    return position;
-                }
-                else
-                {
-                    auto start_idx = static_cast<size_type>(position - begin());
-                    auto end_idx = start_idx + count;
-                    auto new_size = size_ + count;
+                    rotate(begin() + start_idx, end() - count, end());
 
-                    // Auxiliary vector for easier swap.
-                    vector tmp{};
-                    tmp.resize_without_copy_(max(new_size, capacity_));
-                    tmp.size_ = new_size;
+                    return begin() + start_idx;
+                }
 
-                    // Copy before insertion index.
-                    copy(begin(), begin() + start_idx, tmp.begin());
+                // Auxiliary vector for easier swap.
+                vector tmp{};
+                tmp.resize_without_copy_(next_capacity_(size_ + count));
 
-                    // Copy after insertion index.
-                    copy(begin() + start_idx, end(), tmp.begin() + end_idx);
+                constructor(tmp.data_ + start_idx);
 
-                    swap(tmp);
+                for (size_type i = 0; i < start_idx; ++i)
+                {
+                    allocator_traits<Allocator>::construct(
+                        allocator_, tmp.data_ + i, move(data_[i])
+                    );
+                }
 
-                    // Position was invalidated!
-                    return begin() + start_idx;
+                for (size_type i = start_idx; i < size_; ++i)
+                {
+                    allocator_traits<Allocator>::construct(
+                        allocator_, tmp.data_ + i + count, move(data_[i])
+                    );
                 }
+                tmp.size_ = size_ + count;
+
+                swap(tmp);
+
+                // Position was invalidated!
+                return begin() + start_idx;
             }
     };
 
@@ -29,14 +29,13 @@
 #ifndef LIBCPP_BITS_ALGORITHM
 #define LIBCPP_BITS_ALGORITHM
 
+#include <__bits/functional/arithmetic_operations.hpp>
+#include <__bits/memory/misc.hpp>
 #include <iterator>
 #include <utility>
 
 namespace std
 {
-    template<class T>
-    struct less;
-
     /**
      * 25.2, non-modyfing sequence operations:
      */
@@ -653,7 +652,42 @@ namespace std
      * 25.3.11, rotate:
      */
 
-    // TODO: implement
+    template<class ForwardIterator>
+    ForwardIterator rotate(ForwardIterator first, ForwardIterator middle,
+                           ForwardIterator last)
+    {
+        if (first == middle)
+            return last;
+        if (middle == last)
+            return first;
+
+        /**
+         * Swap the leading block forward until the trailing
+         * block is in place, then keep rotating the remainder
+         * of [first, last) until nothing is left out of place.
+         */
+        auto next = middle;
+        do
+        {
+            iter_swap(first++, next++);
+            if (first == middle)
+                middle = next;
+        } while (next != last);
+
+        auto res = first;
+
+        next = middle;
+        while (next != last)
+        {
+            iter_swap(first++, next++);
+            if (first == middle)
+                middle = next;
+            else if (next == last)
+                next = middle;
+        }
+
+        return res;
+    }
 
     /**
      * 25.3.12, shuffle:
@@ -687,6 +721,375 @@ namespace std
     void sort_heap(RandomAccessIterator, RandomAccessIterator,
                    Compare);
 
+    namespace aux
+    {
+        template<class RandomAccessIterator, class Size, class Compare>
+        void correct_children(RandomAccessIterator, Size, Size, Compare);
+
+        /**
+         * Our sort is a pattern-defeating quicksort (introsort
+         * variant), see Orson Peters' pdqsort. Ranges shorter
+         * than the insertion threshold are insertion sorted,
+         * longer than the ninther threshold use the pseudomedian
+         * of nine as a pivot.
+         */
+        inline constexpr ptrdiff_t sort_insertion_threshold{24};
+        inline constexpr ptrdiff_t sort_ninther_threshold{128};
+
+        /**
+         * Maximum number of element moves we allow when
+         * trying to finish a partition that looks sorted.
+         */
+        inline constexpr ptrdiff_t sort_partial_insertion_limit{8};
+
+        template<class T>
+        int sort_log2(T n)
+        {
+            int res{};
+            while (n >>= 1)
+                ++res;
+
+            return res;
+        }
+
+        template<class RandomAccessIterator, class Compare>
+        void insertion_sort(RandomAccessIterator first,
+                            RandomAccessIterator last, Compare comp)
+        {
+            if (first == last)
+                return;
+
+            for (auto it = first + 1; it != last; ++it)
+            {
+                auto sift = it;
+                auto sift_prev = it - 1;
+
+                if (comp(*sift, *sift_prev))
+                {
+                    auto tmp = move(*sift);
+
+                    do
+                    {
+                        *sift-- = move(*sift_prev);
+                    } while (sift != first && comp(tmp, *--sift_prev));
+
+                    *sift = move(tmp);
+                }
+            }
+        }
+
+        /**
+         * Insertion sort that assumes there is an element
+         * before first that is not greater than any element
+         * in [first, last) so it can skip the bound check.
+         */
+        template<class RandomAccessIterator, class Compare>
+        void unguarded_insertion_sort(RandomAccessIterator first,
+                                      RandomAccessIterator last, Compare comp)
+        {
+            if (first == last)
+                return;
+
+            for (auto it = first + 1; it != last; ++it)
+            {
+                auto sift = it;
+                auto sift_prev = it - 1;
+
+                if (comp(*sift, *sift_prev))
+                {
+                    auto tmp = move(*sift);
+
+                    do
+                    {
+                        *sift-- = move(*sift_prev);
+                    } while (comp(tmp, *--sift_prev));
+
+                    *sift = move(tmp);
+                }
+            }
+        }
+
+        /**
+         * Attempts to insertion sort the range, gives up
+         * and returns false if that would take more than
+         * sort_partial_insertion_limit moves.
+         */
+        template<class RandomAccessIterator, class Compare>
+        bool partial_insertion_sort(RandomAccessIterator first,
+                                    RandomAccessIterator last, Compare comp)
+        {
+            if (first == last)
+                return true;
+
+            ptrdiff_t moves{};
+            for (auto it = first + 1; it != last; ++it)
+            {
+                auto sift = it;
+                auto sift_prev = it - 1;
+
+                if (comp(*sift, *sift_prev))
+                {
+                    auto tmp = move(*sift);
+
+                    do
+                    {
+                        *sift-- = move(*sift_prev);
+                    } while (sift != first && comp(tmp, *--sift_prev));
+
+                    *sift = move(tmp);
+                    moves += it - sift;
+                }
+
+                if (moves > sort_partial_insertion_limit)
+                    return false;
+            }
+
+            return true;
+        }
+
+        template<class RandomAccessIterator, class Compare>
+        void sort2(RandomAccessIterator a, RandomAccessIterator b,
+                   Compare comp)
+        {
+            if (comp(*b, *a))
+                iter_swap(a, b);
+        }
+
+        template<class RandomAccessIterator, class Compare>
+        void sort3(RandomAccessIterator a, RandomAccessIterator b,
+                   RandomAccessIterator c, Compare comp)
+        {
+            sort2(a, b, comp);
+            sort2(b, c, comp);
+            sort2(a, b, comp);
+        }
+
+        /**
+         * Moves the median of a sample of [first, last) to first
+         * and guarantees that last - 1 is not less than it.
+         * Requires at least sort_insertion_threshold elements.
+         */
+        template<class RandomAccessIterator, class Compare>
+        void sort_choose_pivot(RandomAccessIterator first,
+                               RandomAccessIterator last, Compare comp)
+        {
+            auto size = last - first;
+            auto half = size / 2;
+
+            if (size > sort_ninther_threshold)
+            {
+                sort3(first, first + half, last - 1, comp);
+                sort3(first + 1, first + (half - 1), last - 2, comp);
+                sort3(first + 2, first + (half + 1), last - 3, comp);
+                sort3(first + (half - 1), first + half, first + (half + 1), comp);
+                iter_swap(first, first + half);
+            }
+            else
+                sort3(first + half, first, last - 1, comp);
+        }
+
+        /**
+         * Partitions [first, last) around the pivot *first with
+         * elements equal to the pivot going to the right part.
+         * Returns the final position of the pivot and whether
+         * no elements had to be swapped.
+         *
+         * Note: There has to be an element not less than the
+         *       pivot in the range, sort_choose_pivot ensures
+         *       that.
+         */
+        template<class RandomAccessIterator, class Compare>
+        pair<RandomAccessIterator, bool> partition_right(
+            RandomAccessIterator first, RandomAccessIterator last,
+            Compare comp
+        )
+        {
+            auto pivot = move(*first);
+            auto l = first;
+            auto r = last;
+
+            while (comp(*++l, pivot))
+            { /* DUMMY BODY */ }
+
+            // Without a smaller element on the left, we need a bound check.
+            if (l - 1 == first)
+            {
+                while (l < r && !comp(*--r, pivot))
+                { /* DUMMY BODY */ }
+            }
+            else
+            {
+                while (!comp(*--r, pivot))
+                { /* DUMMY BODY */ }
+            }
+
+            bool already_partitioned = l >= r;
+            while (l < r)
+            {
+                iter_swap(l, r);
+
+                while (comp(*++l, pivot))
+                { /* DUMMY BODY */ }
+                while (!comp(*--r, pivot))
+                { /* DUMMY BODY */ }
+            }
+
+            auto pivot_pos = l - 1;
+            *first = move(*pivot_pos);
+            *pivot_pos = move(pivot);
+
+            return make_pair(pivot_pos, already_partitioned);
+        }
+
+        /**
+         * Partitions [first, last) around the pivot *first with
+         * elements equal to the pivot going to the left part.
+         * Used when the pivot equals an element preceding the
+         * range, in which case the left part contains only
+         * elements equal to the pivot and needs no sorting.
+         */
+        template<class RandomAccessIterator, class Compare>
+        RandomAccessIterator partition_left(RandomAccessIterator first,
+                                            RandomAccessIterator last,
+                                            Compare comp)
+        {
+            auto pivot = move(*first);
+            auto l = first;
+            auto r = last;
+
+            while (comp(pivot, *--r))
+            { /* DUMMY BODY */ }
+
+            if (r + 1 == last)
+            {
+                while (l < r && !comp(pivot, *++l))
+                { /* DUMMY BODY */ }
+            }
+            else
+            {
+                while (!comp(pivot, *++l))
+                { /* DUMMY BODY */ }
+            }
+
+            while (l < r)
+            {
+                iter_swap(l, r);
+
+                while (comp(pivot, *--r))
+                { /* DUMMY BODY */ }
+                while (!comp(pivot, *++l))
+                { /* DUMMY BODY */ }
+            }
+
+            auto pivot_pos = r;
+            *first = move(*pivot_pos);
+            *pivot_pos = move(pivot);
+
+            return pivot_pos;
+        }
+
+        /**
+         * Swaps a few elements of a partition of the given size
+         * starting at first to break patterns (e.g. organ pipe
+         * inputs) that caused a highly unbalanced partition.
+         */
+        template<class RandomAccessIterator>
+        void sort_break_patterns(RandomAccessIterator first,
+                                 RandomAccessIterator last)
+        {
+            auto size = last - first;
+            if (size < sort_insertion_threshold)
+                return;
+
+            auto quarter = size / 4;
+            iter_swap(first, first + quarter);
+            iter_swap(last - 1, last - quarter);
+
+            if (size > sort_ninther_threshold)
+            {
+                iter_swap(first + 1, first + (quarter + 1));
+                iter_swap(first + 2, first + (quarter + 2));
+                iter_swap(last - 2, last - (quarter + 1));
+                iter_swap(last - 3, last - (quarter + 2));
+            }
+        }
+
+        template<class RandomAccessIterator, class Compare>
+        void pdqsort(RandomAccessIterator first, RandomAccessIterator last,
+                     Compare comp, int bad_allowed, bool leftmost)
+        {
+            while (true)
+            {
+                auto size = last - first;
+
+                if (size < sort_insertion_threshold)
+                {
+                    if (leftmost)
+                        insertion_sort(first, last, comp);
+                    else
+                        unguarded_insertion_sort(first, last, comp);
+
+                    return;
+                }
+
+                sort_choose_pivot(first, last, comp);
+
+                /**
+                 * If the pivot equals the element preceding this
+                 * range (which is not greater than anything in it),
+                 * all elements equal to the pivot can be moved to the
+                 * left and skipped. This makes inputs with many
+                 * duplicates run in linear time.
+                 */
+                if (!leftmost && !comp(*(first - 1), *first))
+                {
+                    first = partition_left(first, last, comp) + 1;
+
+                    continue;
+                }
+
+                auto part = partition_right(first, last, comp);
+                auto pivot_pos = part.first;
+                auto left_size = pivot_pos - first;
+                auto right_size = last - (pivot_pos + 1);
+
+                if (left_size < size / 8 || right_size < size / 8)
+                {
+                    /**
+                     * Too many bad partitions would lead to quadratic
+                     * behaviour, so just like introsort we switch to
+                     * heapsort to guarantee O(n log n).
+                     */
+                    if (--bad_allowed == 0)
+                    {
+                        make_heap(first, last, comp);
+                        sort_heap(first, last, comp);
+
+                        return;
+                    }
+
+                    sort_break_patterns(first, pivot_pos);
+                    sort_break_patterns(pivot_pos + 1, last);
+                }
+                else if (part.second &&
+                         partial_insertion_sort(first, pivot_pos, comp) &&
+                         partial_insertion_sort(pivot_pos + 1, last, comp))
+                {
+                    // Presorted input, we are done in linear time.
+                    return;
+                }
+
+                /**
+                 * Recurse to the left and loop to the right, the
+                 * depth is bounded by the balanced partition check.
+                 */
+                pdqsort(first, pivot_pos, comp, bad_allowed, leftmost);
+                first = pivot_pos + 1;
+                leftmost = false;
+            }
+        }
+    }
+
     template<class RandomAccessIterator>
     void sort(RandomAccessIterator first, RandomAccessIterator last)
     {
@@ -699,30 +1102,200 @@ namespace std
     void sort(RandomAccessIterator first, RandomAccessIterator last,
               Compare comp)
     {
-        /**
-         * Note: This isn't the most effective approach,
-         *       but since we already have these two functions
-         *       and they satisfy asymptotic limitations
-         *       imposed by the standard, we're using them at
-         *       the moment. Might be good to change it to qsort
-         *       or merge sort later.
-         */
+        auto size = last - first;
+        if (size < 2)
+            return;
 
-        make_heap(first, last, comp);
-        sort_heap(first, last, comp);
+        aux::pdqsort(first, last, comp, aux::sort_log2(size), true);
     }
 
     /**
      * 25.4.1.2, stable_sort:
      */
 
-    // TODO: implement
+    template<class ForwardIterator, class T, class Compare>
+    ForwardIterator lower_bound(ForwardIterator, ForwardIterator,
+                                const T&, Compare);
+
+    template<class ForwardIterator, class T, class Compare>
+    ForwardIterator upper_bound(ForwardIterator, ForwardIterator,
+                                const T&, Compare);
+
+    namespace aux
+    {
+        /**
+         * Ranges shorter than this are insertion sorted before
+         * being merged, insertion sort is stable.
+         */
+        inline constexpr ptrdiff_t stable_sort_insertion_threshold{16};
+
+        /**
+         * Merges the sorted ranges [first, middle) and
+         * [middle, last). If the first range fits into the
+         * raw storage buf, it is moved there and merged back,
+         * otherwise the merge is done in place by rotations.
+         */
+        template<class RandomAccessIterator, class T, class Compare>
+        void merge_adaptive(RandomAccessIterator first,
+                            RandomAccessIterator middle,
+                            RandomAccessIterator last,
+                            T* buf, ptrdiff_t buf_size, Compare comp)
+        {
+            auto len1 = middle - first;
+            auto len2 = last - middle;
+
+            if (len1 == 0 || len2 == 0)
+                return;
+
+            // Already in order, common for presorted input.
+            if (!comp(*middle, *(middle - 1)))
+                return;
+
+            if (len1 <= buf_size)
+            {
+                auto buf_last = buf;
+                for (auto it = first; it != middle; ++it, ++buf_last)
+                    ::new(static_cast<void*>(buf_last)) T(move(*it));
+
+                auto l = buf;
+                auto r = middle;
+                auto res = first;
+                while (l != buf_last && r != last)
+                {
+                    // Equal elements from the left go first.
+                    if (comp(*r, *l))
+                        *res++ = move(*r++);
+                    else
+                        *res++ = move(*l++);
+                }
+
+                while (l != buf_last)
+                    *res++ = move(*l++);
+
+                for (auto it = buf; it != buf_last; ++it)
+                    it->~T();
+
+                return;
+            }
+
+            if (len1 + len2 == 2)
+            {
+                if (comp(*middle, *first))
+                    iter_swap(first, middle);
+
+                return;
+            }
+
+            RandomAccessIterator cut1{};
+            RandomAccessIterator cut2{};
+            if (len1 > len2)
+            {
+                cut1 = first + len1 / 2;
+                cut2 = lower_bound(middle, last, *cut1, comp);
+            }
+            else
+            {
+                cut2 = middle + len2 / 2;
+                cut1 = upper_bound(first, middle, *cut2, comp);
+            }
+
+            auto new_middle = rotate(cut1, middle, cut2);
+            merge_adaptive(first, cut1, new_middle, buf, buf_size, comp);
+            merge_adaptive(new_middle, cut2, last, buf, buf_size, comp);
+        }
+
+        template<class RandomAccessIterator, class T, class Compare>
+        void merge_sort(RandomAccessIterator first, RandomAccessIterator last,
+                        T* buf, ptrdiff_t buf_size, Compare comp)
+        {
+            auto size = last - first;
+            if (size <= stable_sort_insertion_threshold)
+            {
+                insertion_sort(first, last, comp);
+
+                return;
+            }
+
+            auto middle = first + size / 2;
+            merge_sort(first, middle, buf, buf_size, comp);
+            merge_sort(middle, last, buf, buf_size, comp);
+            merge_adaptive(first, middle, last, buf, buf_size, comp);
+        }
+    }
+
+    template<class RandomAccessIterator>
+    void stable_sort(RandomAccessIterator first, RandomAccessIterator last)
+    {
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+        stable_sort(first, last, less<value_type>{});
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    void stable_sort(RandomAccessIterator first, RandomAccessIterator last,
+                     Compare comp)
+    {
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+        auto size = last - first;
+        if (size <= aux::stable_sort_insertion_threshold)
+        {
+            aux::insertion_sort(first, last, comp);
+
+            return;
+        }
+
+        /**
+         * Half of the range is enough for every merge, if we
+         * get less we still use it for the merges it fits and
+         * fall back to the in place merge for the rest.
+         */
+        auto buf = get_temporary_buffer<value_type>(size - size / 2);
+        aux::merge_sort(first, last, buf.first, buf.second, comp);
+        return_temporary_buffer(buf.first);
+    }
 
     /**
      * 25.4.1.3, partial_sort:
      */
 
-    // TODO: implement
+    template<class RandomAccessIterator>
+    void partial_sort(RandomAccessIterator first,
+                      RandomAccessIterator middle,
+                      RandomAccessIterator last)
+    {
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+        partial_sort(first, middle, last, less<value_type>{});
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    void partial_sort(RandomAccessIterator first,
+                      RandomAccessIterator middle,
+                      RandomAccessIterator last,
+                      Compare comp)
+    {
+        if (first == middle)
+            return;
+
+        /**
+         * Keep the smallest middle - first elements in a max
+         * heap, anything smaller than the top replaces it.
+         */
+        auto count = middle - first;
+        make_heap(first, middle, comp);
+
+        for (auto it = middle; it != last; ++it)
+        {
+            if (comp(*it, *first))
+            {
+                swap(*it, *first);
+                aux::correct_children(first, decltype(count){}, count, comp);
+            }
+        }
+
+        sort_heap(first, middle, comp);
+    }
 
     /**
      * 25.4.1.4, partial_sort_copy:
@@ -734,29 +1307,18 @@ namespace std
      * 25.4.1.5, is_sorted:
      */
 
-    template<class ForwardIterator>
-    bool is_sorted(ForwardIterator first, ForwardIterator last)
-    {
-        return is_sorted_until(first, last) == last;
-    }
-
-    template<class ForwardIterator, class Comp>
-    bool is_sorted(ForwardIterator first, ForwardIterator last,
-                   Comp comp)
-    {
-        return is_sorted_until(first, last, comp) == last;
-    }
-
     template<class ForwardIterator>
     ForwardIterator is_sorted_until(ForwardIterator first, ForwardIterator last)
     {
-        if (distance(first, last) < 2)
+        if (first == last)
             return last;
 
-        while (first != last)
+        auto next = first;
+        while (++next != last)
         {
-            if (*first > *(++first))
-                return first;
+            if (*next < *first)
+                return next;
+            first = next;
         }
 
         return last;
@@ -766,23 +1328,101 @@ namespace std
     ForwardIterator is_sorted_until(ForwardIterator first, ForwardIterator last,
                                     Comp comp)
     {
-        if (distance(first, last) < 2)
+        if (first == last)
             return last;
 
-        while (first != last)
+        auto next = first;
+        while (++next != last)
         {
-            if (!comp(*first, *(++first)))
-                return first;
+            if (comp(*next, *first))
+                return next;
+            first = next;
         }
 
         return last;
     }
 
+    template<class ForwardIterator>
+    bool is_sorted(ForwardIterator first, ForwardIterator last)
+    {
+        return is_sorted_until(first, last) == last;
+    }
+
+    template<class ForwardIterator, class Comp>
+    bool is_sorted(ForwardIterator first, ForwardIterator last,
+                   Comp comp)
+    {
+        return is_sorted_until(first, last, comp) == last;
+    }
+
     /**
      * 25.4.2, nth_element:
      */
 
-    // TODO: implement
+    namespace aux
+    {
+        template<class RandomAccessIterator, class Compare>
+        void introselect(RandomAccessIterator first, RandomAccessIterator nth,
+                         RandomAccessIterator last, Compare comp, int depth)
+        {
+            while (last - first >= sort_insertion_threshold)
+            {
+                if (depth-- == 0)
+                {
+                    // Guarantee O(n log n) just like in sort.
+                    partial_sort(first, nth + 1, last, comp);
+
+                    return;
+                }
+
+                sort_choose_pivot(first, last, comp);
+                auto pivot_pos = partition_right(first, last, comp).first;
+
+                /**
+                 * The pivot is the minimum, group all elements equal
+                 * to it on the left so that inputs with many
+                 * duplicates do not degrade to quadratic time.
+                 */
+                if (pivot_pos == first)
+                {
+                    pivot_pos = partition_left(first, last, comp);
+                    if (nth <= pivot_pos)
+                        return;
+
+                    first = pivot_pos + 1;
+                    continue;
+                }
+
+                if (pivot_pos == nth)
+                    return;
+                else if (nth < pivot_pos)
+                    last = pivot_pos;
+                else
+                    first = pivot_pos + 1;
+            }
+
+            insertion_sort(first, last, comp);
+        }
+    }
+
+    template<class RandomAccessIterator>
+    void nth_element(RandomAccessIterator first, RandomAccessIterator nth,
+                     RandomAccessIterator last)
+    {
+        using value_type = typename iterator_traits<RandomAccessIterator>::value_type;
+
+        nth_element(first, nth, last, less<value_type>{});
+    }
+
+    template<class RandomAccessIterator, class Compare>
+    void nth_element(RandomAccessIterator first, RandomAccessIterator nth,
+                     RandomAccessIterator last, Compare comp)
+    {
+        if (first == last || nth == last)
+            return;
+
+        aux::introselect(first, nth, last, comp, 2 * aux::sort_log2(last - first));
+    }
 
     /**
      * 25.4.3, binary search:
@@ -792,13 +1432,101 @@ namespace std
      * 25.4.3.1, lower_bound
      */
 
-    // TODO: implement
+    template<class ForwardIterator, class T>
+    ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last,
+                                const T& value)
+    {
+        auto count = distance(first, last);
+        while (count > 0)
+        {
+            auto step = count / 2;
+            auto it = first;
+            advance(it, step);
+
+            if (*it < value)
+            {
+                first = ++it;
+                count -= step + 1;
+            }
+            else
+                count = step;
+        }
+
+        return first;
+    }
+
+    template<class ForwardIterator, class T, class Compare>
+    ForwardIterator lower_bound(ForwardIterator first, ForwardIterator last,
+                                const T& value, Compare comp)
+    {
+        auto count = distance(first, last);
+        while (count > 0)
+        {
+            auto step = count / 2;
+            auto it = first;
+            advance(it, step);
+
+            if (comp(*it, value))
+            {
+                first = ++it;
+                count -= step + 1;
+            }
+            else
+                count = step;
+        }
+
+        return first;
+    }
 
     /**
      * 25.4.3.2, upper_bound
      */
 
-    // TODO: implement
+    template<class ForwardIterator, class T>
+    ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last,
+                                const T& value)
+    {
+        auto count = distance(first, last);
+        while (count > 0)
+        {
+            auto step = count / 2;
+            auto it = first;
+            advance(it, step);
+
+            if (!(value < *it))
+            {
+                first = ++it;
+                count -= step + 1;
+            }
+            else
+                count = step;
+        }
+
+        return first;
+    }
+
+    template<class ForwardIterator, class T, class Compare>
+    ForwardIterator upper_bound(ForwardIterator first, ForwardIterator last,
+                                const T& value, Compare comp)
+    {
+        auto count = distance(first, last);
+        while (count > 0)
+        {
+            auto step = count / 2;
+            auto it = first;
+            advance(it, step);
+
+            if (!comp(value, *it))
+            {
+                first = ++it;
+                count -= step + 1;
+            }
+            else
+                count = step;
+        }
+
+        return first;
+    }
 
     /**
      * 25.4.3.3, equal_range:
@@ -883,32 +1611,27 @@ namespace std
             using aux::heap_left_child;
             using aux::heap_right_child;
 
-            auto left = heap_left_child(idx);
-            auto right = heap_right_child(idx);
-
-            bool left_incorrect{comp(first[idx], first[left])};
-            bool right_incorrect{comp(first[idx], first[right])};
-            while ((left < count && left_incorrect) ||
-                   (right < count && right_incorrect))
+            /**
+             * Note: Children past count are not part of the heap
+             *       and must not be dereferenced, they might be
+             *       past the end of the underlying sequence.
+             */
+            while (true)
             {
-                if (right >= count || (left_incorrect && comp(first[right], first[left])))
-                {
-                    swap(first[idx], first[left]);
-
-                    idx = left;
-                }
-                else if (right < count && right_incorrect)
-                {
-                    swap(first[idx], first[right]);
+                auto left = heap_left_child(idx);
+                auto right = heap_right_child(idx);
+                auto largest = idx;
 
-                    idx = right;
-                } // Else should not happen because of the while condition.
+                if (left < count && comp(first[largest], first[left]))
+                    largest = left;
+                if (right < count && comp(first[largest], first[right]))
+                    largest = right;
 
-                left = heap_left_child(idx);
-                right = heap_right_child(idx);
+                if (largest == idx)
+                    return;
 
-                left_incorrect = comp(first[idx], first[left]);
-                right_incorrect = comp(first[idx], first[right]);
+                swap(first[idx], first[largest]);
+                idx = largest;
             }
         }
     }
@@ -971,7 +1694,7 @@ namespace std
             return;
 
         swap(first[0], first[count - 1]);
-        aux::correct_children(first, decltype(count){}, count - 2, comp);
+        aux::correct_children(first, decltype(count){}, count - 1, comp);
     }
 
     /**
@@ -996,7 +1719,8 @@ namespace std
         if (count <= 1)
             return;
 
-        for (auto i = count; i > 0; --i)
+        // Leaves are trivially heaps, start with the last parent.
+        for (auto i = count / 2; i > 0; --i)
         {
             auto idx = i - 1;
 
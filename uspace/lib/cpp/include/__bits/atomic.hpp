@@ -1,5 +1,6 @@
 /*
  * Copyright (c) 2018 Jaroslav Jindrak
+ * Copyright (c) 2026 HelenOS contributors
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -26,9 +27,845 @@
  * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+
 #ifndef LIBCPP_BITS_ATOMIC
 #define LIBCPP_BITS_ATOMIC
 
-#error "<atomic> is not implemented"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * 29.4, lock-free property:
+ */
+
+#define ATOMIC_BOOL_LOCK_FREE     __GCC_ATOMIC_BOOL_LOCK_FREE
+#define ATOMIC_CHAR_LOCK_FREE     __GCC_ATOMIC_CHAR_LOCK_FREE
+#define ATOMIC_CHAR16_T_LOCK_FREE __GCC_ATOMIC_CHAR16_T_LOCK_FREE
+#define ATOMIC_CHAR32_T_LOCK_FREE __GCC_ATOMIC_CHAR32_T_LOCK_FREE
+#define ATOMIC_WCHAR_T_LOCK_FREE  __GCC_ATOMIC_WCHAR_T_LOCK_FREE
+#define ATOMIC_SHORT_LOCK_FREE    __GCC_ATOMIC_SHORT_LOCK_FREE
+#define ATOMIC_INT_LOCK_FREE      __GCC_ATOMIC_INT_LOCK_FREE
+#define ATOMIC_LONG_LOCK_FREE     __GCC_ATOMIC_LONG_LOCK_FREE
+#define ATOMIC_LLONG_LOCK_FREE    __GCC_ATOMIC_LLONG_LOCK_FREE
+#define ATOMIC_POINTER_LOCK_FREE  __GCC_ATOMIC_POINTER_LOCK_FREE
+
+/**
+ * 29.6.5, initialization:
+ */
+
+#define ATOMIC_VAR_INIT(value) { value }
+
+/**
+ * 29.7, flag type and operations:
+ */
+
+#define ATOMIC_FLAG_INIT { false }
+
+namespace std
+{
+    /**
+     * 29.3, order and consistency:
+     */
+
+    typedef enum memory_order
+    {
+        memory_order_relaxed = __ATOMIC_RELAXED,
+        memory_order_consume = __ATOMIC_CONSUME,
+        memory_order_acquire = __ATOMIC_ACQUIRE,
+        memory_order_release = __ATOMIC_RELEASE,
+        memory_order_acq_rel = __ATOMIC_ACQ_REL,
+        memory_order_seq_cst = __ATOMIC_SEQ_CST
+    } memory_order;
+
+    template<class T>
+    T kill_dependency(T y) noexcept
+    {
+        return y;
+    }
+
+    /**
+     * 29.8, fences:
+     */
+
+    inline void atomic_thread_fence(memory_order order) noexcept
+    {
+        __atomic_thread_fence(order);
+    }
+
+    inline void atomic_signal_fence(memory_order order) noexcept
+    {
+        __atomic_signal_fence(order);
+    }
+
+    namespace aux
+    {
+        /**
+         * The failure order of the single order compare
+         * exchange cannot contain a release.
+         */
+        constexpr memory_order atomic_failure_order(memory_order order) noexcept
+        {
+            if (order == memory_order_acq_rel)
+                return memory_order_acquire;
+            else if (order == memory_order_release)
+                return memory_order_relaxed;
+            else
+                return order;
+        }
+
+        /**
+         * Types whose size the hardware can operate on directly
+         * use the compiler builtins. Anything else (e.g. large
+         * structures) is protected by a lock from a small pool
+         * of spinlocks, we do not have libatomic.
+         */
+        template<class T>
+        inline constexpr bool atomic_lock_free_v = (
+            sizeof(T) == 1 || sizeof(T) == 2 ||
+            sizeof(T) == 4 || sizeof(T) == 8
+        ) && __atomic_always_lock_free(sizeof(T), 0);
+
+        template<class T>
+        inline constexpr size_t atomic_alignment_v = (
+            atomic_lock_free_v<T> && alignof(T) < sizeof(T)
+        ) ? sizeof(T) : alignof(T);
+
+        void atomic_lock(const volatile void*) noexcept;
+        void atomic_unlock(const volatile void*) noexcept;
+
+        /**
+         * Blocks the calling fibril while pred(arg) holds, the
+         * predicate is re-evaluated after every notification on
+         * addr. Waiters on different addresses can share a wait
+         * queue, so spurious wake ups are handled here.
+         */
+        using atomic_wait_pred_t = bool (*)(const void*);
+
+        void atomic_wait_address(const volatile void* addr,
+                                 atomic_wait_pred_t pred,
+                                 const void* arg) noexcept;
+        void atomic_notify_address(const volatile void* addr,
+                                   bool all) noexcept;
+
+        template<class T, bool = atomic_lock_free_v<T>>
+        class atomic_base
+        {
+            public:
+                atomic_base() noexcept = default;
+
+                constexpr atomic_base(T desired) noexcept
+                    : value_{desired}
+                { /* DUMMY BODY */ }
+
+                atomic_base(const atomic_base&) = delete;
+                atomic_base& operator=(const atomic_base&) = delete;
+
+                static constexpr bool is_always_lock_free = true;
+
+                bool is_lock_free() const noexcept
+                {
+                    return true;
+                }
+
+                void store(T desired, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    __atomic_store(__builtin_addressof(value_),
+                                   __builtin_addressof(desired), order);
+                }
+
+                T load(memory_order order = memory_order_seq_cst) const noexcept
+                {
+                    alignas(T) unsigned char buf[sizeof(T)];
+                    auto res = reinterpret_cast<T*>(buf);
+
+                    __atomic_load(__builtin_addressof(value_), res, order);
+
+                    return *res;
+                }
+
+                T exchange(T desired, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    alignas(T) unsigned char buf[sizeof(T)];
+                    auto res = reinterpret_cast<T*>(buf);
+
+                    __atomic_exchange(__builtin_addressof(value_),
+                                      __builtin_addressof(desired),
+                                      res, order);
+
+                    return *res;
+                }
+
+                bool compare_exchange_weak(T& expected, T desired,
+                                           memory_order success,
+                                           memory_order failure) noexcept
+                {
+                    return __atomic_compare_exchange(
+                        __builtin_addressof(value_),
+                        __builtin_addressof(expected),
+                        __builtin_addressof(desired),
+                        true, success, failure
+                    );
+                }
+
+                bool compare_exchange_strong(T& expected, T desired,
+                                             memory_order success,
+                                             memory_order failure) noexcept
+                {
+                    return __atomic_compare_exchange(
+                        __builtin_addressof(value_),
+                        __builtin_addressof(expected),
+                        __builtin_addressof(desired),
+                        false, success, failure
+                    );
+                }
+
+            protected:
+                alignas(atomic_alignment_v<T>) T value_;
+        };
+
+        template<class T>
+        class atomic_base<T, false>
+        {
+            public:
+                atomic_base() noexcept = default;
+
+                constexpr atomic_base(T desired) noexcept
+                    : value_{desired}
+                { /* DUMMY BODY */ }
+
+                atomic_base(const atomic_base&) = delete;
+                atomic_base& operator=(const atomic_base&) = delete;
+
+                static constexpr bool is_always_lock_free = false;
+
+                bool is_lock_free() const noexcept
+                {
+                    return false;
+                }
+
+                void store(T desired, memory_order = memory_order_seq_cst) noexcept
+                {
+                    atomic_lock(&value_);
+                    __builtin_memcpy(__builtin_addressof(value_),
+                                     __builtin_addressof(desired), sizeof(T));
+                    atomic_unlock(&value_);
+                }
+
+                T load(memory_order = memory_order_seq_cst) const noexcept
+                {
+                    alignas(T) unsigned char buf[sizeof(T)];
+
+                    atomic_lock(&value_);
+                    __builtin_memcpy(buf, &value_, sizeof(T));
+                    atomic_unlock(&value_);
+
+                    return *reinterpret_cast<T*>(buf);
+                }
+
+                T exchange(T desired, memory_order = memory_order_seq_cst) noexcept
+                {
+                    alignas(T) unsigned char buf[sizeof(T)];
+
+                    atomic_lock(&value_);
+                    __builtin_memcpy(buf, &value_, sizeof(T));
+                    __builtin_memcpy(&value_, &desired, sizeof(T));
+                    atomic_unlock(&value_);
+
+                    return *reinterpret_cast<T*>(buf);
+                }
+
+                bool compare_exchange_weak(T& expected, T desired,
+                                           memory_order success,
+                                           memory_order failure) noexcept
+                {
+                    return compare_exchange_strong(expected, desired,
+                                                   success, failure);
+                }
+
+                bool compare_exchange_strong(T& expected, T desired,
+                                             memory_order,
+                                             memory_order) noexcept
+                {
+                    bool res{};
+
+                    /**
+                     * Note: The standard specifies comparison of
+                     *       the value representations, not operator==.
+                     */
+                    atomic_lock(&value_);
+                    if (__builtin_memcmp(&value_, &expected, sizeof(T)) == 0)
+                    {
+                        __builtin_memcpy(&value_, &desired, sizeof(T));
+                        res = true;
+                    }
+                    else
+                        __builtin_memcpy(&expected, &value_, sizeof(T));
+                    atomic_unlock(&value_);
+
+                    return res;
+                }
+
+            protected:
+                T value_;
+        };
+
+        /**
+         * Common interface of all atomic types built on top
+         * of the (lock-free or locked) storage.
+         */
+        template<class T>
+        class atomic_common: public atomic_base<T>
+        {
+            public:
+                using atomic_base<T>::atomic_base;
+                using atomic_base<T>::compare_exchange_weak;
+                using atomic_base<T>::compare_exchange_strong;
+
+                atomic_common() noexcept = default;
+                atomic_common(const atomic_common&) = delete;
+                atomic_common& operator=(const atomic_common&) = delete;
+
+                operator T() const noexcept
+                {
+                    return this->load();
+                }
+
+                bool compare_exchange_weak(T& expected, T desired,
+                                           memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return this->compare_exchange_weak(
+                        expected, desired, order, atomic_failure_order(order)
+                    );
+                }
+
+                bool compare_exchange_strong(T& expected, T desired,
+                                             memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return this->compare_exchange_strong(
+                        expected, desired, order, atomic_failure_order(order)
+                    );
+                }
+
+                /**
+                 * Note: The waiting operations are from C++20,
+                 *       but they are too useful for building
+                 *       blocking primitives to leave them out.
+                 */
+
+                void wait(T old, memory_order order = memory_order_seq_cst) const noexcept
+                {
+                    wait_args args{this, old, order};
+                    if (!wait_pred(&args))
+                        return;
+
+                    atomic_wait_address(&this->value_, wait_pred, &args);
+                }
+
+                void notify_one() noexcept
+                {
+                    atomic_notify_address(&this->value_, false);
+                }
+
+                void notify_all() noexcept
+                {
+                    atomic_notify_address(&this->value_, true);
+                }
+
+            private:
+                struct wait_args
+                {
+                    const atomic_common* atom;
+                    T old;
+                    memory_order order;
+                };
+
+                static bool wait_pred(const void* arg)
+                {
+                    auto args = static_cast<const wait_args*>(arg);
+                    T current = args->atom->load(args->order);
+
+                    return __builtin_memcmp(&current, &args->old, sizeof(T)) == 0;
+                }
+        };
+
+        template<class T>
+        class atomic_integral: public atomic_common<T>
+        {
+            public:
+                using atomic_common<T>::atomic_common;
+
+                T fetch_add(T arg, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    if constexpr (atomic_lock_free_v<T>)
+                        return __atomic_fetch_add(&this->value_, arg, order);
+                    else
+                        return fetch_modify_locked_([arg](T x){ return x + arg; });
+                }
+
+                T fetch_sub(T arg, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    if constexpr (atomic_lock_free_v<T>)
+                        return __atomic_fetch_sub(&this->value_, arg, order);
+                    else
+                        return fetch_modify_locked_([arg](T x){ return x - arg; });
+                }
+
+                T fetch_and(T arg, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    if constexpr (atomic_lock_free_v<T>)
+                        return __atomic_fetch_and(&this->value_, arg, order);
+                    else
+                        return fetch_modify_locked_([arg](T x){ return x & arg; });
+                }
+
+                T fetch_or(T arg, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    if constexpr (atomic_lock_free_v<T>)
+                        return __atomic_fetch_or(&this->value_, arg, order);
+                    else
+                        return fetch_modify_locked_([arg](T x){ return x | arg; });
+                }
+
+                T fetch_xor(T arg, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    if constexpr (atomic_lock_free_v<T>)
+                        return __atomic_fetch_xor(&this->value_, arg, order);
+                    else
+                        return fetch_modify_locked_([arg](T x){ return x ^ arg; });
+                }
+
+                T operator++(int) noexcept
+                {
+                    return fetch_add(1);
+                }
+
+                T operator--(int) noexcept
+                {
+                    return fetch_sub(1);
+                }
+
+                T operator++() noexcept
+                {
+                    return fetch_add(1) + 1;
+                }
+
+                T operator--() noexcept
+                {
+                    return fetch_sub(1) - 1;
+                }
+
+                T operator+=(T arg) noexcept
+                {
+                    return fetch_add(arg) + arg;
+                }
+
+                T operator-=(T arg) noexcept
+                {
+                    return fetch_sub(arg) - arg;
+                }
+
+                T operator&=(T arg) noexcept
+                {
+                    return fetch_and(arg) & arg;
+                }
+
+                T operator|=(T arg) noexcept
+                {
+                    return fetch_or(arg) | arg;
+                }
+
+                T operator^=(T arg) noexcept
+                {
+                    return fetch_xor(arg) ^ arg;
+                }
+
+            private:
+                template<class Op>
+                T fetch_modify_locked_(Op op) noexcept
+                {
+                    atomic_lock(&this->value_);
+                    T res = this->value_;
+                    this->value_ = op(res);
+                    atomic_unlock(&this->value_);
+
+                    return res;
+                }
+        };
+
+        template<class T>
+        class atomic_pointer: public atomic_common<T*>
+        {
+            public:
+                using atomic_common<T*>::atomic_common;
+
+                T* fetch_add(ptrdiff_t arg, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    // The builtin does not scale by the pointee size.
+                    return __atomic_fetch_add(&this->value_, arg * sizeof(T), order);
+                }
+
+                T* fetch_sub(ptrdiff_t arg, memory_order order = memory_order_seq_cst) noexcept
+                {
+                    return __atomic_fetch_sub(&this->value_, arg * sizeof(T), order);
+                }
+
+                T* operator++(int) noexcept
+                {
+                    return fetch_add(1);
+                }
+
+                T* operator--(int) noexcept
+                {
+                    return fetch_sub(1);
+                }
+
+                T* operator++() noexcept
+                {
+                    return fetch_add(1) + 1;
+                }
+
+                T* operator--() noexcept
+                {
+                    return fetch_sub(1) - 1;
+                }
+
+                T* operator+=(ptrdiff_t arg) noexcept
+                {
+                    return fetch_add(arg) + arg;
+                }
+
+                T* operator-=(ptrdiff_t arg) noexcept
+                {
+                    return fetch_sub(arg) - arg;
+                }
+        };
+
+        template<class T>
+        using atomic_impl_t = conditional_t<
+            is_integral<T>::value && !is_same_v<T, bool>,
+            atomic_integral<T>,
+            atomic_common<T>
+        >;
+    }
+
+    /**
+     * 29.5, atomic types:
+     *
+     * Note: The volatile overloads of the member functions
+     *       are not provided.
+     */
+
+    template<class T>
+    struct atomic: aux::atomic_impl_t<T>
+    {
+        static_assert(is_trivially_copyable_v<T>, "atomic<T> requires trivially copyable T");
+
+        using aux::atomic_impl_t<T>::atomic_impl_t;
+
+        atomic() noexcept = default;
+        ~atomic() noexcept = default;
+
+        atomic(const atomic&) = delete;
+        atomic& operator=(const atomic&) = delete;
+
+        T operator=(T desired) noexcept
+        {
+            this->store(desired);
+
+            return desired;
+        }
+    };
+
+    template<class T>
+    struct atomic<T*>: aux::atomic_pointer<T>
+    {
+        using aux::atomic_pointer<T>::atomic_pointer;
+
+        atomic() noexcept = default;
+        ~atomic() noexcept = default;
+
+        atomic(const atomic&) = delete;
+        atomic& operator=(const atomic&) = delete;
+
+        T* operator=(T* desired) noexcept
+        {
+            this->store(desired);
+
+            return desired;
+        }
+    };
+
+    using atomic_bool     = atomic<bool>;
+    using atomic_char     = atomic<char>;
+    using atomic_schar    = atomic<signed char>;
+    using atomic_uchar    = atomic<unsigned char>;
+    using atomic_short    = atomic<short>;
+    using atomic_ushort   = atomic<unsigned short>;
+    using atomic_int      = atomic<int>;
+    using atomic_uint     = atomic<unsigned int>;
+    using atomic_long     = atomic<long>;
+    using atomic_ulong    = atomic<unsigned long>;
+    using atomic_llong    = atomic<long long>;
+    using atomic_ullong   = atomic<unsigned long long>;
+    using atomic_char16_t = atomic<char16_t>;
+    using atomic_char32_t = atomic<char32_t>;
+    using atomic_wchar_t  = atomic<wchar_t>;
+
+    using atomic_int8_t   = atomic<int8_t>;
+    using atomic_uint8_t  = atomic<uint8_t>;
+    using atomic_int16_t  = atomic<int16_t>;
+    using atomic_uint16_t = atomic<uint16_t>;
+    using atomic_int32_t  = atomic<int32_t>;
+    using atomic_uint32_t = atomic<uint32_t>;
+    using atomic_int64_t  = atomic<int64_t>;
+    using atomic_uint64_t = atomic<uint64_t>;
+
+    using atomic_intptr_t  = atomic<intptr_t>;
+    using atomic_uintptr_t = atomic<uintptr_t>;
+    using atomic_size_t    = atomic<size_t>;
+    using atomic_ptrdiff_t = atomic<ptrdiff_t>;
+    using atomic_intmax_t  = atomic<intmax_t>;
+    using atomic_uintmax_t = atomic<uintmax_t>;
+
+    /**
+     * 29.6, operations on atomic types:
+     */
+
+    template<class T>
+    bool atomic_is_lock_free(const atomic<T>* obj) noexcept
+    {
+        return obj->is_lock_free();
+    }
+
+    template<class T>
+    void atomic_init(atomic<T>* obj, T desired) noexcept
+    {
+        obj->store(desired, memory_order_relaxed);
+    }
+
+    template<class T>
+    void atomic_store(atomic<T>* obj, T desired) noexcept
+    {
+        obj->store(desired);
+    }
+
+    template<class T>
+    void atomic_store_explicit(atomic<T>* obj, T desired,
+                               memory_order order) noexcept
+    {
+        obj->store(desired, order);
+    }
+
+    template<class T>
+    T atomic_load(const atomic<T>* obj) noexcept
+    {
+        return obj->load();
+    }
+
+    template<class T>
+    T atomic_load_explicit(const atomic<T>* obj, memory_order order) noexcept
+    {
+        return obj->load(order);
+    }
+
+    template<class T>
+    T atomic_exchange(atomic<T>* obj, T desired) noexcept
+    {
+        return obj->exchange(desired);
+    }
+
+    template<class T>
+    T atomic_exchange_explicit(atomic<T>* obj, T desired,
+                               memory_order order) noexcept
+    {
+        return obj->exchange(desired, order);
+    }
+
+    template<class T>
+    bool atomic_compare_exchange_weak(atomic<T>* obj, T* expected,
+                                      T desired) noexcept
+    {
+        return obj->compare_exchange_weak(*expected, desired);
+    }
+
+    template<class T>
+    bool atomic_compare_exchange_strong(atomic<T>* obj, T* expected,
+                                        T desired) noexcept
+    {
+        return obj->compare_exchange_strong(*expected, desired);
+    }
+
+    template<class T>
+    bool atomic_compare_exchange_weak_explicit(atomic<T>* obj, T* expected,
+                                               T desired, memory_order success,
+                                               memory_order failure) noexcept
+    {
+        return obj->compare_exchange_weak(*expected, desired, success, failure);
+    }
+
+    template<class T>
+    bool atomic_compare_exchange_strong_explicit(atomic<T>* obj, T* expected,
+                                                 T desired, memory_order success,
+                                                 memory_order failure) noexcept
+    {
+        return obj->compare_exchange_strong(*expected, desired, success, failure);
+    }
+
+    template<class T, class U>
+    T atomic_fetch_add(atomic<T>* obj, U arg) noexcept
+    {
+        return obj->fetch_add(arg);
+    }
+
+    template<class T, class U>
+    T atomic_fetch_add_explicit(atomic<T>* obj, U arg,
+                                memory_order order) noexcept
+    {
+        return obj->fetch_add(arg, order);
+    }
+
+    template<class T, class U>
+    T atomic_fetch_sub(atomic<T>* obj, U arg) noexcept
+    {
+        return obj->fetch_sub(arg);
+    }
+
+    template<class T, class U>
+    T atomic_fetch_sub_explicit(atomic<T>* obj, U arg,
+                                memory_order order) noexcept
+    {
+        return obj->fetch_sub(arg, order);
+    }
+
+    template<class T>
+    T atomic_fetch_and(atomic<T>* obj, T arg) noexcept
+    {
+        return obj->fetch_and(arg);
+    }
+
+    template<class T>
+    T atomic_fetch_and_explicit(atomic<T>* obj, T arg,
+                                memory_order order) noexcept
+    {
+        return obj->fetch_and(arg, order);
+    }
+
+    template<class T>
+    T atomic_fetch_or(atomic<T>* obj, T arg) noexcept
+    {
+        return obj->fetch_or(arg);
+    }
+
+    template<class T>
+    T atomic_fetch_or_explicit(atomic<T>* obj, T arg,
+                               memory_order order) noexcept
+    {
+        return obj->fetch_or(arg, order);
+    }
+
+    template<class T>
+    T atomic_fetch_xor(atomic<T>* obj, T arg) noexcept
+    {
+        return obj->fetch_xor(arg);
+    }
+
+    template<class T>
+    T atomic_fetch_xor_explicit(atomic<T>* obj, T arg,
+                                memory_order order) noexcept
+    {
+        return obj->fetch_xor(arg, order);
+    }
+
+    /**
+     * 29.7, flag type and operations:
+     */
+
+    struct atomic_flag
+    {
+        public:
+            atomic_flag() noexcept = default;
+
+            constexpr atomic_flag(bool value) noexcept
+                : flag_{value}
+            { /* DUMMY BODY */ }
+
+            atomic_flag(const atomic_flag&) = delete;
+            atomic_flag& operator=(const atomic_flag&) = delete;
+
+            bool test_and_set(memory_order order = memory_order_seq_cst) noexcept
+            {
+                return __atomic_test_and_set(&flag_, order);
+            }
+
+            void clear(memory_order order = memory_order_seq_cst) noexcept
+            {
+                __atomic_clear(&flag_, order);
+            }
+
+            bool test(memory_order order = memory_order_seq_cst) const noexcept
+            {
+                return __atomic_load_n(&flag_, order);
+            }
+
+            void wait(bool old, memory_order order = memory_order_seq_cst) const noexcept
+            {
+                wait_args args{this, old, order};
+                if (!wait_pred(&args))
+                    return;
+
+                aux::atomic_wait_address(&flag_, wait_pred, &args);
+            }
+
+            void notify_one() noexcept
+            {
+                aux::atomic_notify_address(&flag_, false);
+            }
+
+            void notify_all() noexcept
+            {
+                aux::atomic_notify_address(&flag_, true);
+            }
+
+        private:
+            bool flag_;
+
+            struct wait_args
+            {
+                const atomic_flag* flag;
+                bool old;
+                memory_order order;
+            };
+
+            static bool wait_pred(const void* arg)
+            {
+                auto args = static_cast<const wait_args*>(arg);
+
+                return args->flag->test(args->order) == args->old;
+            }
+    };
+
+    inline bool atomic_flag_test_and_set(atomic_flag* flag) noexcept
+    {
+        return flag->test_and_set();
+    }
+
+    inline bool atomic_flag_test_and_set_explicit(atomic_flag* flag,
+                                                  memory_order order) noexcept
+    {
+        return flag->test_and_set(order);
+    }
+
+    inline void atomic_flag_clear(atomic_flag* flag) noexcept
+    {
+        flag->clear();
+    }
+
+    inline void atomic_flag_clear_explicit(atomic_flag* flag,
+                                           memory_order order) noexcept
+    {
+        flag->clear(order);
+    }
+}
 
 #endif
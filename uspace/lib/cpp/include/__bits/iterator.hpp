@@ -115,8 +115,19 @@ namespace std
     template<class InputIterator, class Distance>
     void advance(InputIterator& it, Distance n)
     {
-        for (Distance i = Distance{}; i < n; ++i)
-            ++it;
+        using cat_t = typename iterator_traits<InputIterator>::iterator_category;
+
+        if constexpr (is_same_v<cat_t, random_access_iterator_tag>)
+            it += n;
+        else
+        {
+            for (Distance i = Distance{}; i < n; ++i)
+                ++it;
+
+            // Negative distance is only valid for bidirectional iterators.
+            for (Distance i = Distance{}; i > n; --i)
+                --it;
+        }
     }
 
     template<class InputIterator>
@@ -92,7 +92,7 @@ namespace std
             if (res)
                 return make_pair(res, n);
 
-            --n;
+            n /= 2;
         }
 
         return make_pair(nullptr, ptrdiff_t{});
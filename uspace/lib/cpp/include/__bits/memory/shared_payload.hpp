@@ -132,9 +132,8 @@ namespace std::aux
                 refcount_t rfs = this->refs();
                 while (rfs != 0L)
                 {
-                    if (__atomic_compare_exchange_n(&this->refcount_, &rfs, rfs + 1,
-                                                    true, __ATOMIC_RELAXED,
-                                                    __ATOMIC_RELAXED))
+                    if (this->refcount_.compare_exchange_weak(rfs, rfs + 1,
+                                                              memory_order_relaxed))
                     {
                         return this;
                     }
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef LIBCPP_BITS_REGEX_ALGORITHMS
+#define LIBCPP_BITS_REGEX_ALGORITHMS
+
+#include <__bits/regex/basic_regex.hpp>
+#include <__bits/regex/engine.hpp>
+#include <__bits/regex/match_results.hpp>
+#include <__bits/string/string.hpp>
+
+namespace std
+{
+    namespace aux
+    {
+        template<class BidirIt, class Char, class Traits>
+        bool regex_run(BidirIt first, BidirIt last, const basic_regex<Char, Traits>& re,
+                       regex_constants::match_flag_type flags, bool full,
+                       vector<regex_slot<BidirIt>>* slots,
+                       regex_engine engine = regex_engine::automatic)
+        {
+            auto prog = regex_access::program(re);
+            if (!prog)
+                return false;
+
+            return regex_execute(*prog, first, last, flags, full, slots, engine);
+        }
+
+        template<class BidirIt, class Alloc, class Char, class Traits>
+        bool regex_run(BidirIt first, BidirIt last, match_results<BidirIt, Alloc>& m,
+                       const basic_regex<Char, Traits>& re,
+                       regex_constants::match_flag_type flags, bool full,
+                       regex_engine engine = regex_engine::automatic)
+        {
+            vector<regex_slot<BidirIt>> slots{};
+            if (regex_run(first, last, re, flags, full, &slots, engine))
+            {
+                match_results_access::set(m, first, last, slots, re.mark_count());
+
+                return true;
+            }
+            else
+            {
+                match_results_access::set_failed(m, last);
+
+                return false;
+            }
+        }
+    }
+
+    /**
+     * 28.11.2, function template regex_match:
+     */
+
+    template<class BidirectionalIterator, class Allocator, class Char, class Traits>
+    bool regex_match(BidirectionalIterator first, BidirectionalIterator last,
+                     match_results<BidirectionalIterator, Allocator>& m,
+                     const basic_regex<Char, Traits>& re,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return aux::regex_run(first, last, m, re, flags, true);
+    }
+
+    template<class BidirectionalIterator, class Char, class Traits>
+    bool regex_match(BidirectionalIterator first, BidirectionalIterator last,
+                     const basic_regex<Char, Traits>& re,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return aux::regex_run<BidirectionalIterator>(first, last, re, flags, true, nullptr);
+    }
+
+    template<class Char, class Allocator, class Traits>
+    bool regex_match(const Char* str, match_results<const Char*, Allocator>& m,
+                     const basic_regex<Char, Traits>& re,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_match(str, str + char_traits<Char>::length(str), m, re, flags);
+    }
+
+    template<class ST, class SA, class Allocator, class Char, class Traits>
+    bool regex_match(const basic_string<Char, ST, SA>& str,
+                     match_results<typename basic_string<Char, ST, SA>::const_iterator,
+                                   Allocator>& m,
+                     const basic_regex<Char, Traits>& re,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_match(str.begin(), str.end(), m, re, flags);
+    }
+
+    template<class ST, class SA, class Allocator, class Char, class Traits>
+    bool regex_match(const basic_string<Char, ST, SA>&&,
+                     match_results<typename basic_string<Char, ST, SA>::const_iterator,
+                                   Allocator>&,
+                     const basic_regex<Char, Traits>&,
+                     regex_constants::match_flag_type = regex_constants::match_default) = delete;
+
+    template<class Char, class Traits>
+    bool regex_match(const Char* str, const basic_regex<Char, Traits>& re,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_match(str, str + char_traits<Char>::length(str), re, flags);
+    }
+
+    template<class ST, class SA, class Char, class Traits>
+    bool regex_match(const basic_string<Char, ST, SA>& str,
+                     const basic_regex<Char, Traits>& re,
+                     regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_match(str.begin(), str.end(), re, flags);
+    }
+
+    /**
+     * 28.11.3, function template regex_search:
+     */
+
+    template<class BidirectionalIterator, class Allocator, class Char, class Traits>
+    bool regex_search(BidirectionalIterator first, BidirectionalIterator last,
+                      match_results<BidirectionalIterator, Allocator>& m,
+                      const basic_regex<Char, Traits>& re,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return aux::regex_run(first, last, m, re, flags, false);
+    }
+
+    template<class BidirectionalIterator, class Char, class Traits>
+    bool regex_search(BidirectionalIterator first, BidirectionalIterator last,
+                      const basic_regex<Char, Traits>& re,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return aux::regex_run<BidirectionalIterator>(first, last, re, flags, false, nullptr);
+    }
+
+    template<class Char, class Allocator, class Traits>
+    bool regex_search(const Char* str, match_results<const Char*, Allocator>& m,
+                      const basic_regex<Char, Traits>& re,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_search(str, str + char_traits<Char>::length(str), m, re, flags);
+    }
+
+    template<class Char, class Traits>
+    bool regex_search(const Char* str, const basic_regex<Char, Traits>& re,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_search(str, str + char_traits<Char>::length(str), re, flags);
+    }
+
+    template<class ST, class SA, class Char, class Traits>
+    bool regex_search(const basic_string<Char, ST, SA>& str,
+                      const basic_regex<Char, Traits>& re,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_search(str.begin(), str.end(), re, flags);
+    }
+
+    template<class ST, class SA, class Allocator, class Char, class Traits>
+    bool regex_search(const basic_string<Char, ST, SA>& str,
+                      match_results<typename basic_string<Char, ST, SA>::const_iterator,
+                                    Allocator>& m,
+                      const basic_regex<Char, Traits>& re,
+                      regex_constants::match_flag_type flags = regex_constants::match_default)
+    {
+        return regex_search(str.begin(), str.end(), m, re, flags);
+    }
+
+    template<class ST, class SA, class Allocator, class Char, class Traits>
+    bool regex_search(const basic_string<Char, ST, SA>&&,
+                      match_results<typename basic_string<Char, ST, SA>::const_iterator,
+                                    Allocator>&,
+                      const basic_regex<Char, Traits>&,
+                      regex_constants::match_flag_type = regex_constants::match_default) = delete;
+}
+
+#endif
@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef LIBCPP_BITS_REGEX_BASIC_REGEX
+#define LIBCPP_BITS_REGEX_BASIC_REGEX
+
+#include <__bits/adt/initializer_list.hpp>
+#include <__bits/adt/vector.hpp>
+#include <__bits/locale/locale.hpp>
+#include <__bits/memory/shared_ptr.hpp>
+#include <__bits/regex/program.hpp>
+#include <__bits/regex/regex_constants.hpp>
+#include <__bits/string/string.hpp>
+#include <__bits/trycatch.hpp>
+
+namespace std
+{
+    /**
+     * 28.7, class template regex_traits:
+     * Note: Classification and case folding are ASCII based
+     *       and do not depend on the imbued locale.
+     */
+
+    template<class Char>
+    struct regex_traits
+    {
+        using char_type       = Char;
+        using string_type     = basic_string<char_type>;
+        using locale_type     = locale;
+        using char_class_type = uint16_t;
+
+        regex_traits()
+            : loc_{}
+        { /* DUMMY BODY */ }
+
+        static size_t length(const char_type* p)
+        {
+            return char_traits<char_type>::length(p);
+        }
+
+        char_type translate(char_type c) const
+        {
+            return c;
+        }
+
+        char_type translate_nocase(char_type c) const
+        {
+            if (c >= 'A' && c <= 'Z')
+                return static_cast<char_type>(c - 'A' + 'a');
+            else
+                return c;
+        }
+
+        bool isctype(char_type c, char_class_type f) const
+        {
+            return (aux::regex_classify(aux::regex_code(c)) & f) != 0;
+        }
+
+        int value(char_type c, int radix) const
+        {
+            int res{-1};
+            if (c >= '0' && c <= '9')
+                res = c - '0';
+            else if (c >= 'a' && c <= 'z')
+                res = c - 'a' + 10;
+            else if (c >= 'A' && c <= 'Z')
+                res = c - 'A' + 10;
+
+            if (res >= radix)
+                return -1;
+            else
+                return res;
+        }
+
+        locale_type imbue(locale_type loc)
+        {
+            auto res = loc_;
+            loc_ = loc;
+
+            return res;
+        }
+
+        locale_type getloc() const
+        {
+            return loc_;
+        }
+
+        private:
+            locale_type loc_;
+    };
+
+    template<class Char, class Traits>
+    class basic_regex;
+
+    namespace aux
+    {
+        /**
+         * Gives the matching algorithms access
+         * to the compiled form of a regex.
+         */
+        struct regex_access
+        {
+            template<class Char, class Traits>
+            static const regex_program* program(const basic_regex<Char, Traits>& re)
+            {
+                return re.program_.get();
+            }
+        };
+    }
+
+    /**
+     * 28.8, class template basic_regex:
+     * Note: Only the ECMAScript grammar is implemented, patterns
+     *       given with the other grammar flags are parsed
+     *       as ECMAScript.
+     */
+
+    template<class Char, class Traits = regex_traits<Char>>
+    class basic_regex
+    {
+        public:
+            using value_type  = Char;
+            using traits_type = Traits;
+            using string_type = typename traits_type::string_type;
+            using flag_type   = regex_constants::syntax_option_type;
+            using locale_type = typename traits_type::locale_type;
+
+            static constexpr flag_type icase      = regex_constants::icase;
+            static constexpr flag_type nosubs     = regex_constants::nosubs;
+            static constexpr flag_type optimize   = regex_constants::optimize;
+            static constexpr flag_type collate    = regex_constants::collate;
+            static constexpr flag_type ECMAScript = regex_constants::ECMAScript;
+            static constexpr flag_type basic      = regex_constants::basic;
+            static constexpr flag_type extended   = regex_constants::extended;
+            static constexpr flag_type awk        = regex_constants::awk;
+            static constexpr flag_type grep       = regex_constants::grep;
+            static constexpr flag_type egrep      = regex_constants::egrep;
+            static constexpr flag_type multiline  = regex_constants::multiline;
+
+            /**
+             * 28.8.2, construct/copy/destroy:
+             */
+
+            basic_regex()
+                : flags_{regex_constants::ECMAScript}, traits_{}, program_{}
+            { /* DUMMY BODY */ }
+
+            explicit basic_regex(const value_type* p, flag_type f = regex_constants::ECMAScript)
+                : basic_regex{}
+            {
+                assign(p, f);
+            }
+
+            basic_regex(const value_type* p, size_t len, flag_type f = regex_constants::ECMAScript)
+                : basic_regex{}
+            {
+                assign(p, len, f);
+            }
+
+            basic_regex(const basic_regex& other) = default;
+
+            basic_regex(basic_regex&& other) noexcept = default;
+
+            template<class ST, class SA>
+            explicit basic_regex(const basic_string<value_type, ST, SA>& str,
+                                 flag_type f = regex_constants::ECMAScript)
+                : basic_regex{}
+            {
+                assign(str, f);
+            }
+
+            template<class ForwardIterator>
+            basic_regex(ForwardIterator first, ForwardIterator last,
+                        flag_type f = regex_constants::ECMAScript)
+                : basic_regex{}
+            {
+                assign(first, last, f);
+            }
+
+            basic_regex(initializer_list<value_type> init, flag_type f = regex_constants::ECMAScript)
+                : basic_regex{}
+            {
+                assign(init, f);
+            }
+
+            ~basic_regex() = default;
+
+            basic_regex& operator=(const basic_regex& other) = default;
+
+            basic_regex& operator=(basic_regex&& other) noexcept = default;
+
+            basic_regex& operator=(const value_type* p)
+            {
+                return assign(p);
+            }
+
+            basic_regex& operator=(initializer_list<value_type> init)
+            {
+                return assign(init);
+            }
+
+            template<class ST, class SA>
+            basic_regex& operator=(const basic_string<value_type, ST, SA>& str)
+            {
+                return assign(str);
+            }
+
+            /**
+             * 28.8.3, assign:
+             */
+
+            basic_regex& assign(const basic_regex& other)
+            {
+                return *this = other;
+            }
+
+            basic_regex& assign(basic_regex&& other) noexcept
+            {
+                return *this = move(other);
+            }
+
+            basic_regex& assign(const value_type* p, flag_type f = regex_constants::ECMAScript)
+            {
+                return assign(p, p + traits_type::length(p), f);
+            }
+
+            basic_regex& assign(const value_type* p, size_t len, flag_type f = regex_constants::ECMAScript)
+            {
+                return assign(p, p + len, f);
+            }
+
+            template<class ST, class SA>
+            basic_regex& assign(const basic_string<value_type, ST, SA>& str,
+                                flag_type f = regex_constants::ECMAScript)
+            {
+                return assign(str.begin(), str.end(), f);
+            }
+
+            template<class InputIterator>
+            basic_regex& assign(InputIterator first, InputIterator last,
+                                flag_type f = regex_constants::ECMAScript)
+            {
+                vector<uint32_t> pattern{};
+                while (first != last)
+                    pattern.push_back(aux::regex_code(*first++));
+
+                auto err = regex_constants::error_collate;
+                auto prog = aux::regex_compile(
+                    pattern.data(), pattern.data() + pattern.size(), f, err
+                );
+
+                if (!prog)
+                {
+                    /**
+                     * The regex is left unchanged, which is
+                     * what would happen if throw was real.
+                     */
+                    throw regex_error{err};
+
+                    return *this;
+                }
+
+                flags_ = f;
+                program_ = move(prog);
+
+                return *this;
+            }
+
+            basic_regex& assign(initializer_list<value_type> init,
+                                flag_type f = regex_constants::ECMAScript)
+            {
+                return assign(init.begin(), init.end(), f);
+            }
+
+            /**
+             * 28.8.4, const operations:
+             */
+
+            unsigned int mark_count() const
+            {
+                if (program_)
+                    return static_cast<unsigned int>(program_->mark_count);
+                else
+                    return 0U;
+            }
+
+            flag_type flags() const
+            {
+                return flags_;
+            }
+
+            /**
+             * 28.8.5, locale:
+             */
+
+            locale_type imbue(locale_type loc)
+            {
+                program_.reset();
+
+                return traits_.imbue(loc);
+            }
+
+            locale_type getloc() const
+            {
+                return traits_.getloc();
+            }
+
+            /**
+             * 28.8.6, swap:
+             */
+
+            void swap(basic_regex& other)
+            {
+                std::swap(flags_, other.flags_);
+                std::swap(traits_, other.traits_);
+                std::swap(program_, other.program_);
+            }
+
+        private:
+            flag_type flags_;
+            traits_type traits_;
+
+            /**
+             * Compiled programs are immutable (apart from the
+             * synchronized DFA cache) and thus shared by copies.
+             */
+            shared_ptr<aux::regex_program> program_;
+
+            friend struct aux::regex_access;
+    };
+
+    /**
+     * 28.8.7, basic_regex swap:
+     */
+
+    template<class Char, class Traits>
+    void swap(basic_regex<Char, Traits>& lhs, basic_regex<Char, Traits>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    using regex  = basic_regex<char>;
+    using wregex = basic_regex<wchar_t>;
+}
+
+#endif
@@ -0,0 +1,712 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef LIBCPP_BITS_REGEX_ENGINE
+#define LIBCPP_BITS_REGEX_ENGINE
+
+#include <__bits/adt/vector.hpp>
+#include <__bits/iterator.hpp>
+#include <__bits/regex/program.hpp>
+#include <__bits/regex/regex_constants.hpp>
+#include <cstdint>
+
+namespace std::aux
+{
+    enum class regex_engine
+    {
+        automatic,
+        nfa,
+        backtrack
+    };
+
+    template<class BidirIt>
+    struct regex_slot
+    {
+        BidirIt pos{};
+        ptrdiff_t off{-1};
+    };
+
+    /**
+     * The input sequence together with the context
+     * needed by the anchors and word boundaries.
+     */
+    template<class BidirIt>
+    struct regex_input
+    {
+        BidirIt first;
+        BidirIt last;
+        ptrdiff_t length;
+
+        regex_constants::match_flag_type flags;
+
+        /**
+         * In full mode the match has to span the whole input.
+         */
+        bool full;
+
+        regex_input(BidirIt f, BidirIt l, regex_constants::match_flag_type fl, bool fu)
+            : first{f}, last{l}, length{distance(f, l)}, flags{fl}, full{fu}
+        { /* DUMMY BODY */ }
+
+        bool has_flag(regex_constants::match_flag_type flag) const
+        {
+            return (flags & flag) != 0;
+        }
+
+        /**
+         * Code units before and after a position, -1 stands
+         * for the boundary of the sequence.
+         */
+        int64_t before(BidirIt it, ptrdiff_t off) const
+        {
+            if (off > 0 || (off == 0 && has_flag(regex_constants::match_prev_avail)))
+                return regex_code(*prev(it));
+            else
+                return -1;
+        }
+
+        int64_t after(BidirIt it, ptrdiff_t off) const
+        {
+            if (off < length)
+                return regex_code(*it);
+            else
+                return -1;
+        }
+
+        bool at_bol(int64_t prev_char, ptrdiff_t off, bool multiline) const
+        {
+            if (off == 0 && !has_flag(regex_constants::match_prev_avail))
+                return !has_flag(regex_constants::match_not_bol);
+
+            return multiline && prev_char >= 0 &&
+                   regex_is_line_terminator(static_cast<uint32_t>(prev_char));
+        }
+
+        bool at_eol(int64_t next_char, ptrdiff_t off, bool multiline) const
+        {
+            if (off == length)
+                return !has_flag(regex_constants::match_not_eol);
+
+            return multiline && next_char >= 0 &&
+                   regex_is_line_terminator(static_cast<uint32_t>(next_char));
+        }
+
+        bool at_word_boundary(int64_t prev_char, int64_t next_char, ptrdiff_t off) const
+        {
+            bool prev_word = prev_char >= 0 && regex_is_word(static_cast<uint32_t>(prev_char));
+            bool next_word = next_char >= 0 && regex_is_word(static_cast<uint32_t>(next_char));
+
+            if (off == 0 && !has_flag(regex_constants::match_prev_avail) &&
+                has_flag(regex_constants::match_not_bow))
+                return false;
+            if (off == length && has_flag(regex_constants::match_not_eow))
+                return false;
+
+            return prev_word != next_word;
+        }
+
+        bool accepts(ptrdiff_t start, ptrdiff_t off) const
+        {
+            if (full && off != length)
+                return false;
+            if (has_flag(regex_constants::match_not_null) && start == off)
+                return false;
+
+            return true;
+        }
+    };
+
+    /**
+     * Backtracking executor, used for the patterns that need
+     * backreferences or lookaheads. Its running time can be
+     * exponential in the length of the input.
+     */
+    template<class BidirIt>
+    class regex_backtracker
+    {
+        public:
+            using slot_type = regex_slot<BidirIt>;
+
+            regex_backtracker(const regex_program& prog, const regex_input<BidirIt>& input)
+                : prog_{prog}, input_{input}, stack_{}
+            { /* DUMMY BODY */ }
+
+            /**
+             * Tries to match at the given position,
+             * slots are updated on success.
+             */
+            bool run(uint32_t pc, BidirIt it, ptrdiff_t off, vector<slot_type>& slots)
+            {
+                auto base = stack_.size();
+                stack_.push_back(frame_t{pc, it, off, 0U, false});
+
+                while (stack_.size() > base)
+                {
+                    auto frame = stack_.back();
+                    stack_.pop_back();
+
+                    if (frame.restore)
+                    {
+                        slots[frame.pc].pos = frame.pos;
+                        slots[frame.pc].off = frame.off;
+                        continue;
+                    }
+
+                    if (step_(frame.pc, frame.pos, frame.off, base, slots))
+                    {
+                        stack_.resize(base);
+
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+        private:
+            struct frame_t
+            {
+                uint32_t pc;
+                BidirIt pos;
+                ptrdiff_t off;
+                uint32_t unused;
+                bool restore;
+            };
+
+            const regex_program& prog_;
+            const regex_input<BidirIt>& input_;
+            vector<frame_t> stack_;
+
+            void save_(vector<slot_type>& slots, uint32_t slot, BidirIt it, ptrdiff_t off)
+            {
+                stack_.push_back(frame_t{slot, slots[slot].pos, slots[slot].off, 0U, true});
+                slots[slot].pos = it;
+                slots[slot].off = off;
+            }
+
+            bool backref_(uint32_t group, BidirIt& it, ptrdiff_t& off,
+                          const vector<slot_type>& slots)
+            {
+                const auto& start = slots[2 * group];
+                const auto& end = slots[2 * group + 1];
+                if (start.off < 0 || end.off < 0)
+                    return true; // Unmatched group matches the empty string.
+
+                auto len = end.off - start.off;
+                if (off + len > input_.length)
+                    return false;
+
+                auto src = start.pos;
+                auto dst = it;
+                for (ptrdiff_t i = 0; i < len; ++i, ++src, ++dst)
+                {
+                    auto lhs = regex_code(*src);
+                    auto rhs = regex_code(*dst);
+
+                    if (prog_.icase)
+                    {
+                        lhs = regex_fold_case(lhs);
+                        rhs = regex_fold_case(rhs);
+                    }
+
+                    if (lhs != rhs)
+                        return false;
+                }
+
+                it = dst;
+                off += len;
+
+                return true;
+            }
+
+            /**
+             * Follows a single thread until it fails (returns false
+             * and leaves alternatives on the stack) or matches.
+             */
+            bool step_(uint32_t pc, BidirIt it, ptrdiff_t off, size_t base,
+                       vector<slot_type>& slots)
+            {
+                while (true)
+                {
+                    const auto& inst = prog_.insts[pc];
+                    switch (inst.op)
+                    {
+                        case regex_opcode::match:
+                            if (!input_.accepts(slots[0].off, off))
+                                return false;
+                            return true;
+                        case regex_opcode::look_end:
+                            return true;
+                        case regex_opcode::chr:
+                        case regex_opcode::any:
+                        case regex_opcode::cls:
+                            if (off >= input_.length ||
+                                !regex_inst_consumes(prog_, inst, regex_code(*it)))
+                                return false;
+                            ++it;
+                            ++off;
+                            ++pc;
+                            break;
+                        case regex_opcode::split:
+                            stack_.push_back(frame_t{inst.y, it, off, 0U, false});
+                            pc = inst.x;
+                            break;
+                        case regex_opcode::jmp:
+                            pc = inst.x;
+                            break;
+                        case regex_opcode::save:
+                            save_(slots, inst.x, it, off);
+                            ++pc;
+                            break;
+                        case regex_opcode::clear:
+                            for (auto i = inst.x; i < inst.y; ++i)
+                                save_(slots, i, BidirIt{}, -1);
+                            ++pc;
+                            break;
+                        case regex_opcode::loop_check:
+                            if (slots[inst.x].off == off)
+                                return false;
+                            ++pc;
+                            break;
+                        case regex_opcode::bol:
+                            if (!input_.at_bol(input_.before(it, off), off, prog_.multiline))
+                                return false;
+                            ++pc;
+                            break;
+                        case regex_opcode::eol:
+                            if (!input_.at_eol(input_.after(it, off), off, prog_.multiline))
+                                return false;
+                            ++pc;
+                            break;
+                        case regex_opcode::word_boundary:
+                        case regex_opcode::nword_boundary:
+                        {
+                            bool res = input_.at_word_boundary(
+                                input_.before(it, off), input_.after(it, off), off
+                            );
+                            if (res != (inst.op == regex_opcode::word_boundary))
+                                return false;
+                            ++pc;
+                            break;
+                        }
+                        case regex_opcode::backref:
+                            if (!backref_(inst.x, it, off, slots))
+                                return false;
+                            ++pc;
+                            break;
+                        case regex_opcode::look:
+                        {
+                            /**
+                             * Lookaheads are atomic, the nested run
+                             * does not leave any alternatives behind.
+                             */
+                            vector<slot_type> saved{slots};
+                            bool res = run(pc + 1, it, off, slots);
+
+                            if (inst.y)
+                            {
+                                slots = move(saved);
+                                if (res)
+                                    return false;
+                            }
+                            else if (!res)
+                            {
+                                slots = move(saved);
+                                return false;
+                            }
+                            else
+                            {
+                                for (size_t i = 0; i < slots.size(); ++i)
+                                {
+                                    if (slots[i].off != saved[i].off)
+                                        stack_.push_back(frame_t{
+                                            static_cast<uint32_t>(i), saved[i].pos,
+                                            saved[i].off, 0U, true
+                                        });
+                                }
+                            }
+                            pc = inst.x;
+                            break;
+                        }
+                    }
+                }
+            }
+    };
+
+    /**
+     * Thompson NFA simulation with submatch tracking (Pike VM),
+     * runs in O(n * m) time and reports the same leftmost match
+     * with the same captures as the backtracking engine would.
+     */
+    template<class BidirIt>
+    class regex_pike_vm
+    {
+        public:
+            using slot_type = regex_slot<BidirIt>;
+
+            regex_pike_vm(const regex_program& prog, const regex_input<BidirIt>& input)
+                : prog_{prog}, input_{input}, nslots_{prog.slot_count},
+                  current_{prog.insts.size(), prog.slot_count},
+                  next_{prog.insts.size(), prog.slot_count},
+                  stack_{}, scratch_(prog.slot_count)
+            { /* DUMMY BODY */ }
+
+            bool run(bool anchored, vector<slot_type>& result)
+            {
+                bool matched{false};
+                auto it = input_.first;
+                int64_t prev_char = input_.before(it, 0);
+
+                current_.clear();
+                for (ptrdiff_t off = 0; ; ++off)
+                {
+                    int64_t cur_char = input_.after(it, off);
+
+                    if (!matched && (off == 0 || !anchored))
+                    {
+                        for (auto& slot: scratch_)
+                            slot = slot_type{};
+                        add_(current_, 0, it, off, prev_char, cur_char, scratch_.data());
+                    }
+
+                    if (current_.size == 0)
+                        break;
+
+                    next_.clear();
+                    auto next_it = it;
+                    int64_t next_char{-1};
+                    if (off < input_.length)
+                    {
+                        ++next_it;
+                        next_char = input_.after(next_it, off + 1);
+                    }
+
+                    for (size_t i = 0; i < current_.size; ++i)
+                    {
+                        auto pc = current_.dense[i];
+                        const auto& inst = prog_.insts[pc];
+                        auto* caps = current_.slots(pc);
+
+                        if (inst.op == regex_opcode::match)
+                        {
+                            if (!input_.accepts(caps[0].off, off))
+                                continue;
+
+                            result.assign(caps, caps + nslots_);
+                            matched = true;
+
+                            // Lower priority threads are cut off.
+                            break;
+                        }
+                        else if (off < input_.length &&
+                                 regex_inst_consumes(prog_, inst, static_cast<uint32_t>(cur_char)))
+                        {
+                            add_(next_, pc + 1, next_it, off + 1, cur_char, next_char, caps);
+                        }
+                    }
+
+                    swap(current_, next_);
+                    if (off >= input_.length)
+                        break;
+
+                    prev_char = cur_char;
+                    it = next_it;
+                }
+
+                return matched;
+            }
+
+        private:
+            /**
+             * Sparse set of threads keyed by the program counter,
+             * each thread owns a row of slots.
+             */
+            struct thread_list
+            {
+                vector<uint32_t> dense;
+                vector<uint32_t> sparse;
+                vector<slot_type> slot_rows;
+                size_t size;
+                size_t nslots;
+
+                thread_list(size_t ninsts, size_t ns)
+                    : dense(ninsts), sparse(ninsts), slot_rows(ninsts * ns),
+                      size{}, nslots{ns}
+                { /* DUMMY BODY */ }
+
+                bool contains(uint32_t pc) const
+                {
+                    auto idx = sparse[pc];
+
+                    return idx < size && dense[idx] == pc;
+                }
+
+                void insert(uint32_t pc)
+                {
+                    sparse[pc] = static_cast<uint32_t>(size);
+                    dense[size++] = pc;
+                }
+
+                slot_type* slots(uint32_t pc)
+                {
+                    return slot_rows.data() + pc * nslots;
+                }
+
+                void clear()
+                {
+                    size = 0;
+                }
+            };
+
+            struct frame_t
+            {
+                uint32_t pc;
+                int32_t slot;
+                slot_type value;
+            };
+
+            const regex_program& prog_;
+            const regex_input<BidirIt>& input_;
+            size_t nslots_;
+            thread_list current_;
+            thread_list next_;
+            vector<frame_t> stack_;
+            vector<slot_type> scratch_;
+
+            /**
+             * Follows the epsilon transitions from pc in priority
+             * order. Slot changes are undone through restore frames
+             * (slot >= 0) so that caps can be shared by all threads.
+             */
+            void add_(thread_list& list, uint32_t pc, BidirIt it, ptrdiff_t off,
+                      int64_t prev_char, int64_t next_char, slot_type* caps)
+            {
+                stack_.push_back(frame_t{pc, -1, slot_type{}});
+
+                while (!stack_.empty())
+                {
+                    auto frame = stack_.back();
+                    stack_.pop_back();
+
+                    if (frame.slot >= 0)
+                    {
+                        caps[frame.slot] = frame.value;
+                        continue;
+                    }
+
+                    pc = frame.pc;
+                    while (!list.contains(pc))
+                    {
+                        list.insert(pc);
+
+                        const auto& inst = prog_.insts[pc];
+                        bool proceed{true};
+                        switch (inst.op)
+                        {
+                            case regex_opcode::split:
+                                stack_.push_back(frame_t{inst.y, -1, slot_type{}});
+                                pc = inst.x;
+                                break;
+                            case regex_opcode::jmp:
+                                pc = inst.x;
+                                break;
+                            case regex_opcode::save:
+                                stack_.push_back(frame_t{
+                                    0, static_cast<int32_t>(inst.x), caps[inst.x]
+                                });
+                                caps[inst.x] = slot_type{it, off};
+                                ++pc;
+                                break;
+                            case regex_opcode::clear:
+                                for (auto i = inst.x; i < inst.y; ++i)
+                                {
+                                    stack_.push_back(frame_t{
+                                        0, static_cast<int32_t>(i), caps[i]
+                                    });
+                                    caps[i] = slot_type{};
+                                }
+                                ++pc;
+                                break;
+                            case regex_opcode::loop_check:
+                                proceed = caps[inst.x].off != off;
+                                ++pc;
+                                break;
+                            case regex_opcode::bol:
+                                proceed = input_.at_bol(prev_char, off, prog_.multiline);
+                                ++pc;
+                                break;
+                            case regex_opcode::eol:
+                                proceed = input_.at_eol(next_char, off, prog_.multiline);
+                                ++pc;
+                                break;
+                            case regex_opcode::word_boundary:
+                            case regex_opcode::nword_boundary:
+                                proceed = input_.at_word_boundary(prev_char, next_char, off) ==
+                                          (inst.op == regex_opcode::word_boundary);
+                                ++pc;
+                                break;
+                            default:
+                            {
+                                // Consuming or accepting instruction.
+                                auto* row = list.slots(pc);
+                                for (size_t i = 0; i < nslots_; ++i)
+                                    row[i] = caps[i];
+                                proceed = false;
+                                break;
+                            }
+                        }
+
+                        if (!proceed)
+                            break;
+                    }
+                }
+            }
+    };
+
+    /**
+     * Runs the DFA over the input. Returns 1 on a match, 0 when there
+     * is none and -1 when the automaton is in use by another thread.
+     */
+    template<class BidirIt>
+    int regex_dfa_run(regex_dfa& dfa, const regex_input<BidirIt>& input, bool anchored)
+    {
+        if (!dfa.try_acquire())
+            return -1;
+
+        bool eol = !input.has_flag(regex_constants::match_not_eol);
+        int state = dfa.start(
+            anchored, input.at_bol(input.before(input.first, 0), 0, false)
+        );
+
+        int res{0};
+        if (input.full)
+        {
+            for (auto it = input.first; it != input.last; ++it)
+            {
+                state = dfa.next(state, static_cast<unsigned char>(*it));
+                if (state == regex_dfa::dead_state)
+                    break;
+            }
+
+            res = dfa.accepting_at_end(state, eol);
+        }
+        else
+        {
+            for (auto it = input.first; !dfa.accepting(state); ++it)
+            {
+                if (it == input.last)
+                {
+                    res = dfa.accepting_at_end(state, eol);
+                    break;
+                }
+
+                state = dfa.next(state, static_cast<unsigned char>(*it));
+                if (state == regex_dfa::dead_state)
+                    break;
+            }
+
+            if (dfa.accepting(state))
+                res = 1;
+        }
+
+        dfa.release();
+
+        return res;
+    }
+
+    /**
+     * Matches or searches the input, slots may be null if the
+     * caller only needs to know whether there is a match.
+     */
+    template<class BidirIt>
+    bool regex_execute(
+        const regex_program& prog, BidirIt first, BidirIt last,
+        regex_constants::match_flag_type flags, bool full,
+        vector<regex_slot<BidirIt>>* slots,
+        regex_engine engine = regex_engine::automatic
+    )
+    {
+        using char_type = typename iterator_traits<BidirIt>::value_type;
+
+        regex_input<BidirIt> input{first, last, flags, full};
+        bool anchored = full || input.has_flag(regex_constants::match_continuous);
+
+        if constexpr (sizeof(char_type) == 1)
+        {
+            if (engine == regex_engine::automatic && prog.dfa &&
+                !input.has_flag(regex_constants::match_not_null))
+            {
+                auto res = regex_dfa_run(*prog.dfa, input, anchored);
+                if (res == 0)
+                    return false;
+                else if (res == 1 && !slots)
+                    return true;
+                else if (res == 1 && full && prog.mark_count == 0)
+                {
+                    slots->assign(prog.slot_count, regex_slot<BidirIt>{});
+                    (*slots)[0] = regex_slot<BidirIt>{first, 0};
+                    (*slots)[1] = regex_slot<BidirIt>{last, input.length};
+
+                    return true;
+                }
+            }
+        }
+
+        vector<regex_slot<BidirIt>> local{};
+        auto& result = slots ? *slots : local;
+
+        bool backtrack = prog.backtrack_only || engine == regex_engine::backtrack ||
+                         (engine == regex_engine::automatic && prog.empty_checks);
+        if (backtrack)
+        {
+            regex_backtracker<BidirIt> bt{prog, input};
+
+            auto it = first;
+            for (ptrdiff_t off = 0; off <= input.length; ++off, ++it)
+            {
+                result.assign(prog.slot_count, regex_slot<BidirIt>{});
+                if (bt.run(0, it, off, result))
+                    return true;
+
+                if (anchored || off == input.length)
+                    break;
+            }
+
+            return false;
+        }
+        else
+        {
+            regex_pike_vm<BidirIt> vm{prog, input};
+
+            return vm.run(anchored, result);
+        }
+    }
+}
+
+#endif
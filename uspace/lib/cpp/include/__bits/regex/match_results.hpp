@@ -0,0 +1,463 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef LIBCPP_BITS_REGEX_MATCH_RESULTS
+#define LIBCPP_BITS_REGEX_MATCH_RESULTS
+
+#include <__bits/adt/vector.hpp>
+#include <__bits/iterator.hpp>
+#include <__bits/memory/allocator_traits.hpp>
+#include <__bits/regex/engine.hpp>
+#include <__bits/string/string.hpp>
+#include <__bits/utility/utility.hpp>
+
+namespace std
+{
+    /**
+     * 28.9, class template sub_match:
+     */
+
+    template<class BidirectionalIterator>
+    class sub_match: public pair<BidirectionalIterator, BidirectionalIterator>
+    {
+        public:
+            using value_type      = typename iterator_traits<BidirectionalIterator>::value_type;
+            using difference_type = typename iterator_traits<BidirectionalIterator>::difference_type;
+            using iterator        = BidirectionalIterator;
+            using string_type     = basic_string<value_type>;
+
+            bool matched;
+
+            constexpr sub_match()
+                : pair<iterator, iterator>{}, matched{false}
+            { /* DUMMY BODY */ }
+
+            difference_type length() const
+            {
+                if (matched)
+                    return distance(this->first, this->second);
+                else
+                    return difference_type{};
+            }
+
+            operator string_type() const
+            {
+                return str();
+            }
+
+            string_type str() const
+            {
+                if (matched)
+                    return string_type{this->first, this->second};
+                else
+                    return string_type{};
+            }
+
+            int compare(const sub_match& other) const
+            {
+                return str().compare(other.str());
+            }
+
+            int compare(const string_type& str) const
+            {
+                return this->str().compare(str);
+            }
+
+            int compare(const value_type* str) const
+            {
+                return this->str().compare(str);
+            }
+    };
+
+    using csub_match  = sub_match<const char*>;
+    using wcsub_match = sub_match<const wchar_t*>;
+    using ssub_match  = sub_match<string::const_iterator>;
+    using wssub_match = sub_match<wstring::const_iterator>;
+
+    /**
+     * 28.9.2, sub_match non-member operators:
+     */
+
+    template<class BidirIt>
+    bool operator==(const sub_match<BidirIt>& lhs, const sub_match<BidirIt>& rhs)
+    {
+        return lhs.compare(rhs) == 0;
+    }
+
+    template<class BidirIt>
+    bool operator!=(const sub_match<BidirIt>& lhs, const sub_match<BidirIt>& rhs)
+    {
+        return lhs.compare(rhs) != 0;
+    }
+
+    template<class BidirIt>
+    bool operator<(const sub_match<BidirIt>& lhs, const sub_match<BidirIt>& rhs)
+    {
+        return lhs.compare(rhs) < 0;
+    }
+
+    template<class BidirIt>
+    bool operator==(const sub_match<BidirIt>& lhs,
+                    const typename sub_match<BidirIt>::value_type* rhs)
+    {
+        return lhs.compare(rhs) == 0;
+    }
+
+    template<class BidirIt>
+    bool operator==(const typename sub_match<BidirIt>::value_type* lhs,
+                    const sub_match<BidirIt>& rhs)
+    {
+        return rhs.compare(lhs) == 0;
+    }
+
+    template<class BidirIt>
+    bool operator!=(const sub_match<BidirIt>& lhs,
+                    const typename sub_match<BidirIt>::value_type* rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template<class BidirIt>
+    bool operator!=(const typename sub_match<BidirIt>::value_type* lhs,
+                    const sub_match<BidirIt>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template<class BidirIt, class ST, class SA>
+    bool operator==(const sub_match<BidirIt>& lhs,
+                    const basic_string<typename sub_match<BidirIt>::value_type, ST, SA>& rhs)
+    {
+        return lhs.compare(rhs.c_str()) == 0;
+    }
+
+    template<class BidirIt, class ST, class SA>
+    bool operator==(const basic_string<typename sub_match<BidirIt>::value_type, ST, SA>& lhs,
+                    const sub_match<BidirIt>& rhs)
+    {
+        return rhs.compare(lhs.c_str()) == 0;
+    }
+
+    template<class BidirIt, class ST, class SA>
+    bool operator!=(const sub_match<BidirIt>& lhs,
+                    const basic_string<typename sub_match<BidirIt>::value_type, ST, SA>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template<class BidirIt, class ST, class SA>
+    bool operator!=(const basic_string<typename sub_match<BidirIt>::value_type, ST, SA>& lhs,
+                    const sub_match<BidirIt>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template<class BidirectionalIterator, class Allocator>
+    class match_results;
+
+    namespace aux
+    {
+        /**
+         * Lets the matching algorithms and regex_iterator
+         * fill in the results.
+         */
+        struct match_results_access
+        {
+            template<class BidirIt, class Alloc>
+            static void set(match_results<BidirIt, Alloc>& m, BidirIt first, BidirIt last,
+                            const vector<regex_slot<BidirIt>>& slots, size_t mark_count)
+            {
+                m.subs_.clear();
+                m.subs_.resize(mark_count + 1);
+
+                for (size_t i = 0; i <= mark_count; ++i)
+                {
+                    const auto& start = slots[2 * i];
+                    const auto& end = slots[2 * i + 1];
+
+                    auto& sub = m.subs_[i];
+                    if (start.off >= 0 && end.off >= 0)
+                    {
+                        sub.first = start.pos;
+                        sub.second = end.pos;
+                        sub.matched = true;
+                    }
+                    else
+                    {
+                        sub.first = last;
+                        sub.second = last;
+                        sub.matched = false;
+                    }
+                }
+
+                m.prefix_.first = first;
+                m.prefix_.second = m.subs_[0].first;
+                m.prefix_.matched = m.prefix_.first != m.prefix_.second;
+
+                m.suffix_.first = m.subs_[0].second;
+                m.suffix_.second = last;
+                m.suffix_.matched = m.suffix_.first != m.suffix_.second;
+
+                m.unmatched_.first = last;
+                m.unmatched_.second = last;
+                m.unmatched_.matched = false;
+
+                m.base_ = first;
+                m.ready_ = true;
+            }
+
+            template<class BidirIt, class Alloc>
+            static void set_failed(match_results<BidirIt, Alloc>& m, BidirIt last)
+            {
+                m.subs_.clear();
+                m.unmatched_.first = last;
+                m.unmatched_.second = last;
+                m.unmatched_.matched = false;
+                m.ready_ = true;
+            }
+
+            template<class BidirIt, class Alloc>
+            static void set_prefix_start(match_results<BidirIt, Alloc>& m, BidirIt first)
+            {
+                m.prefix_.first = first;
+                m.prefix_.matched = m.prefix_.first != m.prefix_.second;
+            }
+
+            template<class BidirIt, class Alloc>
+            static void set_base(match_results<BidirIt, Alloc>& m, BidirIt base)
+            {
+                m.base_ = base;
+            }
+        };
+    }
+
+    /**
+     * 28.10, class template match_results:
+     */
+
+    template<class BidirectionalIterator,
+             class Allocator = allocator<sub_match<BidirectionalIterator>>>
+    class match_results
+    {
+        public:
+            using value_type      = sub_match<BidirectionalIterator>;
+            using const_reference = const value_type&;
+            using reference       = value_type&;
+            using const_iterator  = typename vector<value_type, Allocator>::const_iterator;
+            using iterator        = const_iterator;
+            using difference_type =
+                typename iterator_traits<BidirectionalIterator>::difference_type;
+            using size_type       = typename allocator_traits<Allocator>::size_type;
+            using allocator_type  = Allocator;
+            using char_type       =
+                typename iterator_traits<BidirectionalIterator>::value_type;
+            using string_type     = basic_string<char_type>;
+
+            /**
+             * 28.10.1, construct/copy/destroy:
+             */
+
+            explicit match_results(const Allocator& alloc = Allocator{})
+                : subs_{alloc}, prefix_{}, suffix_{}, unmatched_{},
+                  base_{}, ready_{false}
+            { /* DUMMY BODY */ }
+
+            match_results(const match_results&) = default;
+
+            match_results(match_results&&) noexcept = default;
+
+            match_results& operator=(const match_results&) = default;
+
+            match_results& operator=(match_results&&) = default;
+
+            ~match_results() = default;
+
+            /**
+             * 28.10.2, state:
+             */
+
+            bool ready() const
+            {
+                return ready_;
+            }
+
+            /**
+             * 28.10.3, size:
+             */
+
+            size_type size() const
+            {
+                return subs_.size();
+            }
+
+            size_type max_size() const
+            {
+                return subs_.max_size();
+            }
+
+            bool empty() const
+            {
+                return size() == 0;
+            }
+
+            /**
+             * 28.10.4, element access:
+             */
+
+            difference_type length(size_type sub = 0) const
+            {
+                return (*this)[sub].length();
+            }
+
+            difference_type position(size_type sub = 0) const
+            {
+                return distance(base_, (*this)[sub].first);
+            }
+
+            string_type str(size_type sub = 0) const
+            {
+                return (*this)[sub].str();
+            }
+
+            const_reference operator[](size_type n) const
+            {
+                if (n < subs_.size())
+                    return subs_[n];
+                else
+                    return unmatched_;
+            }
+
+            const_reference prefix() const
+            {
+                return prefix_;
+            }
+
+            const_reference suffix() const
+            {
+                return suffix_;
+            }
+
+            const_iterator begin() const
+            {
+                return subs_.begin();
+            }
+
+            const_iterator end() const
+            {
+                return subs_.end();
+            }
+
+            const_iterator cbegin() const
+            {
+                return subs_.cbegin();
+            }
+
+            const_iterator cend() const
+            {
+                return subs_.cend();
+            }
+
+            /**
+             * 28.10.6, allocator:
+             */
+
+            allocator_type get_allocator() const
+            {
+                return subs_.get_allocator();
+            }
+
+            /**
+             * 28.10.7, swap:
+             */
+
+            void swap(match_results& other)
+            {
+                std::swap(subs_, other.subs_);
+                std::swap(prefix_, other.prefix_);
+                std::swap(suffix_, other.suffix_);
+                std::swap(unmatched_, other.unmatched_);
+                std::swap(base_, other.base_);
+                std::swap(ready_, other.ready_);
+            }
+
+        private:
+            vector<value_type, Allocator> subs_;
+            value_type prefix_;
+            value_type suffix_;
+            value_type unmatched_;
+            BidirectionalIterator base_;
+            bool ready_;
+
+            friend struct aux::match_results_access;
+    };
+
+    using cmatch  = match_results<const char*>;
+    using wcmatch = match_results<const wchar_t*>;
+    using smatch  = match_results<string::const_iterator>;
+    using wsmatch = match_results<wstring::const_iterator>;
+
+    template<class BidirIt, class Alloc>
+    bool operator==(const match_results<BidirIt, Alloc>& lhs,
+                    const match_results<BidirIt, Alloc>& rhs)
+    {
+        if (!lhs.ready() && !rhs.ready())
+            return true;
+        if (lhs.empty() != rhs.empty())
+            return false;
+        if (lhs.empty())
+            return true;
+
+        if (lhs.size() != rhs.size() || lhs.prefix() != rhs.prefix() ||
+            lhs.suffix() != rhs.suffix())
+            return false;
+
+        for (size_t i = 0; i < lhs.size(); ++i)
+        {
+            if (lhs[i] != rhs[i])
+                return false;
+        }
+
+        return true;
+    }
+
+    template<class BidirIt, class Alloc>
+    bool operator!=(const match_results<BidirIt, Alloc>& lhs,
+                    const match_results<BidirIt, Alloc>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template<class BidirIt, class Alloc>
+    void swap(match_results<BidirIt, Alloc>& lhs, match_results<BidirIt, Alloc>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+}
+
+#endif
@@ -0,0 +1,369 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef LIBCPP_BITS_REGEX_PROGRAM
+#define LIBCPP_BITS_REGEX_PROGRAM
+
+#include <__bits/adt/vector.hpp>
+#include <__bits/atomic.hpp>
+#include <__bits/memory/shared_ptr.hpp>
+#include <__bits/memory/unique_ptr.hpp>
+#include <__bits/regex/regex_constants.hpp>
+#include <__bits/utility/utility.hpp>
+#include <cstdint>
+#include <cstdlib>
+
+namespace std::aux
+{
+    /**
+     * Patterns are compiled into a program for a small virtual
+     * machine (in the spirit of Thompson's construction and Pike's
+     * VM). The program operates on code units widened to uint32_t,
+     * which lets the compiler live in a single translation unit that
+     * is shared by all character types.
+     */
+
+    enum class regex_opcode: uint8_t
+    {
+        match,           // Accept.
+        chr,             // Consume the code unit x.
+        any,             // Consume anything but a line terminator.
+        cls,             // Consume a code unit from the class x.
+        split,           // Fork, x has priority over y.
+        jmp,             // Continue at x.
+        save,            // Store the position into the slot x.
+        clear,           // Reset the slots [x, y).
+        loop_check,      // Fail if the position equals the slot x.
+        bol,             // ^
+        eol,             // $
+        word_boundary,   // \b
+        nword_boundary,  // \B
+        backref,         // \x (group number)
+        look,            // Lookahead at pc + 1, x is the continuation,
+                         // y is nonzero for a negative lookahead.
+        look_end         // Accept the lookahead subprogram.
+    };
+
+    struct regex_inst
+    {
+        regex_opcode op;
+        uint32_t x;
+        uint32_t y;
+    };
+
+    /**
+     * Character classification used by the builtin classes
+     * (\d, \w, \s and the [:name:] classes). Classification is
+     * ASCII based, with the addition of the Unicode line and
+     * paragraph separators to the space class.
+     */
+
+    enum regex_ctype: uint16_t
+    {
+        regex_ctype_alnum  = 0x0001,
+        regex_ctype_alpha  = 0x0002,
+        regex_ctype_blank  = 0x0004,
+        regex_ctype_cntrl  = 0x0008,
+        regex_ctype_digit  = 0x0010,
+        regex_ctype_graph  = 0x0020,
+        regex_ctype_lower  = 0x0040,
+        regex_ctype_print  = 0x0080,
+        regex_ctype_punct  = 0x0100,
+        regex_ctype_space  = 0x0200,
+        regex_ctype_upper  = 0x0400,
+        regex_ctype_xdigit = 0x0800,
+        regex_ctype_word   = 0x1000
+    };
+
+    inline uint16_t regex_classify(uint32_t c)
+    {
+        if (c >= 0x80)
+        {
+            if (c == 0xa0 || c == 0x2028 || c == 0x2029 || c == 0xfeff)
+                return regex_ctype_space;
+            else
+                return 0;
+        }
+
+        uint16_t res{};
+        if (c < 0x20 || c == 0x7f)
+            res |= regex_ctype_cntrl;
+        else
+            res |= regex_ctype_print;
+
+        if (c == ' ' || c == '\t')
+            res |= regex_ctype_blank;
+        if (c == ' ' || (c >= '\t' && c <= '\r'))
+            res |= regex_ctype_space;
+
+        if (c >= '0' && c <= '9')
+            res |= regex_ctype_digit | regex_ctype_xdigit | regex_ctype_alnum | regex_ctype_word;
+        else if (c >= 'a' && c <= 'z')
+            res |= regex_ctype_lower | regex_ctype_alpha | regex_ctype_alnum | regex_ctype_word;
+        else if (c >= 'A' && c <= 'Z')
+            res |= regex_ctype_upper | regex_ctype_alpha | regex_ctype_alnum | regex_ctype_word;
+        else if (c == '_')
+            res |= regex_ctype_word;
+
+        if ((c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'))
+            res |= regex_ctype_xdigit;
+        if (c > ' ' && c < 0x7f)
+        {
+            res |= regex_ctype_graph;
+            if (!(res & regex_ctype_alnum))
+                res |= regex_ctype_punct;
+        }
+
+        return res;
+    }
+
+    inline bool regex_is_word(uint32_t c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+               (c >= '0' && c <= '9') || c == '_';
+    }
+
+    inline bool regex_is_line_terminator(uint32_t c)
+    {
+        return c == '\n' || c == '\r' || c == 0x2028 || c == 0x2029;
+    }
+
+    inline uint32_t regex_fold_case(uint32_t c)
+    {
+        if (c >= 'A' && c <= 'Z')
+            return c - 'A' + 'a';
+        else
+            return c;
+    }
+
+    struct regex_char_class
+    {
+        vector<pair<uint32_t, uint32_t>> ranges{};
+        uint16_t ctypes{};
+        uint16_t negated_ctypes{};
+        bool negated{};
+
+        bool matches(uint32_t c) const
+        {
+            bool res{};
+            for (const auto& range: ranges)
+            {
+                if (range.first <= c && c <= range.second)
+                {
+                    res = true;
+                    break;
+                }
+            }
+
+            if (!res && (ctypes || negated_ctypes))
+            {
+                auto type = regex_classify(c);
+                res = (type & ctypes) || (~type & negated_ctypes);
+            }
+
+            return res != negated;
+        }
+    };
+
+    class regex_dfa;
+
+    struct regex_program
+    {
+        vector<regex_inst> insts{};
+        vector<regex_char_class> classes{};
+
+        /**
+         * Slots 2n and 2n + 1 hold the bounds of the group n,
+         * the remaining slots are used by the empty loop checks.
+         */
+        size_t mark_count{};
+        size_t slot_count{};
+
+        bool icase{};
+        bool multiline{};
+
+        /**
+         * Backreferences and lookaheads can only be executed
+         * by the backtracking engine.
+         */
+        bool backtrack_only{};
+
+        /**
+         * The program rejects empty loop iterations (a quantified
+         * subexpression can match the empty string). The NFA
+         * simulation merges threads that only differ in the loop
+         * state, which can change the priority of the matches,
+         * so the submatches are extracted by backtracking.
+         */
+        bool empty_checks{};
+
+        /**
+         * Null when the pattern cannot be determinised, i.e. when
+         * it relies on backtracking, word boundaries or multiline
+         * anchors.
+         */
+        unique_ptr<regex_dfa> dfa{};
+
+        ~regex_program();
+    };
+
+    inline bool regex_inst_consumes(const regex_program& prog, const regex_inst& inst, uint32_t c)
+    {
+        switch (inst.op)
+        {
+            case regex_opcode::chr:
+                return c == inst.x;
+            case regex_opcode::any:
+                return !regex_is_line_terminator(c);
+            case regex_opcode::cls:
+                return prog.classes[inst.x].matches(c);
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * Returns null and sets err if the pattern is malformed.
+     */
+    shared_ptr<regex_program> regex_compile(
+        const uint32_t* first, const uint32_t* last,
+        regex_constants::syntax_option_type flags,
+        regex_constants::error_type& err
+    );
+
+    /**
+     * Lazily determinised automaton over bytes. States are
+     * created on demand from sets of NFA program counters
+     * and cached, when the cache grows over its limit it is
+     * flushed and construction starts anew from the current
+     * state. The cache is mutable shared state, so a matcher
+     * has to acquire it first and fall back to the NFA engine
+     * if another thread is using it.
+     */
+    class regex_dfa
+    {
+        public:
+            static constexpr int dead_state{0};
+            static constexpr int unknown_state{-1};
+
+            explicit regex_dfa(const regex_program& prog);
+
+            bool try_acquire() noexcept
+            {
+                return !busy_.test_and_set(memory_order_acquire);
+            }
+
+            void release() noexcept
+            {
+                busy_.clear(memory_order_release);
+            }
+
+            int start(bool anchored, bool at_bol);
+
+            int next(int state, unsigned char c)
+            {
+                auto idx = static_cast<size_t>(state) * class_count_ + byte_class_[c];
+                auto res = table_[idx];
+                if (res == unknown_state)
+                    res = compute_next_(state, c);
+
+                return res;
+            }
+
+            /**
+             * The state has reached a match that does
+             * not depend on the end of the input.
+             */
+            bool accepting(int state) const
+            {
+                return states_[state].accepting;
+            }
+
+            /**
+             * The state has reached a match if the input ends here.
+             */
+            bool accepting_at_end(int state, bool eol) const
+            {
+                if (eol)
+                    return states_[state].accepting_at_end;
+                else
+                    return states_[state].accepting;
+            }
+
+        private:
+            struct state_t
+            {
+                vector<uint32_t> pcs;
+                bool anchored;
+                bool at_bol;
+                bool accepting;
+                bool accepting_at_end;
+                size_t hash;
+            };
+
+            const regex_program& program_;
+            vector<state_t> states_;
+            vector<int> table_;
+            unsigned char byte_class_[256];
+            size_t class_count_;
+
+            /**
+             * Open addressing index of the states
+             * keyed by their sets of instructions.
+             */
+            vector<int> index_;
+            size_t max_states_;
+            int start_states_[4];
+            size_t flushes_;
+
+            vector<uint32_t> stack_;
+            vector<uint32_t> marks_;
+            uint32_t generation_;
+
+            atomic_flag busy_;
+
+            int compute_next_(int, unsigned char);
+            int intern_(vector<uint32_t>&, bool, bool);
+            bool equal_(const state_t&, const vector<uint32_t>&, bool, bool) const;
+            void closure_(vector<uint32_t>&, uint32_t, bool, bool);
+            void new_generation_();
+            void flush_();
+    };
+
+    /**
+     * Widens a code unit to the representation used by the program.
+     */
+    template<class Char>
+    uint32_t regex_code(Char c)
+    {
+        return static_cast<uint32_t>(static_cast<typename make_unsigned<Char>::type>(c));
+    }
+}
+
+#endif
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef LIBCPP_BITS_REGEX_CONSTANTS
+#define LIBCPP_BITS_REGEX_CONSTANTS
+
+#include <__bits/stdexcept.hpp>
+
+namespace std
+{
+    /**
+     * 28.5, namespace std::regex_constants:
+     */
+
+    namespace regex_constants
+    {
+        /**
+         * 28.5.1, bitmask type syntax_option_type:
+         */
+
+        enum syntax_option_type: unsigned int
+        {
+            icase      = 0x001,
+            nosubs     = 0x002,
+            optimize   = 0x004,
+            collate    = 0x008,
+            ECMAScript = 0x010,
+            basic      = 0x020,
+            extended   = 0x040,
+            awk        = 0x080,
+            grep       = 0x100,
+            egrep      = 0x200,
+            multiline  = 0x400
+        };
+
+        constexpr syntax_option_type operator&(syntax_option_type lhs, syntax_option_type rhs)
+        {
+            return static_cast<syntax_option_type>(
+                static_cast<unsigned int>(lhs) & static_cast<unsigned int>(rhs)
+            );
+        }
+
+        constexpr syntax_option_type operator|(syntax_option_type lhs, syntax_option_type rhs)
+        {
+            return static_cast<syntax_option_type>(
+                static_cast<unsigned int>(lhs) | static_cast<unsigned int>(rhs)
+            );
+        }
+
+        constexpr syntax_option_type operator^(syntax_option_type lhs, syntax_option_type rhs)
+        {
+            return static_cast<syntax_option_type>(
+                static_cast<unsigned int>(lhs) ^ static_cast<unsigned int>(rhs)
+            );
+        }
+
+        constexpr syntax_option_type operator~(syntax_option_type opt)
+        {
+            return static_cast<syntax_option_type>(~static_cast<unsigned int>(opt));
+        }
+
+        inline syntax_option_type& operator&=(syntax_option_type& lhs, syntax_option_type rhs)
+        {
+            return lhs = lhs & rhs;
+        }
+
+        inline syntax_option_type& operator|=(syntax_option_type& lhs, syntax_option_type rhs)
+        {
+            return lhs = lhs | rhs;
+        }
+
+        /**
+         * 28.5.2, bitmask type match_flag_type:
+         */
+
+        enum match_flag_type: unsigned int
+        {
+            match_default     = 0x000,
+            match_not_bol     = 0x001,
+            match_not_eol     = 0x002,
+            match_not_bow     = 0x004,
+            match_not_eow     = 0x008,
+            match_any         = 0x010,
+            match_not_null    = 0x020,
+            match_continuous  = 0x040,
+            match_prev_avail  = 0x080,
+            format_default    = 0x000,
+            format_sed        = 0x100,
+            format_no_copy    = 0x200,
+            format_first_only = 0x400
+        };
+
+        constexpr match_flag_type operator&(match_flag_type lhs, match_flag_type rhs)
+        {
+            return static_cast<match_flag_type>(
+                static_cast<unsigned int>(lhs) & static_cast<unsigned int>(rhs)
+            );
+        }
+
+        constexpr match_flag_type operator|(match_flag_type lhs, match_flag_type rhs)
+        {
+            return static_cast<match_flag_type>(
+                static_cast<unsigned int>(lhs) | static_cast<unsigned int>(rhs)
+            );
+        }
+
+        constexpr match_flag_type operator^(match_flag_type lhs, match_flag_type rhs)
+        {
+            return static_cast<match_flag_type>(
+                static_cast<unsigned int>(lhs) ^ static_cast<unsigned int>(rhs)
+            );
+        }
+
+        constexpr match_flag_type operator~(match_flag_type flag)
+        {
+            return static_cast<match_flag_type>(~static_cast<unsigned int>(flag));
+        }
+
+        inline match_flag_type& operator&=(match_flag_type& lhs, match_flag_type rhs)
+        {
+            return lhs = lhs & rhs;
+        }
+
+        inline match_flag_type& operator|=(match_flag_type& lhs, match_flag_type rhs)
+        {
+            return lhs = lhs | rhs;
+        }
+
+        /**
+         * 28.5.3, implementation defined error_type:
+         */
+
+        enum error_type
+        {
+            error_collate,
+            error_ctype,
+            error_escape,
+            error_backref,
+            error_brack,
+            error_paren,
+            error_brace,
+            error_badbrace,
+            error_range,
+            error_space,
+            error_badrepeat,
+            error_complexity,
+            error_stack
+        };
+    }
+
+    /**
+     * 28.6, class regex_error:
+     */
+
+    class regex_error: public runtime_error
+    {
+        public:
+            explicit regex_error(regex_constants::error_type ecode);
+
+            regex_constants::error_type code() const;
+
+        private:
+            regex_constants::error_type code_;
+    };
+}
+
+#endif
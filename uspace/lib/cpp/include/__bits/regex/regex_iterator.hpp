@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef LIBCPP_BITS_REGEX_REGEX_ITERATOR
+#define LIBCPP_BITS_REGEX_REGEX_ITERATOR
+
+#include <__bits/iterator.hpp>
+#include <__bits/regex/algorithms.hpp>
+#include <__bits/regex/basic_regex.hpp>
+#include <__bits/regex/match_results.hpp>
+
+namespace std
+{
+    /**
+     * 28.12.1, class template regex_iterator:
+     */
+
+    template<class BidirectionalIterator,
+             class Char = typename iterator_traits<BidirectionalIterator>::value_type,
+             class Traits = regex_traits<Char>>
+    class regex_iterator
+    {
+        public:
+            using regex_type        = basic_regex<Char, Traits>;
+            using value_type        = match_results<BidirectionalIterator>;
+            using difference_type   = ptrdiff_t;
+            using pointer           = const value_type*;
+            using reference         = const value_type&;
+            using iterator_category = forward_iterator_tag;
+
+            regex_iterator()
+                : begin_{}, end_{}, regex_{}, flags_{}, match_{}
+            { /* DUMMY BODY */ }
+
+            regex_iterator(BidirectionalIterator first, BidirectionalIterator last,
+                           const regex_type& re,
+                           regex_constants::match_flag_type flags = regex_constants::match_default)
+                : begin_{first}, end_{last}, regex_{&re}, flags_{flags}, match_{}
+            {
+                if (!regex_search(begin_, end_, match_, *regex_, flags_))
+                    regex_ = nullptr;
+            }
+
+            regex_iterator(BidirectionalIterator, BidirectionalIterator, const regex_type&&,
+                           regex_constants::match_flag_type = regex_constants::match_default) = delete;
+
+            regex_iterator(const regex_iterator&) = default;
+
+            regex_iterator& operator=(const regex_iterator&) = default;
+
+            bool operator==(const regex_iterator& other) const
+            {
+                if (!regex_ || !other.regex_)
+                    return regex_ == other.regex_;
+
+                return begin_ == other.begin_ && end_ == other.end_ &&
+                       regex_ == other.regex_ && flags_ == other.flags_ &&
+                       match_[0] == other.match_[0];
+            }
+
+            bool operator!=(const regex_iterator& other) const
+            {
+                return !(*this == other);
+            }
+
+            reference operator*() const
+            {
+                return match_;
+            }
+
+            pointer operator->() const
+            {
+                return &match_;
+            }
+
+            regex_iterator& operator++()
+            {
+                auto start = match_[0].second;
+                auto prefix_start = start;
+
+                if (match_[0].matched && match_[0].first == match_[0].second)
+                {
+                    /**
+                     * An empty match, try a non empty one at the
+                     * same position before moving on.
+                     */
+                    if (start == end_)
+                    {
+                        regex_ = nullptr;
+
+                        return *this;
+                    }
+
+                    auto flags = flags_ | regex_constants::match_not_null |
+                                 regex_constants::match_continuous |
+                                 regex_constants::match_prev_avail;
+                    if (regex_search(start, end_, match_, *regex_, flags))
+                    {
+                        fix_match_(prefix_start);
+
+                        return *this;
+                    }
+
+                    ++start;
+                }
+
+                flags_ |= regex_constants::match_prev_avail;
+                if (regex_search(start, end_, match_, *regex_, flags_))
+                    fix_match_(prefix_start);
+                else
+                    regex_ = nullptr;
+
+                return *this;
+            }
+
+            regex_iterator operator++(int)
+            {
+                auto tmp = *this;
+                ++(*this);
+
+                return tmp;
+            }
+
+        private:
+            BidirectionalIterator begin_;
+            BidirectionalIterator end_;
+            const regex_type* regex_;
+            regex_constants::match_flag_type flags_;
+            value_type match_;
+
+            /**
+             * The prefix of the match starts at the end of the previous
+             * one and positions are relative to the original sequence.
+             */
+            void fix_match_(BidirectionalIterator prefix_start)
+            {
+                aux::match_results_access::set_prefix_start(match_, prefix_start);
+                aux::match_results_access::set_base(match_, begin_);
+            }
+    };
+
+    using cregex_iterator  = regex_iterator<const char*>;
+    using wcregex_iterator = regex_iterator<const wchar_t*>;
+    using sregex_iterator  = regex_iterator<string::const_iterator>;
+    using wsregex_iterator = regex_iterator<wstring::const_iterator>;
+}
+
+#endif
@@ -480,6 +480,7 @@ namespace std
                  */
                 data_ = allocator_.allocate(default_capacity_);
                 capacity_ = default_capacity_;
+                ensure_null_terminator_();
             }
 
             basic_string(const basic_string& other)
@@ -520,7 +521,7 @@ namespace std
             }
 
             basic_string(size_type n, value_type c, const allocator_type& alloc = allocator_type{})
-                : data_{}, size_{n}, capacity_{n}, allocator_{alloc}
+                : data_{}, size_{n}, capacity_{n + 1}, allocator_{alloc}
             {
                 data_ = allocator_.allocate(capacity_);
                 for (size_type i = 0; i < size_; ++i)
@@ -536,7 +537,7 @@ namespace std
                 if constexpr (is_integral<InputIterator>::value)
                 { // Required by the standard.
                     size_ = static_cast<size_type>(first);
-                    capacity_ = size_;
+                    capacity_ = size_ + 1;
                     data_ = allocator_.allocate(capacity_);
 
                     for (size_type i = 0; i < size_; ++i)
@@ -92,6 +92,20 @@ namespace std::test
             ~array_test() = default;
     };
 
+    class atomic_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+
+        private:
+            void test_integral();
+            void test_pointer();
+            void test_generic();
+            void test_flag();
+            void test_wait_notify();
+    };
+
     class vector_test: public test_suite
     {
         public:
@@ -107,6 +121,22 @@ namespace std::test
             void test_erase();
     };
 
+    class regex_test: public test_suite
+    {
+        public:
+            bool run(bool) override;
+            const char* name() override;
+
+        private:
+            void test_match();
+            void test_search();
+            void test_captures();
+            void test_assertions();
+            void test_iterator();
+            void test_engines();
+            void test_errors();
+    };
+
     class string_test: public test_suite
     {
         public:
@@ -293,6 +323,7 @@ namespace std::test
         private:
             void test_non_modifying();
             void test_mutating();
+            void test_sorting();
     };
 
     class future_test: public test_suite
@@ -31,6 +31,7 @@
 #include <array>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace std::test
 {
@@ -41,6 +42,7 @@ namespace std::test
 
         test_non_modifying();
         test_mutating();
+        test_sorting();
 
         return end();
     }
@@ -293,4 +295,99 @@ namespace std::test
         );
         test_eq("transform pt2", res6, data10.end());
     }
+
+    void algorithm_test::test_sorting()
+    {
+        auto check1 = {1, 2, 3, 4, 5, 6, 7};
+        std::array<int, 7> data1{4, 2, 7, 1, 6, 3, 5};
+        std::sort(data1.begin(), data1.end());
+        test_eq(
+            "sort small",
+            check1.begin(), check1.end(),
+            data1.begin(), data1.end()
+        );
+
+        /**
+         * Large enough to go through partitioning and
+         * not just through the insertion sort.
+         */
+        std::vector<int> data2{};
+        for (int i = 0; i < 1000; ++i)
+            data2.push_back((i * 7919) % 1000);
+        std::sort(data2.begin(), data2.end());
+        test("sort random", std::is_sorted(data2.begin(), data2.end()));
+        test_eq("sort random front", data2.front(), 0);
+        test_eq("sort random back", data2.back(), 999);
+
+        std::vector<int> data3{};
+        for (int i = 1000; i > 0; --i)
+            data3.push_back(i);
+        std::sort(data3.begin(), data3.end(), [](auto lhs, auto rhs){
+            return lhs > rhs;
+        });
+        test("sort comparator", std::is_sorted(
+            data3.begin(), data3.end(),
+            [](auto lhs, auto rhs){ return lhs > rhs; }
+        ));
+
+        std::vector<int> data4{};
+        for (int i = 0; i < 1000; ++i)
+            data4.push_back((i * 7919) % 3);
+        std::sort(data4.begin(), data4.end());
+        test("sort duplicates", std::is_sorted(data4.begin(), data4.end()));
+        test_eq("sort duplicates count", std::count(data4.begin(), data4.end(), 1), 333);
+
+        std::vector<std::pair<int, int>> data5{};
+        for (int i = 0; i < 1000; ++i)
+            data5.emplace_back((i * 7919) % 10, i);
+        std::stable_sort(
+            data5.begin(), data5.end(),
+            [](const auto& lhs, const auto& rhs){
+                return lhs.first < rhs.first;
+            }
+        );
+        test("stable_sort", std::is_sorted(data5.begin(), data5.end()));
+
+        auto check2 = {0, 1, 2, 3, 4};
+        std::vector<int> data6{};
+        for (int i = 0; i < 100; ++i)
+            data6.push_back((i * 37) % 100);
+        std::partial_sort(data6.begin(), data6.begin() + 5, data6.end());
+        test_eq(
+            "partial_sort",
+            check2.begin(), check2.end(),
+            data6.begin(), data6.begin() + 5
+        );
+
+        std::vector<int> data7{};
+        for (int i = 0; i < 1000; ++i)
+            data7.push_back((i * 7919) % 1000);
+        auto nth = data7.begin() + 500;
+        std::nth_element(data7.begin(), nth, data7.end());
+        test_eq("nth_element pt1", *nth, 500);
+        test("nth_element pt2", std::all_of(
+            data7.begin(), nth,
+            [](auto x){ return x < 500; }
+        ));
+        test("nth_element pt3", std::all_of(
+            nth, data7.end(),
+            [](auto x){ return x >= 500; }
+        ));
+
+        auto check3 = {3, 4, 5, 1, 2};
+        std::array<int, 5> data8{1, 2, 3, 4, 5};
+        auto res1 = std::rotate(data8.begin(), data8.begin() + 2, data8.end());
+        test_eq(
+            "rotate pt1",
+            check3.begin(), check3.end(),
+            data8.begin(), data8.end()
+        );
+        test_eq("rotate pt2", res1, data8.begin() + 3);
+
+        std::array<int, 6> data9{1, 2, 2, 2, 3, 4};
+        auto res2 = std::lower_bound(data9.begin(), data9.end(), 2);
+        auto res3 = std::upper_bound(data9.begin(), data9.end(), 2);
+        test_eq("lower_bound", res2, data9.begin() + 1);
+        test_eq("upper_bound", res3, data9.begin() + 4);
+    }
 }
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <__bits/test/tests.hpp>
+#include <atomic>
+#include <thread>
+
+namespace std::test
+{
+    namespace
+    {
+        struct large_t
+        {
+            int data[8];
+        };
+    }
+
+    bool atomic_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_integral();
+        test_pointer();
+        test_generic();
+        test_flag();
+        test_wait_notify();
+
+        return end();
+    }
+
+    const char* atomic_test::name()
+    {
+        return "atomic";
+    }
+
+    void atomic_test::test_integral()
+    {
+        std::atomic<int> a1{5};
+        test_eq("load", a1.load(), 5);
+        test("is_lock_free", a1.is_lock_free());
+
+        a1.store(7, std::memory_order_relaxed);
+        test_eq("store", a1.load(std::memory_order_relaxed), 7);
+
+        auto res1 = a1.exchange(10);
+        test_eq("exchange pt1", res1, 7);
+        test_eq("exchange pt2", (int)a1, 10);
+
+        int expected{3};
+        auto res2 = a1.compare_exchange_strong(expected, 20);
+        test("compare_exchange_strong failure pt1", !res2);
+        test_eq("compare_exchange_strong failure pt2", expected, 10);
+
+        auto res3 = a1.compare_exchange_strong(expected, 20);
+        test("compare_exchange_strong success pt1", res3);
+        test_eq("compare_exchange_strong success pt2", a1.load(), 20);
+
+        test_eq("fetch_add pt1", a1.fetch_add(5), 20);
+        test_eq("fetch_add pt2", a1.load(), 25);
+        test_eq("fetch_sub", a1.fetch_sub(5), 25);
+        test_eq("operator++ pre", ++a1, 21);
+        test_eq("operator++ post", a1++, 21);
+        test_eq("operator--", --a1, 21);
+        test_eq("operator+=", a1 += 9, 30);
+
+        std::atomic<unsigned int> a2{0b1100};
+        test_eq("fetch_and", a2.fetch_and(0b0100), 0b1100U);
+        test_eq("fetch_or", a2.fetch_or(0b0011), 0b0100U);
+        test_eq("fetch_xor", a2.fetch_xor(0b0001), 0b0111U);
+        test_eq("bitwise result", a2.load(), 0b0110U);
+
+        std::atomic<long> a3{};
+        std::atomic_store(&a3, 42L);
+        test_eq("free functions pt1", std::atomic_load(&a3), 42L);
+        test_eq("free functions pt2", std::atomic_fetch_add(&a3, 1L), 42L);
+        test_eq("free functions pt3", a3.load(), 43L);
+    }
+
+    void atomic_test::test_pointer()
+    {
+        int data[4]{1, 2, 3, 4};
+        std::atomic<int*> a1{data};
+
+        test_eq("pointer fetch_add pt1", a1.fetch_add(2), &data[0]);
+        test_eq("pointer fetch_add pt2", a1.load(), &data[2]);
+        test_eq("pointer operator--", --a1, &data[1]);
+        test_eq("pointer operator+=", a1 += 2, &data[3]);
+        test_eq("pointer deref", *a1.load(), 4);
+    }
+
+    void atomic_test::test_generic()
+    {
+        std::atomic<bool> a1{false};
+        test("bool pt1", !a1.load());
+        test("bool pt2", !a1.exchange(true));
+        test("bool pt3", a1.load());
+
+        large_t value{{1, 2, 3, 4, 5, 6, 7, 8}};
+        std::atomic<large_t> a2{value};
+        test("large is not lock free", !a2.is_lock_free());
+        test_eq("large load", a2.load().data[7], 8);
+
+        large_t expected = value;
+        large_t desired = value;
+        desired.data[0] = 10;
+        auto res1 = a2.compare_exchange_strong(expected, desired);
+        test("large compare_exchange pt1", res1);
+        test_eq("large compare_exchange pt2", a2.load().data[0], 10);
+
+        auto res2 = a2.compare_exchange_strong(expected, desired);
+        test("large compare_exchange pt3", !res2);
+        test_eq("large compare_exchange pt4", expected.data[0], 10);
+    }
+
+    void atomic_test::test_flag()
+    {
+        std::atomic_flag flag = ATOMIC_FLAG_INIT;
+
+        test("flag pt1", !flag.test_and_set());
+        test("flag pt2", flag.test_and_set());
+        flag.clear();
+        test("flag pt3", !flag.test());
+        test("flag pt4", !std::atomic_flag_test_and_set(&flag));
+    }
+
+    void atomic_test::test_wait_notify()
+    {
+        std::atomic<int> a1{0};
+
+        // Value already differs, must not block.
+        a1.wait(1);
+        test("wait on different value", true);
+
+        std::thread thr{[&a1](){
+            a1.store(1);
+            a1.notify_all();
+        }};
+
+        a1.wait(0);
+        test_eq("wait until notified", a1.load(), 1);
+
+        thr.join();
+    }
+}
@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <__bits/test/tests.hpp>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace std::test
+{
+    bool regex_test::run(bool report)
+    {
+        report_ = report;
+        start();
+
+        test_match();
+        test_search();
+        test_captures();
+        test_assertions();
+        test_iterator();
+        test_engines();
+        test_errors();
+
+        return end();
+    }
+
+    const char* regex_test::name()
+    {
+        return "regex";
+    }
+
+    void regex_test::test_match()
+    {
+        std::regex re1{"abc"};
+        test("literal", std::regex_match("abc", re1));
+        test("literal partial", !std::regex_match("abcd", re1));
+
+        std::regex re2{"a[b-d]+e?"};
+        test("class and plus", std::regex_match("abdc", re2));
+        test("optional", std::regex_match("abde", re2));
+        test("class mismatch", !std::regex_match("aee", re2));
+
+        std::regex re3{"(?:ab|cd){2,3}"};
+        test("counted pt1", std::regex_match("abcd", re3));
+        test("counted pt2", std::regex_match("abcdab", re3));
+        test("counted pt3", !std::regex_match("ab", re3));
+        test("counted pt4", !std::regex_match("abababab", re3));
+
+        std::regex re4{"a|ab"};
+        test("full match tries all alternatives", std::regex_match("ab", re4));
+
+        std::regex re5{"\\d{4}-\\d\\d-\\d\\d \\w+\\s[^ ]*"};
+        test("builtin classes", std::regex_match("2026-10-17 INFO\tx/y", re5));
+
+        std::regex re6{"[[:upper:]][[:alpha:]]*"};
+        test("named classes pt1", std::regex_match("Hello", re6));
+        test("named classes pt2", !std::regex_match("hello", re6));
+
+        std::regex re7{"hello world", std::regex::icase};
+        test("icase", std::regex_match("HeLLo WORLD", re7));
+
+        std::regex re8{"[a-c]+", std::regex::icase};
+        test("icase class", std::regex_match("AbC", re8));
+
+        std::regex re9{"a.c"};
+        test("dot", std::regex_match("a-c", re9));
+        test("dot does not match newline", !std::regex_match("a\nc", re9));
+
+        std::regex re10{""};
+        test("empty pattern", std::regex_match("", re10));
+
+        std::string str{"x=\\x41\\u0042"};
+        std::regex re11{"x=\\\\x41\\\\u0042"};
+        test("escapes", std::regex_match(str, re11));
+        std::regex re12{"\\x41\\u0042\\t"};
+        test("hex escapes", std::regex_match("AB\t", re12));
+    }
+
+    void regex_test::test_search()
+    {
+        std::regex re1{"b+"};
+        std::cmatch m1{};
+        auto res1 = std::regex_search("aabbbcc", m1, re1);
+        test("search", res1);
+        test_eq("search position", m1.position(), 2L);
+        test_eq("search length", m1.length(), 3L);
+        test("search prefix", m1.prefix() == "aa");
+        test("search suffix", m1.suffix() == "cc");
+
+        std::regex re2{"a|ab"};
+        std::cmatch m2{};
+        std::regex_search("xab", m2, re2);
+        test("leftmost first", m2[0] == "a");
+
+        std::regex re3{"<.+>"};
+        std::regex re4{"<.+?>"};
+        std::string str{"<a><b>"};
+        std::smatch m3{};
+        std::regex_search(str, m3, re3);
+        test("greedy", m3.str() == "<a><b>");
+        std::regex_search(str, m3, re4);
+        test("lazy", m3.str() == "<a>");
+
+        std::regex re5{"error", std::regex::icase};
+        test("search no match", !std::regex_search("all good", re5));
+        test("search icase", std::regex_search("[ERROR] disk", re5));
+
+        std::regex re6{"x*"};
+        std::cmatch m4{};
+        test("empty match", std::regex_search("abc", m4, re6));
+        test_eq("empty match position", m4.position(), 0L);
+        test_eq("empty match length", m4.length(), 0L);
+
+        std::regex re7{"^b"};
+        test("anchor search", !std::regex_search("ab", re7));
+        test("match_not_bol", !std::regex_search("ba", re7, std::regex_constants::match_not_bol));
+
+        std::regex re8{"b"};
+        test("match_continuous", !std::regex_search("ab", re8, std::regex_constants::match_continuous));
+    }
+
+    void regex_test::test_captures()
+    {
+        std::regex re1{"(\\w+)@(\\w+)\\.com"};
+        std::smatch m1{};
+        std::string str1{"mail: user@example.com."};
+        auto res1 = std::regex_search(str1, m1, re1);
+        test("captures", res1);
+        test_eq("mark_count", re1.mark_count(), 2U);
+        test_eq("captures size", m1.size(), 3UL);
+        test("capture pt1", m1[1] == "user");
+        test("capture pt2", m1[2] == "example");
+        test_eq("capture position", m1.position(2), 11L);
+
+        std::regex re2{"(a)|(b)"};
+        std::cmatch m2{};
+        std::regex_search("b", m2, re2);
+        test("unmatched group", !m2[1].matched);
+        test("matched group", m2[2].matched);
+
+        std::regex re3{"(?:(a)|b)+"};
+        std::cmatch m3{};
+        std::regex_match("ab", m3, re3);
+        test("captures reset per iteration", !m3[1].matched);
+
+        std::regex re4{"(a+)b\\1"};
+        test("backref pt1", std::regex_match("aabaa", re4));
+        test("backref pt2", !std::regex_match("aaba", re4));
+
+        std::regex re5{"(a)\\1", std::regex::icase};
+        test("backref icase", std::regex_match("aA", re5));
+
+        std::regex re6{"(a)(b)", std::regex::nosubs};
+        std::cmatch m4{};
+        std::regex_match("ab", m4, re6);
+        test_eq("nosubs", m4.size(), 1UL);
+
+        std::regex re7{"(a*)*"};
+        std::cmatch m5{};
+        test("nullable loop", std::regex_match("aa", m5, re7));
+        test("nullable loop capture", m5[1] == "aa");
+    }
+
+    void regex_test::test_assertions()
+    {
+        std::regex re1{"\\bcat\\b"};
+        test("word boundary pt1", std::regex_search("a cat!", re1));
+        test("word boundary pt2", !std::regex_search("concat", re1));
+
+        std::regex re2{"\\Bcat"};
+        test("not word boundary", std::regex_search("concat", re2));
+
+        std::regex re3{"^line$", std::regex::multiline};
+        test("multiline", std::regex_search("first\nline\nlast", re3));
+        std::regex re4{"^line$"};
+        test("no multiline", !std::regex_search("first\nline\nlast", re4));
+
+        std::regex re5{"foo(?=bar)"};
+        std::cmatch m1{};
+        test("lookahead pt1", std::regex_search("foobar", m1, re5));
+        test_eq("lookahead pt2", m1.length(), 3L);
+        test("lookahead pt3", !std::regex_search("foobaz", re5));
+
+        std::regex re6{"foo(?!bar)"};
+        test("negative lookahead pt1", std::regex_search("foobaz", re6));
+        test("negative lookahead pt2", !std::regex_search("foobar", re6));
+
+        std::regex re7{"a$"};
+        test("end anchor pt1", std::regex_search("ba", re7));
+        test("end anchor pt2", !std::regex_search("ab", re7));
+        test("match_not_eol", !std::regex_search("ba", re7, std::regex_constants::match_not_eol));
+    }
+
+    void regex_test::test_iterator()
+    {
+        std::string str{"id=1, id=22, id=333"};
+        std::regex re1{"id=(\\d+)"};
+
+        std::vector<std::string> found{};
+        std::vector<long> positions{};
+        auto end = std::sregex_iterator{};
+        for (auto it = std::sregex_iterator{str.begin(), str.end(), re1}; it != end; ++it)
+        {
+            found.push_back((*it)[1].str());
+            positions.push_back(it->position());
+        }
+
+        std::vector<std::string> check1{"1", "22", "333"};
+        std::vector<long> check2{0L, 6L, 13L};
+        test_eq("iterator", found.begin(), found.end(), check1.begin(), check1.end());
+        test_eq("iterator positions", positions.begin(), positions.end(),
+                check2.begin(), check2.end());
+
+        const char* text = "abc";
+        std::regex re2{"x*"};
+        size_t count{};
+        for (auto it = std::cregex_iterator{text, text + 3, re2}; it != std::cregex_iterator{}; ++it)
+            ++count;
+        test_eq("empty matches", count, 4UL);
+    }
+
+    void regex_test::test_engines()
+    {
+        /**
+         * All engines have to agree on both
+         * the match and the submatches.
+         */
+        const char* patterns[] = {
+            "(a|ab)(c|bcd)(d*)", "(a+)(b+)?c", "([a-z]+)([0-9]*)",
+            "(x?)*y", "a{2,4}?(a*)", "((a)|b)+", "(\\d+)\\.(\\d+)",
+            "^(.*)$", "[^a-c]+(.)"
+        };
+        const char* inputs[] = {
+            "abcd", "xaabbc", "abc123def", "xxy", "aaaaa",
+            "abab", "v1.25", "", "abcdefg", "zzz"
+        };
+
+        bool agree{true};
+        for (auto pattern: patterns)
+        {
+            std::regex re{pattern};
+            for (auto input: inputs)
+            {
+                auto len = std::char_traits<char>::length(input);
+                for (bool full: {false, true})
+                {
+                    std::cmatch m1{}, m2{}, m3{};
+                    auto res1 = std::aux::regex_run(input, input + len, m1, re,
+                        std::regex_constants::match_default, full,
+                        std::aux::regex_engine::automatic);
+                    auto res2 = std::aux::regex_run(input, input + len, m2, re,
+                        std::regex_constants::match_default, full,
+                        std::aux::regex_engine::nfa);
+                    auto res3 = std::aux::regex_run(input, input + len, m3, re,
+                        std::regex_constants::match_default, full,
+                        std::aux::regex_engine::backtrack);
+
+                    if (res1 != res2 || res2 != res3 || (res1 && (m1 != m2 || m2 != m3)))
+                        agree = false;
+                }
+            }
+        }
+        test("engines agree", agree);
+    }
+
+    void regex_test::test_errors()
+    {
+        const char* patterns[] = {
+            "(a", "a)", "[a", "a{2", "a{3,2}", "*a", "a**", "\\", "[b-a]",
+            "(a)\\2", "[[:nope:]]"
+        };
+
+        bool all_thrown{true};
+        for (auto pattern: patterns)
+        {
+            std::aux::exception_thrown = false;
+            std::regex re{pattern};
+
+            if (!std::aux::exception_thrown || re.mark_count() != 0)
+                all_thrown = false;
+        }
+        std::aux::exception_thrown = false;
+        test("invalid patterns", all_thrown);
+
+        std::regex re1{"ok"};
+        re1.assign("(bad");
+        std::aux::exception_thrown = false;
+        test("failed assign keeps the regex", std::regex_match("ok", re1));
+
+        std::regex_error err{std::regex_constants::error_paren};
+        test("regex_error code", err.code() == std::regex_constants::error_paren);
+    }
+}
@@ -29,6 +29,7 @@
 #include <__bits/test/tests.hpp>
 #include <algorithm>
 #include <initializer_list>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -189,6 +190,25 @@ namespace std::test
             vec6.begin(), vec6.end(),
             check3.begin(), check3.end()
         );
+
+        auto check4 = {5, 1, 2, 3, 4, 5};
+        std::vector<int> vec7{1, 2, 3, 4, 5};
+        vec7.reserve(10);
+        auto data = vec7.data();
+        vec7.insert(vec7.begin(), vec7[4]);
+        test_eq(
+            "insert of own element in place",
+            vec7.begin(), vec7.end(),
+            check4.begin(), check4.end()
+        );
+        test_eq("insert within capacity keeps storage", vec7.data(), data);
+
+        std::vector<std::string> vec8{"a", "b", "c"};
+        vec8.shrink_to_fit();
+        vec8.insert(vec8.begin() + 1, vec8[0]);
+        vec8.insert(vec8.begin() + 1, vec8[3]);
+        test_eq("insert of own element with reallocation", vec8[1], std::string{"c"});
+        test_eq("insert of own element not moved from", vec8[2], std::string{"a"});
     }
 
     void vector_test::test_erase()
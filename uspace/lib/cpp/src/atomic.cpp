@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <__bits/thread/threading.hpp>
+#include <atomic>
+#include <cstdint>
+
+namespace std::aux
+{
+    namespace
+    {
+        /**
+         * Both the locks for atomics that are not lock-free
+         * and the wait queues are hashed by address, the
+         * count is a power of two.
+         */
+        constexpr size_t atomic_pool_size{16};
+
+        size_t atomic_pool_index(const volatile void* addr) noexcept
+        {
+            auto key = reinterpret_cast<uintptr_t>(addr);
+
+            // Objects close to each other should not collide.
+            return ((key >> 4) ^ (key >> 12)) & (atomic_pool_size - 1);
+        }
+
+        bool atomic_locks[atomic_pool_size]{};
+
+        struct atomic_wait_queue
+        {
+            atomic_wait_queue()
+                : mtx{}, cv{}, waiters{}
+            {
+                threading::mutex::init(mtx);
+                threading::condvar::init(cv);
+            }
+
+            mutex_t mtx;
+            condvar_t cv;
+            long waiters;
+        };
+
+        atomic_wait_queue atomic_wait_queues[atomic_pool_size]{};
+    }
+
+    void atomic_lock(const volatile void* addr) noexcept
+    {
+        auto& lock = atomic_locks[atomic_pool_index(addr)];
+
+        /**
+         * Note: The critical sections only copy the value and
+         *       never block, so there is no point in sleeping.
+         */
+        while (__atomic_test_and_set(&lock, __ATOMIC_ACQUIRE))
+        {
+            while (__atomic_load_n(&lock, __ATOMIC_RELAXED))
+            { /* DUMMY BODY */ }
+        }
+    }
+
+    void atomic_unlock(const volatile void* addr) noexcept
+    {
+        __atomic_clear(&atomic_locks[atomic_pool_index(addr)], __ATOMIC_RELEASE);
+    }
+
+    void atomic_wait_address(const volatile void* addr,
+                             atomic_wait_pred_t pred,
+                             const void* arg) noexcept
+    {
+        auto& queue = atomic_wait_queues[atomic_pool_index(addr)];
+
+        /**
+         * Announce ourselves before checking the value, the
+         * notifier checks for waiters after it changed the
+         * value, so one of us always sees the other.
+         */
+        __atomic_add_fetch(&queue.waiters, 1, __ATOMIC_SEQ_CST);
+
+        threading::mutex::lock(queue.mtx);
+        while (pred(arg))
+            threading::condvar::wait(queue.cv, queue.mtx);
+        threading::mutex::unlock(queue.mtx);
+
+        __atomic_sub_fetch(&queue.waiters, 1, __ATOMIC_RELAXED);
+    }
+
+    void atomic_notify_address(const volatile void* addr, bool) noexcept
+    {
+        auto& queue = atomic_wait_queues[atomic_pool_index(addr)];
+
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&queue.waiters, __ATOMIC_RELAXED) == 0)
+            return;
+
+        /**
+         * The queue is shared by all addresses hashing into
+         * it, waking just one waiter could wake the wrong one,
+         * so notify_one wakes everybody as well.
+         */
+        threading::mutex::lock(queue.mtx);
+        threading::condvar::broadcast(queue.cv);
+        threading::mutex::unlock(queue.mtx);
+    }
+}
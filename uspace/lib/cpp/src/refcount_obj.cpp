@@ -30,20 +30,30 @@
 
 namespace std::aux
 {
-    void refcount_obj::increment()
+    /**
+     * Taking a new reference requires an existing one, so
+     * there is nothing to order the increments with. The
+     * decrements release our writes to the object and the
+     * one that drops the last reference acquires them all
+     * before the object gets destroyed.
+     */
+
+    void refcount_obj::increment() noexcept
     {
-        __atomic_add_fetch(&refcount_, 1, __ATOMIC_ACQ_REL);
+        refcount_.fetch_add(1, memory_order_relaxed);
     }
 
-    void refcount_obj::increment_weak()
+    void refcount_obj::increment_weak() noexcept
     {
-        __atomic_add_fetch(&weak_refcount_, 1, __ATOMIC_ACQ_REL);
+        weak_refcount_.fetch_add(1, memory_order_relaxed);
     }
 
-    bool refcount_obj::decrement()
+    bool refcount_obj::decrement() noexcept
     {
-        if (__atomic_sub_fetch(&refcount_, 1, __ATOMIC_ACQ_REL) == 0)
+        if (refcount_.fetch_sub(1, memory_order_release) == 1)
         {
+            atomic_thread_fence(memory_order_acquire);
+
             /**
              * First call to destroy() will delete the held object,
              * so it doesn't matter what the weak_refcount_ is,
@@ -57,22 +67,29 @@ namespace std::aux
             return false;
     }
 
-    bool refcount_obj::decrement_weak()
+    bool refcount_obj::decrement_weak() noexcept
     {
-        return __atomic_sub_fetch(&weak_refcount_, 1, __ATOMIC_ACQ_REL) == 0 && refs() == 0;
+        if (weak_refcount_.fetch_sub(1, memory_order_release) == 1)
+        {
+            atomic_thread_fence(memory_order_acquire);
+
+            return refs() == 0;
+        }
+        else
+            return false;
     }
 
-    refcount_t refcount_obj::refs() const
+    refcount_t refcount_obj::refs() const noexcept
     {
-        return __atomic_load_n(&refcount_, __ATOMIC_RELAXED);
+        return refcount_.load(memory_order_relaxed);
     }
 
-    refcount_t refcount_obj::weak_refs() const
+    refcount_t refcount_obj::weak_refs() const noexcept
     {
-        return __atomic_load_n(&weak_refcount_, __ATOMIC_RELAXED);
+        return weak_refcount_.load(memory_order_relaxed);
     }
 
-    bool refcount_obj::expired() const
+    bool refcount_obj::expired() const noexcept
     {
         return refs() == 0;
     }
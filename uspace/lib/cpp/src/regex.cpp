@@ -0,0 +1,1414 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <regex>
+#include <vector>
+
+namespace std
+{
+    namespace
+    {
+        const char* regex_error_message(regex_constants::error_type ecode)
+        {
+            switch (ecode)
+            {
+                case regex_constants::error_collate:
+                    return "invalid collating element name";
+                case regex_constants::error_ctype:
+                    return "invalid character class name";
+                case regex_constants::error_escape:
+                    return "invalid escaped character or trailing escape";
+                case regex_constants::error_backref:
+                    return "invalid back reference";
+                case regex_constants::error_brack:
+                    return "mismatched [ and ]";
+                case regex_constants::error_paren:
+                    return "mismatched ( and )";
+                case regex_constants::error_brace:
+                    return "mismatched { and }";
+                case regex_constants::error_badbrace:
+                    return "invalid range in a {} expression";
+                case regex_constants::error_range:
+                    return "invalid character range";
+                case regex_constants::error_space:
+                    return "insufficient memory to compile the regular expression";
+                case regex_constants::error_badrepeat:
+                    return "repeat specifier not preceded by a valid expression";
+                case regex_constants::error_complexity:
+                    return "regular expression is too complex";
+                case regex_constants::error_stack:
+                    return "insufficient memory to match the regular expression";
+                default:
+                    return "unknown regex error";
+            }
+        }
+    }
+
+    regex_error::regex_error(regex_constants::error_type ecode)
+        : runtime_error{regex_error_message(ecode)}, code_{ecode}
+    { /* DUMMY BODY */ }
+
+    regex_constants::error_type regex_error::code() const
+    {
+        return code_;
+    }
+}
+
+namespace std::aux
+{
+    namespace
+    {
+        using regex_constants::error_type;
+
+        constexpr size_t unbounded{SIZE_MAX};
+
+        /**
+         * Upper bound on the number of instructions,
+         * counted repetitions are expanded by copying.
+         */
+        constexpr size_t max_program_size{1U << 16};
+
+        enum class node_kind
+        {
+            empty,
+            chr,
+            any,
+            cls,
+            group,
+            concat,
+            alt,
+            repeat,
+            assertion,
+            backref,
+            look
+        };
+
+        struct regex_node
+        {
+            node_kind kind;
+            uint32_t value{};        // Code unit, class, group or assertion opcode.
+            size_t min{};
+            size_t max{};
+            bool greedy{true};
+            bool negative{};
+            vector<size_t> children{};
+        };
+
+        /**
+         * Recursive descent parser for the ECMAScript grammar
+         * (ECMA-262 15.10.1) that builds a syntax tree.
+         */
+        class regex_parser
+        {
+            public:
+                regex_parser(const uint32_t* first, const uint32_t* last,
+                             regex_constants::syntax_option_type flags,
+                             regex_program& prog)
+                    : nodes{}, group_count{}, max_backref{}, it_{first}, end_{last},
+                      icase_{(flags & regex_constants::icase) != 0},
+                      prog_{prog}, err_{regex_constants::error_collate}
+                { /* DUMMY BODY */ }
+
+                bool parse(size_t& root)
+                {
+                    if (!disjunction_(root))
+                        return false;
+
+                    if (!at_end_())
+                        return fail_(regex_constants::error_paren);
+
+                    if (max_backref > group_count)
+                        return fail_(regex_constants::error_backref);
+
+                    return true;
+                }
+
+                error_type error() const
+                {
+                    return err_;
+                }
+
+                vector<regex_node> nodes;
+                size_t group_count;
+                size_t max_backref;
+
+            private:
+                const uint32_t* it_;
+                const uint32_t* end_;
+                bool icase_;
+                regex_program& prog_;
+                error_type err_;
+
+                bool at_end_() const
+                {
+                    return it_ == end_;
+                }
+
+                bool peek_(uint32_t c) const
+                {
+                    return it_ != end_ && *it_ == c;
+                }
+
+                bool peek_(uint32_t c1, uint32_t c2) const
+                {
+                    return end_ - it_ >= 2 && it_[0] == c1 && it_[1] == c2;
+                }
+
+                bool fail_(error_type err)
+                {
+                    err_ = err;
+
+                    return false;
+                }
+
+                size_t new_node_(node_kind kind, uint32_t value = 0)
+                {
+                    regex_node node{};
+                    node.kind = kind;
+                    node.value = value;
+                    nodes.push_back(move(node));
+
+                    return nodes.size() - 1;
+                }
+
+                size_t new_class_(regex_char_class&& cls)
+                {
+                    if (icase_)
+                        fold_class_(cls);
+
+                    prog_.classes.push_back(move(cls));
+
+                    return new_node_(node_kind::cls, static_cast<uint32_t>(prog_.classes.size() - 1));
+                }
+
+                size_t char_node_(uint32_t c)
+                {
+                    if (icase_ && regex_classify(c) & regex_ctype_alpha)
+                    {
+                        regex_char_class cls{};
+                        cls.ranges.emplace_back(c, c);
+
+                        return new_class_(move(cls));
+                    }
+
+                    return new_node_(node_kind::chr, c);
+                }
+
+                void fold_class_(regex_char_class& cls)
+                {
+                    auto count = cls.ranges.size();
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        auto range = cls.ranges[i];
+
+                        auto lo = max(range.first, uint32_t{'a'});
+                        auto hi = min(range.second, uint32_t{'z'});
+                        if (lo <= hi)
+                            cls.ranges.emplace_back(lo - 'a' + 'A', hi - 'a' + 'A');
+
+                        lo = max(range.first, uint32_t{'A'});
+                        hi = min(range.second, uint32_t{'Z'});
+                        if (lo <= hi)
+                            cls.ranges.emplace_back(lo - 'A' + 'a', hi - 'A' + 'a');
+                    }
+
+                    if (cls.ctypes & (regex_ctype_lower | regex_ctype_upper))
+                        cls.ctypes |= regex_ctype_alpha;
+                    if (cls.negated_ctypes & (regex_ctype_lower | regex_ctype_upper))
+                        cls.negated_ctypes |= regex_ctype_cntrl | regex_ctype_digit |
+                                              regex_ctype_punct | regex_ctype_space;
+                }
+
+                bool disjunction_(size_t& res)
+                {
+                    size_t alt{};
+                    if (!alternative_(alt))
+                        return false;
+
+                    if (!peek_('|'))
+                    {
+                        res = alt;
+
+                        return true;
+                    }
+
+                    vector<size_t> alts{};
+                    alts.push_back(alt);
+                    while (peek_('|'))
+                    {
+                        ++it_;
+                        if (!alternative_(alt))
+                            return false;
+                        alts.push_back(alt);
+                    }
+
+                    res = new_node_(node_kind::alt);
+                    nodes[res].children = move(alts);
+
+                    return true;
+                }
+
+                bool alternative_(size_t& res)
+                {
+                    vector<size_t> terms{};
+                    while (!at_end_() && !peek_('|') && !peek_(')'))
+                    {
+                        size_t term{};
+                        if (!term_(term))
+                            return false;
+                        terms.push_back(term);
+                    }
+
+                    if (terms.empty())
+                        res = new_node_(node_kind::empty);
+                    else if (terms.size() == 1)
+                        res = terms.front();
+                    else
+                    {
+                        res = new_node_(node_kind::concat);
+                        nodes[res].children = move(terms);
+                    }
+
+                    return true;
+                }
+
+                bool term_(size_t& res)
+                {
+                    if (peek_('^'))
+                    {
+                        ++it_;
+                        res = new_node_(node_kind::assertion, static_cast<uint32_t>(regex_opcode::bol));
+
+                        return true;
+                    }
+                    else if (peek_('$'))
+                    {
+                        ++it_;
+                        res = new_node_(node_kind::assertion, static_cast<uint32_t>(regex_opcode::eol));
+
+                        return true;
+                    }
+                    else if (peek_('\\', 'b') || peek_('\\', 'B'))
+                    {
+                        auto op = it_[1] == 'b' ? regex_opcode::word_boundary : regex_opcode::nword_boundary;
+                        it_ += 2;
+                        res = new_node_(node_kind::assertion, static_cast<uint32_t>(op));
+
+                        return true;
+                    }
+                    else if (end_ - it_ >= 3 && it_[0] == '(' && it_[1] == '?' &&
+                             (it_[2] == '=' || it_[2] == '!'))
+                    {
+                        bool negative = it_[2] == '!';
+                        it_ += 3;
+
+                        size_t body{};
+                        if (!disjunction_(body))
+                            return false;
+                        if (!peek_(')'))
+                            return fail_(regex_constants::error_paren);
+                        ++it_;
+
+                        res = new_node_(node_kind::look);
+                        nodes[res].negative = negative;
+                        nodes[res].children.push_back(body);
+                        prog_.backtrack_only = true;
+
+                        return true;
+                    }
+
+                    if (!atom_(res))
+                        return false;
+
+                    return quantifier_(res);
+                }
+
+                bool decimal_(size_t& res)
+                {
+                    if (at_end_() || *it_ < '0' || *it_ > '9')
+                        return false;
+
+                    res = 0;
+                    while (!at_end_() && *it_ >= '0' && *it_ <= '9')
+                    {
+                        if (res < unbounded / 10 - 10)
+                            res = res * 10 + (*it_ - '0');
+                        ++it_;
+                    }
+
+                    return true;
+                }
+
+                bool is_quantifier_brace_() const
+                {
+                    return end_ - it_ >= 2 && it_[0] == '{' &&
+                           it_[1] >= '0' && it_[1] <= '9';
+                }
+
+                bool quantifier_(size_t& atom)
+                {
+                    size_t min{};
+                    size_t max{};
+
+                    if (peek_('*'))
+                    {
+                        max = unbounded;
+                        ++it_;
+                    }
+                    else if (peek_('+'))
+                    {
+                        min = 1;
+                        max = unbounded;
+                        ++it_;
+                    }
+                    else if (peek_('?'))
+                    {
+                        max = 1;
+                        ++it_;
+                    }
+                    else if (peek_('{'))
+                    {
+                        ++it_;
+                        if (!decimal_(min))
+                            return fail_(regex_constants::error_badbrace);
+
+                        max = min;
+                        if (peek_(','))
+                        {
+                            ++it_;
+                            if (!decimal_(max))
+                                max = unbounded;
+                        }
+
+                        if (!peek_('}'))
+                            return fail_(regex_constants::error_brace);
+                        ++it_;
+
+                        if (max < min)
+                            return fail_(regex_constants::error_badbrace);
+                    }
+                    else
+                        return true;
+
+                    bool greedy{true};
+                    if (peek_('?'))
+                    {
+                        greedy = false;
+                        ++it_;
+                    }
+
+                    auto res = new_node_(node_kind::repeat);
+                    nodes[res].min = min;
+                    nodes[res].max = max;
+                    nodes[res].greedy = greedy;
+                    nodes[res].children.push_back(atom);
+                    atom = res;
+
+                    return true;
+                }
+
+                bool atom_(size_t& res)
+                {
+                    auto c = *it_;
+                    switch (c)
+                    {
+                        case '.':
+                            ++it_;
+                            res = new_node_(node_kind::any);
+                            return true;
+                        case '(':
+                        {
+                            ++it_;
+
+                            bool capture{true};
+                            if (peek_('?', ':'))
+                            {
+                                capture = false;
+                                it_ += 2;
+                            }
+
+                            uint32_t group{};
+                            if (capture)
+                                group = static_cast<uint32_t>(++group_count);
+
+                            size_t body{};
+                            if (!disjunction_(body))
+                                return false;
+
+                            if (!peek_(')'))
+                                return fail_(regex_constants::error_paren);
+                            ++it_;
+
+                            if (capture)
+                            {
+                                res = new_node_(node_kind::group, group);
+                                nodes[res].children.push_back(body);
+                            }
+                            else
+                                res = body;
+
+                            return true;
+                        }
+                        case '[':
+                            ++it_;
+                            return class_(res);
+                        case '\\':
+                            ++it_;
+                            return atom_escape_(res);
+                        case '*':
+                        case '+':
+                        case '?':
+                            return fail_(regex_constants::error_badrepeat);
+                        case '{':
+                            if (is_quantifier_brace_())
+                                return fail_(regex_constants::error_badrepeat);
+                            [[fallthrough]];
+                        default:
+                            ++it_;
+                            res = char_node_(c);
+                            return true;
+                    }
+                }
+
+                bool hex_(size_t digits, uint32_t& res)
+                {
+                    if (static_cast<size_t>(end_ - it_) < digits)
+                        return false;
+
+                    res = 0;
+                    for (size_t i = 0; i < digits; ++i)
+                    {
+                        auto c = it_[i];
+                        if (!(regex_classify(c) & regex_ctype_xdigit))
+                            return false;
+
+                        uint32_t val{};
+                        if (c <= '9')
+                            val = c - '0';
+                        else
+                            val = regex_fold_case(c) - 'a' + 10;
+                        res = res * 16 + val;
+                    }
+                    it_ += digits;
+
+                    return true;
+                }
+
+                /**
+                 * Escapes that stand for a single code unit,
+                 * it_ points past the backslash.
+                 */
+                bool character_escape_(uint32_t& res)
+                {
+                    if (at_end_())
+                        return fail_(regex_constants::error_escape);
+
+                    auto c = *it_++;
+                    switch (c)
+                    {
+                        case 'f':
+                            res = '\f';
+                            return true;
+                        case 'n':
+                            res = '\n';
+                            return true;
+                        case 'r':
+                            res = '\r';
+                            return true;
+                        case 't':
+                            res = '\t';
+                            return true;
+                        case 'v':
+                            res = '\v';
+                            return true;
+                        case 'c':
+                            if (at_end_() || !(regex_classify(*it_) & regex_ctype_alpha))
+                                return fail_(regex_constants::error_escape);
+                            res = *it_++ % 32;
+                            return true;
+                        case 'x':
+                            if (!hex_(2, res))
+                                return fail_(regex_constants::error_escape);
+                            return true;
+                        case 'u':
+                            if (!hex_(4, res))
+                                return fail_(regex_constants::error_escape);
+                            return true;
+                        case '0':
+                            if (!at_end_() && *it_ >= '0' && *it_ <= '9')
+                                return fail_(regex_constants::error_escape);
+                            res = 0;
+                            return true;
+                        default:
+                            if (regex_is_word(c))
+                                return fail_(regex_constants::error_escape);
+                            res = c;
+                            return true;
+                    }
+                }
+
+                /**
+                 * Class escapes (\d, \s, \w and their negations).
+                 */
+                bool class_escape_(uint32_t c, uint16_t& ctypes, bool& negated)
+                {
+                    switch (c)
+                    {
+                        case 'd':
+                        case 'D':
+                            ctypes = regex_ctype_digit;
+                            break;
+                        case 's':
+                        case 'S':
+                            ctypes = regex_ctype_space;
+                            break;
+                        case 'w':
+                        case 'W':
+                            ctypes = regex_ctype_word;
+                            break;
+                        default:
+                            return false;
+                    }
+
+                    negated = c == 'D' || c == 'S' || c == 'W';
+
+                    return true;
+                }
+
+                bool atom_escape_(size_t& res)
+                {
+                    if (at_end_())
+                        return fail_(regex_constants::error_escape);
+
+                    auto c = *it_;
+                    if (c >= '1' && c <= '9')
+                    {
+                        size_t group{};
+                        decimal_(group);
+
+                        res = new_node_(node_kind::backref, static_cast<uint32_t>(group));
+                        max_backref = max(max_backref, group);
+                        prog_.backtrack_only = true;
+
+                        return true;
+                    }
+
+                    uint16_t ctypes{};
+                    bool negated{};
+                    if (class_escape_(c, ctypes, negated))
+                    {
+                        ++it_;
+
+                        regex_char_class cls{};
+                        cls.ctypes = ctypes;
+                        cls.negated = negated;
+                        res = new_class_(move(cls));
+
+                        return true;
+                    }
+
+                    uint32_t chr{};
+                    if (!character_escape_(chr))
+                        return false;
+
+                    res = char_node_(chr);
+
+                    return true;
+                }
+
+                bool class_name_(uint16_t& ctypes)
+                {
+                    static constexpr struct
+                    {
+                        const char* name;
+                        uint16_t ctype;
+                    } names[] = {
+                        { "alnum", regex_ctype_alnum },
+                        { "alpha", regex_ctype_alpha },
+                        { "blank", regex_ctype_blank },
+                        { "cntrl", regex_ctype_cntrl },
+                        { "d", regex_ctype_digit },
+                        { "digit", regex_ctype_digit },
+                        { "graph", regex_ctype_graph },
+                        { "lower", regex_ctype_lower },
+                        { "print", regex_ctype_print },
+                        { "punct", regex_ctype_punct },
+                        { "s", regex_ctype_space },
+                        { "space", regex_ctype_space },
+                        { "upper", regex_ctype_upper },
+                        { "w", regex_ctype_word },
+                        { "xdigit", regex_ctype_xdigit }
+                    };
+
+                    auto start = it_;
+                    while (!at_end_() && !peek_(':', ']'))
+                        ++it_;
+                    if (at_end_())
+                        return fail_(regex_constants::error_brack);
+
+                    size_t len = it_ - start;
+                    it_ += 2;
+
+                    for (const auto& entry: names)
+                    {
+                        size_t i{};
+                        while (i < len && entry.name[i] && entry.name[i] == static_cast<char>(start[i]))
+                            ++i;
+
+                        if (i == len && !entry.name[i])
+                        {
+                            ctypes = entry.ctype;
+
+                            return true;
+                        }
+                    }
+
+                    return fail_(regex_constants::error_ctype);
+                }
+
+                /**
+                 * Parses a single class atom, which is either a code
+                 * unit or a builtin class stored directly into cls.
+                 */
+                bool class_atom_(regex_char_class& cls, uint32_t& c, bool& is_char)
+                {
+                    is_char = true;
+
+                    if (peek_('[', ':'))
+                    {
+                        it_ += 2;
+
+                        uint16_t ctypes{};
+                        if (!class_name_(ctypes))
+                            return false;
+
+                        cls.ctypes |= ctypes;
+                        is_char = false;
+
+                        return true;
+                    }
+                    else if (peek_('\\'))
+                    {
+                        ++it_;
+                        if (at_end_())
+                            return fail_(regex_constants::error_escape);
+
+                        uint16_t ctypes{};
+                        bool negated{};
+                        if (class_escape_(*it_, ctypes, negated))
+                        {
+                            ++it_;
+                            if (negated)
+                                cls.negated_ctypes |= ctypes;
+                            else
+                                cls.ctypes |= ctypes;
+                            is_char = false;
+
+                            return true;
+                        }
+                        else if (peek_('b'))
+                        {
+                            ++it_;
+                            c = '\b';
+
+                            return true;
+                        }
+                        else if (peek_('-'))
+                        {
+                            ++it_;
+                            c = '-';
+
+                            return true;
+                        }
+
+                        return character_escape_(c);
+                    }
+
+                    c = *it_++;
+
+                    return true;
+                }
+
+                bool class_(size_t& res)
+                {
+                    regex_char_class cls{};
+                    if (peek_('^'))
+                    {
+                        cls.negated = true;
+                        ++it_;
+                    }
+
+                    while (!peek_(']'))
+                    {
+                        if (at_end_())
+                            return fail_(regex_constants::error_brack);
+
+                        uint32_t lo{};
+                        bool lo_char{};
+                        if (!class_atom_(cls, lo, lo_char))
+                            return false;
+
+                        if (peek_('-') && end_ - it_ >= 2 && it_[1] != ']')
+                        {
+                            ++it_;
+
+                            uint32_t hi{};
+                            bool hi_char{};
+                            if (!class_atom_(cls, hi, hi_char))
+                                return false;
+
+                            if (!lo_char || !hi_char || lo > hi)
+                                return fail_(regex_constants::error_range);
+
+                            cls.ranges.emplace_back(lo, hi);
+                        }
+                        else if (lo_char)
+                            cls.ranges.emplace_back(lo, lo);
+                    }
+                    ++it_;
+
+                    res = new_class_(move(cls));
+
+                    return true;
+                }
+        };
+
+        /**
+         * Translates the syntax tree into the program.
+         */
+        class regex_codegen
+        {
+            public:
+                regex_codegen(const vector<regex_node>& nodes, regex_program& prog,
+                              bool nosubs)
+                    : nodes_{nodes}, prog_{prog}, nosubs_{nosubs}, loop_slots_{}
+                { /* DUMMY BODY */ }
+
+                bool generate(size_t root, size_t group_count)
+                {
+                    slot_base_ = 2 * (group_count + 1);
+
+                    emit_(regex_opcode::save, 0);
+                    if (!emit_node_(root))
+                        return false;
+                    emit_(regex_opcode::save, 1);
+                    emit_(regex_opcode::match);
+
+                    prog_.slot_count = slot_base_ + loop_slots_;
+
+                    return prog_.insts.size() <= max_program_size;
+                }
+
+            private:
+                const vector<regex_node>& nodes_;
+                regex_program& prog_;
+                bool nosubs_;
+                size_t slot_base_;
+                size_t loop_slots_;
+
+                uint32_t pc_() const
+                {
+                    return static_cast<uint32_t>(prog_.insts.size());
+                }
+
+                uint32_t emit_(regex_opcode op, uint32_t x = 0, uint32_t y = 0)
+                {
+                    prog_.insts.push_back(regex_inst{op, x, y});
+
+                    return pc_() - 1;
+                }
+
+                bool nullable_(size_t idx) const
+                {
+                    const auto& node = nodes_[idx];
+                    switch (node.kind)
+                    {
+                        case node_kind::chr:
+                        case node_kind::any:
+                        case node_kind::cls:
+                            return false;
+                        case node_kind::group:
+                            return nullable_(node.children[0]);
+                        case node_kind::concat:
+                            for (auto child: node.children)
+                            {
+                                if (!nullable_(child))
+                                    return false;
+                            }
+                            return true;
+                        case node_kind::alt:
+                            for (auto child: node.children)
+                            {
+                                if (nullable_(child))
+                                    return true;
+                            }
+                            return false;
+                        case node_kind::repeat:
+                            return node.min == 0 || nullable_(node.children[0]);
+                        default:
+                            return true;
+                    }
+                }
+
+                void group_range_(size_t idx, uint32_t& lo, uint32_t& hi) const
+                {
+                    const auto& node = nodes_[idx];
+                    if (node.kind == node_kind::group)
+                    {
+                        lo = min(lo, node.value);
+                        hi = max(hi, node.value);
+                    }
+
+                    for (auto child: node.children)
+                        group_range_(child, lo, hi);
+                }
+
+                bool emit_node_(size_t idx)
+                {
+                    if (prog_.insts.size() > max_program_size)
+                        return false;
+
+                    const auto& node = nodes_[idx];
+                    switch (node.kind)
+                    {
+                        case node_kind::empty:
+                            return true;
+                        case node_kind::chr:
+                            emit_(regex_opcode::chr, node.value);
+                            return true;
+                        case node_kind::any:
+                            emit_(regex_opcode::any);
+                            return true;
+                        case node_kind::cls:
+                            emit_(regex_opcode::cls, node.value);
+                            return true;
+                        case node_kind::assertion:
+                            emit_(static_cast<regex_opcode>(node.value));
+                            return true;
+                        case node_kind::backref:
+                            emit_(regex_opcode::backref, node.value);
+                            return true;
+                        case node_kind::group:
+                        {
+                            bool save = !nosubs_ || prog_.backtrack_only;
+                            if (save)
+                                emit_(regex_opcode::save, 2 * node.value);
+                            if (!emit_node_(node.children[0]))
+                                return false;
+                            if (save)
+                                emit_(regex_opcode::save, 2 * node.value + 1);
+                            return true;
+                        }
+                        case node_kind::concat:
+                            for (auto child: node.children)
+                            {
+                                if (!emit_node_(child))
+                                    return false;
+                            }
+                            return true;
+                        case node_kind::alt:
+                            return emit_alt_(node);
+                        case node_kind::repeat:
+                            return emit_repeat_(node);
+                        case node_kind::look:
+                        {
+                            auto look = emit_(regex_opcode::look, 0, node.negative ? 1 : 0);
+                            if (!emit_node_(node.children[0]))
+                                return false;
+                            emit_(regex_opcode::look_end);
+                            prog_.insts[look].x = pc_();
+                            return true;
+                        }
+                    }
+
+                    return true;
+                }
+
+                bool emit_alt_(const regex_node& node)
+                {
+                    vector<uint32_t> jumps{};
+                    for (size_t i = 0; i < node.children.size(); ++i)
+                    {
+                        uint32_t split{};
+                        bool last = i + 1 == node.children.size();
+                        if (!last)
+                            split = emit_(regex_opcode::split, pc_() + 1);
+
+                        if (!emit_node_(node.children[i]))
+                            return false;
+
+                        if (!last)
+                        {
+                            jumps.push_back(emit_(regex_opcode::jmp));
+                            prog_.insts[split].y = pc_();
+                        }
+                    }
+
+                    for (auto jump: jumps)
+                        prog_.insts[jump].x = pc_();
+
+                    return true;
+                }
+
+                /**
+                 * Emits one iteration of a loop body, captures
+                 * from the previous iteration are cleared first.
+                 */
+                bool emit_iteration_(size_t body, bool check_empty, uint32_t lo, uint32_t hi)
+                {
+                    uint32_t slot{};
+                    if (check_empty)
+                    {
+                        prog_.empty_checks = true;
+                        slot = static_cast<uint32_t>(slot_base_ + loop_slots_++);
+                        emit_(regex_opcode::save, slot);
+                    }
+
+                    if (lo <= hi && (!nosubs_ || prog_.backtrack_only))
+                        emit_(regex_opcode::clear, 2 * lo, 2 * hi + 2);
+
+                    if (!emit_node_(body))
+                        return false;
+
+                    if (check_empty)
+                        emit_(regex_opcode::loop_check, slot);
+
+                    return true;
+                }
+
+                bool emit_repeat_(const regex_node& node)
+                {
+                    auto body = node.children[0];
+
+                    uint32_t lo{UINT32_MAX};
+                    uint32_t hi{0};
+                    group_range_(body, lo, hi);
+
+                    for (size_t i = 0; i < node.min; ++i)
+                    {
+                        if (!emit_iteration_(body, false, lo, hi))
+                            return false;
+                    }
+
+                    /**
+                     * After the minimum is reached, iterations that
+                     * match the empty string are rejected (this also
+                     * keeps the backtracking engine from looping).
+                     */
+                    bool check_empty = nullable_(body);
+                    if (node.max == unbounded)
+                    {
+                        auto split = emit_(regex_opcode::split);
+                        if (!emit_iteration_(body, check_empty, lo, hi))
+                            return false;
+                        emit_(regex_opcode::jmp, split);
+                        patch_split_(split, node.greedy);
+                    }
+                    else
+                    {
+                        vector<uint32_t> splits{};
+                        for (size_t i = node.min; i < node.max; ++i)
+                        {
+                            splits.push_back(emit_(regex_opcode::split));
+                            if (!emit_iteration_(body, check_empty, lo, hi))
+                                return false;
+                        }
+
+                        for (auto split: splits)
+                            patch_split_(split, node.greedy);
+                    }
+
+                    return true;
+                }
+
+                void patch_split_(uint32_t split, bool greedy)
+                {
+                    auto& inst = prog_.insts[split];
+                    if (greedy)
+                    {
+                        inst.x = split + 1;
+                        inst.y = pc_();
+                    }
+                    else
+                    {
+                        inst.x = pc_();
+                        inst.y = split + 1;
+                    }
+                }
+        };
+
+        bool regex_determinisable(const regex_program& prog)
+        {
+            if (prog.backtrack_only || prog.multiline)
+                return false;
+
+            for (const auto& inst: prog.insts)
+            {
+                if (inst.op == regex_opcode::word_boundary ||
+                    inst.op == regex_opcode::nword_boundary)
+                    return false;
+            }
+
+            return true;
+        }
+    }
+
+    regex_program::~regex_program()
+    { /* DUMMY BODY */ }
+
+    shared_ptr<regex_program> regex_compile(
+        const uint32_t* first, const uint32_t* last,
+        regex_constants::syntax_option_type flags,
+        regex_constants::error_type& err
+    )
+    {
+        auto prog = make_shared<regex_program>();
+        prog->icase = (flags & regex_constants::icase) != 0;
+        prog->multiline = (flags & regex_constants::multiline) != 0;
+
+        regex_parser parser{first, last, flags, *prog};
+
+        size_t root{};
+        if (!parser.parse(root))
+        {
+            err = parser.error();
+
+            return shared_ptr<regex_program>{};
+        }
+
+        bool nosubs = (flags & regex_constants::nosubs) != 0;
+        regex_codegen codegen{parser.nodes, *prog, nosubs};
+        if (!codegen.generate(root, parser.group_count))
+        {
+            err = regex_constants::error_complexity;
+
+            return shared_ptr<regex_program>{};
+        }
+
+        prog->mark_count = nosubs ? 0 : parser.group_count;
+        if (regex_determinisable(*prog))
+            prog->dfa = make_unique<regex_dfa>(*prog);
+
+        return prog;
+    }
+
+    namespace
+    {
+        /**
+         * Memory budget of a single transition table.
+         */
+        constexpr size_t dfa_table_budget{256 * 1024};
+    }
+
+    regex_dfa::regex_dfa(const regex_program& prog)
+        : program_{prog}, states_{}, table_{}, byte_class_{}, class_count_{},
+          index_{}, max_states_{}, start_states_{}, flushes_{},
+          stack_{}, marks_(prog.insts.size()), generation_{}, busy_{}
+    {
+        /**
+         * Bytes that no instruction distinguishes share
+         * a column in the transition table.
+         */
+        bool boundary[257]{};
+        for (const auto& inst: prog.insts)
+        {
+            switch (inst.op)
+            {
+                case regex_opcode::chr:
+                    if (inst.x < 256)
+                    {
+                        boundary[inst.x] = true;
+                        boundary[inst.x + 1] = true;
+                    }
+                    break;
+                case regex_opcode::any:
+                    boundary['\n'] = boundary['\n' + 1] = true;
+                    boundary['\r'] = boundary['\r' + 1] = true;
+                    break;
+                case regex_opcode::cls:
+                {
+                    const auto& cls = prog.classes[inst.x];
+                    for (const auto& range: cls.ranges)
+                    {
+                        if (range.first < 256)
+                            boundary[range.first] = true;
+                        if (range.second < 256)
+                            boundary[range.second + 1] = true;
+                    }
+
+                    if (cls.ctypes || cls.negated_ctypes)
+                    {
+                        for (uint32_t c = 1; c < 256; ++c)
+                        {
+                            if (regex_classify(c) != regex_classify(c - 1))
+                                boundary[c] = true;
+                        }
+                    }
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
+        for (size_t c = 0; c < 256; ++c)
+        {
+            if (c > 0 && boundary[c])
+                ++class_count_;
+            byte_class_[c] = static_cast<unsigned char>(class_count_);
+        }
+        ++class_count_;
+
+        max_states_ = max(dfa_table_budget / (class_count_ * sizeof(int)), size_t{16});
+
+        size_t index_size{1};
+        while (index_size < 2 * max_states_)
+            index_size *= 2;
+        index_.resize(index_size, unknown_state);
+
+        flush_();
+    }
+
+    void regex_dfa::flush_()
+    {
+        states_.clear();
+        table_.clear();
+        for (auto& idx: index_)
+            idx = unknown_state;
+        ++flushes_;
+
+        for (auto& start: start_states_)
+            start = unknown_state;
+
+        // The dead state has no way out.
+        states_.push_back(state_t{vector<uint32_t>{}, true, false, false, false, 0U});
+        table_.resize(class_count_, dead_state);
+    }
+
+    void regex_dfa::new_generation_()
+    {
+        if (++generation_ == 0)
+        {
+            for (auto& mark: marks_)
+                mark = 0;
+            generation_ = 1;
+        }
+    }
+
+    /**
+     * Adds the consuming, accepting and (unless resolved) end
+     * anchor instructions reachable from pc to pcs.
+     */
+    void regex_dfa::closure_(vector<uint32_t>& pcs, uint32_t pc, bool at_bol, bool at_eol)
+    {
+        stack_.push_back(pc);
+        while (!stack_.empty())
+        {
+            pc = stack_.back();
+            stack_.pop_back();
+
+            while (marks_[pc] != generation_)
+            {
+                marks_[pc] = generation_;
+
+                const auto& inst = program_.insts[pc];
+                bool proceed{true};
+                switch (inst.op)
+                {
+                    case regex_opcode::split:
+                        stack_.push_back(inst.y);
+                        pc = inst.x;
+                        break;
+                    case regex_opcode::jmp:
+                        pc = inst.x;
+                        break;
+                    case regex_opcode::save:
+                    case regex_opcode::clear:
+                    case regex_opcode::loop_check:
+                        ++pc;
+                        break;
+                    case regex_opcode::bol:
+                        proceed = at_bol;
+                        ++pc;
+                        break;
+                    case regex_opcode::eol:
+                        if (at_eol)
+                            ++pc;
+                        else
+                        {
+                            pcs.push_back(pc);
+                            proceed = false;
+                        }
+                        break;
+                    default:
+                        pcs.push_back(pc);
+                        proceed = false;
+                        break;
+                }
+
+                if (!proceed)
+                    break;
+            }
+        }
+    }
+
+    int regex_dfa::intern_(vector<uint32_t>& pcs, bool anchored, bool at_bol)
+    {
+        /**
+         * Nothing can be reached from an empty set, not even
+         * in unanchored mode (the restart is part of the set).
+         */
+        if (pcs.empty())
+            return dead_state;
+
+        sort(pcs.begin(), pcs.end());
+
+        // FNV-1a over the flags and the instructions.
+        size_t hash{14695981039346656037ULL};
+        hash = (hash ^ ((anchored ? 1U : 0U) | (at_bol ? 2U : 0U))) * 1099511628211ULL;
+        for (auto pc: pcs)
+            hash = (hash ^ pc) * 1099511628211ULL;
+
+        auto mask = index_.size() - 1;
+        for (auto i = hash & mask; index_[i] != unknown_state; i = (i + 1) & mask)
+        {
+            const auto& state = states_[index_[i]];
+            if (state.hash == hash && equal_(state, pcs, anchored, at_bol))
+                return index_[i];
+        }
+
+        if (states_.size() >= max_states_)
+            flush_();
+
+        state_t state{pcs, anchored, at_bol, false, false, hash};
+        for (auto pc: pcs)
+        {
+            if (program_.insts[pc].op == regex_opcode::match)
+                state.accepting = true;
+        }
+
+        state.accepting_at_end = state.accepting;
+        if (!state.accepting)
+        {
+            new_generation_();
+
+            vector<uint32_t> end_pcs{};
+            for (auto pc: pcs)
+            {
+                if (program_.insts[pc].op == regex_opcode::eol)
+                    closure_(end_pcs, pc + 1, at_bol, true);
+            }
+
+            for (auto pc: end_pcs)
+            {
+                if (program_.insts[pc].op == regex_opcode::match)
+                    state.accepting_at_end = true;
+            }
+        }
+
+        auto res = static_cast<int>(states_.size());
+        states_.push_back(move(state));
+        table_.resize(table_.size() + class_count_, unknown_state);
+
+        auto i = hash & mask;
+        while (index_[i] != unknown_state)
+            i = (i + 1) & mask;
+        index_[i] = res;
+
+        return res;
+    }
+
+    bool regex_dfa::equal_(const state_t& state, const vector<uint32_t>& pcs,
+                           bool anchored, bool at_bol) const
+    {
+        if (state.anchored != anchored || state.at_bol != at_bol ||
+            state.pcs.size() != pcs.size())
+            return false;
+
+        for (size_t i = 0; i < pcs.size(); ++i)
+        {
+            if (state.pcs[i] != pcs[i])
+                return false;
+        }
+
+        return true;
+    }
+
+    int regex_dfa::start(bool anchored, bool at_bol)
+    {
+        auto& start = start_states_[(anchored ? 1 : 0) | (at_bol ? 2 : 0)];
+        if (start != unknown_state)
+            return start;
+
+        new_generation_();
+
+        vector<uint32_t> pcs{};
+        closure_(pcs, 0, at_bol, false);
+
+        auto res = intern_(pcs, anchored, at_bol);
+
+        /**
+         * Interning can flush the cache, which
+         * resets the start states as well.
+         */
+        start_states_[(anchored ? 1 : 0) | (at_bol ? 2 : 0)] = res;
+
+        return res;
+    }
+
+    int regex_dfa::compute_next_(int state, unsigned char c)
+    {
+        new_generation_();
+
+        bool anchored = states_[state].anchored;
+
+        vector<uint32_t> pcs{};
+        for (auto pc: states_[state].pcs)
+        {
+            const auto& inst = program_.insts[pc];
+            if (regex_inst_consumes(program_, inst, c))
+                closure_(pcs, pc + 1, false, false);
+        }
+
+        if (!anchored)
+            closure_(pcs, 0, false, false);
+
+        auto generation = flushes_;
+        auto res = intern_(pcs, anchored, false);
+
+        // The source state does not exist anymore after a flush.
+        if (generation == flushes_)
+            table_[static_cast<size_t>(state) * class_count_ + byte_class_[c]] = res;
+
+        return res;
+    }
+}
@@ -58,6 +58,8 @@ typedef struct ext4_node {
 	fs_node_t *fs_node;
 	ht_link_t link;
 	unsigned int references;
+	/** Number of VFS opens not yet matched by a close */
+	unsigned int opened;
 } ext4_node_t;
 
 #define EXT4_NODE(node) \
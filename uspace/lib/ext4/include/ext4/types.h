@@ -35,6 +35,7 @@
 #ifndef LIBEXT4_TYPES_H_
 #define LIBEXT4_TYPES_H_
 
+#include <adt/list.h>
 #include <block.h>
 
 /*
@@ -232,6 +233,8 @@ typedef struct ext4_filesystem {
 	ext4_superblock_t *superblock;
 	aoff64_t inode_block_limits[4];
 	aoff64_t inode_blocks_per_level[4];
+	list_t prealloc;        /* Preallocation windows, most recent first */
+	size_t prealloc_count;
 } ext4_filesystem_t;
 
 /** Size of buffer for volume name. To hold 16 latin-1 chars encoded as UTF-8
@@ -35,9 +35,11 @@
  * @brief Physical block allocator.
  */
 
+#include <adt/list.h>
 #include <errno.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include "ext4/balloc.h"
 #include "ext4/bitmap.h"
 #include "ext4/block_group.h"
@@ -46,6 +48,21 @@
 #include "ext4/superblock.h"
 #include "ext4/types.h"
 
+/** Minimum and maximum size of a preallocation window in blocks. */
+#define EXT4_PREALLOC_MIN  16
+#define EXT4_PREALLOC_MAX  2048
+
+/** Maximum number of preallocation windows kept per file system. */
+#define EXT4_PREALLOC_WINDOWS  64
+
+/** Preallocation window of one i-node. */
+typedef struct {
+	link_t link;
+	uint32_t index;  /* I-node the window belongs to */
+	uint32_t start;  /* Next block of the window */
+	uint32_t count;  /* Blocks left in the window */
+} ext4_prealloc_t;
+
 /** Free block.
  *
  * @param inode_ref  Inode, where the block is allocated
@@ -119,10 +136,20 @@ errno_t ext4_balloc_free_block(ext4_inode_ref_t *inode_ref, uint32_t block_addr)
 	return ext4_filesystem_put_block_group_ref(bg_ref);
 }
 
-static errno_t ext4_balloc_free_blocks_internal(ext4_inode_ref_t *inode_ref,
-    uint32_t first, uint32_t count)
+/** Free continuous set of blocks within one block group.
+ *
+ * @param fs        Filesystem the blocks belong to
+ * @param inode_ref I-node charged for the blocks or NULL if the blocks
+ *                  are not accounted to any i-node
+ * @param first     First block to release
+ * @param count     Number of blocks to release
+ *
+ * @return Error code
+ *
+ */
+static errno_t ext4_balloc_free_blocks_internal(ext4_filesystem_t *fs,
+    ext4_inode_ref_t *inode_ref, uint32_t first, uint32_t count)
 {
-	ext4_filesystem_t *fs = inode_ref->fs;
 	ext4_superblock_t *sb = fs->superblock;
 
 	/* Compute indexes */
@@ -174,11 +201,13 @@ static errno_t ext4_balloc_free_blocks_internal(ext4_inode_ref_t *inode_ref,
 	ext4_superblock_set_free_blocks_count(sb, sb_free_blocks);
 
 	/* Update inode blocks count */
-	uint64_t ino_blocks =
-	    ext4_inode_get_blocks_count(sb, inode_ref->inode);
-	ino_blocks -= count * (block_size / EXT4_INODE_BLOCK_SIZE);
-	ext4_inode_set_blocks_count(sb, inode_ref->inode, ino_blocks);
-	inode_ref->dirty = true;
+	if (inode_ref != NULL) {
+		uint64_t ino_blocks =
+		    ext4_inode_get_blocks_count(sb, inode_ref->inode);
+		ino_blocks -= count * (block_size / EXT4_INODE_BLOCK_SIZE);
+		ext4_inode_set_blocks_count(sb, inode_ref->inode, ino_blocks);
+		inode_ref->dirty = true;
+	}
 
 	/* Update block group free blocks count */
 	uint32_t free_blocks =
@@ -220,7 +249,7 @@ errno_t ext4_balloc_free_blocks(ext4_inode_ref_t *inode_ref,
 			 */
 			uint32_t s = limit - first;
 
-			r = ext4_balloc_free_blocks_internal(inode_ref,
+			r = ext4_balloc_free_blocks_internal(fs, inode_ref,
 			    first, s);
 			if (r != EOK)
 				return r;
@@ -228,7 +257,7 @@ errno_t ext4_balloc_free_blocks(ext4_inode_ref_t *inode_ref,
 			first = limit;
 			count -= s;
 		} else {
-			return ext4_balloc_free_blocks_internal(inode_ref,
+			return ext4_balloc_free_blocks_internal(fs, inode_ref,
 			    first, count);
 		}
 	}
@@ -312,7 +341,7 @@ static errno_t ext4_balloc_find_goal(ext4_inode_ref_t *inode_ref, uint32_t *goal
 		if (rc != EOK)
 			return rc;
 
-		if (goal != 0) {
+		if (*goal != 0) {
 			(*goal)++;
 			return EOK;
 		}
@@ -699,6 +728,391 @@ terminate:
 	return ext4_filesystem_put_block_group_ref(bg_ref);
 }
 
+/** Look for a run of free blocks in a range of a block bitmap.
+ *
+ * @param bitmap Block bitmap
+ * @param from   First index of the range
+ * @param to     Index just past the range
+ * @param want   Desired length of the run
+ * @param start  Start of the longest run seen so far
+ * @param len    Length of the longest run seen so far
+ *
+ * @return True if a run of @a want blocks was found
+ *
+ */
+static bool ext4_balloc_scan_run(uint8_t *bitmap, uint32_t from, uint32_t to,
+    uint32_t want, uint32_t *start, uint32_t *len)
+{
+	uint32_t idx = from;
+
+	while (idx < to) {
+		/* Skip fully allocated bytes at once */
+		if ((idx % 8 == 0) && (bitmap[idx / 8] == 0xff)) {
+			idx += 8;
+			continue;
+		}
+
+		if (!ext4_bitmap_is_free_bit(bitmap, idx)) {
+			idx++;
+			continue;
+		}
+
+		uint32_t run = idx;
+		while ((idx < to) && (idx - run < want) &&
+		    ext4_bitmap_is_free_bit(bitmap, idx))
+			idx++;
+
+		if (idx - run > *len) {
+			*start = run;
+			*len = idx - run;
+			if (*len == want)
+				return true;
+		}
+	}
+
+	return false;
+}
+
+/** Allocate a run of contiguous blocks.
+ *
+ * The run is looked for in the block group of the goal first, starting at
+ * the goal itself so that a file can grow in place. A run of the requested
+ * length is preferred in any group; if there is none, the longest run in
+ * the first group with free blocks is taken. Bitmap, block group and
+ * superblock are updated once for the whole run. The inode's block count
+ * is not changed.
+ *
+ * @param fs     Filesystem to allocate blocks on
+ * @param goal   Preferred first block of the run
+ * @param want   Desired number of blocks
+ * @param fblock Output value - first block of the run
+ * @param count  Output value - number of blocks in the run
+ *
+ * @return Error code
+ *
+ */
+static errno_t ext4_balloc_alloc_run(ext4_filesystem_t *fs, uint32_t goal,
+    uint32_t want, uint32_t *fblock, uint32_t *count)
+{
+	ext4_superblock_t *sb = fs->superblock;
+	uint32_t block_group_count = ext4_superblock_get_block_group_count(sb);
+	uint32_t goal_group = ext4_filesystem_blockaddr2group(sb, goal);
+	uint32_t goal_index =
+	    ext4_filesystem_blockaddr2_index_in_group(sb, goal);
+	errno_t rc;
+
+	if (goal_group >= block_group_count) {
+		goal_group = 0;
+		goal_index = 0;
+	}
+
+	for (unsigned pass = 0; pass < 2; pass++) {
+		for (uint32_t i = 0; i < block_group_count; i++) {
+			uint32_t bgid = (goal_group + i) % block_group_count;
+
+			ext4_block_group_ref_t *bg_ref;
+			rc = ext4_filesystem_get_block_group_ref(fs, bgid,
+			    &bg_ref);
+			if (rc != EOK)
+				return rc;
+
+			uint32_t free_blocks =
+			    ext4_block_group_get_free_blocks_count(
+			    bg_ref->block_group, sb);
+			if ((free_blocks == 0) ||
+			    ((pass == 0) && (free_blocks < want))) {
+				rc = ext4_filesystem_put_block_group_ref(bg_ref);
+				if (rc != EOK)
+					return rc;
+				continue;
+			}
+
+			uint32_t first_index =
+			    ext4_filesystem_blockaddr2_index_in_group(sb,
+			    ext4_balloc_get_first_data_block_in_group(sb,
+			    bg_ref));
+			uint32_t blocks_in_group =
+			    ext4_superblock_get_blocks_in_group(sb, bgid);
+			uint32_t from = first_index;
+			if ((i == 0) && (goal_index > first_index))
+				from = goal_index;
+
+			block_t *bitmap_block;
+			rc = block_get(&bitmap_block, fs->device,
+			    ext4_block_group_get_block_bitmap(
+			    bg_ref->block_group, sb), BLOCK_FLAGS_NONE);
+			if (rc != EOK) {
+				ext4_filesystem_put_block_group_ref(bg_ref);
+				return rc;
+			}
+
+			uint8_t *bitmap = bitmap_block->data;
+			uint32_t start = 0;
+			uint32_t len = 0;
+
+			/* Scan from the goal to the end, then wrap around */
+			if (!ext4_balloc_scan_run(bitmap, from, blocks_in_group,
+			    want, &start, &len)) {
+				(void) ext4_balloc_scan_run(bitmap, first_index,
+				    from, want, &start, &len);
+			}
+
+			/*
+			 * On the first pass a shorter run is only good enough
+			 * if it lets the file grow in place.
+			 */
+			if ((len == 0) || ((pass == 0) && (len < want) &&
+			    (start != from))) {
+				rc = block_put(bitmap_block);
+				if (rc == EOK)
+					rc = ext4_filesystem_put_block_group_ref(bg_ref);
+				else
+					ext4_filesystem_put_block_group_ref(bg_ref);
+				if (rc != EOK)
+					return rc;
+				continue;
+			}
+
+			for (uint32_t idx = start; idx < start + len; idx++)
+				ext4_bitmap_set_bit(bitmap, idx);
+			bitmap_block->dirty = true;
+
+			rc = block_put(bitmap_block);
+			if (rc != EOK) {
+				ext4_filesystem_put_block_group_ref(bg_ref);
+				return rc;
+			}
+
+			/* Update superblock free blocks count */
+			uint32_t sb_free_blocks =
+			    ext4_superblock_get_free_blocks_count(sb);
+			sb_free_blocks -= len;
+			ext4_superblock_set_free_blocks_count(sb, sb_free_blocks);
+
+			/* Update block group free blocks count */
+			ext4_block_group_set_free_blocks_count(bg_ref->block_group,
+			    sb, free_blocks - len);
+			bg_ref->dirty = true;
+
+			*fblock = ext4_filesystem_index_in_group2blockaddr(sb,
+			    start, bgid);
+			*count = len;
+
+			return ext4_filesystem_put_block_group_ref(bg_ref);
+		}
+	}
+
+	return ENOSPC;
+}
+
+/** Find the preallocation window of an i-node.
+ *
+ * @param fs    Filesystem
+ * @param index I-node index
+ *
+ * @return Window or NULL if the i-node has none
+ *
+ */
+static ext4_prealloc_t *ext4_balloc_prealloc_find(ext4_filesystem_t *fs,
+    uint32_t index)
+{
+	list_foreach(fs->prealloc, link, ext4_prealloc_t, pa) {
+		if (pa->index == index)
+			return pa;
+	}
+
+	return NULL;
+}
+
+/** Return unused blocks of a detached preallocation window.
+ *
+ * @param fs Filesystem
+ * @param pa Window already removed from the list of windows
+ *
+ * @return Error code
+ *
+ */
+static errno_t ext4_balloc_prealloc_free(ext4_filesystem_t *fs,
+    ext4_prealloc_t *pa)
+{
+	errno_t rc = EOK;
+
+	/* The window never spans more than one block group */
+	if (pa->count != 0)
+		rc = ext4_balloc_free_blocks_internal(fs, NULL, pa->start,
+		    pa->count);
+
+	free(pa);
+	return rc;
+}
+
+/** Allocate a data block to be appended to an i-node.
+ *
+ * Regular files are given blocks from a preallocation window. The window
+ * is reserved as one contiguous run, preferably right at the goal, and its
+ * size follows the size of the file. Sequential writes thus produce long
+ * extents and touch the block bitmap once per window rather than once per
+ * block.
+ *
+ * Windows are kept in the file system instance, keyed by i-node index, so
+ * that they survive between write requests. The unused part of a window
+ * is returned when the file is closed, truncated or destroyed, when the
+ * file system is unmounted, or when the window is evicted to make room for
+ * a window of another i-node.
+ *
+ * @param inode_ref I-node to allocate block for
+ * @param goal      Preferred block address (e.g. the one following
+ *                  the last extent) or zero if there is no preference
+ * @param fblock    Output value - allocated block address
+ *
+ * @return Error code
+ *
+ */
+errno_t ext4_balloc_alloc_append_block(ext4_inode_ref_t *inode_ref,
+    uint32_t goal, uint32_t *fblock)
+{
+	ext4_filesystem_t *fs = inode_ref->fs;
+	ext4_superblock_t *sb = fs->superblock;
+	errno_t rc;
+
+	if (!ext4_inode_is_type(sb, inode_ref->inode, EXT4_INODE_MODE_FILE)) {
+		if (goal != 0) {
+			bool free;
+			rc = ext4_balloc_try_alloc_block(inode_ref, goal, &free);
+			if (rc != EOK)
+				return rc;
+			if (free) {
+				*fblock = goal;
+				return EOK;
+			}
+		}
+
+		return ext4_balloc_alloc_block(inode_ref, fblock);
+	}
+
+	uint32_t block_size = ext4_superblock_get_block_size(sb);
+
+	ext4_prealloc_t *pa = ext4_balloc_prealloc_find(fs, inode_ref->index);
+	if ((pa == NULL) || (pa->count == 0)) {
+		if (goal == 0) {
+			rc = ext4_balloc_find_goal(inode_ref, &goal);
+			if (rc != EOK)
+				return rc;
+		}
+
+		uint64_t file_blocks = ext4_inode_get_size(sb, inode_ref->inode) /
+		    block_size;
+		uint32_t want = max(EXT4_PREALLOC_MIN,
+		    min(file_blocks, EXT4_PREALLOC_MAX));
+
+		uint32_t start;
+		uint32_t count;
+		rc = ext4_balloc_alloc_run(fs, goal, want, &start, &count);
+		if (rc != EOK)
+			return rc;
+
+		/* The list may have changed while the bitmap was read */
+		pa = ext4_balloc_prealloc_find(fs, inode_ref->index);
+		if (pa == NULL) {
+			pa = malloc(sizeof(ext4_prealloc_t));
+			if (pa == NULL) {
+				ext4_balloc_free_blocks_internal(fs, NULL,
+				    start, count);
+				return ENOMEM;
+			}
+
+			link_initialize(&pa->link);
+			pa->index = inode_ref->index;
+			pa->count = 0;
+			list_prepend(&pa->link, &fs->prealloc);
+			fs->prealloc_count++;
+		}
+
+		if (pa->count == 0) {
+			pa->start = start;
+			pa->count = count;
+		} else {
+			rc = ext4_balloc_free_blocks_internal(fs, NULL,
+			    start, count);
+			if (rc != EOK)
+				return rc;
+		}
+	}
+
+	*fblock = pa->start++;
+	pa->count--;
+
+	/* Keep the most recently used windows at the front */
+	list_remove(&pa->link);
+	list_prepend(&pa->link, &fs->prealloc);
+
+	/* Update inode blocks (different block size!) count */
+	uint64_t ino_blocks =
+	    ext4_inode_get_blocks_count(sb, inode_ref->inode);
+	ino_blocks += block_size / EXT4_INODE_BLOCK_SIZE;
+	ext4_inode_set_blocks_count(sb, inode_ref->inode, ino_blocks);
+	inode_ref->dirty = true;
+
+	/* Evict the least recently used window if there are too many */
+	if (fs->prealloc_count > EXT4_PREALLOC_WINDOWS) {
+		ext4_prealloc_t *old = list_get_instance(list_last(&fs->prealloc),
+		    ext4_prealloc_t, link);
+		list_remove(&old->link);
+		fs->prealloc_count--;
+
+		rc = ext4_balloc_prealloc_free(fs, old);
+		if (rc != EOK)
+			return rc;
+	}
+
+	return EOK;
+}
+
+/** Return unused blocks of the preallocation window of an i-node.
+ *
+ * @param fs    Filesystem
+ * @param index Index of the i-node whose window is to be released
+ *
+ * @return Error code
+ *
+ */
+errno_t ext4_balloc_prealloc_release(ext4_filesystem_t *fs, uint32_t index)
+{
+	ext4_prealloc_t *pa = ext4_balloc_prealloc_find(fs, index);
+	if (pa == NULL)
+		return EOK;
+
+	list_remove(&pa->link);
+	fs->prealloc_count--;
+
+	return ext4_balloc_prealloc_free(fs, pa);
+}
+
+/** Return unused blocks of all preallocation windows.
+ *
+ * @param fs Filesystem
+ *
+ * @return Error code
+ *
+ */
+errno_t ext4_balloc_prealloc_release_all(ext4_filesystem_t *fs)
+{
+	errno_t rc = EOK;
+
+	while (!list_empty(&fs->prealloc)) {
+		ext4_prealloc_t *pa = list_get_instance(list_first(&fs->prealloc),
+		    ext4_prealloc_t, link);
+		list_remove(&pa->link);
+		fs->prealloc_count--;
+
+		errno_t rc2 = ext4_balloc_prealloc_free(fs, pa);
+		if (rc == EOK)
+			rc = rc2;
+	}
+
+	return rc;
+}
+
 /**
  * @}
  */
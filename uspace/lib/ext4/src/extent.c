@@ -1001,7 +1001,8 @@ errno_t ext4_extent_append_block(ext4_inode_ref_t *inode_ref, uint32_t *iblock,
 		/* There is space for new block in the extent */
 		if (block_count == 0) {
 			/* Existing extent is empty */
-			rc = ext4_balloc_alloc_block(inode_ref, &phys_block);
+			rc = ext4_balloc_alloc_append_block(inode_ref, 0,
+			    &phys_block);
 			if (rc != EOK)
 				goto finish;
 
@@ -1021,18 +1022,19 @@ errno_t ext4_extent_append_block(ext4_inode_ref_t *inode_ref, uint32_t *iblock,
 			goto finish;
 		} else {
 			/* Existing extent contains some blocks */
-			phys_block = ext4_extent_get_start(path_ptr->extent);
-			phys_block += ext4_extent_get_block_count(path_ptr->extent);
+			uint32_t next_block =
+			    ext4_extent_get_start(path_ptr->extent) +
+			    ext4_extent_get_block_count(path_ptr->extent);
 
-			/* Check if the following block is free for allocation */
-			bool free;
-			rc = ext4_balloc_try_alloc_block(inode_ref, phys_block, &free);
+			/* Prefer the block following the extent */
+			rc = ext4_balloc_alloc_append_block(inode_ref, next_block,
+			    &phys_block);
 			if (rc != EOK)
 				goto finish;
 
-			if (!free) {
-				/* Target is not free, new block must be appended to new extent */
-				goto append_extent;
+			if (phys_block != next_block) {
+				/* Not contiguous, block must be appended to new extent */
+				goto new_extent;
 			}
 
 			/* Update extent */
@@ -1055,10 +1057,11 @@ append_extent:
 	phys_block = 0;
 
 	/* Allocate new data block */
-	rc = ext4_balloc_alloc_block(inode_ref, &phys_block);
+	rc = ext4_balloc_alloc_append_block(inode_ref, 0, &phys_block);
 	if (rc != EOK)
 		goto finish;
 
+new_extent:
 	/* Append extent for new block (includes tree splitting if needed) */
 	rc = ext4_extent_append_extent(inode_ref, path, new_block_idx);
 	if (rc != EOK) {
@@ -80,6 +80,8 @@ static errno_t ext4_filesystem_init(ext4_filesystem_t *fs, service_id_t service_
 	ext4_superblock_t *temp_superblock = NULL;
 
 	fs->device = service_id;
+	list_initialize(&fs->prealloc);
+	fs->prealloc_count = 0;
 
 	/* Initialize block library (4096 is size of communication channel) */
 	rc = block_init(fs->device, 4096);
@@ -481,9 +483,14 @@ error:
  */
 errno_t ext4_filesystem_close(ext4_filesystem_t *fs)
 {
+	/* Return unused preallocated blocks */
+	errno_t rc = ext4_balloc_prealloc_release_all(fs);
+	if (rc != EOK)
+		return rc;
+
 	/* Write the superblock to the device */
 	ext4_superblock_set_state(fs->superblock, EXT4_SUPERBLOCK_STATE_VALID_FS);
-	errno_t rc = ext4_superblock_write_direct(fs->device, fs->superblock);
+	rc = ext4_superblock_write_direct(fs->device, fs->superblock);
 	if (rc != EOK)
 		return rc;
 
@@ -1370,6 +1377,10 @@ errno_t ext4_filesystem_free_inode(ext4_inode_ref_t *inode_ref)
 {
 	ext4_filesystem_t *fs = inode_ref->fs;
 
+	errno_t rc_pa = ext4_balloc_prealloc_release(fs, inode_ref->index);
+	if (rc_pa != EOK)
+		return rc_pa;
+
 	/* For extents must be data block destroyed by other way */
 	if ((ext4_superblock_has_feature_incompatible(fs->superblock,
 	    EXT4_FEATURE_INCOMPAT_EXTENTS)) &&
@@ -1538,6 +1549,12 @@ errno_t ext4_filesystem_truncate_inode(ext4_inode_ref_t *inode_ref,
 	if (old_size < new_size)
 		return EINVAL;
 
+	/* The preallocation window would no longer follow the file's end */
+	errno_t rc_pa = ext4_balloc_prealloc_release(inode_ref->fs,
+	    inode_ref->index);
+	if (rc_pa != EOK)
+		return rc_pa;
+
 	/* Compute how many blocks will be released */
 	aoff64_t size_diff = old_size - new_size;
 	uint32_t block_size  = ext4_superblock_get_block_size(sb);
@@ -333,6 +333,7 @@ errno_t ext4_node_get_core(fs_node_t **rfn, ext4_instance_t *inst,
 	enode->inode_ref = inode_ref;
 	enode->instance = inst;
 	enode->references = 1;
+	enode->opened = 0;
 	enode->fs_node = fs_node;
 
 	fs_node->data = enode;
@@ -373,7 +374,8 @@ static errno_t ext4_node_put_core(ext4_node_t *enode)
 
 /** Open node.
  *
- * This operation is stateless in this driver.
+ * The node is kept loaded until the matching close so that the number
+ * of opens survives between requests.
  *
  * @param fn Node to open
  *
@@ -382,7 +384,13 @@ static errno_t ext4_node_put_core(ext4_node_t *enode)
  */
 errno_t ext4_node_open(fs_node_t *fn)
 {
-	/* Stateless operation */
+	fibril_mutex_lock(&open_nodes_lock);
+
+	ext4_node_t *enode = EXT4_NODE(fn);
+	enode->opened++;
+	enode->references++;
+
+	fibril_mutex_unlock(&open_nodes_lock);
 	return EOK;
 }
 
@@ -461,6 +469,7 @@ errno_t ext4_create_node(fs_node_t **rfn, service_id_t service_id, int flags)
 	enode->inode_ref = inode_ref;
 	enode->instance = inst;
 	enode->references = 1;
+	enode->opened = 0;
 
 	fibril_mutex_lock(&open_nodes_lock);
 	hash_table_insert(&open_nodes, &enode->link);
@@ -1435,6 +1444,9 @@ static errno_t ext4_truncate(service_id_t service_id, fs_index_t index,
 }
 
 /** Close file.
+ *
+ * The file's preallocation window is released when the last open
+ * of the node is closed.
  *
  * @param service_id Device identifier
  * @param index      I-node number
@@ -1444,7 +1456,34 @@ static errno_t ext4_truncate(service_id_t service_id, fs_index_t index,
  */
 static errno_t ext4_close(service_id_t service_id, fs_index_t index)
 {
-	return EOK;
+	fs_node_t *fn;
+	errno_t rc = ext4_node_get(&fn, service_id, index);
+	if (rc != EOK)
+		return rc;
+
+	ext4_node_t *enode = EXT4_NODE(fn);
+
+	fibril_mutex_lock(&open_nodes_lock);
+
+	/* Drop the reference taken by ext4_node_open() */
+	assert(enode->opened > 0);
+	assert(enode->references > 1);
+	enode->opened--;
+	enode->references--;
+	bool last = (enode->opened == 0);
+
+	fibril_mutex_unlock(&open_nodes_lock);
+
+	/*
+	 * VFS closes every file object separately. Keep the preallocation
+	 * window while another open file may still be writing through it.
+	 */
+	if (last)
+		rc = ext4_balloc_prealloc_release(enode->instance->filesystem,
+		    index);
+
+	errno_t rc2 = ext4_node_put(fn);
+	return (rc != EOK) ? rc : rc2;
 }
 
 /** Destroy node specified by index.
@@ -554,6 +554,18 @@ void libfs_lookup(libfs_ops_t *ops, fs_handle_t fs_handle, ipc_call_t *req)
 	fs_node_t *tmp = NULL;
 	unsigned clen = 0;
 
+	/* Nodes found on the way, reported back if asked to. */
+	vfs_lookup_step_t steps[VFS_LOOKUP_STEPS_MAX];
+	size_t nsteps = 0;
+	ipc_call_t tcall;
+	size_t tsize;
+
+	if ((lflag & L_TRACE) && !async_data_read_receive(&tcall, &tsize)) {
+		async_answer_0(&tcall, EINVAL);
+		async_answer_0(req, EINVAL);
+		return;
+	}
+
 	rc = ops->node_get(&cur, service_id, index);
 	if (rc != EOK) {
 		async_answer_0(req, rc);
@@ -612,6 +624,14 @@ void libfs_lookup(libfs_ops_t *ops, fs_handle_t fs_handle, ipc_call_t *req)
 		par = cur;
 		cur = tmp;
 		tmp = NULL;
+
+		if ((lflag & L_TRACE) && cur && (nsteps < VFS_LOOKUP_STEPS_MAX)) {
+			steps[nsteps++] = (vfs_lookup_step_t) {
+				.size = ops->size_get(cur),
+				.index = ops->index_get(cur),
+				.directory = ops->is_directory(cur)
+			};
+		}
 	}
 
 	/*
@@ -703,6 +723,11 @@ out1:
 	    UPPER32(ops->size_get(cur)));
 
 out:
+	if (lflag & L_TRACE) {
+		(void) async_data_read_finalize(&tcall, steps,
+		    min(tsize, nsteps * sizeof(vfs_lookup_step_t)));
+	}
+
 	if (par)
 		(void) ops->node_put(par);
 
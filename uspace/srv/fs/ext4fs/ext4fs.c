@@ -50,7 +50,9 @@
 
 vfs_info_t ext4fs_vfs_info = {
 	.name = NAME,
-	.instance = 0
+	.instance = 0,
+	.page_cache = true,
+	.dentry_cache = true
 };
 
 int main(int argc, char **argv)
@@ -243,20 +243,18 @@ typedef struct fat_node {
 	bool			dirty;
 
 	/*
-	 * Cache of the node's last and "current" cluster to avoid some
-	 * unnecessary FAT walks.
+	 * Cache of the node's last cluster to avoid some unnecessary FAT
+	 * walks.
 	 */
-	/* Node's last cluster in FAT. */
 	bool		lastc_cached_valid;
 	fat_cluster_t	lastc_cached_value;
-	/* Node's "current" cluster, i.e. where the last I/O took place. */
-	bool		currc_cached_valid;
-	aoff64_t	currc_cached_bn;
-	fat_cluster_t	currc_cached_value;
+	/* Extent map of the node's cluster chain. */
+	fat_extmap_t	extmap;
 } fat_node_t;
 
 typedef struct {
 	bool lfn_enabled;
+	fat_clmap_t clmap;
 } fat_instance_t;
 
 extern vfs_out_ops_t fat_ops;
@@ -52,10 +52,18 @@
 
 #define IS_ODD(number)	(number & 0x1)
 
+/** Number of clusters freed in one batch of FAT updates. */
+#define FAT_FREE_BATCH	64
+
+/** Initial and maximum number of extents in a node's extent map. */
+#define FAT_EXTMAP_INIT	8
+#define FAT_EXTMAP_MAX	4096
+
 /**
  * The fat_alloc_lock mutex protects all copies of the File Allocation Table
- * during allocation of clusters. The lock does not have to be held durring
- * deallocation of clusters.
+ * during allocation of clusters and the free cluster maps. The lock does not
+ * have to be held durring deallocation of clusters, except for returning
+ * them to the free cluster map.
  */
 static FIBRIL_MUTEX_INITIALIZE(fat_alloc_lock);
 
@@ -126,16 +134,16 @@ errno_t
 fat_block_get(block_t **block, struct fat_bs *bs, fat_node_t *nodep,
     aoff64_t bn, int flags)
 {
-	fat_cluster_t firstc = nodep->firstc;
 	fat_cluster_t currc = 0;
-	aoff64_t relbn = bn;
 	errno_t rc;
 
 	if (!nodep->size)
 		return ELIMIT;
 
-	if (!FAT_IS_FAT32(bs) && nodep->firstc == FAT_CLST_ROOT)
-		goto fall_through;
+	if (!FAT_IS_FAT32(bs) && nodep->firstc == FAT_CLST_ROOT) {
+		return _fat_block_get(block, bs, nodep->idx->service_id,
+		    nodep->firstc, NULL, bn, flags);
+	}
 
 	if (((((nodep->size - 1) / BPS(bs)) / SPC(bs)) == bn / SPC(bs)) &&
 	    nodep->lastc_cached_valid) {
@@ -147,28 +155,187 @@ fat_block_get(block_t **block, struct fat_bs *bs, fat_node_t *nodep,
 		    CLBN2PBN(bs, nodep->lastc_cached_value, bn), flags);
 	}
 
-	if (nodep->currc_cached_valid && bn >= nodep->currc_cached_bn) {
-		/*
-		 * We can start with the cluster cached by the previous call to
-		 * fat_block_get().
-		 */
-		firstc = nodep->currc_cached_value;
-		relbn -= (nodep->currc_cached_bn / SPC(bs)) * SPC(bs);
-	}
-
-fall_through:
-	rc = _fat_block_get(block, bs, nodep->idx->service_id, firstc,
-	    &currc, relbn, flags);
+	rc = fat_cluster_lookup(bs, nodep, bn / SPC(bs), &currc);
 	if (rc != EOK)
 		return rc;
 
+	return block_get(block, nodep->idx->service_id,
+	    CLBN2PBN(bs, currc, bn), flags);
+}
+
+/** Initialize an empty extent map. */
+void fat_extmap_init(fat_extmap_t *map)
+{
+	fibril_mutex_initialize(&map->lock);
+	map->extents = NULL;
+	map->count = 0;
+	map->alloc = 0;
+	map->clusters = 0;
+}
+
+/** Release the extent map. */
+void fat_extmap_fini(fat_extmap_t *map)
+{
+	free(map->extents);
+	map->extents = NULL;
+	map->count = 0;
+	map->alloc = 0;
+	map->clusters = 0;
+}
+
+/** Add the next cluster of the chain to the extent map.
+ *
+ * @return		EOK on success, ELIMIT if the map has reached its
+ *			maximum size or ENOMEM.
+ */
+static errno_t fat_extmap_append(fat_extmap_t *map, fat_cluster_t clst)
+{
+	if (map->count > 0) {
+		fat_extent_t *last = &map->extents[map->count - 1];
+		if (last->pcn + last->len == clst) {
+			last->len++;
+			map->clusters++;
+			return EOK;
+		}
+	}
+
+	if (map->count == FAT_EXTMAP_MAX)
+		return ELIMIT;
+
+	if (map->count == map->alloc) {
+		size_t alloc = map->alloc ? 2 * map->alloc : FAT_EXTMAP_INIT;
+		fat_extent_t *extents = realloc(map->extents,
+		    alloc * sizeof(fat_extent_t));
+		if (extents == NULL)
+			return ENOMEM;
+		map->extents = extents;
+		map->alloc = alloc;
+	}
+
+	map->extents[map->count].lcn = map->clusters;
+	map->extents[map->count].pcn = clst;
+	map->extents[map->count].len = 1;
+	map->count++;
+	map->clusters++;
+
+	return EOK;
+}
+
+/** Trim the extent map after the given cluster.
+ *
+ * @param map		Extent map.
+ * @param lcl		Last cluster which remains in the chain or
+ *			FAT_CLST_RES0 if the whole chain is gone.
+ */
+static void fat_extmap_chop(fat_extmap_t *map, fat_cluster_t lcl)
+{
+	fibril_mutex_lock(&map->lock);
+
+	if (lcl == FAT_CLST_RES0) {
+		map->count = 0;
+		map->clusters = 0;
+	}
+
 	/*
-	 * Update the "current" cluster cache.
+	 * If lcl is not mapped, it lies behind the mapped part of the chain
+	 * and the map remains valid as it is.
 	 */
-	nodep->currc_cached_valid = true;
-	nodep->currc_cached_bn = bn;
-	nodep->currc_cached_value = currc;
+	for (size_t i = 0; i < map->count; i++) {
+		fat_extent_t *ext = &map->extents[i];
+		if (lcl >= ext->pcn && lcl < ext->pcn + ext->len) {
+			ext->len = lcl - ext->pcn + 1;
+			map->count = i + 1;
+			map->clusters = ext->lcn + ext->len;
+			break;
+		}
+	}
+
+	fibril_mutex_unlock(&map->lock);
+}
+
+/** Find the cluster at the given position in a node's cluster chain.
+ *
+ * The node's extent map is extended as far as necessary and consulted
+ * with a binary search, so that only the part of the chain which has not
+ * been visited before needs to be walked in FAT.
+ *
+ * @param bs		Buffer holding the boot sector of the file system.
+ * @param nodep		FAT node.
+ * @param lcn		Position of the cluster within the chain.
+ * @param clp		Output parameter for the cluster.
+ *
+ * @return		EOK on success or an error code.
+ */
+errno_t fat_cluster_lookup(fat_bs_t *bs, fat_node_t *nodep, uint32_t lcn,
+    fat_cluster_t *clp)
+{
+	fat_extmap_t *map = &nodep->extmap;
+	service_id_t service_id = nodep->idx->service_id;
+	fat_cluster_t clst_last1 = FAT_CLST_LAST1(bs);
+	fat_cluster_t next;
+	errno_t rc = EOK;
+
+	if (nodep->firstc == FAT_CLST_RES0)
+		return ELIMIT;
+
+	fibril_mutex_lock(&map->lock);
+
+	while (map->clusters <= lcn) {
+		if (map->count == 0) {
+			next = nodep->firstc;
+		} else {
+			fat_extent_t *last = &map->extents[map->count - 1];
+			rc = fat_get_cluster(bs, service_id, FAT1,
+			    last->pcn + last->len - 1, &next);
+			if (rc != EOK)
+				break;
+		}
+
+		if (next < FAT_CLST_FIRST || next >= clst_last1) {
+			/* The chain is shorter than expected. */
+			rc = ELIMIT;
+			break;
+		}
+		assert(next != FAT_CLST_BAD(bs));
+
+		rc = fat_extmap_append(map, next);
+		if (rc != EOK)
+			break;
+	}
+
+	if (rc == ELIMIT && map->count == FAT_EXTMAP_MAX) {
+		/*
+		 * The map is full, walk the rest of the chain from its last
+		 * mapped cluster.
+		 */
+		fat_extent_t *last = &map->extents[map->count - 1];
+		uint32_t clusters;
+
+		rc = fat_cluster_walk(bs, service_id,
+		    last->pcn + last->len - 1, clp, &clusters,
+		    lcn - (map->clusters - 1));
+		if (rc == EOK && clusters != lcn - (map->clusters - 1))
+			rc = ELIMIT;
+		fibril_mutex_unlock(&map->lock);
+		return rc;
+	}
+
+	if (rc == EOK) {
+		size_t lo = 0;
+		size_t hi = map->count;
+
+		while (hi - lo > 1) {
+			size_t mid = (lo + hi) / 2;
+			if (map->extents[mid].lcn <= lcn)
+				lo = mid;
+			else
+				hi = mid;
+		}
 
+		*clp = map->extents[lo].pcn + (lcn - map->extents[lo].lcn);
+	}
+
+	fibril_mutex_unlock(&map->lock);
 	return rc;
 }
 
@@ -654,25 +821,302 @@ errno_t fat_alloc_shadow_clusters(fat_bs_t *bs, service_id_t service_id,
 	return EOK;
 }
 
-/** Allocate clusters in all copies of FAT.
+/** Set a list of clusters in one instance of FAT.
  *
- * This function will attempt to allocate the requested number of clusters in
- * all instances of the FAT.  The FAT will be altered so that the allocated
- * clusters form an independent chain (i.e. a chain which does not belong to any
- * file yet).
+ * Consecutive entries which share a FAT block are updated with a single
+ * block_get()/block_put() pair, so writing a contiguous chain costs one
+ * block operation per FAT block rather than one per cluster.
  *
  * @param bs		Buffer holding the boot sector of the file system.
  * @param service_id	Device service ID of the file system.
- * @param nclsts	Number of clusters to allocate.
- * @param mcl		Output parameter where the first cluster in the chain
- *			will be returned.
- * @param lcl		Output parameter where the last cluster in the chain
- *			will be returned.
+ * @param fatno		Number of the FAT instance where to make the change.
+ * @param clsts		Clusters to set.
+ * @param nclsts	Number of clusters in @a clsts.
+ * @param chain		If true, link the clusters into a chain terminated
+ *			after the last one. Otherwise mark them free.
  *
- * @return		EOK on success, an error code otherwise.
+ * @return		EOK on success or an error code.
  */
-errno_t
-fat_alloc_clusters(fat_bs_t *bs, service_id_t service_id, unsigned nclsts,
+static errno_t
+fat_set_clusters(fat_bs_t *bs, service_id_t service_id, unsigned fatno,
+    fat_cluster_t *clsts, unsigned nclsts, bool chain)
+{
+	fat_cluster_t clst_last1 = FAT_CLST_LAST1(bs);
+	block_t *b = NULL;
+	aoff64_t blk = 0;
+	unsigned i;
+	errno_t rc = EOK;
+
+	for (i = 0; i < nclsts; i++) {
+		fat_cluster_t value = FAT_CLST_RES0;
+		if (chain)
+			value = (i + 1 < nclsts) ? clsts[i + 1] : clst_last1;
+
+		if (FAT_IS_FAT12(bs)) {
+			/* FAT12 entries may straddle blocks. */
+			rc = fat_set_cluster(bs, service_id, fatno, clsts[i],
+			    value);
+			if (rc != EOK)
+				return rc;
+			continue;
+		}
+
+		aoff64_t offset = clsts[i] * FAT_CLST_SIZE(bs);
+		aoff64_t bn = RSCNT(bs) + SF(bs) * fatno + offset / BPS(bs);
+
+		if (b == NULL || bn != blk) {
+			if (b != NULL) {
+				rc = block_put(b);
+				b = NULL;
+				if (rc != EOK)
+					return rc;
+			}
+			rc = block_get(&b, service_id, bn, BLOCK_FLAGS_NONE);
+			if (rc != EOK)
+				return rc;
+			blk = bn;
+		}
+
+		if (FAT_IS_FAT32(bs)) {
+			uint32_t *entry = (uint32_t *) (b->data +
+			    offset % BPS(bs));
+			fat_cluster_t temp = uint32_t_le2host(*entry);
+			temp &= 0xf0000000;
+			temp |= (value & FAT32_MASK);
+			*entry = host2uint32_t_le(temp);
+		} else {
+			uint16_t *entry = (uint16_t *) (b->data +
+			    offset % BPS(bs));
+			*entry = host2uint16_t_le(value);
+		}
+		b->dirty = true;	/* need to sync block */
+	}
+
+	if (b != NULL)
+		rc = block_put(b);
+
+	return rc;
+}
+
+static inline bool clmap_used(fat_clmap_t *cm, fat_cluster_t clst)
+{
+	return (cm->bits[clst / 32] & (1U << (clst % 32))) != 0;
+}
+
+static inline void clmap_set(fat_clmap_t *cm, fat_cluster_t clst, bool used)
+{
+	if (used)
+		cm->bits[clst / 32] |= 1U << (clst % 32);
+	else
+		cm->bits[clst / 32] &= ~(1U << (clst % 32));
+}
+
+/** Initialize an empty free cluster map. */
+void fat_clmap_init(fat_clmap_t *cm)
+{
+	cm->bits = NULL;
+	cm->nfree = 0;
+	cm->hint = FAT_CLST_FIRST;
+	cm->failed = false;
+}
+
+/** Release the free cluster map. */
+void fat_clmap_fini(fat_clmap_t *cm)
+{
+	free(cm->bits);
+	fat_clmap_init(cm);
+}
+
+/** Build the free cluster map from FAT1.
+ *
+ * FAT16 and FAT32 tables are read a block at a time. FAT12 volumes have at
+ * most a few thousand clusters, so they simply use fat_get_cluster().
+ */
+static errno_t fat_clmap_load(fat_bs_t *bs, service_id_t service_id,
+    fat_clmap_t *cm)
+{
+	fat_cluster_t total = CC(bs) + 2;
+	size_t per_block = BPS(bs) / FAT_CLST_SIZE(bs);
+	fat_cluster_t clst;
+	fat_cluster_t value;
+	block_t *b;
+	errno_t rc;
+
+	cm->bits = calloc((total + 31) / 32, sizeof(uint32_t));
+	if (cm->bits == NULL)
+		return ENOMEM;
+
+	/* Clusters past the end of the FAT are never free. */
+	for (clst = total; clst % 32 != 0; clst++)
+		clmap_set(cm, clst, true);
+
+	cm->nfree = 0;
+	clst = 0;
+	while (clst < total) {
+		if (FAT_IS_FAT12(bs)) {
+			rc = fat_get_cluster(bs, service_id, FAT1, clst,
+			    &value);
+			if (rc != EOK)
+				goto error;
+			if (clst < FAT_CLST_FIRST || value != FAT_CLST_RES0)
+				clmap_set(cm, clst, true);
+			else
+				cm->nfree++;
+			clst++;
+			continue;
+		}
+
+		rc = block_get(&b, service_id, RSCNT(bs) + clst / per_block,
+		    BLOCK_FLAGS_NONE);
+		if (rc != EOK)
+			goto error;
+
+		for (size_t i = 0; i < per_block && clst < total; i++, clst++) {
+			if (FAT_IS_FAT32(bs)) {
+				value = uint32_t_le2host(
+				    ((uint32_t *) b->data)[i]) & FAT32_MASK;
+			} else {
+				value = uint16_t_le2host(
+				    ((uint16_t *) b->data)[i]);
+			}
+
+			if (clst < FAT_CLST_FIRST || value != FAT_CLST_RES0)
+				clmap_set(cm, clst, true);
+			else
+				cm->nfree++;
+		}
+
+		rc = block_put(b);
+		if (rc != EOK)
+			goto error;
+	}
+
+	cm->hint = FAT_CLST_FIRST;
+	return EOK;
+
+error:
+	free(cm->bits);
+	cm->bits = NULL;
+	return rc;
+}
+
+/** Get the free cluster map of a file system instance.
+ *
+ * The map is built on first use. Must be called with fat_alloc_lock held.
+ *
+ * @return		The map or NULL if it is not available, in which case
+ *			the caller should fall back to scanning FAT1.
+ */
+static fat_clmap_t *fat_clmap_get(fat_bs_t *bs, service_id_t service_id)
+{
+	fat_instance_t *instance;
+	void *data;
+
+	if (fs_instance_get(service_id, &data) != EOK)
+		return NULL;
+	instance = (fat_instance_t *) data;
+
+	if (instance->clmap.bits == NULL && !instance->clmap.failed) {
+		if (fat_clmap_load(bs, service_id, &instance->clmap) != EOK)
+			instance->clmap.failed = true;
+	}
+
+	return instance->clmap.bits != NULL ? &instance->clmap : NULL;
+}
+
+/** Look for a run of free clusters in a range of the map.
+ *
+ * @param cm		Free cluster map.
+ * @param from		First cluster of the range.
+ * @param to		Cluster just past the range.
+ * @param want		Desired length of the run.
+ * @param best		Start of the longest run seen so far.
+ * @param best_len	Length of the longest run seen so far.
+ *
+ * @return		True if a run of @a want clusters was found.
+ */
+static bool fat_clmap_scan(fat_clmap_t *cm, fat_cluster_t from,
+    fat_cluster_t to, unsigned want, fat_cluster_t *best, unsigned *best_len)
+{
+	fat_cluster_t clst = from;
+
+	while (clst < to) {
+		/* Skip words with no free cluster at once. */
+		if (clst % 32 == 0 && cm->bits[clst / 32] == UINT32_MAX) {
+			clst += 32;
+			continue;
+		}
+
+		if (clmap_used(cm, clst)) {
+			clst++;
+			continue;
+		}
+
+		fat_cluster_t start = clst;
+		while (clst < to && !clmap_used(cm, clst) &&
+		    clst - start < want)
+			clst++;
+
+		if (clst - start > *best_len) {
+			*best = start;
+			*best_len = clst - start;
+			if (*best_len == want)
+				return true;
+		}
+	}
+
+	return false;
+}
+
+/** Pick free clusters using the free cluster map.
+ *
+ * The search is next-fit: it starts at the cluster following the previous
+ * allocation and prefers a single contiguous run of the requested length.
+ * If there is no such run, the clusters are collected in ascending order
+ * starting at the longest free run found.
+ *
+ * @param bs		Buffer holding the boot sector of the file system.
+ * @param cm		Free cluster map with at least @a nclsts free clusters.
+ * @param clsts		Output array for the picked clusters, in chain order.
+ * @param nclsts	Number of clusters to pick.
+ */
+static void fat_clmap_pick(fat_bs_t *bs, fat_clmap_t *cm, fat_cluster_t *clsts,
+    unsigned nclsts)
+{
+	fat_cluster_t total = CC(bs) + 2;
+	fat_cluster_t best = FAT_CLST_FIRST;
+	unsigned best_len = 0;
+	fat_cluster_t clst;
+	unsigned found = 0;
+
+	if (cm->hint < FAT_CLST_FIRST || cm->hint >= total)
+		cm->hint = FAT_CLST_FIRST;
+
+	if (!fat_clmap_scan(cm, cm->hint, total, nclsts, &best, &best_len))
+		(void) fat_clmap_scan(cm, FAT_CLST_FIRST, cm->hint, nclsts,
+		    &best, &best_len);
+
+	clst = best;
+	while (found < nclsts) {
+		if (clst >= total)
+			clst = FAT_CLST_FIRST;
+		if (!clmap_used(cm, clst)) {
+			clmap_set(cm, clst, true);
+			clsts[found++] = clst;
+		}
+		clst++;
+	}
+
+	cm->nfree -= nclsts;
+	cm->hint = clst;
+}
+
+/** Allocate clusters by scanning FAT1.
+ *
+ * This is used when the free cluster map is not available.
+ */
+static errno_t
+fat_alloc_clusters_scan(fat_bs_t *bs, service_id_t service_id, unsigned nclsts,
     fat_cluster_t *mcl, fat_cluster_t *lcl)
 {
 	fat_cluster_t *lifo;    /* stack for storing free cluster numbers */
@@ -689,7 +1133,6 @@ fat_alloc_clusters(fat_bs_t *bs, service_id_t service_id, unsigned nclsts,
 	/*
 	 * Search FAT1 for unused clusters.
 	 */
-	fibril_mutex_lock(&fat_alloc_lock);
 	for (clst = FAT_CLST_FIRST; clst < CC(bs) + 2 && found < nclsts;
 	    clst++) {
 		rc = fat_get_cluster(bs, service_id, FAT1, clst, &value);
@@ -717,7 +1160,6 @@ fat_alloc_clusters(fat_bs_t *bs, service_id_t service_id, unsigned nclsts,
 			*mcl = lifo[found - 1];
 			*lcl = lifo[0];
 			free(lifo);
-			fibril_mutex_unlock(&fat_alloc_lock);
 			return EOK;
 		}
 	}
@@ -729,12 +1171,113 @@ fat_alloc_clusters(fat_bs_t *bs, service_id_t service_id, unsigned nclsts,
 	}
 
 	free(lifo);
-	fibril_mutex_unlock(&fat_alloc_lock);
 
 	return ENOSPC;
 }
 
+/** Allocate clusters in all copies of FAT.
+ *
+ * This function will attempt to allocate the requested number of clusters in
+ * all instances of the FAT.  The FAT will be altered so that the allocated
+ * clusters form an independent chain (i.e. a chain which does not belong to any
+ * file yet).
+ *
+ * @param bs		Buffer holding the boot sector of the file system.
+ * @param service_id	Device service ID of the file system.
+ * @param nclsts	Number of clusters to allocate.
+ * @param mcl		Output parameter where the first cluster in the chain
+ *			will be returned.
+ * @param lcl		Output parameter where the last cluster in the chain
+ *			will be returned.
+ *
+ * @return		EOK on success, an error code otherwise.
+ */
+errno_t
+fat_alloc_clusters(fat_bs_t *bs, service_id_t service_id, unsigned nclsts,
+    fat_cluster_t *mcl, fat_cluster_t *lcl)
+{
+	fat_cluster_t *clsts;
+	fat_clmap_t *cm;
+	unsigned fatno;
+	errno_t rc = EOK;
+
+	fibril_mutex_lock(&fat_alloc_lock);
+
+	cm = fat_clmap_get(bs, service_id);
+	if (cm == NULL) {
+		rc = fat_alloc_clusters_scan(bs, service_id, nclsts, mcl, lcl);
+		fibril_mutex_unlock(&fat_alloc_lock);
+		return rc;
+	}
+
+	if (cm->nfree < nclsts) {
+		fibril_mutex_unlock(&fat_alloc_lock);
+		return ENOSPC;
+	}
+
+	clsts = (fat_cluster_t *) malloc(nclsts * sizeof(fat_cluster_t));
+	if (!clsts) {
+		fibril_mutex_unlock(&fat_alloc_lock);
+		return ENOMEM;
+	}
+
+	fat_clmap_pick(bs, cm, clsts, nclsts);
+
+	for (fatno = FAT1; fatno < FATCNT(bs); fatno++) {
+		rc = fat_set_clusters(bs, service_id, fatno, clsts, nclsts,
+		    true);
+		if (rc != EOK)
+			break;
+	}
+
+	if (rc == EOK) {
+		*mcl = clsts[0];
+		*lcl = clsts[nclsts - 1];
+	} else {
+		/* Return the clusters to all copies of FAT and to the map. */
+		for (fatno = FAT1; fatno < FATCNT(bs); fatno++) {
+			(void) fat_set_clusters(bs, service_id, fatno, clsts,
+			    nclsts, false);
+		}
+		for (unsigned i = 0; i < nclsts; i++)
+			clmap_set(cm, clsts[i], false);
+		cm->nfree += nclsts;
+	}
+
+	free(clsts);
+	fibril_mutex_unlock(&fat_alloc_lock);
+
+	return rc;
+}
+
+/** Get the number of free clusters.
+ *
+ * @param bs		Buffer holding the boot sector of the file system.
+ * @param service_id	Device service ID of the file system.
+ * @param count		Output parameter for the number of free clusters.
+ *
+ * @return		EOK on success, ENOTSUP if the free cluster map is
+ *			not available.
+ */
+errno_t fat_free_cluster_count(fat_bs_t *bs, service_id_t service_id,
+    uint32_t *count)
+{
+	fat_clmap_t *cm;
+
+	fibril_mutex_lock(&fat_alloc_lock);
+	cm = fat_clmap_get(bs, service_id);
+	if (cm != NULL)
+		*count = cm->nfree;
+	fibril_mutex_unlock(&fat_alloc_lock);
+
+	return cm != NULL ? EOK : ENOTSUP;
+}
+
 /** Free clusters forming a cluster chain in all copies of FAT.
+ *
+ * The chain is freed in batches so that the FAT blocks are updated in
+ * bulk. The clusters are returned to the free cluster map only after they
+ * have been marked free in all copies of FAT.
  *
  * @param bs		Buffer hodling the boot sector of the file system.
  * @param service_id	Device service ID of the file system.
@@ -745,27 +1288,44 @@ fat_alloc_clusters(fat_bs_t *bs, service_id_t service_id, unsigned nclsts,
 errno_t
 fat_free_clusters(fat_bs_t *bs, service_id_t service_id, fat_cluster_t firstc)
 {
+	fat_cluster_t batch[FAT_FREE_BATCH];
 	unsigned fatno;
-	fat_cluster_t nextc = 0;
+	unsigned n;
 	fat_cluster_t clst_bad = FAT_CLST_BAD(bs);
+	fat_clmap_t *cm;
 	errno_t rc;
 
 	/* Mark all clusters in the chain as free in all copies of FAT. */
 	while (firstc < FAT_CLST_LAST1(bs)) {
-		assert(firstc >= FAT_CLST_FIRST && firstc < clst_bad);
+		for (n = 0; n < FAT_FREE_BATCH &&
+		    firstc < FAT_CLST_LAST1(bs); n++) {
+			assert(firstc >= FAT_CLST_FIRST && firstc < clst_bad);
 
-		rc = fat_get_cluster(bs, service_id, FAT1, firstc, &nextc);
-		if (rc != EOK)
-			return rc;
+			batch[n] = firstc;
+			rc = fat_get_cluster(bs, service_id, FAT1, firstc,
+			    &firstc);
+			if (rc != EOK)
+				return rc;
+		}
 
 		for (fatno = FAT1; fatno < FATCNT(bs); fatno++) {
-			rc = fat_set_cluster(bs, service_id, fatno, firstc,
-			    FAT_CLST_RES0);
+			rc = fat_set_clusters(bs, service_id, fatno, batch, n,
+			    false);
 			if (rc != EOK)
 				return rc;
 		}
 
-		firstc = nextc;
+		fibril_mutex_lock(&fat_alloc_lock);
+		cm = fat_clmap_get(bs, service_id);
+		if (cm != NULL) {
+			for (unsigned i = 0; i < n; i++) {
+				if (clmap_used(cm, batch[i])) {
+					clmap_set(cm, batch[i], false);
+					cm->nfree++;
+				}
+			}
+		}
+		fibril_mutex_unlock(&fat_alloc_lock);
 	}
 
 	return EOK;
@@ -811,6 +1371,10 @@ errno_t fat_append_clusters(fat_bs_t *bs, fat_node_t *nodep, fat_cluster_t mcl,
 		}
 	}
 
+	/*
+	 * The extent map will pick up the new clusters the next time it is
+	 * extended past its current end.
+	 */
 	nodep->lastc_cached_valid = true;
 	nodep->lastc_cached_value = lcl;
 
@@ -837,8 +1401,7 @@ errno_t fat_chop_clusters(fat_bs_t *bs, fat_node_t *nodep, fat_cluster_t lcl)
 	 * Invalidate cached cluster numbers.
 	 */
 	nodep->lastc_cached_valid = false;
-	if (nodep->currc_cached_value != lcl)
-		nodep->currc_cached_valid = false;
+	fat_extmap_chop(&nodep->extmap, lcl);
 
 	if (lcl == FAT_CLST_RES0) {
 		/* The node will have zero size and no clusters allocated. */
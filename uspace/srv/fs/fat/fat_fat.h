@@ -35,8 +35,10 @@
 #define FAT_FAT_FAT_H_
 
 #include "../../vfs/vfs.h"
+#include <stdbool.h>
 #include <stdint.h>
 #include <block.h>
+#include <fibril_synch.h>
 
 #define FAT1		0
 
@@ -105,6 +107,49 @@ struct fat_bs;
 
 typedef uint32_t fat_cluster_t;
 
+/** In-core map of free clusters of one file system instance.
+ *
+ * The map is built from FAT1 when the first cluster is allocated and it is
+ * protected by the same lock as the allocation of clusters.
+ */
+typedef struct {
+	/** One bit per cluster, set if the cluster is in use. */
+	uint32_t *bits;
+	/** Number of free clusters. */
+	uint32_t nfree;
+	/** Cluster where the next search for free clusters starts. */
+	fat_cluster_t hint;
+	/** Building the map failed, scan FAT1 instead. */
+	bool failed;
+} fat_clmap_t;
+
+/** Contiguous run of clusters within a cluster chain. */
+typedef struct {
+	/** Position of the first cluster of the run within the chain. */
+	uint32_t lcn;
+	/** First cluster of the run. */
+	fat_cluster_t pcn;
+	/** Number of clusters in the run. */
+	uint32_t len;
+} fat_extent_t;
+
+/** Map of the leading part of a node's cluster chain.
+ *
+ * The map is extended lazily as the chain is walked and it is trimmed when
+ * the chain is chopped. Clusters appended to the chain are picked up the
+ * next time the map is extended. Lookups within the mapped part of the
+ * chain are a binary search over the extents.
+ */
+typedef struct {
+	fibril_mutex_t lock;
+	/** Extents sorted by position in the chain. */
+	fat_extent_t *extents;
+	size_t count;
+	size_t alloc;
+	/** Number of clusters covered by the extents. */
+	uint32_t clusters;
+} fat_extmap_t;
+
 #define fat_clusters_get(numc, bs, sid, fc) \
     fat_cluster_walk((bs), (sid), (fc), NULL, (numc), (uint32_t) -1)
 extern errno_t fat_cluster_walk(struct fat_bs *, service_id_t, fat_cluster_t,
@@ -124,10 +169,18 @@ extern errno_t fat_alloc_clusters(struct fat_bs *, service_id_t, unsigned,
 extern errno_t fat_free_clusters(struct fat_bs *, service_id_t, fat_cluster_t);
 extern errno_t fat_alloc_shadow_clusters(struct fat_bs *, service_id_t,
     fat_cluster_t *, unsigned);
+extern errno_t fat_free_cluster_count(struct fat_bs *, service_id_t,
+    uint32_t *);
+extern void fat_clmap_init(fat_clmap_t *);
+extern void fat_clmap_fini(fat_clmap_t *);
 extern errno_t fat_get_cluster(struct fat_bs *, service_id_t, unsigned,
     fat_cluster_t, fat_cluster_t *);
 extern errno_t fat_set_cluster(struct fat_bs *, service_id_t, unsigned,
     fat_cluster_t, fat_cluster_t);
+extern errno_t fat_cluster_lookup(struct fat_bs *, struct fat_node *,
+    uint32_t, fat_cluster_t *);
+extern void fat_extmap_init(fat_extmap_t *);
+extern void fat_extmap_fini(fat_extmap_t *);
 extern errno_t fat_fill_gap(struct fat_bs *, struct fat_node *, fat_cluster_t,
     aoff64_t);
 extern errno_t fat_zero_cluster(struct fat_bs *, service_id_t, fat_cluster_t);
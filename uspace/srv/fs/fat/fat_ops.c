@@ -108,9 +108,7 @@ static void fat_node_initialize(fat_node_t *node)
 	node->dirty = false;
 	node->lastc_cached_valid = false;
 	node->lastc_cached_value = 0;
-	node->currc_cached_valid = false;
-	node->currc_cached_bn = 0;
-	node->currc_cached_value = 0;
+	fat_extmap_init(&node->extmap);
 }
 
 static errno_t fat_node_sync(fat_node_t *node)
@@ -192,6 +190,7 @@ restart:
 				return rc;
 		}
 		nodep->idx->nodep = NULL;
+		fat_extmap_fini(&nodep->extmap);
 		free(nodep->bp);
 		free(nodep);
 
@@ -230,6 +229,7 @@ static errno_t fat_node_get_new(fat_node_t **nodepp)
 				idxp_tmp->nodep = NULL;
 				fibril_mutex_unlock(&nodep->lock);
 				fibril_mutex_unlock(&idxp_tmp->lock);
+				fat_extmap_fini(&nodep->extmap);
 				free(nodep->bp);
 				free(nodep);
 				return rc;
@@ -238,6 +238,7 @@ static errno_t fat_node_get_new(fat_node_t **nodepp)
 		idxp_tmp->nodep = NULL;
 		fibril_mutex_unlock(&nodep->lock);
 		fibril_mutex_unlock(&idxp_tmp->lock);
+		fat_extmap_fini(&nodep->extmap);
 		fn = FS_NODE(nodep);
 	} else {
 	skip_cache:
@@ -476,6 +477,7 @@ errno_t fat_node_put(fs_node_t *fn)
 	}
 	fibril_mutex_unlock(&nodep->lock);
 	if (destroy) {
+		fat_extmap_fini(&nodep->extmap);
 		free(nodep->bp);
 		free(nodep);
 	}
@@ -569,6 +571,7 @@ errno_t fat_destroy_node(fs_node_t *fn)
 	}
 
 	fat_idx_destroy(nodep->idx);
+	fat_extmap_fini(&nodep->extmap);
 	free(nodep->bp);
 	free(nodep);
 	return rc;
@@ -869,8 +872,13 @@ errno_t fat_free_block_count(service_id_t service_id, uint64_t *count)
 	errno_t rc;
 	uint32_t cluster_no, clusters;
 
-	block_count = 0;
 	bs = block_bb_get(service_id);
+	if (fat_free_cluster_count(bs, service_id, &clusters) == EOK) {
+		*count = clusters;
+		return EOK;
+	}
+
+	block_count = 0;
 	clusters = (SPC(bs)) ? TS(bs) / SPC(bs) : 0;
 	for (cluster_no = 0; cluster_no < clusters; cluster_no++) {
 		rc = fat_get_cluster(bs, service_id, FAT1, cluster_no, &e0);
@@ -1024,6 +1032,7 @@ static errno_t fat_fs_open(service_id_t service_id, enum cache_mode cmode,
 
 static void fat_fs_close(service_id_t service_id, fs_node_t *rfn)
 {
+	fat_extmap_fini(&FAT_NODE(rfn)->extmap);
 	free(rfn->data);
 	free(rfn);
 	(void) block_cache_fini(service_id);
@@ -1088,6 +1097,7 @@ fat_mounted(service_id_t service_id, const char *opts, fs_index_t *index,
 	if (!instance)
 		return ENOMEM;
 	instance->lfn_enabled = true;
+	fat_clmap_init(&instance->clmap);
 
 	/* Parse mount options. */
 	char *mntopts = (char *) opts;
@@ -1123,7 +1133,8 @@ fat_mounted(service_id_t service_id, const char *opts, fs_index_t *index,
 	return EOK;
 }
 
-static errno_t fat_update_fat32_fsinfo(service_id_t service_id)
+static errno_t fat_update_fat32_fsinfo(service_id_t service_id,
+    fat_clmap_t *clmap)
 {
 	fat_bs_t *bs;
 	fat32_fsinfo_t *info;
@@ -1147,8 +1158,14 @@ static errno_t fat_update_fat32_fsinfo(service_id_t service_id)
 		return EINVAL;
 	}
 
-	/* For now, invalidate the counter. */
-	info->free_clusters = host2uint16_t_le(-1);
+	if (clmap != NULL && clmap->bits != NULL) {
+		/* The free cluster map is exact, store it as a hint. */
+		info->free_clusters = host2uint32_t_le(clmap->nfree);
+		info->last_allocated_cluster = host2uint32_t_le(clmap->hint);
+	} else {
+		/* Otherwise invalidate the counter. */
+		info->free_clusters = host2uint16_t_le(-1);
+	}
 
 	b->dirty = true;
 	return block_put(b);
@@ -1158,10 +1175,14 @@ static errno_t fat_unmounted(service_id_t service_id)
 {
 	fs_node_t *fn;
 	fat_node_t *nodep;
+	fat_instance_t *instance = NULL;
 	fat_bs_t *bs;
+	void *data;
 	errno_t rc;
 
 	bs = block_bb_get(service_id);
+	if (fs_instance_get(service_id, &data) == EOK)
+		instance = (fat_instance_t *) data;
 
 	rc = fat_root_get(&fn, service_id);
 	if (rc != EOK)
@@ -1181,7 +1202,8 @@ static errno_t fat_unmounted(service_id_t service_id)
 		/*
 		 * Attempt to update the FAT32 FS info.
 		 */
-		(void) fat_update_fat32_fsinfo(service_id);
+		(void) fat_update_fat32_fsinfo(service_id,
+		    instance != NULL ? &instance->clmap : NULL);
 	}
 
 	/*
@@ -1197,10 +1219,10 @@ static errno_t fat_unmounted(service_id_t service_id)
 	(void) fat_node_fini_by_service_id(service_id);
 	fat_fs_close(service_id, fn);
 
-	void *data;
-	if (fs_instance_get(service_id, &data) == EOK) {
+	if (instance != NULL) {
 		fs_instance_destroy(service_id);
-		free(data);
+		fat_clmap_fini(&instance->clmap);
+		free(instance);
 	}
 
 	return EOK;
@@ -1495,8 +1517,8 @@ fat_truncate(service_id_t service_id, fs_index_t index, aoff64_t size)
 				goto out;
 		} else {
 			fat_cluster_t lastc;
-			rc = fat_cluster_walk(bs, service_id, nodep->firstc,
-			    &lastc, NULL, (size - 1) / BPC(bs));
+			rc = fat_cluster_lookup(bs, nodep, (size - 1) / BPC(bs),
+			    &lastc);
 			if (rc != EOK)
 				goto out;
 			rc = fat_chop_clusters(bs, nodep, lastc);
@@ -58,6 +58,7 @@ vfs_info_t tmpfs_vfs_info = {
 	.name = NAME,
 	.concurrent_read_write = false,
 	.write_retains_size = false,
+	.dentry_cache = true,
 	.instance = 0,
 };
 
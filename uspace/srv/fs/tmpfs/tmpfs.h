@@ -35,9 +35,18 @@
 
 #include <libfs.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <as.h>
 #include <stdbool.h>
 #include <adt/hash_table.h>
 
+/** Granularity of file content storage. */
+#define TMPFS_CHUNK_SIZE	PAGE_SIZE
+
+/** Number of chunks needed to store @a size bytes. */
+#define TMPFS_CHUNKS(size) \
+	(((size) + TMPFS_CHUNK_SIZE - 1) / TMPFS_CHUNK_SIZE)
+
 #define TMPFS_NODE(node)	((node) ? (tmpfs_node_t *)(node)->data : NULL)
 #define FS_NODE(node)		((node) ? (node)->bp : NULL)
 
@@ -64,7 +73,13 @@ typedef struct tmpfs_node {
 	tmpfs_dentry_type_t type;
 	unsigned lnkcnt;	/**< Link count. */
 	size_t size;		/**< File size if type is TMPFS_FILE. */
-	void *data;		/**< File content's if type is TMPFS_FILE. */
+	/**
+	 * File content if type is TMPFS_FILE, split into chunks of
+	 * TMPFS_CHUNK_SIZE bytes. NULL entries are holes which read as zeros.
+	 * Bytes past the end of file are always zero.
+	 */
+	uint8_t **chunks;
+	size_t chunks_cnt;	/**< Number of entries in chunks. */
 	list_t cs_list;		/**< Child's siblings list. */
 } tmpfs_node_t;
 
@@ -58,6 +58,9 @@
 /** Global counter for assigning node indices. Shared by all instances. */
 fs_index_t tmpfs_next_index = 1;
 
+/** Content of file holes. */
+static const uint8_t tmpfs_zero_chunk[TMPFS_CHUNK_SIZE];
+
 /*
  * Implementation of the libfs interface.
  */
@@ -179,9 +182,11 @@ static void nodes_remove_callback(ht_link_t *item)
 		free(dentryp);
 	}
 
-	if (nodep->data) {
+	if (nodep->chunks) {
 		assert(nodep->type == TMPFS_FILE);
-		free(nodep->data);
+		for (size_t i = 0; i < nodep->chunks_cnt; i++)
+			free(nodep->chunks[i]);
+		free(nodep->chunks);
 	}
 	free(nodep->bp);
 	free(nodep);
@@ -204,7 +209,8 @@ static void tmpfs_node_initialize(tmpfs_node_t *nodep)
 	nodep->type = TMPFS_NONE;
 	nodep->lnkcnt = 0;
 	nodep->size = 0;
-	nodep->data = NULL;
+	nodep->chunks = NULL;
+	nodep->chunks_cnt = 0;
 	list_initialize(&nodep->cs_list);
 }
 
@@ -462,6 +468,102 @@ static errno_t tmpfs_unmounted(service_id_t service_id)
 	return EOK;
 }
 
+/** Make sure that the chunk array of a file can hold @a size bytes.
+ *
+ * The array grows geometrically so that appending to a file takes
+ * amortized constant time. New entries are holes.
+ */
+static errno_t tmpfs_chunks_reserve(tmpfs_node_t *nodep, size_t size)
+{
+	size_t cnt = TMPFS_CHUNKS(size);
+	if (cnt <= nodep->chunks_cnt)
+		return EOK;
+
+	cnt = max(cnt, 2 * nodep->chunks_cnt);
+	uint8_t **chunks = realloc(nodep->chunks, cnt * sizeof(uint8_t *));
+	if (!chunks)
+		return ENOMEM;
+
+	memset(&chunks[nodep->chunks_cnt], 0,
+	    (cnt - nodep->chunks_cnt) * sizeof(uint8_t *));
+	nodep->chunks = chunks;
+	nodep->chunks_cnt = cnt;
+	return EOK;
+}
+
+/** Drop the content of a file past @a size bytes.
+ *
+ * Whole chunks are freed, the tail of the last partial chunk is cleared.
+ */
+static void tmpfs_chunks_trim(tmpfs_node_t *nodep, size_t size)
+{
+	size_t cnt = TMPFS_CHUNKS(size);
+
+	for (size_t i = cnt; i < nodep->chunks_cnt; i++) {
+		free(nodep->chunks[i]);
+		nodep->chunks[i] = NULL;
+	}
+
+	size_t offset = size % TMPFS_CHUNK_SIZE;
+	if (offset != 0 && nodep->chunks[cnt - 1]) {
+		memset(nodep->chunks[cnt - 1] + offset, 0,
+		    TMPFS_CHUNK_SIZE - offset);
+	}
+
+	/* Give back the array once the file shrinks considerably. */
+	if (cnt < nodep->chunks_cnt / 4) {
+		if (cnt == 0) {
+			free(nodep->chunks);
+			nodep->chunks = NULL;
+			nodep->chunks_cnt = 0;
+			return;
+		}
+
+		uint8_t **chunks = realloc(nodep->chunks,
+		    cnt * sizeof(uint8_t *));
+		if (chunks) {
+			nodep->chunks = chunks;
+			nodep->chunks_cnt = cnt;
+		}
+	}
+}
+
+/** Copy file contents into a contiguous buffer. Holes read as zeros. */
+static void tmpfs_chunks_gather(tmpfs_node_t *nodep, aoff64_t pos,
+    uint8_t *buf, size_t size)
+{
+	size_t done = 0;
+
+	while (done < size) {
+		size_t offset = (pos + done) % TMPFS_CHUNK_SIZE;
+		size_t len = min(size - done, TMPFS_CHUNK_SIZE - offset);
+		uint8_t *chunk = nodep->chunks[(pos + done) / TMPFS_CHUNK_SIZE];
+
+		if (chunk)
+			memcpy(buf + done, chunk + offset, len);
+		else
+			memset(buf + done, 0, len);
+
+		done += len;
+	}
+}
+
+/** Copy a contiguous buffer into file chunks, which must be allocated. */
+static void tmpfs_chunks_scatter(tmpfs_node_t *nodep, aoff64_t pos,
+    const uint8_t *buf, size_t size)
+{
+	size_t done = 0;
+
+	while (done < size) {
+		size_t offset = (pos + done) % TMPFS_CHUNK_SIZE;
+		size_t len = min(size - done, TMPFS_CHUNK_SIZE - offset);
+		uint8_t *chunk = nodep->chunks[(pos + done) / TMPFS_CHUNK_SIZE];
+
+		memcpy(chunk + offset, buf + done, len);
+		done += len;
+	}
+}
+
 static errno_t tmpfs_read(service_id_t service_id, fs_index_t index, aoff64_t pos,
     size_t *rbytes)
 {
@@ -491,9 +593,27 @@ static errno_t tmpfs_read(service_id_t service_id, fs_index_t index, aoff64_t po
 
 	size_t bytes;
 	if (nodep->type == TMPFS_FILE) {
-		bytes = min(nodep->size - pos, size);
-		(void) async_data_read_finalize(&call, nodep->data + pos,
-		    bytes);
+		bytes = (pos < nodep->size) ? min(nodep->size - pos, size) : 0;
+
+		size_t offset = pos % TMPFS_CHUNK_SIZE;
+		if (offset + bytes <= TMPFS_CHUNK_SIZE) {
+			/* Serve the data right from the chunk. */
+			const uint8_t *src = tmpfs_zero_chunk;
+			if ((bytes > 0) && nodep->chunks[pos / TMPFS_CHUNK_SIZE])
+				src = nodep->chunks[pos / TMPFS_CHUNK_SIZE] + offset;
+
+			(void) async_data_read_finalize(&call, src, bytes);
+		} else {
+			uint8_t *buf = malloc(bytes);
+			if (!buf) {
+				async_answer_0(&call, ENOMEM);
+				return ENOMEM;
+			}
+
+			tmpfs_chunks_gather(nodep, pos, buf, bytes);
+			(void) async_data_read_finalize(&call, buf, bytes);
+			free(buf);
+		}
 	} else {
 		tmpfs_dentry_t *dentryp;
 		link_t *lnk;
@@ -552,34 +672,69 @@ tmpfs_write(service_id_t service_id, fs_index_t index, aoff64_t pos,
 		return EINVAL;
 	}
 
-	/*
-	 * Check whether the file needs to grow.
-	 */
-	if (pos + size <= nodep->size) {
-		/* The file size is not changing. */
-		(void) async_data_write_finalize(&call, nodep->data + pos,
-		    size);
+	if (pos > SIZE_MAX - size) {
+		async_answer_0(&call, ENOMEM);
+		size = 0;
+		goto out;
+	}
+
+	errno_t rc = tmpfs_chunks_reserve(nodep, pos + size);
+	if (rc != EOK) {
+		async_answer_0(&call, rc);
+		size = 0;
 		goto out;
 	}
-	size_t delta = (pos + size) - nodep->size;
+
 	/*
-	 * At this point, we are deliberately extremely straightforward and
-	 * simply realloc the contents of the file on every write that grows the
-	 * file. In the end, the situation might not be as bad as it may look:
-	 * our heap allocator can save us and just grow the block whenever
-	 * possible.
+	 * Allocate the chunks being written to. Should memory run out, accept
+	 * only the part for which there are chunks. Chunks which are not
+	 * written to remain holes.
 	 */
-	void *newdata = realloc(nodep->data, nodep->size + delta);
-	if (!newdata) {
+	size_t offset = pos % TMPFS_CHUNK_SIZE;
+	size_t avail = 0;
+	while (avail < size) {
+		uint8_t **chunk = &nodep->chunks[(pos + avail) / TMPFS_CHUNK_SIZE];
+		if (!*chunk) {
+			*chunk = calloc(1, TMPFS_CHUNK_SIZE);
+			if (!*chunk)
+				break;
+		}
+
+		avail += min(size - avail,
+		    TMPFS_CHUNK_SIZE - (pos + avail) % TMPFS_CHUNK_SIZE);
+	}
+
+	if ((avail == 0) && (size > 0)) {
 		async_answer_0(&call, ENOMEM);
 		size = 0;
 		goto out;
 	}
-	/* Clear any newly allocated memory in order to emulate gaps. */
-	memset(newdata + nodep->size, 0, delta);
-	nodep->size += delta;
-	nodep->data = newdata;
-	(void) async_data_write_finalize(&call, nodep->data + pos, size);
+
+	size = avail;
+
+	if (offset + size <= TMPFS_CHUNK_SIZE) {
+		/* Receive the data right into the chunk. */
+		uint8_t *dst = (size > 0) ?
+		    nodep->chunks[pos / TMPFS_CHUNK_SIZE] + offset : NULL;
+		(void) async_data_write_finalize(&call, dst, size);
+	} else {
+		uint8_t *buf = malloc(size);
+		if (!buf) {
+			async_answer_0(&call, ENOMEM);
+			size = 0;
+			goto out;
+		}
+
+		rc = async_data_write_finalize(&call, buf, size);
+		if (rc == EOK)
+			tmpfs_chunks_scatter(nodep, pos, buf, size);
+		else
+			size = 0;
+		free(buf);
+	}
+
+	if (pos + size > nodep->size)
+		nodep->size = pos + size;
 
 out:
 	*wbytes = size;
@@ -609,17 +764,16 @@ static errno_t tmpfs_truncate(service_id_t service_id, fs_index_t index,
 	if (size > SIZE_MAX)
 		return ENOMEM;
 
-	void *newdata = realloc(nodep->data, size);
-	if (!newdata && size)
-		return ENOMEM;
-
 	if (size > nodep->size) {
-		size_t delta = size - nodep->size;
-		memset(newdata + nodep->size, 0, delta);
+		/* The new space is a hole. */
+		errno_t rc = tmpfs_chunks_reserve(nodep, size);
+		if (rc != EOK)
+			return rc;
+	} else {
+		tmpfs_chunks_trim(nodep, size);
 	}
 
 	nodep->size = size;
-	nodep->data = newdata;
 	return EOK;
 }
 
@@ -46,6 +46,7 @@
 #include <ipc/services.h>
 #include <loc.h>
 #include <mem.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <task.h>
 
@@ -67,6 +68,9 @@ static const char *ro_data = "Hello, world!";
  */
 static char rw_data[] = "Hello, world!";
 
+/** Buffer for data transfer tests. */
+static uint8_t xfer_buf[DATA_XFER_LIMIT];
+
 static void ipc_test_get_ro_area_size_srv(ipc_call_t *icall)
 {
 	errno_t rc;
@@ -181,6 +185,66 @@ static void ipc_test_share_in_rw_srv(ipc_call_t *icall)
 	async_answer_0(icall, EOK);
 }
 
+static void ipc_test_data_write_srv(ipc_call_t *icall)
+{
+	ipc_call_t call;
+	errno_t rc;
+	size_t size;
+
+	log_msg(LOG_DEFAULT, LVL_DEBUG, "ipc_test_data_write_srv");
+	if (!async_data_write_receive(&call, &size)) {
+		async_answer_0(icall, EINVAL);
+		log_msg(LOG_DEFAULT, LVL_ERROR, "data_write_receive failed");
+		return;
+	}
+
+	if (size > sizeof(xfer_buf)) {
+		async_answer_0(&call, ELIMIT);
+		async_answer_0(icall, ELIMIT);
+		return;
+	}
+
+	rc = async_data_write_finalize(&call, xfer_buf, size);
+	if (rc != EOK) {
+		log_msg(LOG_DEFAULT, LVL_ERROR,
+		    "async_data_write_finalize failed");
+		async_answer_0(icall, rc);
+		return;
+	}
+
+	async_answer_0(icall, EOK);
+}
+
+static void ipc_test_data_read_srv(ipc_call_t *icall)
+{
+	ipc_call_t call;
+	errno_t rc;
+	size_t size;
+
+	log_msg(LOG_DEFAULT, LVL_DEBUG, "ipc_test_data_read_srv");
+	if (!async_data_read_receive(&call, &size)) {
+		async_answer_0(icall, EINVAL);
+		log_msg(LOG_DEFAULT, LVL_ERROR, "data_read_receive failed");
+		return;
+	}
+
+	if (size > sizeof(xfer_buf)) {
+		async_answer_0(&call, ELIMIT);
+		async_answer_0(icall, ELIMIT);
+		return;
+	}
+
+	rc = async_data_read_finalize(&call, xfer_buf, size);
+	if (rc != EOK) {
+		log_msg(LOG_DEFAULT, LVL_ERROR,
+		    "async_data_read_finalize failed");
+		async_answer_0(icall, rc);
+		return;
+	}
+
+	async_answer_0(icall, EOK);
+}
+
 static void ipc_test_connection(ipc_call_t *icall, void *arg)
 {
 	/* Accept connection */
@@ -211,6 +275,12 @@ static void ipc_test_connection(ipc_call_t *icall, void *arg)
 		case IPC_TEST_SHARE_IN_RW:
 			ipc_test_share_in_rw_srv(&call);
 			break;
+		case IPC_TEST_DATA_WRITE:
+			ipc_test_data_write_srv(&call);
+			break;
+		case IPC_TEST_DATA_READ:
+			ipc_test_data_read_srv(&call);
+			break;
 		default:
 			async_answer_0(&call, ENOTSUP);
 			break;
@@ -229,6 +229,36 @@ extern void vfs_register(ipc_call_t *);
 
 extern void vfs_page_in(ipc_call_t *);
 
+/** Page of a regular file held in the VFS page cache. */
+typedef struct vfs_cache_page vfs_cache_page_t;
+
+extern bool vfs_cache_init(void);
+extern bool vfs_cache_enabled(vfs_node_t *);
+extern errno_t vfs_cache_get(async_exch_t *, vfs_node_t *, aoff64_t,
+    vfs_cache_page_t **);
+extern void vfs_cache_put(vfs_cache_page_t *);
+extern void *vfs_cache_data(vfs_cache_page_t *);
+extern errno_t vfs_cache_read(async_exch_t *, vfs_node_t *, aoff64_t,
+    size_t *);
+extern errno_t vfs_cache_write(async_exch_t *, vfs_node_t *, aoff64_t,
+    ipc_call_t *, size_t *);
+extern void vfs_cache_resize(vfs_triplet_t *, aoff64_t);
+extern void vfs_cache_invalidate(vfs_triplet_t *);
+extern void vfs_cache_invalidate_fs(fs_handle_t, service_id_t);
+
+extern bool vfs_dentry_init(void);
+extern bool vfs_dentry_enabled(fs_handle_t);
+extern errno_t vfs_dentry_lookup(vfs_triplet_t *, const char *,
+    vfs_lookup_res_t *, unsigned int *);
+extern void vfs_dentry_insert(unsigned int, vfs_triplet_t *, const char *,
+    vfs_lookup_res_t *);
+extern void vfs_dentry_update(vfs_triplet_t *, const char *,
+    vfs_lookup_res_t *);
+extern void vfs_dentry_forget(vfs_triplet_t *, const char *);
+extern void vfs_dentry_node_put(vfs_node_t *);
+extern void vfs_dentry_invalidate_dir(vfs_triplet_t *);
+extern void vfs_dentry_invalidate_fs(fs_handle_t, service_id_t);
+
 typedef struct {
 	void *buffer;
 	size_t size;
@@ -0,0 +1,818 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup vfs
+ * @{
+ */
+
+/**
+ * @file vfs_cache.c
+ * @brief VFS page cache.
+ *
+ * Contents of regular files are cached in page-sized, page-aligned buffers
+ * keyed by the file's triplet and the offset of the page. The same pages
+ * serve read and write requests and are shared read-only with tasks which
+ * map the files through the VFS pager. Writes go through to the file system
+ * and update the cached pages in place, so mappings of a cached page see
+ * the new data.
+ *
+ * The cache is limited in size and reclaims the least recently used pages
+ * when it is full or when the system runs low on free physical memory.
+ */
+
+#include "vfs.h"
+#include <adt/hash.h>
+#include <adt/hash_table.h>
+#include <adt/list.h>
+#include <align.h>
+#include <as.h>
+#include <assert.h>
+#include <errno.h>
+#include <fibril_synch.h>
+#include <macros.h>
+#include <mem.h>
+#include <stats.h>
+#include <stdlib.h>
+
+/** Maximum number of cached pages. */
+#define VFS_CACHE_PAGES_MAX  4096
+
+/** Maximum number of bytes transferred by a single read or write request. */
+#define VFS_CACHE_IO_MAX  (16 * PAGE_SIZE)
+
+/** Number of page allocations between checks of free physical memory. */
+#define VFS_CACHE_PRESSURE_INTERVAL  64
+
+/**
+ * The cache shrinks when less than 1/VFS_CACHE_PRESSURE_RATIO of physical
+ * memory is free.
+ */
+#define VFS_CACHE_PRESSURE_RATIO  32
+
+/** Cached page of a regular file. */
+struct vfs_cache_page {
+	ht_link_t link;		/**< Page hash table link. */
+	link_t lru_link;	/**< Link in the LRU list. */
+
+	vfs_triplet_t triplet;
+	aoff64_t offset;	/**< Offset of the page within the file. */
+
+	uint8_t *data;		/**< Page contents. */
+	size_t valid;		/**< Number of bytes backed by the file. */
+
+	unsigned refcnt;
+	bool busy;		/**< Being read from the file system. */
+	bool cached;		/**< Present in the page hash table. */
+};
+
+typedef struct {
+	vfs_triplet_t triplet;
+	aoff64_t offset;
+} vfs_cache_key_t;
+
+/** Mutex protecting the page hash table, the LRU list and page state. */
+static FIBRIL_MUTEX_INITIALIZE(cache_mutex);
+
+/** Signalled when a page stops being busy. */
+static FIBRIL_CONDVAR_INITIALIZE(cache_cv);
+
+static hash_table_t cache_pages;
+
+/** Cached pages, most recently used first. */
+static LIST_INITIALIZE(cache_lru);
+
+/** Removed pages waiting to be destroyed once the cache mutex is dropped. */
+static LIST_INITIALIZE(cache_reaped);
+
+static size_t cache_count = 0;
+static unsigned int cache_allocs = 0;
+
+static size_t cache_key_hash(const void *key)
+{
+	const vfs_cache_key_t *ckey = key;
+	size_t hash = hash_combine(ckey->triplet.fs_handle,
+	    ckey->triplet.index);
+	hash = hash_combine(hash, ckey->triplet.service_id);
+	return hash_combine(hash, (size_t) (ckey->offset / PAGE_SIZE));
+}
+
+static size_t cache_hash(const ht_link_t *item)
+{
+	vfs_cache_page_t *page =
+	    hash_table_get_inst(item, vfs_cache_page_t, link);
+	vfs_cache_key_t key = {
+		.triplet = page->triplet,
+		.offset = page->offset
+	};
+
+	return cache_key_hash(&key);
+}
+
+static bool triplet_equal(const vfs_triplet_t *a, const vfs_triplet_t *b)
+{
+	return (a->fs_handle == b->fs_handle) &&
+	    (a->service_id == b->service_id) && (a->index == b->index);
+}
+
+static bool cache_key_equal(const void *key, const ht_link_t *item)
+{
+	const vfs_cache_key_t *ckey = key;
+	vfs_cache_page_t *page =
+	    hash_table_get_inst(item, vfs_cache_page_t, link);
+
+	return triplet_equal(&ckey->triplet, &page->triplet) &&
+	    (ckey->offset == page->offset);
+}
+
+/** VFS page cache hash table operations. */
+static hash_table_ops_t cache_ops = {
+	.hash = cache_hash,
+	.key_hash = cache_key_hash,
+	.key_equal = cache_key_equal,
+	.equal = NULL,
+	.remove_callback = NULL,
+};
+
+/** Initialize the VFS page cache.
+ *
+ * @return		Return true on success, false on failure.
+ */
+bool vfs_cache_init(void)
+{
+	return hash_table_create(&cache_pages, 0, 0, &cache_ops);
+}
+
+/** Find out whether the contents of a node may be cached.
+ *
+ * @param node		VFS node.
+ *
+ * @return		True if reads and writes of the node should be served
+ *			from the page cache.
+ */
+bool vfs_cache_enabled(vfs_node_t *node)
+{
+	if (node->type != VFS_NODE_FILE)
+		return false;
+
+	vfs_info_t *fs_info = fs_handle_to_info(node->fs_handle);
+	return (fs_info != NULL) && fs_info->page_cache;
+}
+
+static void cache_page_destroy(vfs_cache_page_t *page)
+{
+	as_area_destroy(page->data);
+	free(page);
+}
+
+/** Destroy removed pages. */
+static void cache_reap(list_t *reaped)
+{
+	list_foreach_safe(*reaped, cur, next) {
+		vfs_cache_page_t *page =
+		    list_get_instance(cur, vfs_cache_page_t, lru_link);
+		list_remove(cur);
+		cache_page_destroy(page);
+	}
+}
+
+/** Release the cache mutex and destroy the pages removed under it.
+ *
+ * Each page is a separate address space area and destroying it is a system
+ * call, so it is not done while other fibrils wait for the mutex.
+ */
+static void cache_unlock(void)
+{
+	list_t reaped;
+	list_initialize(&reaped);
+	list_concat(&reaped, &cache_reaped);
+
+	fibril_mutex_unlock(&cache_mutex);
+
+	cache_reap(&reaped);
+}
+
+/** Remove a page from the cache.
+ *
+ * The page is destroyed as soon as it is not referenced. Tasks which have
+ * the page mapped keep their own reference to its frame.
+ *
+ * The cache mutex must be held and must be released by cache_unlock().
+ */
+static void cache_remove(vfs_cache_page_t *page)
+{
+	if (!page->cached)
+		return;
+
+	hash_table_remove_item(&cache_pages, &page->link);
+	list_remove(&page->lru_link);
+	page->cached = false;
+	cache_count--;
+
+	if (page->refcnt == 0)
+		list_append(&page->lru_link, &cache_reaped);
+}
+
+/** Reclaim the least recently used pages which are not in use.
+ *
+ * The cache mutex must be held.
+ *
+ * @param count		Number of pages to reclaim.
+ */
+static void cache_evict(size_t count)
+{
+	link_t *link = list_last(&cache_lru);
+
+	while ((link != NULL) && (count > 0)) {
+		vfs_cache_page_t *page =
+		    list_get_instance(link, vfs_cache_page_t, lru_link);
+		link = list_prev(link, &cache_lru);
+
+		if (page->refcnt == 0) {
+			cache_remove(page);
+			count--;
+		}
+	}
+}
+
+/** Shrink the cache if the system is running low on memory.
+ *
+ * The cache mutex must be held.
+ */
+static void cache_pressure(void)
+{
+	if ((++cache_allocs % VFS_CACHE_PRESSURE_INTERVAL) != 0)
+		return;
+
+	stats_physmem_t *physmem = stats_get_physmem();
+	if (physmem == NULL)
+		return;
+
+	if (physmem->free < physmem->total / VFS_CACHE_PRESSURE_RATIO)
+		cache_evict(cache_count / 4 + 1);
+
+	free(physmem);
+}
+
+/** Allocate an empty page and insert it into the cache.
+ *
+ * The cache mutex must be held.
+ */
+static vfs_cache_page_t *cache_alloc(vfs_cache_key_t *key)
+{
+	if (cache_count >= VFS_CACHE_PAGES_MAX)
+		cache_evict(1);
+
+	cache_pressure();
+
+	vfs_cache_page_t *page = malloc(sizeof(vfs_cache_page_t));
+	if (page == NULL)
+		return NULL;
+
+	page->data = as_area_create(AS_AREA_ANY, PAGE_SIZE,
+	    AS_AREA_READ | AS_AREA_WRITE | AS_AREA_CACHEABLE,
+	    AS_AREA_UNPAGED);
+	if (page->data == AS_MAP_FAILED) {
+		/*
+		 * Make room and retry once. The memory must be returned
+		 * right away, so the evicted pages are destroyed under the
+		 * mutex on this rare path.
+		 */
+		cache_evict(cache_count / 4 + 1);
+		cache_reap(&cache_reaped);
+		page->data = as_area_create(AS_AREA_ANY, PAGE_SIZE,
+		    AS_AREA_READ | AS_AREA_WRITE | AS_AREA_CACHEABLE,
+		    AS_AREA_UNPAGED);
+		if (page->data == AS_MAP_FAILED) {
+			free(page);
+			return NULL;
+		}
+	}
+
+	page->triplet = key->triplet;
+	page->offset = key->offset;
+	page->valid = 0;
+	page->refcnt = 1;
+	page->busy = true;
+	page->cached = true;
+
+	hash_table_insert(&cache_pages, &page->link);
+	list_prepend(&page->lru_link, &cache_lru);
+	cache_count++;
+
+	return page;
+}
+
+/** Read the contents of a page from the file system.
+ *
+ * The part of the page past the end of the file is zeroed.
+ */
+static errno_t cache_fill(async_exch_t *exch, vfs_cache_page_t *page)
+{
+	size_t total = 0;
+
+	while (total < PAGE_SIZE) {
+		aoff64_t pos = page->offset + total;
+
+		ipc_call_t answer;
+		aid_t msg = async_send_4(exch, VFS_OUT_READ,
+		    page->triplet.service_id, page->triplet.index,
+		    LOWER32(pos), UPPER32(pos), &answer);
+		if (msg == 0)
+			return EINVAL;
+
+		errno_t rc = async_data_read_start(exch, page->data + total,
+		    PAGE_SIZE - total);
+		if (rc != EOK) {
+			async_forget(msg);
+			return rc;
+		}
+
+		async_wait_for(msg, &rc);
+		if (rc != EOK)
+			return rc;
+
+		size_t bytes = ipc_get_arg1(&answer);
+		if (bytes == 0)
+			break;
+
+		total += bytes;
+	}
+
+	memset(page->data + total, 0, PAGE_SIZE - total);
+	page->valid = total;
+	return EOK;
+}
+
+/** Get a referenced page of a file, reading it if it is not cached.
+ *
+ * The caller must hold the node's contents rwlock.
+ *
+ * @param exch		Exchange with the node's file system.
+ * @param node		VFS node.
+ * @param pos		Position within the file.
+ * @param out_page	Place to store the page.
+ *
+ * @return		EOK on success or an error code.
+ */
+errno_t vfs_cache_get(async_exch_t *exch, vfs_node_t *node, aoff64_t pos,
+    vfs_cache_page_t **out_page)
+{
+	vfs_cache_key_t key = {
+		.triplet = {
+			.fs_handle = node->fs_handle,
+			.service_id = node->service_id,
+			.index = node->index
+		},
+		.offset = ALIGN_DOWN(pos, PAGE_SIZE)
+	};
+	vfs_cache_page_t *page;
+
+	fibril_mutex_lock(&cache_mutex);
+
+	while (true) {
+		ht_link_t *link = hash_table_find(&cache_pages, &key);
+		if (link == NULL)
+			break;
+
+		page = hash_table_get_inst(link, vfs_cache_page_t, link);
+		if (page->busy) {
+			fibril_condvar_wait(&cache_cv, &cache_mutex);
+			continue;
+		}
+
+		page->refcnt++;
+		list_remove(&page->lru_link);
+		list_prepend(&page->lru_link, &cache_lru);
+
+		cache_unlock();
+		*out_page = page;
+		return EOK;
+	}
+
+	page = cache_alloc(&key);
+	cache_unlock();
+
+	if (page == NULL)
+		return ENOMEM;
+
+	errno_t rc = cache_fill(exch, page);
+
+	fibril_mutex_lock(&cache_mutex);
+	page->busy = false;
+	if (rc != EOK)
+		cache_remove(page);
+	fibril_condvar_broadcast(&cache_cv);
+	cache_unlock();
+
+	if (rc != EOK) {
+		vfs_cache_put(page);
+		return rc;
+	}
+
+	*out_page = page;
+	return EOK;
+}
+
+/** Drop a reference to a page.
+ *
+ * @param page		Page returned by vfs_cache_get().
+ */
+void vfs_cache_put(vfs_cache_page_t *page)
+{
+	fibril_mutex_lock(&cache_mutex);
+
+	assert(page->refcnt > 0);
+	page->refcnt--;
+	bool destroy = (page->refcnt == 0) && (!page->cached);
+
+	fibril_mutex_unlock(&cache_mutex);
+
+	if (destroy)
+		cache_page_destroy(page);
+}
+
+/** Get the contents of a page.
+ *
+ * @param page		Page returned by vfs_cache_get().
+ *
+ * @return		Page-aligned buffer of PAGE_SIZE bytes.
+ */
+void *vfs_cache_data(vfs_cache_page_t *page)
+{
+	return page->data;
+}
+
+/** Serve a client read request from the page cache.
+ *
+ * Receives the client's IPC_M_DATA_READ and answers it with the cached
+ * contents of the file. The caller must hold the node's contents rwlock.
+ *
+ * @param exch		Exchange with the node's file system.
+ * @param node		VFS node of a regular file.
+ * @param pos		Position within the file.
+ * @param out_bytes	Place to store the number of bytes read.
+ *
+ * @return		EOK on success or an error code.
+ */
+errno_t vfs_cache_read(async_exch_t *exch, vfs_node_t *node, aoff64_t pos,
+    size_t *out_bytes)
+{
+	ipc_call_t call;
+	size_t size;
+	if (!async_data_read_receive(&call, &size)) {
+		async_answer_0(&call, EINVAL);
+		return EINVAL;
+	}
+
+	if (pos >= node->size)
+		size = 0;
+	else
+		size = min(size, min(node->size - pos, VFS_CACHE_IO_MAX));
+
+	*out_bytes = 0;
+
+	if (size == 0)
+		return async_data_read_finalize(&call, NULL, 0);
+
+	vfs_cache_page_t *page;
+	size_t poff = pos % PAGE_SIZE;
+	errno_t rc;
+
+	if (poff + size <= PAGE_SIZE) {
+		/* Answer directly from the cached page */
+		rc = vfs_cache_get(exch, node, pos, &page);
+		if (rc != EOK) {
+			async_answer_0(&call, rc);
+			return rc;
+		}
+
+		size_t bytes = (page->valid > poff) ?
+		    min(size, page->valid - poff) : 0;
+		rc = async_data_read_finalize(&call, page->data + poff, bytes);
+		vfs_cache_put(page);
+
+		if (rc == EOK)
+			*out_bytes = bytes;
+		return rc;
+	}
+
+	uint8_t *buf = malloc(size);
+	if (buf == NULL) {
+		async_answer_0(&call, ENOMEM);
+		return ENOMEM;
+	}
+
+	size_t done = 0;
+	while (done < size) {
+		rc = vfs_cache_get(exch, node, pos + done, &page);
+		if (rc != EOK)
+			break;
+
+		poff = (pos + done) % PAGE_SIZE;
+		size_t bytes = min(size - done, PAGE_SIZE - poff);
+		bool eof = false;
+		if (page->valid < poff + bytes) {
+			bytes = (page->valid > poff) ? page->valid - poff : 0;
+			eof = true;
+		}
+
+		memcpy(buf + done, page->data + poff, bytes);
+		vfs_cache_put(page);
+
+		done += bytes;
+		if (eof)
+			break;
+	}
+
+	if (done == 0 && rc != EOK) {
+		async_answer_0(&call, rc);
+		free(buf);
+		return rc;
+	}
+
+	rc = async_data_read_finalize(&call, buf, done);
+	free(buf);
+
+	if (rc == EOK)
+		*out_bytes = done;
+	return rc;
+}
+
+/** Update the cached pages of a file with written data.
+ *
+ * If the write has extended the file, the pages between the old and the
+ * new end of file become valid up to the new end. Their contents past the
+ * old end of file are already zero, matching the gap filled by the file
+ * system.
+ *
+ * The cache mutex must be held.
+ */
+static void cache_update(vfs_node_t *node, aoff64_t pos, const uint8_t *buf,
+    size_t size, aoff64_t old_size, aoff64_t new_size)
+{
+	vfs_cache_key_t key = {
+		.triplet = {
+			.fs_handle = node->fs_handle,
+			.service_id = node->service_id,
+			.index = node->index
+		}
+	};
+
+	for (key.offset = ALIGN_DOWN(pos, PAGE_SIZE); key.offset < pos + size;
+	    key.offset += PAGE_SIZE) {
+		ht_link_t *link = hash_table_find(&cache_pages, &key);
+		if (link == NULL)
+			continue;
+
+		vfs_cache_page_t *page =
+		    hash_table_get_inst(link, vfs_cache_page_t, link);
+		if (page->busy) {
+			/* The data being read may be stale, drop the page */
+			cache_remove(page);
+			continue;
+		}
+
+		aoff64_t start = max(pos, key.offset);
+		aoff64_t end = min(pos + size, key.offset + PAGE_SIZE);
+
+		memcpy(page->data + (start - key.offset), buf + (start - pos),
+		    end - start);
+		page->valid = max(page->valid, end - key.offset);
+	}
+
+	for (key.offset = ALIGN_DOWN(old_size, PAGE_SIZE);
+	    key.offset < new_size; key.offset += PAGE_SIZE) {
+		ht_link_t *link = hash_table_find(&cache_pages, &key);
+		if (link == NULL)
+			continue;
+
+		vfs_cache_page_t *page =
+		    hash_table_get_inst(link, vfs_cache_page_t, link);
+		if (page->busy) {
+			cache_remove(page);
+			continue;
+		}
+
+		page->valid = max(page->valid,
+		    min(PAGE_SIZE, new_size - key.offset));
+	}
+}
+
+/** Serve a client write request through the page cache.
+ *
+ * Receives the client's IPC_M_DATA_WRITE, writes the data to the file system
+ * and updates the cached pages of the file. The caller must hold the node's
+ * contents rwlock.
+ *
+ * @param exch		Exchange with the node's file system.
+ * @param node		VFS node of a regular file.
+ * @param pos		Position within the file.
+ * @param answer	Answer of the file system, containing the new size of
+ *			the file.
+ * @param out_bytes	Place to store the number of bytes written.
+ *
+ * @return		EOK on success or an error code.
+ */
+errno_t vfs_cache_write(async_exch_t *exch, vfs_node_t *node, aoff64_t pos,
+    ipc_call_t *answer, size_t *out_bytes)
+{
+	ipc_call_t call;
+	size_t size;
+	if (!async_data_write_receive(&call, &size)) {
+		async_answer_0(&call, EINVAL);
+		return EINVAL;
+	}
+
+	size = min(size, VFS_CACHE_IO_MAX);
+
+	uint8_t *buf = malloc(max(size, 1));
+	if (buf == NULL) {
+		async_answer_0(&call, ENOMEM);
+		return ENOMEM;
+	}
+
+	errno_t rc = async_data_write_finalize(&call, buf, size);
+	if (rc != EOK) {
+		free(buf);
+		return rc;
+	}
+
+	aoff64_t old_size = node->size;
+	ipc_set_arg2(answer, LOWER32(old_size));
+	ipc_set_arg3(answer, UPPER32(old_size));
+
+	size_t done = 0;
+	while (done < size) {
+		ipc_call_t reply;
+		aid_t msg = async_send_4(exch, VFS_OUT_WRITE, node->service_id,
+		    node->index, LOWER32(pos + done), UPPER32(pos + done),
+		    &reply);
+		if (msg == 0) {
+			rc = EINVAL;
+			break;
+		}
+
+		rc = async_data_write_start(exch, buf + done, size - done);
+		if (rc != EOK) {
+			async_forget(msg);
+			break;
+		}
+
+		async_wait_for(msg, &rc);
+		if (rc != EOK)
+			break;
+
+		*answer = reply;
+
+		size_t bytes = ipc_get_arg1(&reply);
+		if (bytes == 0)
+			break;
+
+		done += bytes;
+	}
+
+	if (done > 0) {
+		aoff64_t new_size = MERGE_LOUP32(ipc_get_arg2(answer),
+		    ipc_get_arg3(answer));
+
+		fibril_mutex_lock(&cache_mutex);
+		cache_update(node, pos, buf, done, old_size,
+		    max(old_size, new_size));
+		cache_unlock();
+		rc = EOK;
+	}
+
+	free(buf);
+
+	*out_bytes = done;
+	return rc;
+}
+
+/** Apply a new size of a file to its cached pages. */
+static bool cache_resize_cb(ht_link_t *item, void *arg)
+{
+	vfs_cache_page_t *page =
+	    hash_table_get_inst(item, vfs_cache_page_t, link);
+	vfs_cache_key_t *key = (vfs_cache_key_t *) arg;
+
+	if (!triplet_equal(&page->triplet, &key->triplet))
+		return true;
+
+	if ((page->offset >= key->offset) || page->busy) {
+		cache_remove(page);
+		return true;
+	}
+
+	size_t valid = min(key->offset - page->offset, PAGE_SIZE);
+	if (valid < page->valid)
+		memset(page->data + valid, 0, page->valid - valid);
+	page->valid = valid;
+
+	return true;
+}
+
+/** Update the cached pages of a file after its size has changed.
+ *
+ * @param triplet	File whose size has changed.
+ * @param size		New size of the file.
+ */
+void vfs_cache_resize(vfs_triplet_t *triplet, aoff64_t size)
+{
+	vfs_cache_key_t key = {
+		.triplet = *triplet,
+		.offset = size
+	};
+
+	fibril_mutex_lock(&cache_mutex);
+	hash_table_apply(&cache_pages, cache_resize_cb, &key);
+	cache_unlock();
+}
+
+typedef struct {
+	fs_handle_t fs_handle;
+	service_id_t service_id;
+	fs_index_t index;
+	bool any_index;
+} cache_invalidate_t;
+
+static bool cache_invalidate_cb(ht_link_t *item, void *arg)
+{
+	vfs_cache_page_t *page =
+	    hash_table_get_inst(item, vfs_cache_page_t, link);
+	cache_invalidate_t *inv = (cache_invalidate_t *) arg;
+
+	if ((page->triplet.fs_handle == inv->fs_handle) &&
+	    (page->triplet.service_id == inv->service_id) &&
+	    (inv->any_index || (page->triplet.index == inv->index)))
+		cache_remove(page);
+
+	return true;
+}
+
+/** Drop all cached pages of a file.
+ *
+ * Used when the file is unlinked or its VFS node is destroyed, as its index
+ * may be reused.
+ *
+ * @param triplet	File to forget.
+ */
+void vfs_cache_invalidate(vfs_triplet_t *triplet)
+{
+	cache_invalidate_t inv = {
+		.fs_handle = triplet->fs_handle,
+		.service_id = triplet->service_id,
+		.index = triplet->index,
+		.any_index = false
+	};
+
+	fibril_mutex_lock(&cache_mutex);
+	hash_table_apply(&cache_pages, cache_invalidate_cb, &inv);
+	cache_unlock();
+}
+
+/** Drop all cached pages of a file system instance.
+ *
+ * @param fs_handle	File system handle.
+ * @param service_id	Service ID of the file system instance.
+ */
+void vfs_cache_invalidate_fs(fs_handle_t fs_handle, service_id_t service_id)
+{
+	cache_invalidate_t inv = {
+		.fs_handle = fs_handle,
+		.service_id = service_id,
+		.any_index = true
+	};
+
+	fibril_mutex_lock(&cache_mutex);
+	hash_table_apply(&cache_pages, cache_invalidate_cb, &inv);
+	cache_unlock();
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,474 @@
+/*
+ * Copyright (c) 2026 HelenOS contributors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * - Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - The name of the author may not be used to endorse or promote products
+ *   derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @addtogroup vfs
+ * @{
+ */
+
+/**
+ * @file vfs_dentry.c
+ * @brief VFS path component cache.
+ *
+ * The cache remembers the result of looking up a single path component in a
+ * directory. Positive entries map the directory and the name to the found
+ * node, negative entries record that the name does not exist. Lookups of
+ * cached components are resolved without asking the file system server.
+ *
+ * The cache is kept coherent by VFS itself, because all namespace changes
+ * of the file systems which allow caching go through VFS. Entries are
+ * updated on create, link, unlink and rename, and dropped when a file
+ * system instance is mounted or unmounted.
+ *
+ * Lookups run concurrently with namespace changes, so a lookup which has
+ * been answered by the file system before a change may finish after it.
+ * Such results are not inserted, which is detected by comparing the cache
+ * generation before and after the lookup.
+ */
+
+#include "vfs.h"
+#include <adt/hash.h>
+#include <adt/hash_table.h>
+#include <adt/list.h>
+#include <assert.h>
+#include <fibril_synch.h>
+#include <stdlib.h>
+#include <str.h>
+
+/** Maximum number of cached path components. */
+#define VFS_DENTRY_MAX  2048
+
+/** Cached path component. */
+typedef struct {
+	ht_link_t link;		/**< Link in the hash table of names. */
+	ht_link_t child_link;	/**< Link in the hash table of found nodes. */
+	link_t lru_link;	/**< Link in the LRU list. */
+
+	vfs_triplet_t parent;	/**< Directory containing the component. */
+	bool negative;		/**< The component does not exist. */
+	vfs_lookup_res_t child;	/**< Found node, unless negative. */
+	char name[];
+} vfs_dentry_t;
+
+typedef struct {
+	const vfs_triplet_t *parent;
+	const char *name;
+} vfs_dentry_key_t;
+
+/** Mutex protecting the hash tables, the LRU list and the generation. */
+static FIBRIL_MUTEX_INITIALIZE(dentry_mutex);
+
+/** Cached components by directory and name. */
+static hash_table_t dentries;
+
+/** Positive cached components by the found node. */
+static hash_table_t dentry_children;
+
+/** Cached components, most recently used first. */
+static LIST_INITIALIZE(dentry_lru);
+
+static size_t dentry_count = 0;
+
+/** Incremented on every namespace change. */
+static unsigned int dentry_generation = 0;
+
+static size_t triplet_hash(const vfs_triplet_t *triplet)
+{
+	size_t hash = hash_combine(triplet->fs_handle, triplet->index);
+	return hash_combine(hash, triplet->service_id);
+}
+
+static bool triplet_equal(const vfs_triplet_t *a, const vfs_triplet_t *b)
+{
+	return (a->fs_handle == b->fs_handle) &&
+	    (a->service_id == b->service_id) && (a->index == b->index);
+}
+
+static size_t dentry_key_hash(const void *key)
+{
+	const vfs_dentry_key_t *dkey = key;
+	size_t hash = triplet_hash(dkey->parent);
+
+	for (const char *c = dkey->name; *c != 0; c++)
+		hash = hash * 31 + (unsigned char) *c;
+
+	return hash_mix(hash);
+}
+
+static size_t dentry_hash(const ht_link_t *item)
+{
+	vfs_dentry_t *dentry = hash_table_get_inst(item, vfs_dentry_t, link);
+	vfs_dentry_key_t key = {
+		.parent = &dentry->parent,
+		.name = dentry->name
+	};
+
+	return dentry_key_hash(&key);
+}
+
+static bool dentry_key_equal(const void *key, const ht_link_t *item)
+{
+	const vfs_dentry_key_t *dkey = key;
+	vfs_dentry_t *dentry = hash_table_get_inst(item, vfs_dentry_t, link);
+
+	return triplet_equal(dkey->parent, &dentry->parent) &&
+	    (str_cmp(dkey->name, dentry->name) == 0);
+}
+
+static size_t child_key_hash(const void *key)
+{
+	return triplet_hash((const vfs_triplet_t *) key);
+}
+
+static size_t child_hash(const ht_link_t *item)
+{
+	vfs_dentry_t *dentry =
+	    hash_table_get_inst(item, vfs_dentry_t, child_link);
+	return triplet_hash(&dentry->child.triplet);
+}
+
+static bool child_equal(const ht_link_t *item1, const ht_link_t *item2)
+{
+	vfs_dentry_t *dentry1 =
+	    hash_table_get_inst(item1, vfs_dentry_t, child_link);
+	vfs_dentry_t *dentry2 =
+	    hash_table_get_inst(item2, vfs_dentry_t, child_link);
+	return triplet_equal(&dentry1->child.triplet, &dentry2->child.triplet);
+}
+
+static bool child_key_equal(const void *key, const ht_link_t *item)
+{
+	vfs_dentry_t *dentry =
+	    hash_table_get_inst(item, vfs_dentry_t, child_link);
+	return triplet_equal((const vfs_triplet_t *) key,
+	    &dentry->child.triplet);
+}
+
+/** Path component hash table operations. */
+static hash_table_ops_t dentries_ops = {
+	.hash = dentry_hash,
+	.key_hash = dentry_key_hash,
+	.key_equal = dentry_key_equal,
+	.equal = NULL,
+	.remove_callback = NULL,
+};
+
+/** Found node hash table operations. */
+static hash_table_ops_t dentry_children_ops = {
+	.hash = child_hash,
+	.key_hash = child_key_hash,
+	.key_equal = child_key_equal,
+	.equal = child_equal,
+	.remove_callback = NULL,
+};
+
+/** Initialize the path component cache.
+ *
+ * @return		Return true on success, false on failure.
+ */
+bool vfs_dentry_init(void)
+{
+	if (!hash_table_create(&dentries, 0, 0, &dentries_ops))
+		return false;
+
+	if (!hash_table_create(&dentry_children, 0, 0, &dentry_children_ops)) {
+		hash_table_destroy(&dentries);
+		return false;
+	}
+
+	return true;
+}
+
+/** Find out whether path components of a file system may be cached.
+ *
+ * @param fs_handle	File system handle.
+ *
+ * @return		True if the namespace of the file system is only
+ *			modified through VFS.
+ */
+bool vfs_dentry_enabled(fs_handle_t fs_handle)
+{
+	vfs_info_t *fs_info = fs_handle_to_info(fs_handle);
+	return (fs_info != NULL) && fs_info->dentry_cache;
+}
+
+/** Remove an entry from the cache.
+ *
+ * The dentry mutex must be held.
+ */
+static void dentry_remove(vfs_dentry_t *dentry)
+{
+	hash_table_remove_item(&dentries, &dentry->link);
+	if (!dentry->negative)
+		hash_table_remove_item(&dentry_children, &dentry->child_link);
+	list_remove(&dentry->lru_link);
+	dentry_count--;
+	free(dentry);
+}
+
+/** Find an entry.
+ *
+ * The dentry mutex must be held.
+ */
+static vfs_dentry_t *dentry_find(vfs_triplet_t *parent, const char *name)
+{
+	vfs_dentry_key_t key = {
+		.parent = parent,
+		.name = name
+	};
+
+	ht_link_t *link = hash_table_find(&dentries, &key);
+	if (link == NULL)
+		return NULL;
+
+	return hash_table_get_inst(link, vfs_dentry_t, link);
+}
+
+/** Insert or replace an entry.
+ *
+ * The dentry mutex must be held.
+ */
+static void dentry_set(vfs_triplet_t *parent, const char *name,
+    vfs_lookup_res_t *child)
+{
+	vfs_dentry_t *dentry = dentry_find(parent, name);
+	if (dentry != NULL)
+		dentry_remove(dentry);
+
+	if (dentry_count >= VFS_DENTRY_MAX) {
+		link_t *last = list_last(&dentry_lru);
+		assert(last != NULL);
+		dentry_remove(list_get_instance(last, vfs_dentry_t, lru_link));
+	}
+
+	size_t size = str_size(name) + 1;
+	dentry = malloc(sizeof(vfs_dentry_t) + size);
+	if (dentry == NULL)
+		return;
+
+	dentry->parent = *parent;
+	str_cpy(dentry->name, size, name);
+
+	if (child != NULL) {
+		dentry->negative = false;
+		dentry->child = *child;
+		hash_table_insert(&dentry_children, &dentry->child_link);
+	} else {
+		dentry->negative = true;
+	}
+
+	hash_table_insert(&dentries, &dentry->link);
+	list_prepend(&dentry->lru_link, &dentry_lru);
+	dentry_count++;
+}
+
+/** Look up a path component in the cache.
+ *
+ * @param parent	Directory containing the component.
+ * @param name		Name of the component.
+ * @param child		Place to store the found node.
+ * @param gen		Place to store the cache generation, to be passed
+ *			to vfs_dentry_insert() on a miss.
+ *
+ * @return		EOK if the component is cached and exists, ENOENT if
+ *			it is cached and does not exist, EAGAIN if it is not
+ *			cached.
+ */
+errno_t vfs_dentry_lookup(vfs_triplet_t *parent, const char *name,
+    vfs_lookup_res_t *child, unsigned int *gen)
+{
+	errno_t rc;
+
+	fibril_mutex_lock(&dentry_mutex);
+
+	vfs_dentry_t *dentry = dentry_find(parent, name);
+	if (dentry == NULL) {
+		*gen = dentry_generation;
+		rc = EAGAIN;
+	} else {
+		list_remove(&dentry->lru_link);
+		list_prepend(&dentry->lru_link, &dentry_lru);
+
+		if (dentry->negative) {
+			rc = ENOENT;
+		} else {
+			*child = dentry->child;
+			rc = EOK;
+		}
+	}
+
+	fibril_mutex_unlock(&dentry_mutex);
+	return rc;
+}
+
+/** Insert the result of a lookup done by the file system.
+ *
+ * The result is dropped if the namespace has changed since the lookup
+ * started, as it might be stale.
+ *
+ * @param gen		Cache generation returned by vfs_dentry_lookup().
+ * @param parent	Directory containing the component.
+ * @param name		Name of the component.
+ * @param child		Found node or NULL if the component does not exist.
+ */
+void vfs_dentry_insert(unsigned int gen, vfs_triplet_t *parent,
+    const char *name, vfs_lookup_res_t *child)
+{
+	fibril_mutex_lock(&dentry_mutex);
+
+	if (gen == dentry_generation)
+		dentry_set(parent, name, child);
+
+	fibril_mutex_unlock(&dentry_mutex);
+}
+
+/** Record a namespace change done through VFS.
+ *
+ * @param parent	Directory containing the component.
+ * @param name		Name of the component.
+ * @param child		New node linked under the name, NULL if the name
+ *			has been unlinked.
+ */
+void vfs_dentry_update(vfs_triplet_t *parent, const char *name,
+    vfs_lookup_res_t *child)
+{
+	fibril_mutex_lock(&dentry_mutex);
+
+	dentry_generation++;
+	dentry_set(parent, name, child);
+
+	fibril_mutex_unlock(&dentry_mutex);
+}
+
+/** Forget a path component whose state is not known.
+ *
+ * @param parent	Directory containing the component.
+ * @param name		Name of the component.
+ */
+void vfs_dentry_forget(vfs_triplet_t *parent, const char *name)
+{
+	fibril_mutex_lock(&dentry_mutex);
+
+	dentry_generation++;
+	vfs_dentry_t *dentry = dentry_find(parent, name);
+	if (dentry != NULL)
+		dentry_remove(dentry);
+
+	fibril_mutex_unlock(&dentry_mutex);
+}
+
+/** Update the cached size of a node which is no longer in memory.
+ *
+ * While a node is in memory, its size is tracked by the VFS node. Once the
+ * node is freed, the cached entries pointing to it take over.
+ *
+ * @param node		VFS node being freed.
+ */
+void vfs_dentry_node_put(vfs_node_t *node)
+{
+	vfs_triplet_t triplet = {
+		.fs_handle = node->fs_handle,
+		.service_id = node->service_id,
+		.index = node->index
+	};
+
+	fibril_mutex_lock(&dentry_mutex);
+
+	ht_link_t *first = hash_table_find(&dentry_children, &triplet);
+	ht_link_t *link = first;
+	while (link != NULL) {
+		vfs_dentry_t *dentry =
+		    hash_table_get_inst(link, vfs_dentry_t, child_link);
+		dentry->child.size = node->size;
+
+		link = hash_table_find_next(&dentry_children, first, link);
+	}
+
+	fibril_mutex_unlock(&dentry_mutex);
+}
+
+typedef struct {
+	vfs_triplet_t triplet;
+	bool any_index;
+} dentry_invalidate_t;
+
+static bool dentry_invalidate_cb(ht_link_t *item, void *arg)
+{
+	vfs_dentry_t *dentry = hash_table_get_inst(item, vfs_dentry_t, link);
+	dentry_invalidate_t *inv = (dentry_invalidate_t *) arg;
+
+	if ((dentry->parent.fs_handle == inv->triplet.fs_handle) &&
+	    (dentry->parent.service_id == inv->triplet.service_id) &&
+	    (inv->any_index || (dentry->parent.index == inv->triplet.index)))
+		dentry_remove(dentry);
+
+	return true;
+}
+
+/** Drop all cached components of a directory.
+ *
+ * Used when the directory is unlinked, as its index may be reused.
+ *
+ * @param dir		Directory to forget.
+ */
+void vfs_dentry_invalidate_dir(vfs_triplet_t *dir)
+{
+	dentry_invalidate_t inv = {
+		.triplet = *dir,
+		.any_index = false
+	};
+
+	fibril_mutex_lock(&dentry_mutex);
+	dentry_generation++;
+	hash_table_apply(&dentries, dentry_invalidate_cb, &inv);
+	fibril_mutex_unlock(&dentry_mutex);
+}
+
+/** Drop all cached components of a file system instance.
+ *
+ * @param fs_handle	File system handle.
+ * @param service_id	Service ID of the file system instance.
+ */
+void vfs_dentry_invalidate_fs(fs_handle_t fs_handle, service_id_t service_id)
+{
+	dentry_invalidate_t inv = {
+		.triplet = {
+			.fs_handle = fs_handle,
+			.service_id = service_id
+		},
+		.any_index = true
+	};
+
+	fibril_mutex_lock(&dentry_mutex);
+	dentry_generation++;
+	hash_table_apply(&dentries, dentry_invalidate_cb, &inv);
+	fibril_mutex_unlock(&dentry_mutex);
+}
+
+/**
+ * @}
+ */
@@ -202,6 +202,9 @@ errno_t vfs_link_internal(vfs_node_t *base, char *path, vfs_triplet_t *child)
 	if (orig_rc != EOK)
 		rc = orig_rc;
 
+	if (vfs_dentry_enabled(triplet->fs_handle))
+		vfs_dentry_forget(triplet, component);
+
 out:
 	return rc;
 }
@@ -237,6 +240,302 @@ static errno_t out_lookup(vfs_triplet_t *base, size_t *pfirst, size_t *plen,
 	return EOK;
 }
 
+/** Look up a path and get the node found for each of its components.
+ *
+ * @param base    Directory to start the lookup in.
+ * @param first   PLB index of the path.
+ * @param len     Length of the path.
+ * @param steps   Array of VFS_LOOKUP_STEPS_MAX entries for the nodes found.
+ * @param nsteps  Place to store the number of nodes found.
+ *
+ * @return EOK on success or an error code from errno.h.
+ *
+ */
+static errno_t out_lookup_trace(vfs_triplet_t *base, size_t first, size_t len,
+    vfs_lookup_step_t *steps, size_t *nsteps)
+{
+	ipc_call_t answer;
+	ipc_call_t tanswer;
+	errno_t rc;
+	errno_t trc;
+
+	async_exch_t *exch = vfs_exchange_grab(base->fs_handle);
+	aid_t req = async_send_5(exch, VFS_OUT_LOOKUP, (sysarg_t) first,
+	    (sysarg_t) len, (sysarg_t) base->service_id,
+	    (sysarg_t) base->index, (sysarg_t) L_TRACE, &answer);
+	aid_t treq = async_data_read(exch, steps,
+	    VFS_LOOKUP_STEPS_MAX * sizeof(vfs_lookup_step_t), &tanswer);
+	async_wait_for(req, &rc);
+	async_wait_for(treq, &trc);
+	vfs_exchange_release(exch);
+
+	if (rc != EOK)
+		return rc;
+	if (trc != EOK)
+		return trc;
+
+	*nsteps = ipc_get_arg2(&tanswer) / sizeof(vfs_lookup_step_t);
+	return EOK;
+}
+
+/** Cross the mount points stacked on a node.
+ *
+ * @param res     Looked up node, replaced by the root of the file system
+ *                mounted on it, if any.
+ * @param lflag   Flags to be used during lookup.
+ *
+ * @return EOK on success, EXDEV if mount points are not to be crossed.
+ *
+ */
+static errno_t lookup_cross(vfs_lookup_res_t *res, int lflag)
+{
+	vfs_node_t *node = vfs_node_peek(res);
+	if (node == NULL)
+		return EOK;
+
+	if (node->mount == NULL) {
+		vfs_node_put(node);
+		return EOK;
+	}
+
+	if (lflag & L_DISABLE_MOUNTS) {
+		vfs_node_put(node);
+		return EXDEV;
+	}
+
+	while (node->mount) {
+		vfs_node_addref(node->mount);
+		vfs_node_t *nnode = node->mount;
+		vfs_node_put(node);
+		node = nnode;
+	}
+
+	res->triplet = *((vfs_triplet_t *) node);
+	res->type = node->type;
+	res->size = node->size;
+	vfs_node_put(node);
+	return EOK;
+}
+
+/** Get the next component of a path.
+ *
+ * @param path    Path, pointing at the component or the slash before it.
+ * @param len     Length of the path.
+ * @param name    Buffer of NAME_MAX + 1 bytes for the component.
+ *
+ * @return Number of characters taken, including the slash, or zero if the
+ *         component is too long or empty.
+ *
+ */
+static size_t lookup_next_name(const char *path, size_t len, char *name)
+{
+	size_t skip = ((len > 0) && (*path == '/')) ? 1 : 0;
+
+	size_t clen = 0;
+	while ((skip + clen < len) && (path[skip + clen] != '/'))
+		clen++;
+
+	if ((clen == 0) || (clen > NAME_MAX))
+		return 0;
+
+	memcpy(name, path + skip, clen);
+	name[clen] = 0;
+	return skip + clen;
+}
+
+/** Resolve the rest of a path in one request to the file system.
+ *
+ * Every node found on the way is cached. The lookup stops early at a mount
+ * point, which the caller crosses, or after VFS_LOOKUP_STEPS_MAX
+ * components, in which case the caller carries on.
+ *
+ * @param path    Rest of the path, pointing at the next component.
+ * @param next    PLB index of the rest of the path.
+ * @param len     Length of the rest of the path.
+ * @param gen     Cache generation returned by vfs_dentry_lookup().
+ * @param dir     Directory to start the lookup in.
+ * @param child   Place to store the last node found.
+ * @param ptotal  Place to store the number of characters resolved.
+ *
+ * @return EOK on success or an error code from errno.h.
+ *
+ */
+static errno_t lookup_rest(const char *path, size_t next, size_t len,
+    unsigned int gen, vfs_triplet_t *dir, vfs_lookup_res_t *child,
+    size_t *ptotal)
+{
+	vfs_lookup_step_t steps[VFS_LOOKUP_STEPS_MAX];
+	size_t nsteps;
+
+	errno_t rc = out_lookup_trace(dir, next, len, steps, &nsteps);
+	if (rc != EOK)
+		return rc;
+
+	vfs_triplet_t parent = *dir;
+	char name[NAME_MAX + 1];
+	size_t total = 0;
+	bool mp = false;
+
+	for (size_t i = 0; (i < nsteps) && !mp; i++) {
+		size_t taken = lookup_next_name(path + total, len - total,
+		    name);
+		if (taken == 0)
+			return ENOENT;
+
+		*child = (vfs_lookup_res_t) {
+			.triplet = {
+				.fs_handle = parent.fs_handle,
+				.service_id = parent.service_id,
+				.index = steps[i].index
+			},
+			.size = steps[i].size,
+			.type = steps[i].directory ?
+			    VFS_NODE_DIRECTORY : VFS_NODE_FILE
+		};
+
+		vfs_dentry_insert(gen, &parent, name, child);
+		parent = child->triplet;
+		total += taken;
+
+		/* The file system does not see what is mounted on the node. */
+		vfs_node_t *node = vfs_node_peek(child);
+		if (node != NULL) {
+			mp = (node->mount != NULL);
+			vfs_node_put(node);
+		}
+	}
+
+	if (!mp && (total < len) && (nsteps < VFS_LOOKUP_STEPS_MAX)) {
+		/* The file system stopped at a missing component. */
+		if (lookup_next_name(path + total, len - total, name) != 0)
+			vfs_dentry_insert(gen, &parent, name, NULL);
+		return ENOENT;
+	}
+
+	*ptotal = total;
+	return EOK;
+}
+
+/** Resolve the next path component through the path component cache.
+ *
+ * The component is looked up by the file system only if it is not cached,
+ * and the result is cached afterwards. On a miss, the rest of the path is
+ * looked up in the same request.
+ *
+ * @param path    Path being resolved, as copied into PLB.
+ * @param first   PLB index of the beginning of the path.
+ * @param pnext   PLB index of the next component, updated on return.
+ * @param plen    Length of the unresolved part of the path, updated on
+ *                return.
+ * @param lflag   Flags to be used during lookup.
+ * @param res     Directory to look the component up in, replaced by the
+ *                found node.
+ *
+ * @return EOK on success or an error code from errno.h.
+ *
+ */
+static errno_t lookup_component(const char *path, size_t first,
+    size_t *pnext, size_t *plen, int lflag, vfs_lookup_res_t *res)
+{
+	const char *start = path + (*pnext - first);
+	const char *comp = (*start == '/') ? start + 1 : start;
+
+	size_t clen = 0;
+	while ((clen < *plen - (comp - start)) && (comp[clen] != '/'))
+		clen++;
+
+	size_t total = (comp - start) + clen;
+	vfs_lookup_res_t child;
+
+	if (clen == 0) {
+		/* The path is just "/". */
+		child = *res;
+	} else {
+		if (clen > NAME_MAX)
+			return ENAMETOOLONG;
+
+		if (res->type == VFS_NODE_FILE)
+			return ENOTDIR;
+
+		char name[NAME_MAX + 1];
+		memcpy(name, comp, clen);
+		name[clen] = 0;
+
+		unsigned int gen;
+		errno_t rc = vfs_dentry_lookup(&res->triplet, name, &child,
+		    &gen);
+		if ((rc == EAGAIN) && (total < *plen)) {
+			rc = lookup_rest(start, *pnext, *plen, gen,
+			    &res->triplet, &child, &total);
+			if (rc != EOK)
+				return rc;
+		} else if (rc == EAGAIN) {
+			size_t next = *pnext;
+			size_t len = total;
+
+			rc = out_lookup(&res->triplet, &next, &len, L_NONE,
+			    &child);
+			if (rc != EOK)
+				return rc;
+
+			if (len > 0) {
+				/* The file system stopped at the directory. */
+				vfs_dentry_insert(gen, &res->triplet, name,
+				    NULL);
+				return ENOENT;
+			}
+
+			vfs_dentry_insert(gen, &res->triplet, name, &child);
+		} else if (rc != EOK) {
+			return rc;
+		}
+	}
+
+	*pnext += total;
+	*plen -= total;
+
+	if (*plen == 0) {
+		if ((lflag & L_FILE) && (child.type == VFS_NODE_DIRECTORY))
+			return EISDIR;
+
+		if ((lflag & L_DIRECTORY) && (child.type == VFS_NODE_FILE))
+			return ENOTDIR;
+	}
+
+	*res = child;
+	return EOK;
+}
+
+/** Record the result of creating or unlinking a name in the path cache.
+ *
+ * @param dir     Directory in which the name was created or unlinked.
+ * @param path    Path of the name relative to the directory.
+ * @param lflag   Flags used during lookup.
+ * @param rc      Result of the operation.
+ * @param res     Node which was created or unlinked.
+ *
+ */
+static void lookup_update(vfs_triplet_t *dir, const char *path, int lflag,
+    errno_t rc, vfs_lookup_res_t *res)
+{
+	if (!vfs_dentry_enabled(dir->fs_handle))
+		return;
+
+	const char *name = (*path == '/') ? path + 1 : path;
+	if ((*name == 0) || (str_chr(name, '/') != NULL))
+		return;
+
+	if (rc != EOK) {
+		vfs_dentry_forget(dir, name);
+	} else if (lflag & L_UNLINK) {
+		vfs_dentry_update(dir, name, NULL);
+		if (res->type == VFS_NODE_DIRECTORY)
+			vfs_dentry_invalidate_dir(&res->triplet);
+	} else {
+		vfs_dentry_update(dir, name, res);
+	}
+}
+
 static errno_t _vfs_lookup_internal(vfs_node_t *base, char *path, int lflag,
     vfs_lookup_res_t *result, size_t len)
 {
@@ -251,40 +550,51 @@ static errno_t _vfs_lookup_internal(vfs_node_t *base, char *path, int lflag,
 	size_t next = first;
 	size_t nlen = len;
 
-	vfs_lookup_res_t res;
+	/* Names are only cached by lookups which do not modify them. */
+	bool cached = !(lflag & (L_CREATE | L_UNLINK));
+
+	vfs_lookup_res_t res = {
+		.triplet = *((vfs_triplet_t *) base),
+		.type = base->type,
+		.size = base->size
+	};
 
 	/* Resolve path as long as there are mount points to cross. */
 	while (nlen > 0) {
-		while (base->mount) {
-			if (lflag & L_DISABLE_MOUNTS) {
-				rc = EXDEV;
-				goto out;
-			}
+		rc = lookup_cross(&res, lflag);
+		if (rc != EOK)
+			goto out;
 
-			base = base->mount;
+		if (cached && vfs_dentry_enabled(res.triplet.fs_handle)) {
+			rc = lookup_component(path, first, &next, &nlen, lflag,
+			    &res);
+			if (rc != EOK)
+				goto out;
+			continue;
 		}
 
-		rc = out_lookup((vfs_triplet_t *) base, &next, &nlen, lflag,
-		    &res);
+		vfs_triplet_t dir = res.triplet;
+		rc = out_lookup(&dir, &next, &nlen, lflag, &res);
+		if (!cached) {
+			lookup_update(&dir, path, lflag,
+			    (nlen > 0) ? ENOENT : rc, &res);
+		}
 		if (rc != EOK)
 			goto out;
 
 		if (nlen > 0) {
-			base = vfs_node_peek(&res);
-			if (!base) {
+			/* Only a mount point may stop the lookup early. */
+			vfs_node_t *node = vfs_node_peek(&res);
+			if (!node) {
 				rc = ENOENT;
 				goto out;
 			}
-			if (!base->mount) {
-				vfs_node_put(base);
+			if (!node->mount) {
+				vfs_node_put(node);
 				rc = ENOENT;
 				goto out;
 			}
-			vfs_node_put(base);
-			if (lflag & L_DISABLE_MOUNTS) {
-				rc = EXDEV;
-				goto out;
-			}
+			vfs_node_put(node);
 		}
 	}
 
@@ -293,27 +603,11 @@ static errno_t _vfs_lookup_internal(vfs_node_t *base, char *path, int lflag,
 
 	if (result != NULL) {
 		/* The found file may be a mount point. Try to cross it. */
-		if (!(lflag & (L_MP | L_DISABLE_MOUNTS))) {
-			base = vfs_node_peek(&res);
-			if (base && base->mount) {
-				while (base->mount) {
-					vfs_node_addref(base->mount);
-					vfs_node_t *nbase = base->mount;
-					vfs_node_put(base);
-					base = nbase;
-				}
-
-				result->triplet = *((vfs_triplet_t *) base);
-				result->type = base->type;
-				result->size = base->size;
-				vfs_node_put(base);
-				goto out;
-			}
-			if (base)
-				vfs_node_put(base);
-		}
+		if (!(lflag & (L_MP | L_DISABLE_MOUNTS)))
+			rc = lookup_cross(&res, lflag);
 
-		*result = res;
+		if (rc == EOK)
+			*result = res;
 	}
 
 out:
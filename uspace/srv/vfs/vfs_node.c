@@ -124,6 +124,22 @@ void vfs_node_delref(vfs_node_t *node)
 	fibril_mutex_unlock(&nodes_mutex);
 
 	if (free_node) {
+		/* Cached lookups of the node take over its size. */
+		vfs_dentry_node_put(node);
+
+		/*
+		 * Pages read through a file descriptor which outlived an
+		 * unlink must go before the file system can reuse the index.
+		 */
+		if (vfs_cache_enabled(node)) {
+			vfs_triplet_t triplet = {
+				.fs_handle = node->fs_handle,
+				.service_id = node->service_id,
+				.index = node->index
+			};
+			vfs_cache_invalidate(&triplet);
+		}
+
 		/*
 		 * VFS_OUT_DESTROY will free up the file's resources if there
 		 * are no more hard links.
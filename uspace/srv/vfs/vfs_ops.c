@@ -267,6 +267,11 @@ errno_t vfs_op_mount(int mpfd, unsigned service_id, unsigned flags,
 
 	rc = vfs_connect_internal(service_id, flags, instance, opts, fs_name,
 	    &root);
+	if (rc == EOK) {
+		/* Forget anything cached about a previous instance. */
+		vfs_cache_invalidate_fs(root->fs_handle, root->service_id);
+		vfs_dentry_invalidate_fs(root->fs_handle, root->service_id);
+	}
 	if (rc == EOK && !(flags & VFS_MOUNT_CONNECT_ONLY)) {
 		vfs_node_addref(mp->node);
 		vfs_node_addref(root);
@@ -379,6 +384,21 @@ static errno_t rdwr_ipc_client(async_exch_t *exch, vfs_file_t *file, aoff64_t po
 	return rc;
 }
 
+static errno_t rdwr_ipc_cache(async_exch_t *exch, vfs_file_t *file, aoff64_t pos,
+    ipc_call_t *answer, bool read, void *data)
+{
+	size_t *bytes = (size_t *) data;
+
+	/* Only regular files of file systems which allow it are cached. */
+	if (!vfs_cache_enabled(file->node))
+		return rdwr_ipc_client(exch, file, pos, answer, read, data);
+
+	if (read)
+		return vfs_cache_read(exch, file->node, pos, bytes);
+	else
+		return vfs_cache_write(exch, file->node, pos, answer, bytes);
+}
+
 static errno_t rdwr_ipc_internal(async_exch_t *exch, vfs_file_t *file, aoff64_t pos,
     ipc_call_t *answer, bool read, void *data)
 {
@@ -507,7 +527,7 @@ errno_t vfs_rdwr_internal(int fd, aoff64_t pos, bool read, rdwr_io_chunk_t *chun
 
 errno_t vfs_op_read(int fd, aoff64_t pos, size_t *out_bytes)
 {
-	return vfs_rdwr(fd, pos, true, rdwr_ipc_client, out_bytes);
+	return vfs_rdwr(fd, pos, true, rdwr_ipc_cache, out_bytes);
 }
 
 errno_t vfs_op_rename(int basefd, char *old, char *new)
@@ -599,6 +619,8 @@ errno_t vfs_op_rename(int basefd, char *old, char *new)
 
 	/* If the node is not held by anyone, try to destroy it. */
 	if (orig_unlinked) {
+		vfs_cache_invalidate(&new_lr_orig.triplet);
+
 		vfs_node_t *node = vfs_node_peek(&new_lr_orig);
 		if (!node)
 			out_destroy(&new_lr_orig.triplet);
@@ -626,9 +648,17 @@ errno_t vfs_op_resize(int fd, int64_t size)
 
 	errno_t rc = vfs_truncate_internal(file->node->fs_handle,
 	    file->node->service_id, file->node->index, size);
-	if (rc == EOK)
+	if (rc == EOK) {
 		file->node->size = size;
 
+		vfs_triplet_t triplet = {
+			.fs_handle = file->node->fs_handle,
+			.service_id = file->node->service_id,
+			.index = file->node->index
+		};
+		vfs_cache_resize(&triplet, size);
+	}
+
 	fibril_rwlock_write_unlock(&file->node->contents_rwlock);
 	vfs_file_put(file);
 	return rc;
@@ -766,6 +796,9 @@ errno_t vfs_op_unlink(int parentfd, int expectfd, char *path)
 	if (rc != EOK)
 		goto exit;
 
+	/* The index of the node may be reused by another node. */
+	vfs_cache_invalidate(&lr.triplet);
+
 	/* If the node is not held by anyone, try to destroy it. */
 	vfs_node_t *node = vfs_node_peek(&lr);
 	if (!node)
@@ -822,6 +855,11 @@ errno_t vfs_op_unmount(int mpfd)
 		return rc;
 	}
 
+	vfs_cache_invalidate_fs(mp->node->mount->fs_handle,
+	    mp->node->mount->service_id);
+	vfs_dentry_invalidate_fs(mp->node->mount->fs_handle,
+	    mp->node->mount->service_id);
+
 	vfs_node_forget(mp->node->mount);
 	vfs_node_put(mp->node);
 	mp->node->mount = NULL;
@@ -920,7 +958,7 @@ errno_t vfs_op_walk(int parentfd, int flags, char *path, int *out_fd)
 
 errno_t vfs_op_write(int fd, aoff64_t pos, size_t *out_bytes)
 {
-	return vfs_rdwr(fd, pos, false, rdwr_ipc_client, out_bytes);
+	return vfs_rdwr(fd, pos, false, rdwr_ipc_cache, out_bytes);
 }
 
 /**
@@ -41,6 +41,47 @@
 #include <errno.h>
 #include <as.h>
 
+/** Answer a page-in request with a page from the page cache.
+ *
+ * The kernel maps the physical frame of the cached page into the faulting
+ * task and takes its own reference to it, so the page may be reclaimed
+ * from the cache afterwards without affecting the mapping.
+ *
+ * @return		False if the file cannot be served from the cache.
+ */
+static bool vfs_page_in_cached(ipc_call_t *req, int fd, aoff64_t offset)
+{
+	vfs_file_t *file = vfs_file_get(fd);
+	if (file == NULL)
+		return false;
+
+	if (!file->open_read || !vfs_cache_enabled(file->node)) {
+		vfs_file_put(file);
+		return false;
+	}
+
+	vfs_node_t *node = file->node;
+	fibril_rwlock_read_lock(&node->contents_rwlock);
+
+	async_exch_t *exch = vfs_exchange_grab(node->fs_handle);
+
+	vfs_cache_page_t *page;
+	errno_t rc = vfs_cache_get(exch, node, offset, &page);
+
+	vfs_exchange_release(exch);
+
+	if (rc == EOK) {
+		async_answer_1(req, EOK, (sysarg_t) vfs_cache_data(page));
+		vfs_cache_put(page);
+	} else {
+		async_answer_0(req, rc);
+	}
+
+	fibril_rwlock_read_unlock(&node->contents_rwlock);
+	vfs_file_put(file);
+	return true;
+}
+
 void vfs_page_in(ipc_call_t *req)
 {
 	aoff64_t offset = ipc_get_arg1(req);
@@ -49,6 +90,10 @@ void vfs_page_in(ipc_call_t *req)
 	void *page;
 	errno_t rc;
 
+	if ((page_size == PAGE_SIZE) && ((offset % PAGE_SIZE) == 0) &&
+	    vfs_page_in_cached(req, fd, offset))
+		return;
+
 	page = as_area_create(AS_AREA_ANY, page_size,
 	    AS_AREA_READ | AS_AREA_WRITE | AS_AREA_CACHEABLE,
 	    AS_AREA_UNPAGED);
@@ -80,10 +125,8 @@ void vfs_page_in(ipc_call_t *req)
 	async_answer_1(req, rc, (sysarg_t) page);
 
 	/*
-	 * FIXME:
-	 * This is just for now until we implement proper page cache
-	 * management.  Not keeping the pages around in a cache results in
-	 * inherently non-coherent private mappings.
+	 * Files which cannot be cached are read into a temporary page. Their
+	 * private mappings are inherently non-coherent.
 	 */
 	as_area_destroy(page);
 }